@@ -163,10 +163,13 @@ SOURCES += src/main.cpp \
     src/export/CsvExport.cpp \
     src/export/ExportTemplate.cpp \
     src/export/ExportTemplateLoader.cpp \
+    src/export/ImageExporter.cpp \
     src/export/MediaExport.cpp \
     src/export/SimpleEngine.cpp \
+    src/export/SimpleTemplate.cpp \
     src/export/TableWriter.cpp \
     src/file_search/ConcertFileSearcher.cpp \
+    src/file_search/DirectoryCrawler.cpp \
     src/file_search/movie/MovieDirectorySearcher.cpp \
     src/file_search/movie/MovieDirScan.cpp \
     src/file_search/movie/MovieFileSearcher.cpp \
@@ -194,6 +197,7 @@ SOURCES += src/main.cpp \
     src/media/NameFormatter.cpp \
     src/media/Path.cpp \
     src/media/StreamDetails.cpp \
+    src/media/StreamDetailsService.cpp \
     src/media_center/kodi/AlbumXmlReader.cpp \
     src/media_center/kodi/AlbumXmlWriter.cpp \
     src/media_center/kodi/ArtistXmlReader.cpp \
@@ -202,9 +206,12 @@ SOURCES += src/main.cpp \
     src/media_center/kodi/ConcertXmlWriter.cpp \
     src/media_center/kodi/EpisodeXmlReader.cpp \
     src/media_center/kodi/EpisodeXmlWriter.cpp \
+    src/media_center/kodi/KodiFileIndex.cpp \
+    src/media_center/kodi/KodiXmlReader.cpp \
     src/media_center/kodi/KodiXmlWriter.cpp \
     src/media_center/kodi/MovieXmlReader.cpp \
     src/media_center/kodi/MovieXmlWriter.cpp \
+    src/media_center/kodi/NfoFileWriter.cpp \
     src/media_center/kodi/TvShowXmlReader.cpp \
     src/media_center/kodi/TvShowXmlWriter.cpp \
     src/media_center/KodiVersion.cpp \
@@ -216,12 +223,15 @@ SOURCES += src/main.cpp \
     src/model/ImageModel.cpp \
     src/model/ImageProxyModel.cpp \
     src/model/MediaStatusColumn.cpp \
+    src/model/MovieDuplicateIndex.cpp \
     src/model/MovieModel.cpp \
     src/model/MovieProxyModel.cpp \
     src/model/music/MusicModel.cpp \
     src/model/music/MusicModelItem.cpp \
     src/model/music/MusicProxyModel.cpp \
     src/model/RatingModel.cpp \
+    src/model/SearchIndex.cpp \
+    src/model/SortKeyCache.cpp \
     src/model/tv_show/EpisodeModelItem.cpp \
     src/model/tv_show/SeasonModelItem.cpp \
     src/model/tv_show/TvShowBaseModelItem.cpp \
@@ -232,10 +242,13 @@ SOURCES += src/main.cpp \
     src/model/TvShowProxyModel.cpp \
     src/network/DownloadManager.cpp \
     src/network/DownloadManagerElement.cpp \
+    src/network/HttpCache.cpp \
     src/network/HttpStatusCodes.cpp \
     src/network/NetworkManager.cpp \
     src/network/NetworkReplyWatcher.cpp \
     src/network/NetworkRequest.cpp \
+    src/network/RequestScheduler.cpp \
+    src/network/ScheduledReply.cpp \
     src/network/WebsiteCache.cpp \
     src/qml/AlbumImageProvider.cpp \
     src/renamer/ConcertRenamer.cpp \
@@ -288,6 +301,7 @@ SOURCES += src/main.cpp \
     src/scrapers/ScraperInterface.cpp \
     src/scrapers/ScraperResult.cpp \
     src/scrapers/ScraperUtils.cpp \
+    src/scrapers/ScrapePipeline.cpp \
     src/scrapers/tmdb/TmdbApi.cpp \
     src/scrapers/trailer/HdTrailers.cpp \
     src/scrapers/trailer/TrailerProvider.cpp \
@@ -506,10 +520,13 @@ HEADERS  += Version.h \
     src/export/CsvExport.h \
     src/export/ExportTemplate.h \
     src/export/ExportTemplateLoader.h \
+    src/export/ImageExporter.h \
     src/export/MediaExport.h \
     src/export/SimpleEngine.h \
+    src/export/SimpleTemplate.h \
     src/export/TableWriter.h \
     src/file_search/ConcertFileSearcher.h \
+    src/file_search/DirectoryCrawler.h \
     src/file_search/movie/MovieDirectorySearcher.h \
     src/file_search/movie/MovieDirScan.h \
     src/file_search/movie/MovieFileSearcher.h \
@@ -538,6 +555,7 @@ HEADERS  += Version.h \
     src/media/NameFormatter.h \
     src/media/Path.h \
     src/media/StreamDetails.h \
+    src/media/StreamDetailsService.h \
     src/media_center/kodi/AlbumXmlReader.h \
     src/media_center/kodi/AlbumXmlWriter.h \
     src/media_center/kodi/ArtistXmlReader.h \
@@ -546,9 +564,12 @@ HEADERS  += Version.h \
     src/media_center/kodi/ConcertXmlWriter.h \
     src/media_center/kodi/EpisodeXmlReader.h \
     src/media_center/kodi/EpisodeXmlWriter.h \
+    src/media_center/kodi/KodiFileIndex.h \
+    src/media_center/kodi/KodiXmlReader.h \
     src/media_center/kodi/KodiXmlWriter.h \
     src/media_center/kodi/MovieXmlReader.h \
     src/media_center/kodi/MovieXmlWriter.h \
+    src/media_center/kodi/NfoFileWriter.h \
     src/media_center/kodi/TvShowXmlReader.h \
     src/media_center/kodi/TvShowXmlWriter.h \
     src/media_center/KodiVersion.h \
@@ -560,12 +581,15 @@ HEADERS  += Version.h \
     src/model/ImageModel.h \
     src/model/ImageProxyModel.h \
     src/model/MediaStatusColumn.h \
+    src/model/MovieDuplicateIndex.h \
     src/model/MovieModel.h \
     src/model/MovieProxyModel.h \
     src/model/music/MusicModel.h \
     src/model/music/MusicModelItem.h \
     src/model/music/MusicProxyModel.h \
     src/model/RatingModel.h \
+    src/model/SearchIndex.h \
+    src/model/SortKeyCache.h \
     src/model/tv_show/EpisodeModelItem.h \
     src/model/tv_show/SeasonModelItem.h \
     src/model/tv_show/TvShowBaseModelItem.h \
@@ -576,10 +600,13 @@ HEADERS  += Version.h \
     src/model/TvShowProxyModel.h \
     src/network/DownloadManager.h \
     src/network/DownloadManagerElement.h \
+    src/network/HttpCache.h \
     src/network/HttpStatusCodes.h \
     src/network/NetworkManager.h \
     src/network/NetworkReplyWatcher.h \
     src/network/NetworkRequest.h \
+    src/network/RequestScheduler.h \
+    src/network/ScheduledReply.h \
     src/network/WebsiteCache.h \
     src/qml/AlbumImageProvider.h \
     src/renamer/ConcertRenamer.h \
@@ -632,6 +659,7 @@ HEADERS  += Version.h \
     src/scrapers/ScraperInterface.h \
     src/scrapers/ScraperResult.h \
     src/scrapers/ScraperUtils.h \
+    src/scrapers/ScrapePipeline.h \
     src/scrapers/tmdb/TmdbApi.h \
     src/scrapers/trailer/HdTrailers.h \
     src/scrapers/trailer/TrailerProvider.h \
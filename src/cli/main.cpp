@@ -3,6 +3,7 @@
 #include "cli/info.h"
 #include "cli/list.h"
 #include "cli/reload.h"
+#include "cli/scrape.h"
 #include "cli/show.h"
 #include "settings/Settings.h"
 #include "utils/Meta.h"
@@ -24,6 +25,7 @@ enum class Command
     Unknown,
     List,
     Reload,
+    Scrape,
     Add,
     Show,
     Sync,
@@ -41,6 +43,9 @@ static Command commandFromString(const QString& command)
     if ("reload" == command) {
         return Command::Reload;
     }
+    if ("scrape" == command) {
+        return Command::Scrape;
+    }
     if ("add" == command) {
         return Command::Add;
     }
@@ -76,6 +81,7 @@ Options:
 commands:
    list        List all media entries.
    reload      Reload all media files.
+   scrape      Scrape all media entries without user interaction.
    add <path>  Add given path to MediaElch's directory settings.
    show <id>   Show an entry with the identifier <id>. <id> can be either
                MediaElch's media id, IMDb id or TheTvDb id for TV shows.
@@ -123,6 +129,7 @@ static int parseArguments(QApplication& app)
     case Command::Version: parser.showVersion();
     case Command::List: return mediaelch::cli::list(app, parser);
     case Command::Reload: return mediaelch::cli::reload(app, parser);
+    case Command::Scrape: return mediaelch::cli::scrape(app, parser);
     case Command::Settings:
     case Command::Sync:
     case Command::Add: printUnsupported(command); return 1;
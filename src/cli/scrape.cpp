@@ -0,0 +1,382 @@
+#include "cli/scrape.h"
+
+#include "data/movie/Movie.h"
+#include "file_search/movie/MovieFileSearcher.h"
+#include "globals/Manager.h"
+#include "scrapers/movie/MovieScraper.h"
+#include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "settings/Settings.h"
+
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QTimer>
+#include <iostream>
+
+namespace mediaelch {
+namespace cli {
+
+MovieBatchScraper::MovieBatchScraper(ScrapeConfig config, scraper::MovieScraper* scraper, QObject* parent) :
+    QObject(parent), m_config{std::move(config)}, m_scraper{scraper}, m_infos{scraper->meta().supportedDetails}
+{
+}
+
+void MovieBatchScraper::start(const QVector<Movie*>& movies)
+{
+    m_timer.start();
+    m_total = qsizetype_to_int(movies.size());
+    for (Movie* movie : movies) {
+        m_queue.enqueue(movie);
+    }
+
+    loadProgress();
+
+    const int jobs = qMax(1, m_config.jobs);
+    for (int i = 0; i < jobs; ++i) {
+        startNext();
+    }
+}
+
+QJsonObject MovieBatchScraper::summary() const
+{
+    QJsonObject summary;
+    summary.insert("scraper", m_scraper->meta().identifier);
+    summary.insert("total", m_total);
+    summary.insert("scraped", m_scraped);
+    summary.insert("skipped", m_skipped);
+    summary.insert("notFound", m_notFound);
+    summary.insert("failed", m_failed);
+    summary.insert("durationMs", static_cast<double>(m_timer.elapsed()));
+    summary.insert("movies", m_results);
+    return summary;
+}
+
+void MovieBatchScraper::startNext()
+{
+    while (!m_queue.isEmpty()) {
+        Movie* movie = m_queue.dequeue();
+        if (m_alreadyScraped.contains(movieFile(movie))) {
+            done(movie, Status::Skipped, QStringLiteral("already scraped"));
+            continue;
+        }
+        ++m_running;
+        scrape(movie);
+        return;
+    }
+
+    if (m_running == 0) {
+        if (m_progress.isOpen()) {
+            m_progress.close();
+        }
+        emit finished();
+    }
+}
+
+void MovieBatchScraper::scrape(Movie* movie)
+{
+    using namespace mediaelch::scraper;
+
+    const QString& scraperId = m_scraper->meta().identifier;
+    const bool isImdb = (scraperId == ImdbMovie::ID);
+    const bool isTmdb = (scraperId == TmdbMovie::ID);
+
+    // Existing details must be loaded, otherwise they would be lost when saving.
+    movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
+
+    QHash<MovieScraper*, MovieIdentifier> ids;
+    if (isImdb && movie->imdbId().isValid()) {
+        ids.insert(nullptr, MovieIdentifier(movie->imdbId()));
+    } else if (isTmdb && movie->tmdbId().isValid()) {
+        ids.insert(nullptr, MovieIdentifier(movie->tmdbId()));
+    } else if (isTmdb && movie->imdbId().isValid()) {
+        // TMDb can also load with IMDb IDs.
+        ids.insert(nullptr, MovieIdentifier(movie->imdbId()));
+    }
+
+    if (ids.isEmpty() && m_config.onlyWithId) {
+        --m_running;
+        done(movie, Status::Skipped, QStringLiteral("no ID"));
+        startNext();
+        return;
+    }
+
+    // There is no GUI; errors are reported by onScraperError().
+    movie->controller()->setShowErrorNotifications(false);
+    connect(movie->controller(), &MovieController::sigScraperError, this, &MovieBatchScraper::onScraperError);
+    connect(movie->controller(), &MovieController::sigLoadDone, this, &MovieBatchScraper::onLoadDone);
+
+    if (!ids.isEmpty()) {
+        movie->controller()->loadData(ids, m_scraper, m_infos);
+        return;
+    }
+
+    MovieSearchJob::Config config;
+    config.query = movie->name().replace(".", " ");
+    config.includeAdult = Settings::instance()->showAdultScrapers();
+
+    auto* searchJob = m_scraper->search(config);
+    searchJob->setProperty("movie", QVariant::fromValue(movie));
+    connect(searchJob, &MovieSearchJob::searchFinished, this, &MovieBatchScraper::onSearchFinished);
+    searchJob->start();
+}
+
+void MovieBatchScraper::onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob)
+{
+    using namespace mediaelch::scraper;
+
+    auto dls = makeDeleteLaterScope(searchJob);
+    auto* movie = searchJob->property("movie").value<Movie*>();
+
+    if (searchJob->hasError() || searchJob->results().isEmpty()) {
+        disconnect(movie->controller(), &MovieController::sigScraperError, this, &MovieBatchScraper::onScraperError);
+        disconnect(movie->controller(), &MovieController::sigLoadDone, this, &MovieBatchScraper::onLoadDone);
+        --m_running;
+        if (searchJob->hasError()) {
+            done(movie, Status::Failed, searchJob->errorString());
+        } else {
+            done(movie, Status::NotFound);
+        }
+        startNext();
+        return;
+    }
+
+    QHash<MovieScraper*, MovieIdentifier> ids;
+    ids.insert(m_scraper, searchJob->results().first().identifier);
+    movie->controller()->loadData(ids, m_scraper, m_infos);
+}
+
+void MovieBatchScraper::onScraperError(Movie* movie, mediaelch::ScraperError error)
+{
+    // Only the first error is reported; the custom movie scraper may report multiple ones.
+    if (!m_errors.contains(movie)) {
+        m_errors.insert(movie, error);
+    }
+}
+
+void MovieBatchScraper::onLoadDone(Movie* movie)
+{
+    disconnect(movie->controller(), &MovieController::sigScraperError, this, &MovieBatchScraper::onScraperError);
+    disconnect(movie->controller(), &MovieController::sigLoadDone, this, &MovieBatchScraper::onLoadDone);
+    --m_running;
+
+    // Movies with errors are not saved, because their details may be incomplete.
+    const auto error = m_errors.find(movie);
+    if (error != m_errors.end()) {
+        if (error->is404()) {
+            done(movie, Status::NotFound, error->message);
+        } else {
+            done(movie, Status::Failed, error->message);
+        }
+        m_errors.erase(error);
+
+    } else if (m_config.save && !movie->controller()->saveData(Manager::instance()->mediaCenterInterface())) {
+        done(movie, Status::Failed, QStringLiteral("could not save movie"));
+    } else {
+        done(movie, Status::Scraped);
+    }
+    startNext();
+}
+
+void MovieBatchScraper::done(Movie* movie, Status status, const QString& message)
+{
+    QString statusStr;
+    switch (status) {
+    case Status::Scraped:
+        ++m_scraped;
+        statusStr = QStringLiteral("scraped");
+        break;
+    case Status::Skipped:
+        ++m_skipped;
+        statusStr = QStringLiteral("skipped");
+        break;
+    case Status::NotFound:
+        ++m_notFound;
+        statusStr = QStringLiteral("not found");
+        break;
+    case Status::Failed:
+        ++m_failed;
+        statusStr = QStringLiteral("failed");
+        break;
+    }
+
+    const QString file = movieFile(movie);
+    QJsonObject result;
+    result.insert("title", movie->name());
+    result.insert("file", file);
+    result.insert("status", statusStr);
+    if (!message.isEmpty()) {
+        result.insert("message", message);
+    }
+    m_results.append(result);
+
+    const int current = m_scraped + m_skipped + m_notFound + m_failed;
+    std::cerr << "[" << current << "/" << m_total << "] " << statusStr.toStdString() << ": "
+              << movie->name().toStdString() << std::endl;
+
+    // Movies that were not found are not recorded: a later run with different
+    // settings may find them.
+    if (m_progress.isOpen() && (status == Status::Scraped) && !file.isEmpty()) {
+        m_progress.write(file.toUtf8() + '\n');
+        m_progress.flush();
+    }
+}
+
+QString MovieBatchScraper::movieFile(const Movie* movie)
+{
+    return movie->files().isEmpty() ? QString() : movie->files().first().toString();
+}
+
+void MovieBatchScraper::loadProgress()
+{
+    if (m_config.progressFile.isEmpty()) {
+        return;
+    }
+    m_progress.setFileName(m_config.progressFile);
+    if (!m_progress.open(QIODevice::ReadWrite | QIODevice::Append | QIODevice::Text)) {
+        std::cerr << "Could not open progress file: " << m_config.progressFile.toStdString() << std::endl;
+        return;
+    }
+    m_progress.seek(0);
+    while (!m_progress.atEnd()) {
+        const QString line = QString::fromUtf8(m_progress.readLine()).trimmed();
+        if (!line.isEmpty()) {
+            m_alreadyScraped.insert(line);
+        }
+    }
+}
+
+static scraper::MovieScraper* findMovieScraper(const QString& identifier)
+{
+    const auto& scrapers = Manager::instance()->scrapers().movieScrapers();
+    for (scraper::MovieScraper* scraper : scrapers) {
+        if (scraper->meta().identifier.compare(identifier, Qt::CaseInsensitive) == 0) {
+            return scraper;
+        }
+    }
+    return nullptr;
+}
+
+/// \brief Waits until the scraper is initialized, e.g. until TMDb's configuration was loaded.
+static bool waitForInitialization(scraper::MovieScraper* scraper)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QEventLoop loop;
+    while (!scraper->isInitialized() && timer.elapsed() < 30000) {
+        QTimer::singleShot(100, &loop, &QEventLoop::quit);
+        loop.exec();
+    }
+    return scraper->isInitialized();
+}
+
+static QVector<Movie*> loadMovies()
+{
+    auto* searcher = Manager::instance()->movieFileSearcher();
+    searcher->setMovieDirectories(Settings::instance()->directorySettings().movieDirectories());
+
+    bool finished = false;
+    QEventLoop loop;
+    QObject::connect(searcher, &MovieFileSearcher::finished, &loop, [&]() {
+        finished = true;
+        loop.quit();
+    });
+    searcher->reload(false);
+    if (!finished) {
+        loop.exec();
+    }
+
+    QVector<Movie*> movies;
+    MovieModel* movieModel = Manager::instance()->movieModel();
+    for (int i = 0; i < movieModel->rowCount(); ++i) {
+        Movie* movie = movieModel->movie(i);
+        if (movie != nullptr) {
+            movies << movie;
+        }
+    }
+    return movies;
+}
+
+int scrape(QApplication& app, QCommandLineParser& parser)
+{
+    parser.clearPositionalArguments();
+    // re-add this command so that it appears when help is printed
+    parser.addPositionalArgument("scrape", "Scrape all media entries", "scrape [scrape_options]");
+
+    QCommandLineOption typeOption("type", R"(Media type. Only "movie" is supported, yet.)", "mediatype", "movie");
+    QCommandLineOption scraperOption("scraper", "Identifier of the scraper, e.g. \"tmdb\"", "scraper", "tmdb");
+    QCommandLineOption jobsOption("jobs", "Number of entries that are scraped in parallel", "N", "4");
+    QCommandLineOption onlyWithIdOption("only-with-id", "Only scrape entries that have an ID for the scraper");
+    QCommandLineOption dryRunOption("dry-run", "Scrape entries but do not save them");
+    QCommandLineOption progressOption("progress-file",
+        "Record scraped entries in this file and skip entries that are already listed in it",
+        "file");
+
+    parser.addOption(typeOption);
+    parser.addOption(scraperOption);
+    parser.addOption(jobsOption);
+    parser.addOption(onlyWithIdOption);
+    parser.addOption(dryRunOption);
+    parser.addOption(progressOption);
+    parser.process(app);
+
+    ScrapeConfig config;
+    config.mediaType = mediaTypeFromString(parser.value(typeOption));
+    config.scraperId = parser.value(scraperOption);
+    config.onlyWithId = parser.isSet(onlyWithIdOption);
+    config.save = !parser.isSet(dryRunOption);
+    config.progressFile = parser.value(progressOption);
+
+    bool ok = false;
+    config.jobs = parser.value(jobsOption).toInt(&ok);
+    if (!ok || config.jobs < 1) {
+        std::cerr << "Invalid number of jobs: " << parser.value(jobsOption).toStdString() << std::endl;
+        return 1;
+    }
+
+    if (config.mediaType != MediaType::Movie) {
+        std::cerr << "Media type not supported, yet: " << parser.value(typeOption).toStdString() << std::endl;
+        return 1;
+    }
+
+    scraper::MovieScraper* movieScraper = findMovieScraper(config.scraperId);
+    if (movieScraper == nullptr || movieScraper->meta().identifier == scraper::CustomMovieScraper::ID) {
+        std::cerr << "Unknown scraper: " << config.scraperId.toStdString() << "\nAvailable scrapers:";
+        for (const auto* scraper : Manager::instance()->scrapers().movieScrapers()) {
+            if (scraper->meta().identifier != scraper::CustomMovieScraper::ID) {
+                std::cerr << " " << scraper->meta().identifier.toStdString();
+            }
+        }
+        std::cerr << std::endl;
+        return 1;
+    }
+
+    if (!waitForInitialization(movieScraper)) {
+        std::cerr << "Scraper could not be initialized: " << movieScraper->meta().name.toStdString() << std::endl;
+        return 1;
+    }
+
+    const QVector<Movie*> movies = loadMovies();
+
+    MovieBatchScraper batchScraper(config, movieScraper);
+    bool finished = false;
+    QEventLoop loop;
+    QObject::connect(&batchScraper, &MovieBatchScraper::finished, &loop, [&]() {
+        finished = true;
+        loop.quit();
+    });
+    batchScraper.start(movies);
+    if (!finished) {
+        loop.exec();
+    }
+
+    QTextStream out(stdout);
+    out << QJsonDocument(batchScraper.summary()).toJson(QJsonDocument::Indented);
+    out.flush();
+
+    return batchScraper.failedCount() > 0 ? 1 : 0;
+}
+
+} // namespace cli
+} // namespace mediaelch
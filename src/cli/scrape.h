@@ -0,0 +1,104 @@
+#pragma once
+
+#include "cli/common.h"
+#include "scrapers/ScraperError.h"
+#include "scrapers/ScraperInfos.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+
+class Movie;
+
+namespace mediaelch {
+namespace scraper {
+class MovieScraper;
+class MovieSearchJob;
+} // namespace scraper
+
+namespace cli {
+
+struct ScrapeConfig
+{
+    MediaType mediaType = MediaType::Movie;
+    QString scraperId;
+    /// \brief Number of movies that are scraped in parallel.
+    int jobs = 4;
+    /// \brief Only scrape movies that have an ID for the scraper.
+    bool onlyWithId = false;
+    /// \brief Whether scraped movies are saved.
+    bool save = true;
+    /// \brief File in which scraped movies are recorded.  Movies listed in it are skipped,
+    ///        so that an interrupted run can be resumed.
+    QString progressFile;
+};
+
+/// \brief Scrapes movies without any user interaction.
+///
+/// Runs the same search, scrape and save steps as the multi-scrape dialog, but for
+/// multiple movies in parallel.  If a search has results, the first one is used.
+class MovieBatchScraper : public QObject
+{
+    Q_OBJECT
+
+public:
+    MovieBatchScraper(ScrapeConfig config, scraper::MovieScraper* scraper, QObject* parent = nullptr);
+
+    void start(const QVector<Movie*>& movies);
+    /// \brief Summary of all scraped movies; valid after finished() was emitted.
+    QJsonObject summary() const;
+    int failedCount() const { return m_failed; }
+
+signals:
+    void finished();
+
+private:
+    enum class Status
+    {
+        Scraped,
+        Skipped,
+        NotFound,
+        Failed
+    };
+
+    void startNext();
+    void scrape(Movie* movie);
+    void onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob);
+    void onScraperError(Movie* movie, mediaelch::ScraperError error);
+    void onLoadDone(Movie* movie);
+    void done(Movie* movie, Status status, const QString& message = {});
+
+    static QString movieFile(const Movie* movie);
+    void loadProgress();
+
+private:
+    ScrapeConfig m_config;
+    scraper::MovieScraper* m_scraper = nullptr;
+    QSet<MovieScraperInfo> m_infos;
+    QQueue<Movie*> m_queue;
+    QSet<QString> m_alreadyScraped;
+    /// \brief Errors of movies that are currently scraped.
+    QHash<Movie*, ScraperError> m_errors;
+    QFile m_progress;
+    QElapsedTimer m_timer;
+    int m_running = 0;
+    int m_total = 0;
+    int m_scraped = 0;
+    int m_skipped = 0;
+    int m_notFound = 0;
+    int m_failed = 0;
+    QJsonArray m_results;
+};
+
+int scrape(QApplication& app, QCommandLineParser& parser);
+
+} // namespace cli
+} // namespace mediaelch
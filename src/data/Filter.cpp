@@ -111,6 +111,14 @@ bool Filter::isInfo(MovieFilters info) const
     return m_type == FilterType::Movie && m_movieInfo == info;
 }
 
+bool Filter::needsMovieDetails() const
+{
+    return isInfo(MovieFilters::StreamDetails) || isInfo(MovieFilters::Actors) || isInfo(MovieFilters::Quality)
+           || isInfo(MovieFilters::Rating) || isInfo(MovieFilters::AudioChannels)
+           || isInfo(MovieFilters::AudioQuality) || isInfo(MovieFilters::HasSubtitle)
+           || isInfo(MovieFilters::VideoCodec);
+}
+
 bool Filter::isInfo(TvShowFilters info) const
 {
     return m_type == FilterType::TvShow && m_showInfo == info;
@@ -61,6 +61,9 @@ public:
     bool isInfo(TvShowFilters info) const;
     bool isInfo(MusicFilters info) const;
     bool isInfo(ConcertFilters info) const;
+    /// \brief Returns true if the filter uses movie details that are not part of
+    ///        the list data, e.g. actors or stream details.
+    bool needsMovieDetails() const;
 
 private:
     enum class FilterType
@@ -9,6 +9,7 @@
 #include "media/ImageCache.h"
 #include "media/ImageUtils.h"
 #include "media/NameFormatter.h"
+#include "media/StreamDetailsService.h"
 #include "media_center/MediaCenterInterface.h"
 #include "network/DownloadManager.h"
 #include "scrapers/concert/ConcertScraper.h"
@@ -119,6 +120,8 @@ bool ConcertController::loadData(MediaCenterInterface* mediaCenterInterface, boo
     m_infoFromNfoLoaded = infoLoaded && reloadFromNfo;
     m_concert->setChanged(false);
     m_concert->blockSignals(false);
+    // Signals were blocked while loading, but models must still update, e.g. their search index.
+    emit m_concert->sigChanged(m_concert);
     return infoLoaded;
 }
 
@@ -130,10 +133,10 @@ void ConcertController::loadData(TmdbId id,
     scraperInterface->loadData(id, m_concert, infos);
 }
 
-bool ConcertController::loadStreamDetailsFromFile()
+bool ConcertController::loadStreamDetailsFromFile(bool forceReprobe)
 {
     using namespace std::chrono;
-    const bool success = m_concert->streamDetails()->loadStreamDetails();
+    const bool success = m_concert->streamDetails()->loadStreamDetails(forceReprobe);
     if (!success) {
         return false;
     }
@@ -144,6 +147,23 @@ bool ConcertController::loadStreamDetailsFromFile()
     return true;
 }
 
+void ConcertController::loadStreamDetailsInBackground()
+{
+    using namespace std::chrono;
+    mediaelch::StreamDetailsService::instance()->load(m_concert->streamDetails()->files(),
+        this,
+        [this](bool success, const StreamDetails::Details& details) {
+            m_concert->streamDetails()->setLoaded(true);
+            if (success) {
+                m_concert->streamDetails()->setDetails(details);
+                seconds runtime(details.video.value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
+                m_concert->setRuntime(duration_cast<minutes>(runtime));
+                m_concert->setChanged(true);
+            }
+            emit sigStreamDetailsLoaded(m_concert, success);
+        });
+}
+
 QSet<ConcertScraperInfo> ConcertController::infosToLoad()
 {
     return m_infosToLoad;
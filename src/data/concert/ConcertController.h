@@ -30,7 +30,9 @@ public:
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool force = false, bool reloadFromNfo = true);
     void loadData(TmdbId id, mediaelch::scraper::ConcertScraper* scraperInterface, QSet<ConcertScraperInfo> infos);
 
-    ELCH_NODISCARD bool loadStreamDetailsFromFile();
+    ELCH_NODISCARD bool loadStreamDetailsFromFile(bool forceReprobe = false);
+    /// \brief Loads stream details in a background thread.  Emits sigStreamDetailsLoaded() once done.
+    void loadStreamDetailsInBackground();
 
     void scraperLoadDone(mediaelch::scraper::ConcertScraper* scraper);
     QSet<ConcertScraperInfo> infosToLoad();
@@ -46,6 +48,7 @@ public:
 signals:
     void sigInfoLoadDone(Concert*);
     void sigLoadDone(Concert*);
+    void sigStreamDetailsLoaded(Concert*, bool success);
     void sigLoadImagesStarted(Concert*);
     void sigDownloadProgress(Concert*, int, int);
     void sigLoadingImages(Concert*, QSet<ImageType>);
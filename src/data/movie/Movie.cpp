@@ -537,6 +537,14 @@ QDateTime Movie::fileLastModified() const
 }
 
 QString Movie::nfoContent() const
+{
+    if (m_nfoContent.isEmpty()) {
+        return QString();
+    }
+    return QString::fromUtf8(qUncompress(m_nfoContent));
+}
+
+QByteArray Movie::compressedNfoContent() const
 {
     return m_nfoContent;
 }
@@ -807,6 +815,11 @@ void Movie::setFileLastModified(QDateTime modified)
 }
 
 void Movie::setNfoContent(QString content)
+{
+    m_nfoContent = content.isEmpty() ? QByteArray() : qCompress(content.toUtf8());
+}
+
+void Movie::setCompressedNfoContent(QByteArray content)
 {
     m_nfoContent = std::move(content);
 }
@@ -1103,20 +1116,6 @@ void Movie::onSubtitleChanged()
     setChanged(true);
 }
 
-bool Movie::hasDuplicates() const
-{
-    return m_hasDuplicates;
-}
-
-void Movie::setHasDuplicates(bool hasDuplicates)
-{
-    if (m_hasDuplicates == hasDuplicates) {
-        return;
-    }
-    m_hasDuplicates = hasDuplicates;
-    emit sigChanged(this);
-}
-
 void Movie::setLabel(ColorLabel label)
 {
     m_label = label;
@@ -14,6 +14,7 @@
 #include "globals/Globals.h"
 #include "media/StreamDetails.h"
 
+#include <QByteArray>
 #include <QDate>
 #include <QDebug>
 #include <QObject>
@@ -91,6 +92,8 @@ public:
     bool streamDetailsLoaded() const;
     QDateTime fileLastModified() const;
     QString nfoContent() const;
+    /// \brief The NFO content as stored in memory and in the database: zlib-compressed UTF-8.
+    QByteArray compressedNfoContent() const;
     mediaelch::DatabaseId databaseId() const;
     bool syncNeeded() const;
     bool hasLocalTrailer() const;
@@ -135,6 +138,7 @@ public:
     void setMediaCenterId(int mediaCenterId);
     void setFileLastModified(QDateTime modified);
     void setNfoContent(QString content);
+    void setCompressedNfoContent(QByteArray content);
     void setDatabaseId(mediaelch::DatabaseId id);
     void setSyncNeeded(bool syncNeeded);
     void setDateAdded(QDateTime date);
@@ -164,10 +168,6 @@ public:
     void addSubtitle(Subtitle* subtitle, bool fromLoad = false);
 
     bool isDuplicate(Movie* movie) const;
-
-    bool hasDuplicates() const;
-    void setHasDuplicates(bool hasDuplicates);
-
     MovieDuplicate duplicateProperties(Movie* movie) const;
 
 public:
@@ -263,10 +263,11 @@ private:
     bool m_hasChanged = false;
     bool m_inSeparateFolder = false;
     bool m_syncNeeded = false;
-    bool m_hasDuplicates = false;
     StreamDetails* m_streamDetails;
     QDateTime m_fileLastModified;
-    QString m_nfoContent;
+    /// \brief Compressed, because NFO files are rarely needed after they were
+    ///        parsed but are kept for every movie.  See compressedNfoContent().
+    QByteArray m_nfoContent;
     QDateTime m_dateAdded;
     DiscType m_discType;
     ColorLabel m_label;
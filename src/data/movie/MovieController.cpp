@@ -11,6 +11,7 @@
 #include "media/ImageCache.h"
 #include "media/ImageUtils.h"
 #include "media/NameFormatter.h"
+#include "media/StreamDetailsService.h"
 #include "media_center/MediaCenterInterface.h"
 #include "network/DownloadManager.h"
 #include "scrapers/movie/MovieScraper.h"
@@ -47,6 +48,11 @@ MovieController::MovieController(Movie* parent) :
 
 bool MovieController::saveData(MediaCenterInterface* mediaCenterInterface)
 {
+    if (m_listDataOnly) {
+        // Writing the NFO file now would drop everything that is not part of the list data.
+        qCCritical(generic) << "[MovieController] Refusing to save movie without loaded details:" << m_movie->name();
+        return false;
+    }
     if (!m_movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
         const bool success = loadStreamDetailsFromFile();
         if (!success) {
@@ -129,7 +135,7 @@ bool MovieController::loadData(MediaCenterInterface* mediaCenterInterface, bool
                     m_movie->setName(NameFormatter::formatName(fi.completeBaseName()));
                 }
             }
-            QRegularExpression rx("tt\\d+");
+            static const QRegularExpression rx("tt\\d+");
             QRegularExpressionMatch match = rx.match(fi.completeBaseName());
             if (match.hasMatch()) {
                 m_movie->setImdbId(ImdbId(match.captured(0)));
@@ -138,11 +144,33 @@ bool MovieController::loadData(MediaCenterInterface* mediaCenterInterface, bool
     }
     m_infoLoaded = infoLoaded;
     m_infoFromNfoLoaded = infoLoaded && reloadFromNfo;
+    m_listDataOnly = false;
     m_movie->setChanged(false);
     m_movie->blockSignals(false);
+    // Signals were blocked while loading, but models must still update, e.g. their search index.
+    emit m_movie->sigChanged(m_movie);
     return infoLoaded;
 }
 
+void MovieController::setListDataLoaded()
+{
+    m_infoLoaded = true;
+    m_infoFromNfoLoaded = false;
+    m_listDataOnly = true;
+}
+
+bool MovieController::listDataOnly() const
+{
+    return m_listDataOnly;
+}
+
+void MovieController::loadDetails(MediaCenterInterface* mediaCenterInterface)
+{
+    if (m_listDataOnly) {
+        loadData(mediaCenterInterface, true, false);
+    }
+}
+
 void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier> ids,
     mediaelch::scraper::MovieScraper* scraperInterface,
     QSet<MovieScraperInfo> infos)
@@ -151,6 +179,8 @@ void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, mediaelc
         return;
     }
 
+    // Scrapers only replace the requested infos; all others are written back as they are.
+    loadDetails(Manager::instance()->mediaCenterInterface());
     emit sigLoadStarted(m_movie);
 
     const auto scraper = scraperInterface->meta().identifier;
@@ -169,11 +199,11 @@ void MovieController::loadData(QHash<mediaelch::scraper::MovieScraper*, mediaelc
     scraperInterface->loadData(ids, m_movie, infos);
 }
 
-bool MovieController::loadStreamDetailsFromFile()
+bool MovieController::loadStreamDetailsFromFile(bool forceReprobe)
 {
     using namespace std::chrono;
     using namespace std::chrono_literals;
-    bool success = m_movie->streamDetails()->loadStreamDetails();
+    bool success = m_movie->streamDetails()->loadStreamDetails(forceReprobe);
     if (!success) {
         return false;
     }
@@ -186,6 +216,26 @@ bool MovieController::loadStreamDetailsFromFile()
     return true;
 }
 
+void MovieController::loadStreamDetailsInBackground()
+{
+    using namespace std::chrono;
+    using namespace std::chrono_literals;
+    mediaelch::StreamDetailsService::instance()->load(m_movie->streamDetails()->files(),
+        this,
+        [this](bool success, const StreamDetails::Details& details) {
+            m_movie->streamDetails()->setLoaded(true);
+            if (success) {
+                m_movie->streamDetails()->setDetails(details);
+                const seconds runtime(details.video.value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
+                if (runtime > 0s) {
+                    m_movie->setRuntime(duration_cast<minutes>(runtime));
+                }
+                m_movie->setChanged(true);
+            }
+            emit sigStreamDetailsLoaded(m_movie, success);
+        });
+}
+
 QSet<MovieScraperInfo> MovieController::infosToLoad()
 {
     return m_infosToLoad;
@@ -200,11 +250,14 @@ void MovieController::scraperLoadDone(mediaelch::scraper::MovieScraper* scraper,
 {
     using namespace std::chrono_literals;
 
-    if (error.hasError() && !error.is404()) {
+    if (error.hasError() && !error.is404() && m_showErrorNotifications) {
         // TODO: 404 not necessary but avoids false positives at the moment.
         // TODO: Remove UI dependency
         NotificationBox::instance()->showError(error.message, 6s);
     }
+    if (error.hasError()) {
+        emit sigScraperError(m_movie, error);
+    }
 
     if (!property("customMovieScraperLoads").isNull() && property("customMovieScraperLoads").toInt() > 1) {
         setProperty("customMovieScraperLoads", property("customMovieScraperLoads").toInt() - 1);
@@ -481,3 +534,8 @@ void MovieController::setForceFanartLogo(const bool& force)
 {
     m_forceFanartLogo = force;
 }
+
+void MovieController::setShowErrorNotifications(bool show)
+{
+    m_showErrorNotifications = show;
+}
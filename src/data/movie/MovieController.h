@@ -37,6 +37,17 @@ public:
     /// \return Loading was successful or not
     bool loadData(MediaCenterInterface* mediaCenterInterface, bool force = false, bool reloadFromNfo = true);
 
+    /// \brief Marks the movie as loaded from the database's list columns, see Database::moviesInDirectory().
+    /// \details Only the data shown, sorted and filtered in the movie list is set.  The cached
+    ///          NFO content is parsed by loadDetails() once the rest is needed.
+    void setListDataLoaded();
+    /// \brief Returns true if only the list data was loaded, see setListDataLoaded().
+    bool listDataOnly() const;
+    /// \brief Parses the cached NFO content if only the list data was loaded.
+    /// \details Must be called before a movie is changed or written, otherwise all
+    ///          details that are not part of the list data would be lost.
+    void loadDetails(MediaCenterInterface* mediaCenterInterface);
+
     /// \brief Loads the movies info from a scraper
     /// \param ids Id of the movie within the given ScraperInterface
     /// \param scraperInterface ScraperInterface to use for loading
@@ -45,7 +56,9 @@ public:
         mediaelch::scraper::MovieScraper* scraperInterface,
         QSet<MovieScraperInfo> infos);
 
-    ELCH_NODISCARD bool loadStreamDetailsFromFile();
+    ELCH_NODISCARD bool loadStreamDetailsFromFile(bool forceReprobe = false);
+    /// \brief Loads stream details in a background thread.  Emits sigStreamDetailsLoaded() once done.
+    void loadStreamDetailsInBackground();
 
     /// \brief Called when a ScraperInterface has finished loading
     ///        Emits the loaded signal
@@ -72,11 +85,17 @@ public:
     void setForceFanartCdArt(const bool& force);
     void setForceFanartClearArt(const bool& force);
     void setForceFanartLogo(const bool& force);
+    /// \brief Whether scraper errors are shown in a NotificationBox.  Headless runs, e.g. of the
+    ///        CLI, disable it and only get errors through sigScraperError().
+    void setShowErrorNotifications(bool show);
 
 signals:
     void sigLoadStarted(Movie*);
     void sigInfoLoadDone(Movie*);
+    /// \brief Loading details from a scraper failed.  Emitted before sigInfoLoadDone().
+    void sigScraperError(Movie*, mediaelch::ScraperError error);
     void sigLoadDone(Movie*);
+    void sigStreamDetailsLoaded(Movie*, bool success);
     void sigLoadImagesStarted(Movie*);
     void sigDownloadProgress(Movie*, int, int);
     void sigLoadingImages(Movie*, QSet<ImageType>);
@@ -91,6 +110,7 @@ private:
     Movie* m_movie;
     bool m_infoLoaded;
     bool m_infoFromNfoLoaded;
+    bool m_listDataOnly = false;
     QSet<MovieScraperInfo> m_infosToLoad;
     DownloadManager* m_downloadManager;
     int m_downloadsSize = 0;
@@ -101,4 +121,5 @@ private:
     bool m_forceFanartClearArt;
     bool m_forceFanartCdArt;
     bool m_forceFanartLogo;
+    bool m_showErrorNotifications = true;
 };
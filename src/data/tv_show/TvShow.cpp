@@ -175,6 +175,7 @@ void TvShow::clearSeasonImageType(ImageType imageType)
 void TvShow::addEpisode(TvShowEpisode* episode)
 {
     m_episodes.push_back(episode);
+    invalidateEpisodeIndex();
 }
 
 /**
@@ -402,8 +403,9 @@ bool TvShow::hasNewEpisodes() const
  */
 bool TvShow::hasNewEpisodesInSeason(SeasonNumber season) const
 {
-    return std::any_of(m_episodes.cbegin(), m_episodes.cend(), [season](const TvShowEpisode* const episode) {
-        return episode->seasonNumber() == season && !episode->infoLoaded();
+    const QVector<TvShowEpisode*> seasonEpisodes = episodeIndex().value(season).episodes;
+    return std::any_of(seasonEpisodes.cbegin(), seasonEpisodes.cend(), [](const TvShowEpisode* const episode) {
+        return !episode->infoLoaded();
     });
 }
 
@@ -719,25 +721,27 @@ const QMap<SeasonNumber, QVector<Poster>>& TvShow::allSeasonThumbs() const
     return m_seasonThumbs;
 }
 
-TvShowEpisode* TvShow::episode(SeasonNumber season, EpisodeNumber episode)
+TvShowEpisode* TvShow::episode(SeasonNumber season, EpisodeNumber episode) const
 {
-    for (elch_ssize_t i = 0, n = m_episodes.count(); i < n; ++i) {
-        if (m_episodes[i]->seasonNumber() == season && m_episodes[i]->episodeNumber() == episode) {
-            return m_episodes[i];
-        }
+    const auto& index = episodeIndex();
+    const auto seasonEpisodes = index.constFind(season);
+    if (seasonEpisodes == index.constEnd()) {
+        return nullptr;
     }
-    return new TvShowEpisode(QStringList(), this);
+    return seasonEpisodes->byNumber.value(episode, nullptr);
 }
 
 QVector<SeasonNumber> TvShow::seasons(bool includeDummies) const
 {
+    const auto& index = episodeIndex();
     QVector<SeasonNumber> seasons;
-    for (TvShowEpisode* episode : m_episodes) {
-        if (episode->isDummy() && !includeDummies) {
+    for (const SeasonNumber& season : asConst(m_indexedSeasons)) {
+        if (season == SeasonNumber::NoSeason) {
             continue;
         }
-        if (!seasons.contains(episode->seasonNumber()) && episode->seasonNumber() != SeasonNumber::NoSeason) {
-            seasons.append(episode->seasonNumber());
+        const auto seasonEpisodes = index.constFind(season);
+        if (includeDummies || seasonEpisodes->dummyEpisodes < seasonEpisodes->episodes.size()) {
+            seasons.append(season);
         }
     }
     return seasons;
@@ -750,14 +754,7 @@ const QVector<TvShowEpisode*>& TvShow::episodes() const
 
 QVector<TvShowEpisode*> TvShow::episodes(SeasonNumber season) const
 {
-    QVector<TvShowEpisode*> episodes;
-    for (TvShowEpisode* episode : m_episodes) {
-        if (episode->seasonNumber() == season) {
-            episodes.push_back(episode);
-        }
-    }
-
-    return episodes;
+    return episodeIndex().value(season).episodes;
 }
 
 TvShowModelItem* TvShow::modelItem()
@@ -1407,19 +1404,14 @@ void TvShow::setRuntime(std::chrono::minutes runtime)
 
 bool TvShow::isDummySeason(SeasonNumber season) const
 {
-    for (TvShowEpisode* episode : m_episodes) {
-        if (episode->seasonNumber() == season && !episode->isDummy()) {
-            return false;
-        }
-    }
-    return true;
+    const auto& index = episodeIndex();
+    const auto seasonEpisodes = index.constFind(season);
+    return seasonEpisodes == index.constEnd() || seasonEpisodes->dummyEpisodes == seasonEpisodes->episodes.size();
 }
 
 bool TvShow::hasDummyEpisodes(SeasonNumber season) const
 {
-    return std::any_of(m_episodes.cbegin(), m_episodes.cend(), [season](const TvShowEpisode* const episode) {
-        return episode->seasonNumber() == season && episode->isDummy();
-    });
+    return episodeIndex().value(season).dummyEpisodes > 0;
 }
 
 bool TvShow::hasDummyEpisodes() const
@@ -1463,16 +1455,7 @@ void TvShow::fillMissingEpisodes()
             continue;
         }
 
-        bool found = false;
-        for (elch_ssize_t i = 0, n = m_episodes.count(); i < n; ++i) {
-            if (m_episodes[i]->seasonNumber() == episode->seasonNumber()
-                && m_episodes[i]->episodeNumber() == episode->episodeNumber()) {
-                found = true;
-                break;
-            }
-        }
-
-        if (found) {
+        if (this->episode(episode->seasonNumber(), episode->episodeNumber()) != nullptr) {
             episode->deleteLater();
             continue;
         }
@@ -1496,11 +1479,44 @@ void TvShow::clearMissingEpisodes()
 {
     const auto isDummyEpisode = [](TvShowEpisode* episode) { return episode->isDummy(); };
     m_episodes.erase(std::remove_if(m_episodes.begin(), m_episodes.end(), isDummyEpisode), m_episodes.end());
+    invalidateEpisodeIndex();
 
     Manager::instance()->tvShowModel()->updateShow(this);
     TvShowFilesWidget::instance().renewModel(true);
 }
 
+void TvShow::invalidateEpisodeIndex()
+{
+    m_episodeIndexValid = false;
+}
+
+const QHash<SeasonNumber, TvShow::SeasonEpisodes>& TvShow::episodeIndex() const
+{
+    if (m_episodeIndexValid) {
+        return m_episodeIndex;
+    }
+
+    m_episodeIndex.clear();
+    m_indexedSeasons.clear();
+    for (TvShowEpisode* episode : m_episodes) {
+        const SeasonNumber season = episode->seasonNumber();
+        auto seasonEpisodes = m_episodeIndex.find(season);
+        if (seasonEpisodes == m_episodeIndex.end()) {
+            seasonEpisodes = m_episodeIndex.insert(season, SeasonEpisodes{});
+            m_indexedSeasons.append(season);
+        }
+        seasonEpisodes->episodes.append(episode);
+        if (!seasonEpisodes->byNumber.contains(episode->episodeNumber())) {
+            seasonEpisodes->byNumber.insert(episode->episodeNumber(), episode);
+        }
+        if (episode->isDummy()) {
+            ++seasonEpisodes->dummyEpisodes;
+        }
+    }
+    m_episodeIndexValid = true;
+    return m_episodeIndex;
+}
+
 QDebug operator<<(QDebug dbg, const TvShow& show)
 {
     QDebugStateSaver saver(dbg);
@@ -95,7 +95,8 @@ public:
     const QMap<SeasonNumber, QVector<Poster>>& allSeasonBanners() const;
     const QMap<SeasonNumber, QVector<Poster>>& allSeasonThumbs() const;
 
-    TvShowEpisode* episode(SeasonNumber season, EpisodeNumber episode);
+    /// \brief Returns the episode with the given season and episode number or nullptr if there is none.
+    TvShowEpisode* episode(SeasonNumber season, EpisodeNumber episode) const;
     QVector<SeasonNumber> seasons(bool includeDummies = true) const;
     const QVector<TvShowEpisode*>& episodes() const;
     QVector<TvShowEpisode*> episodes(SeasonNumber season) const;
@@ -121,6 +122,9 @@ public:
     bool showMissingEpisodes() const;
     bool hideSpecialsInMissingEpisodes() const;
 
+    /// \brief Must be called if an episode's season or episode number or its dummy state changed.
+    void invalidateEpisodeIndex();
+
     void setTitle(const QString& title);
     void setOriginalTitle(const QString& title);
     void setShowTitle(const QString& title);
@@ -337,7 +341,26 @@ private:
     QMap<ImageType, bool> m_hasImageChanged;
     QMap<SeasonNumber, QMap<ImageType, bool>> m_hasSeasonImageChanged;
 
+    /// \brief Episodes of a single season; part of the episode index.
+    struct SeasonEpisodes
+    {
+        QVector<TvShowEpisode*> episodes;
+        /// \brief First episode for each episode number.
+        QHash<EpisodeNumber, TvShowEpisode*> byNumber;
+        int dummyEpisodes = 0;
+    };
+
+    /// \brief Index of m_episodes by season and episode number.
+    /// \details Rebuilt lazily after episodes were added, removed or renumbered so that
+    ///          lookups don't need to scan all episodes, which is slow for shows with
+    ///          thousands of episodes.
+    mutable QHash<SeasonNumber, SeasonEpisodes> m_episodeIndex;
+    /// \brief Seasons in the order of their first episode in m_episodes.
+    mutable QVector<SeasonNumber> m_indexedSeasons;
+    mutable bool m_episodeIndexValid = false;
+
     void clearSeasonImageType(ImageType imageType);
+    const QHash<SeasonNumber, SeasonEpisodes>& episodeIndex() const;
 };
 
 QDebug operator<<(QDebug dbg, const TvShow& show);
@@ -3,6 +3,7 @@
 #include "data/tv_show/TvShow.h"
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "media/StreamDetailsService.h"
 #include "media_center/MediaCenterInterface.h"
 #include "model/tv_show/EpisodeModelItem.h"
 #include "model/tv_show/TvShowUtils.h"
@@ -198,15 +199,28 @@ bool TvShowEpisode::loadData(MediaCenterInterface* mediaCenterInterface, bool re
     return infoLoaded;
 }
 
-bool TvShowEpisode::loadStreamDetailsFromFile()
+bool TvShowEpisode::loadStreamDetailsFromFile(bool forceReprobe)
 {
-    const bool success = m_streamDetails->loadStreamDetails();
+    const bool success = m_streamDetails->loadStreamDetails(forceReprobe);
     if (success) {
         setChanged(true);
     }
     return success;
 }
 
+void TvShowEpisode::loadStreamDetailsInBackground()
+{
+    mediaelch::StreamDetailsService::instance()->load(m_streamDetails->files(),
+        this,
+        [this](bool success, const StreamDetails::Details& details) {
+            m_streamDetails->setLoaded(true);
+            if (success) {
+                m_streamDetails->setDetails(details);
+            }
+            emit sigStreamDetailsLoaded(this, success);
+        });
+}
+
 /**
  * \brief Save data using a MediaCenterInterface
  * \param mediaCenterInterface MediaCenterInterface to use
@@ -665,6 +679,9 @@ void TvShowEpisode::setUserRating(double rating)
 void TvShowEpisode::setSeason(SeasonNumber season)
 {
     m_season = season;
+    if (m_show != nullptr) {
+        m_show->invalidateEpisodeIndex();
+    }
     setChanged(true);
 }
 
@@ -676,6 +693,9 @@ void TvShowEpisode::setSeason(SeasonNumber season)
 void TvShowEpisode::setEpisode(EpisodeNumber episode)
 {
     m_episode = episode;
+    if (m_show != nullptr) {
+        m_show->invalidateEpisodeIndex();
+    }
     setChanged(true);
 }
 
@@ -931,6 +951,9 @@ void TvShowEpisode::removeImage(ImageType type)
 void TvShowEpisode::setIsDummy(bool dummy)
 {
     m_isDummy = dummy;
+    if (m_show != nullptr) {
+        m_show->invalidateEpisodeIndex();
+    }
 }
 
 bool TvShowEpisode::isDummy() const
@@ -152,7 +152,10 @@ public:
         const QSet<EpisodeScraperInfo>& infosToLoad);
 
     /// \brief Tries to load streamdetails from the file
-    ELCH_NODISCARD bool loadStreamDetailsFromFile();
+    ELCH_NODISCARD bool loadStreamDetailsFromFile(bool forceReprobe = false);
+    /// \brief Loads streamdetails in a background thread.  Emits sigStreamDetailsLoaded() once done.
+    /// \details Unlike loadStreamDetailsFromFile(), the episode is not marked as changed.
+    void loadStreamDetailsInBackground();
 
     void clearImages();
     QSet<EpisodeScraperInfo> infosToLoad();
@@ -222,6 +225,7 @@ public:
 signals:
     void sigLoaded(TvShowEpisode*);
     void sigChanged(TvShowEpisode*);
+    void sigStreamDetailsLoaded(TvShowEpisode*, bool success);
 
 private:
     void initCounter();
@@ -16,12 +16,27 @@
 #include <QDir>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QSet>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlRecord>
 
 using namespace mediaelch;
 
+namespace mediaelch {
+
+bool operator==(const MovieDirectoryState& lhs, const MovieDirectoryState& rhs)
+{
+    return lhs.dir == rhs.dir && lhs.lastModified == rhs.lastModified && lhs.files == rhs.files;
+}
+
+bool operator!=(const MovieDirectoryState& lhs, const MovieDirectoryState& rhs)
+{
+    return !(lhs == rhs);
+}
+
+} // namespace mediaelch
+
 /// \brief This mutex is used for initializing new connections.
 static QMutex s_initializingDatabaseMutex;
 /// \brief Used for creating a new connection name.
@@ -53,6 +68,12 @@ Database::Database(QObject* parent) : QObject(parent)
 Database::~Database()
 {
     if (m_db != nullptr && m_db->isOpen()) {
+        {
+            // Let SQLite update its statistics for the query planner if required.
+            QSqlQuery query(*m_db);
+            query.prepare("PRAGMA optimize;");
+            query.exec();
+        }
         m_db->close();
     }
 }
@@ -122,6 +143,10 @@ void Database::clearAllMovies()
     query.exec();
     query.prepare("DELETE FROM sqlite_sequence WHERE name='movieSubtitles'");
     query.exec();
+    query.prepare("DELETE FROM movieDirectories");
+    query.exec();
+    query.prepare("DELETE FROM sqlite_sequence WHERE name='movieDirectories'");
+    query.exec();
 }
 
 void Database::clearMoviesInDirectory(DirectoryPath path)
@@ -136,67 +161,259 @@ void Database::clearMoviesInDirectory(DirectoryPath path)
     query.prepare("DELETE FROM movies WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+    query.prepare("DELETE FROM movieDirectories WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
 }
 
-void Database::addMovie(Movie* movie, DirectoryPath path)
+void Database::removeMovies(const QVector<DatabaseId>& ids)
 {
+    QSqlQuery queryFiles(db());
+    QSqlQuery querySubtitles(db());
+    QSqlQuery queryMovies(db());
+    queryFiles.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
+    querySubtitles.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
+    queryMovies.prepare("DELETE FROM movies WHERE idMovie=:idMovie");
+
+    for (const DatabaseId& id : ids) {
+        queryFiles.bindValue(":idMovie", id.toInt());
+        queryFiles.exec();
+        querySubtitles.bindValue(":idMovie", id.toInt());
+        querySubtitles.exec();
+        queryMovies.bindValue(":idMovie", id.toInt());
+        queryMovies.exec();
+    }
+}
+
+QHash<QString, MovieDirectoryState> Database::movieDirectoryStates(DirectoryPath path)
+{
+    QHash<QString, MovieDirectoryState> states;
     QSqlQuery query(db());
-    query.prepare("INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
-                  "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path) "
-                  "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
-                  ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path)");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent().toUtf8());
-    query.bindValue(
-        ":lastModified", movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
-    query.bindValue(":inSeparateFolder", (movie->inSeparateFolder() ? 1 : 0));
-    query.bindValue(":hasPoster", movie->hasImage(ImageType::MoviePoster) ? 1 : 0);
-    query.bindValue(":hasBackdrop", movie->hasImage(ImageType::MovieBackdrop) ? 1 : 0);
-    query.bindValue(":hasLogo", movie->hasImage(ImageType::MovieLogo) ? 1 : 0);
-    query.bindValue(":hasClearArt", movie->hasImage(ImageType::MovieClearArt) ? 1 : 0);
-    query.bindValue(":hasCdArt", movie->hasImage(ImageType::MovieCdArt) ? 1 : 0);
-    query.bindValue(":hasBanner", movie->hasImage(ImageType::MovieBanner) ? 1 : 0);
-    query.bindValue(":hasThumb", movie->hasImage(ImageType::MovieThumb) ? 1 : 0);
-    query.bindValue(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
-    query.bindValue(":discType", static_cast<int>(movie->discType()));
+    query.prepare("SELECT dir, lastModified, files FROM movieDirectories WHERE path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
-    int insertId = query.lastInsertId().toInt();
+    while (query.next()) {
+        MovieDirectoryState state;
+        state.dir = QString::fromUtf8(query.value(0).toByteArray());
+        state.lastModified = query.value(1).toLongLong();
+        // File names can't contain slashes, so it is safe to use it as a separator.
+        const QString files = QString::fromUtf8(query.value(2).toByteArray());
+        state.files = files.isEmpty() ? QStringList{} : files.split('/');
+        states.insert(state.dir, state);
+    }
+    return states;
+}
 
-    for (const mediaelch::FilePath& file : movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
+void Database::setMovieDirectoryStates(DirectoryPath path, const QVector<MovieDirectoryState>& states)
+{
+    QSqlQuery query(db());
+    query.prepare("DELETE FROM movieDirectories WHERE path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
+
+    query.prepare("INSERT INTO movieDirectories(dir, lastModified, files, path) "
+                  "VALUES(:dir, :lastModified, :files, :path)");
+    for (const MovieDirectoryState& state : states) {
+        query.bindValue(":dir", state.dir.toUtf8());
+        query.bindValue(":lastModified", state.lastModified);
+        query.bindValue(":files", state.files.join('/').toUtf8());
+        query.bindValue(":path", path.toString().toUtf8());
         query.exec();
     }
+}
+
+static const char* const s_insertMovieStatement =
+    "INSERT INTO movies(content, lastModified, inSeparateFolder, hasPoster, hasBackdrop, hasLogo, "
+    "hasClearArt, hasCdArt, hasBanner, hasThumb, hasExtraFanarts, discType, path, "
+    "title, originalTitle, sortTitle, released, playCount, lastPlayed, imdbId, tmdbId, "
+    "certification, director, setName, genres, tags, studios, countries, trailer) "
+    "VALUES(:content, :lastModified, :inSeparateFolder, :hasPoster, :hasBackdrop, :hasLogo, "
+    ":hasClearArt, :hasCdArt, :hasBanner, :hasThumb, :hasExtraFanarts, :discType, :path, "
+    ":title, :originalTitle, :sortTitle, :released, :playCount, :lastPlayed, :imdbId, :tmdbId, "
+    ":certification, :director, :setName, :genres, :tags, :studios, :countries, :trailer)";
+static const char* const s_updateMovieListDataStatement =
+    "UPDATE movies SET title=:title, originalTitle=:originalTitle, sortTitle=:sortTitle, released=:released, "
+    "playCount=:playCount, lastPlayed=:lastPlayed, imdbId=:imdbId, tmdbId=:tmdbId, certification=:certification, "
+    "director=:director, setName=:setName, genres=:genres, tags=:tags, studios=:studios, countries=:countries, "
+    "trailer=:trailer WHERE idMovie=:idMovie";
+static const char* const s_insertMovieFileStatement = "INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)";
+static const char* const s_insertMovieSubtitleStatement =
+    "INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, :language, :forced)";
+
+/// \brief Binds the data that is shown, sorted and filtered in the movie list.
+/// \details The title is NULL for movies without loaded infos, which are parsed again on the next load.
+static void bindMovieListData(QSqlQuery& query, const Movie* movie)
+{
+    const bool infoLoaded = movie->controller()->infoLoaded();
+    query.bindValue(":title", infoLoaded ? QVariant(movie->name()) : QVariant());
+    query.bindValue(":originalTitle", movie->originalName());
+    query.bindValue(":sortTitle", movie->sortTitle());
+    query.bindValue(":released", movie->released().toString(Qt::ISODate));
+    query.bindValue(":playCount", movie->playcount());
+    query.bindValue(":lastPlayed", movie->lastPlayed());
+    query.bindValue(":imdbId", movie->imdbId().toString());
+    query.bindValue(":tmdbId", movie->tmdbId().toString());
+    query.bindValue(":certification", movie->certification().toString());
+    query.bindValue(":director", movie->director());
+    query.bindValue(":setName", movie->set().name);
+    query.bindValue(":genres", movie->genres().join("%§%"));
+    query.bindValue(":tags", movie->tags().join("%§%"));
+    query.bindValue(":studios", movie->studios().join("%§%"));
+    query.bindValue(":countries", movie->countries().join("%§%"));
+    query.bindValue(":trailer", movie->trailer().toString());
+}
+
+/// \brief Sets the list data bound by bindMovieListData() if it was stored.
+static void loadMovieListData(const QSqlQuery& query, Movie* movie)
+{
+    const QSqlRecord record = query.record();
+    const QVariant title = query.value(record.indexOf("title"));
+    if (title.isNull()) {
+        return;
+    }
+    const auto splitList = [&](const char* column) {
+        const QString value = query.value(record.indexOf(column)).toString();
+        return value.isEmpty() ? QStringList() : value.split("%§%");
+    };
+
+    movie->setName(title.toString());
+    movie->setOriginalName(query.value(record.indexOf("originalTitle")).toString());
+    movie->setSortTitle(query.value(record.indexOf("sortTitle")).toString());
+    movie->setReleased(QDate::fromString(query.value(record.indexOf("released")).toString(), Qt::ISODate));
+    movie->setPlayCount(query.value(record.indexOf("playCount")).toInt());
+    movie->setLastPlayed(query.value(record.indexOf("lastPlayed")).toDateTime());
+    movie->setImdbId(ImdbId(query.value(record.indexOf("imdbId")).toString()));
+    movie->setTmdbId(TmdbId(query.value(record.indexOf("tmdbId")).toString()));
+    movie->setCertification(Certification(query.value(record.indexOf("certification")).toString()));
+    movie->setDirector(query.value(record.indexOf("director")).toString());
+    MovieSet set;
+    set.name = query.value(record.indexOf("setName")).toString();
+    movie->setSet(set);
+    for (const QString& genre : splitList("genres")) {
+        movie->addGenre(genre);
+    }
+    for (const QString& tag : splitList("tags")) {
+        movie->addTag(tag);
+    }
+    for (const QString& studio : splitList("studios")) {
+        movie->addStudio(studio);
+    }
+    for (const QString& country : splitList("countries")) {
+        movie->addCountry(country);
+    }
+    movie->setTrailer(QUrl(query.value(record.indexOf("trailer")).toString()));
+    movie->controller()->setListDataLoaded();
+}
+
+/// \brief Executes the prepared movie statements for the given movie and sets its database ID.
+/// \details The statements are only bound and executed, so that they can be reused for many movies.
+static void insertMovie(QSqlQuery& movieQuery,
+    QSqlQuery& fileQuery,
+    QSqlQuery& subtitleQuery,
+    Movie* movie,
+    const QByteArray& path)
+{
+    const QByteArray content = movie->compressedNfoContent();
+    movieQuery.bindValue(":content", content.isEmpty() ? QByteArray("") : content);
+    movieQuery.bindValue(
+        ":lastModified", movie->fileLastModified().isNull() ? QDateTime::currentDateTime() : movie->fileLastModified());
+    movieQuery.bindValue(":inSeparateFolder", (movie->inSeparateFolder() ? 1 : 0));
+    movieQuery.bindValue(":hasPoster", movie->hasImage(ImageType::MoviePoster) ? 1 : 0);
+    movieQuery.bindValue(":hasBackdrop", movie->hasImage(ImageType::MovieBackdrop) ? 1 : 0);
+    movieQuery.bindValue(":hasLogo", movie->hasImage(ImageType::MovieLogo) ? 1 : 0);
+    movieQuery.bindValue(":hasClearArt", movie->hasImage(ImageType::MovieClearArt) ? 1 : 0);
+    movieQuery.bindValue(":hasCdArt", movie->hasImage(ImageType::MovieCdArt) ? 1 : 0);
+    movieQuery.bindValue(":hasBanner", movie->hasImage(ImageType::MovieBanner) ? 1 : 0);
+    movieQuery.bindValue(":hasThumb", movie->hasImage(ImageType::MovieThumb) ? 1 : 0);
+    movieQuery.bindValue(":hasExtraFanarts", movie->images().hasExtraFanarts() ? 1 : 0);
+    movieQuery.bindValue(":discType", static_cast<int>(movie->discType()));
+    movieQuery.bindValue(":path", path);
+    bindMovieListData(movieQuery, movie);
+    movieQuery.exec();
+    const int insertId = movieQuery.lastInsertId().toInt();
+
+    for (const mediaelch::FilePath& file : movie->files()) {
+        fileQuery.bindValue(":idMovie", insertId);
+        fileQuery.bindValue(":file", file.toString().toUtf8());
+        fileQuery.exec();
+    }
 
     for (const Subtitle* subtitle : movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
-                      ":language, :forced)");
-        query.bindValue(":idMovie", insertId);
-        query.bindValue(":files", subtitle->files().join("%§%"));
-        query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
-        query.bindValue(":forced", subtitle->forced() ? 1 : 0);
-        query.exec();
+        subtitleQuery.bindValue(":idMovie", insertId);
+        subtitleQuery.bindValue(":files", subtitle->files().join("%§%"));
+        subtitleQuery.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
+        subtitleQuery.bindValue(":forced", subtitle->forced() ? 1 : 0);
+        subtitleQuery.exec();
     }
 
+    movie->setDatabaseId(insertId);
+}
+
+void Database::addMovie(Movie* movie, DirectoryPath path)
+{
+    QSqlQuery movieQuery(db());
+    QSqlQuery fileQuery(db());
+    QSqlQuery subtitleQuery(db());
+    movieQuery.prepare(s_insertMovieStatement);
+    fileQuery.prepare(s_insertMovieFileStatement);
+    subtitleQuery.prepare(s_insertMovieSubtitleStatement);
+
+    insertMovie(movieQuery, fileQuery, subtitleQuery, movie, path.toString().toUtf8());
     setLabel(movie->files(), movie->label());
+}
 
-    movie->setDatabaseId(insertId);
+void Database::addMovies(const QVector<Movie*>& movies, DirectoryPath path)
+{
+    if (movies.isEmpty()) {
+        return;
+    }
+
+    // Qt's SQLite driver emulates execBatch() by executing the statement row by row,
+    // so there is nothing to gain from it.  The expensive part is preparing the
+    // statements, which is done only once here.
+    QSqlQuery labelQuery(db());
+    QSqlQuery movieQuery(db());
+    QSqlQuery fileQuery(db());
+    QSqlQuery subtitleQuery(db());
+    labelQuery.prepare("SELECT color FROM labels WHERE fileName=:fileName");
+    movieQuery.prepare(s_insertMovieStatement);
+    fileQuery.prepare(s_insertMovieFileStatement);
+    subtitleQuery.prepare(s_insertMovieSubtitleStatement);
+
+    const QByteArray dirPath = path.toString().toUtf8();
+    for (Movie* movie : movies) {
+        ColorLabel label = ColorLabel::NoLabel;
+        if (!movie->files().isEmpty()) {
+            labelQuery.bindValue(":fileName", movie->files().first().toString().toUtf8());
+            if (labelQuery.exec() && labelQuery.next()) {
+                label = static_cast<ColorLabel>(labelQuery.value(0).toInt());
+            }
+            labelQuery.finish();
+        }
+        movie->setLabel(label);
+        insertMovie(movieQuery, fileQuery, subtitleQuery, movie, dirPath);
+    }
 }
 
 void Database::update(Movie* movie)
 {
     QSqlQuery query(db());
     query.prepare("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
-    query.bindValue(":content", movie->nfoContent().isEmpty() ? "" : movie->nfoContent());
+    const QByteArray content = movie->compressedNfoContent();
+    query.bindValue(":content", content.isEmpty() ? QByteArray("") : content);
+    query.bindValue(":idMovie", movie->databaseId().toInt());
+    query.exec();
+
+    query.prepare(s_updateMovieListDataStatement);
+    bindMovieListData(query, movie);
     query.bindValue(":idMovie", movie->databaseId().toInt());
     query.exec();
 
     query.prepare("DELETE FROM movieFiles WHERE idMovie=:idMovie");
     query.bindValue(":idMovie", movie->databaseId().toInt());
     query.exec();
+    query.prepare(s_insertMovieFileStatement);
     for (const mediaelch::FilePath& file : movie->files()) {
-        query.prepare("INSERT INTO movieFiles(idMovie, file) VALUES(:idMovie, :file)");
         query.bindValue(":idMovie", movie->databaseId().toInt());
         query.bindValue(":file", file.toString().toUtf8());
         query.exec();
@@ -205,9 +422,8 @@ void Database::update(Movie* movie)
     query.prepare("DELETE FROM movieSubtitles WHERE idMovie=:idMovie");
     query.bindValue(":idMovie", movie->databaseId().toInt());
     query.exec();
+    query.prepare(s_insertMovieSubtitleStatement);
     for (const Subtitle* subtitle : movie->subtitles()) {
-        query.prepare("INSERT INTO movieSubtitles(idMovie, files, language, forced) VALUES(:idMovie, :files, "
-                      ":language, :forced)");
         query.bindValue(":idMovie", movie->databaseId().toInt());
         query.bindValue(":files", subtitle->files().join("%§%"));
         query.bindValue(":language", subtitle->language().isEmpty() ? "" : subtitle->language());
@@ -216,13 +432,26 @@ void Database::update(Movie* movie)
     }
 }
 
+void Database::updateListData(const QVector<Movie*>& movies)
+{
+    QSqlQuery query(db());
+    query.prepare(s_updateMovieListDataStatement);
+    for (const Movie* movie : movies) {
+        bindMovieListData(query, movie);
+        query.bindValue(":idMovie", movie->databaseId().toInt());
+        query.exec();
+    }
+}
+
 QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* movieParent)
 {
     transaction();
     QSqlQuery query(db());
     query.prepare("SELECT M.idMovie, M.content, M.lastModified, M.inSeparateFolder, M.hasPoster, M.hasBackdrop, "
                   "M.hasLogo, M.hasClearArt, "
-                  "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, MF.file, L.color "
+                  "M.hasCdArt, M.hasBanner, M.hasThumb, M.hasExtraFanarts, M.discType, M.title, M.originalTitle, "
+                  "M.sortTitle, M.released, M.playCount, M.lastPlayed, M.imdbId, M.tmdbId, M.certification, "
+                  "M.director, M.setName, M.genres, M.tags, M.studios, M.countries, M.trailer, MF.file, L.color "
                   "FROM movies M "
                   "LEFT JOIN movieFiles MF ON MF.idMovie=M.idMovie "
                   "LEFT JOIN labels L ON MF.file=L.fileName "
@@ -248,7 +477,7 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* moviePa
             movie->setDatabaseId(query.value(query.record().indexOf("idMovie")).toInt());
             movie->setFileLastModified(query.value(query.record().indexOf("lastModified")).toDateTime());
             movie->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-            movie->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+            movie->setCompressedNfoContent(query.value(query.record().indexOf("content")).toByteArray());
             movie->images().setHasImage(
                 ImageType::MoviePoster, query.value(query.record().indexOf("hasPoster")).toInt() == 1);
             movie->images().setHasImage(
@@ -266,6 +495,7 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* moviePa
             movie->images().setHasExtraFanarts(query.value(query.record().indexOf("hasExtraFanarts")).toInt() == 1);
             movie->setDiscType(static_cast<DiscType>(query.value(query.record().indexOf("discType")).toInt()));
             movie->setLabel(label);
+            loadMovieListData(query, movie);
             movie->setChanged(false);
             movies.insert(query.value(query.record().indexOf("idMovie")).toInt(), movie);
         }
@@ -275,7 +505,11 @@ QVector<Movie*> Database::moviesInDirectory(DirectoryPath path, QObject* moviePa
         movie->setFiles(files);
     }
 
-    query.prepare("SELECT idMovie, files, language, forced FROM movieSubtitles");
+    query.prepare("SELECT S.idMovie, S.files, S.language, S.forced "
+                  "FROM movieSubtitles S "
+                  "INNER JOIN movies M ON M.idMovie=S.idMovie "
+                  "WHERE M.path=:path");
+    query.bindValue(":path", path.toString().toUtf8());
     query.exec();
     while (query.next()) {
         int movieId = query.value(query.record().indexOf("idMovie")).toInt();
@@ -361,26 +595,54 @@ void Database::update(Concert* concert)
 
 QVector<Concert*> Database::concertsInDirectory(DirectoryPath path)
 {
-    QVector<Concert*> concerts;
+    // Load concerts and their files in one query. Rows are ordered by concert
+    // so that all files of a concert are consecutive.
     QSqlQuery query(db());
-    QSqlQuery queryFiles(db());
-    query.prepare("SELECT idConcert, content, inSeparateFolder FROM concerts WHERE path=:path");
+    query.prepare("SELECT C.idConcert, C.content, C.inSeparateFolder, CF.file "
+                  "FROM concerts C "
+                  "LEFT JOIN concertFiles CF ON CF.idConcert=C.idConcert "
+                  "WHERE C.path=:path "
+                  "ORDER BY C.idConcert, CF.idFile");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
-    while (query.next()) {
-        QStringList files;
-        queryFiles.prepare("SELECT file FROM concertFiles WHERE idConcert=:idConcert");
-        queryFiles.bindValue(":idConcert", query.value(query.record().indexOf("idConcert")).toInt());
-        queryFiles.exec();
-        while (queryFiles.next()) {
-            files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
-        }
 
+    const QSqlRecord record = query.record();
+    const int idxId = record.indexOf("idConcert");
+    const int idxContent = record.indexOf("content");
+    const int idxInSeparateFolder = record.indexOf("inSeparateFolder");
+    const int idxFile = record.indexOf("file");
+
+    QVector<Concert*> concerts;
+    int currentId = -1;
+    QStringList files;
+    QByteArray content;
+    bool inSeparateFolder = false;
+
+    const auto createConcert = [&]() {
         auto* concert = new Concert(files, Manager::instance()->concertFileSearcher());
-        concert->setDatabaseId(query.value(query.record().indexOf("idConcert")).toInt());
-        concert->setInSeparateFolder(query.value(query.record().indexOf("inSeparateFolder")).toInt() == 1);
-        concert->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
+        concert->setDatabaseId(currentId);
+        concert->setInSeparateFolder(inSeparateFolder);
+        concert->setNfoContent(QString::fromUtf8(content));
         concerts.append(concert);
+    };
+
+    while (query.next()) {
+        const int id = query.value(idxId).toInt();
+        if (id != currentId) {
+            if (currentId != -1) {
+                createConcert();
+            }
+            currentId = id;
+            files.clear();
+            content = query.value(idxContent).toByteArray();
+            inSeparateFolder = query.value(idxInSeparateFolder).toInt() == 1;
+        }
+        if (!query.isNull(idxFile)) {
+            files << QString::fromUtf8(query.value(idxFile).toByteArray());
+        }
+    }
+    if (currentId != -1) {
+        createConcert();
     }
     return concerts;
 }
@@ -466,27 +728,56 @@ void Database::setHideSpecialsInMissingEpisodes(TvShow* show, bool hideSpecials)
     }
 }
 
-void Database::add(TvShowEpisode* episode, DirectoryPath path, mediaelch::DatabaseId idShow)
+static const char* const s_insertEpisodeStatement =
+    "INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
+    "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)";
+static const char* const s_insertEpisodeFileStatement =
+    "INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)";
+
+/// \brief Executes the prepared episode statements for the given episode and sets its database ID.
+static void insertEpisode(QSqlQuery& episodeQuery,
+    QSqlQuery& fileQuery,
+    TvShowEpisode* episode,
+    const QByteArray& path,
+    mediaelch::DatabaseId idShow)
 {
-    QSqlQuery query(db());
-    query.prepare("INSERT INTO episodes(content, idShow, path, seasonNumber, episodeNumber) "
-                  "VALUES(:content, :idShow, :path, :seasonNumber, :episodeNumber)");
-    query.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent().toUtf8());
-    query.bindValue(":idShow", idShow.toInt());
-    query.bindValue(":path", path.toString().toUtf8());
-    query.bindValue(":seasonNumber", episode->seasonNumber().toInt());
-    query.bindValue(":episodeNumber", episode->episodeNumber().toInt());
-    query.exec();
-    int insertId = query.lastInsertId().toInt();
+    episodeQuery.bindValue(":content", episode->nfoContent().isEmpty() ? "" : episode->nfoContent().toUtf8());
+    episodeQuery.bindValue(":idShow", idShow.toInt());
+    episodeQuery.bindValue(":path", path);
+    episodeQuery.bindValue(":seasonNumber", episode->seasonNumber().toInt());
+    episodeQuery.bindValue(":episodeNumber", episode->episodeNumber().toInt());
+    episodeQuery.exec();
+    const int insertId = episodeQuery.lastInsertId().toInt();
     for (const FilePath& file : episode->files()) {
-        query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
-        query.bindValue(":idEpisode", insertId);
-        query.bindValue(":file", file.toString().toUtf8());
-        query.exec();
+        fileQuery.bindValue(":idEpisode", insertId);
+        fileQuery.bindValue(":file", file.toString().toUtf8());
+        fileQuery.exec();
     }
     episode->setDatabaseId(insertId);
 }
 
+void Database::add(TvShowEpisode* episode, DirectoryPath path, mediaelch::DatabaseId idShow)
+{
+    addEpisodes({episode}, path, idShow);
+}
+
+void Database::addEpisodes(const QVector<TvShowEpisode*>& episodes, DirectoryPath path, mediaelch::DatabaseId idShow)
+{
+    if (episodes.isEmpty()) {
+        return;
+    }
+
+    QSqlQuery episodeQuery(db());
+    QSqlQuery fileQuery(db());
+    episodeQuery.prepare(s_insertEpisodeStatement);
+    fileQuery.prepare(s_insertEpisodeFileStatement);
+
+    const QByteArray dirPath = path.toString().toUtf8();
+    for (TvShowEpisode* episode : episodes) {
+        insertEpisode(episodeQuery, fileQuery, episode, dirPath, idShow);
+    }
+}
+
 void Database::update(TvShow* show)
 {
     QSqlQuery query(db());
@@ -519,8 +810,8 @@ void Database::update(TvShowEpisode* episode)
     query.bindValue(":idEpisode", episode->databaseId().toInt());
     query.exec();
 
+    query.prepare(s_insertEpisodeFileStatement);
     for (const FilePath& file : episode->files()) {
-        query.prepare("INSERT INTO episodeFiles(idEpisode, file) VALUES(:idEpisode, :file)");
         query.bindValue(":idEpisode", episode->databaseId().toInt());
         query.bindValue(":file", file.toString().toUtf8());
         query.exec();
@@ -544,28 +835,40 @@ int Database::showCount(DirectoryPath path)
 QVector<TvShow*> Database::showsInDirectory(DirectoryPath path)
 {
     QVector<TvShow*> shows;
+    QSet<int> showIds;
     QSqlQuery query(db());
-    query.prepare("SELECT idShow, dir, content, path FROM shows WHERE path=:path");
+    query.prepare("SELECT S.idShow, S.dir, S.content, S.path, "
+                  "SS.showMissingEpisodes, SS.hideSpecialsInMissingEpisodes "
+                  "FROM shows S "
+                  "LEFT JOIN showsSettings SS ON SS.dir=S.dir "
+                  "WHERE S.path=:path");
     query.bindValue(":path", path.toString().toUtf8());
     query.exec();
+
+    const QSqlRecord record = query.record();
+    const int idxId = record.indexOf("idShow");
+    const int idxDir = record.indexOf("dir");
+    const int idxContent = record.indexOf("content");
+    const int idxShowMissing = record.indexOf("showMissingEpisodes");
+    const int idxHideSpecials = record.indexOf("hideSpecialsInMissingEpisodes");
+
     while (query.next()) {
-        mediaelch::DirectoryPath dir(QString::fromUtf8(query.value(query.record().indexOf("dir")).toByteArray()));
-        auto* show = new TvShow(dir, Manager::instance()->tvShowFileSearcher());
-        show->setDatabaseId(query.value(query.record().indexOf("idShow")).toInt());
-        show->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-        shows.append(show);
-    }
+        const int id = query.value(idxId).toInt();
+        if (showIds.contains(id)) {
+            // There should only be one settings entry per show.  Just in case.
+            continue;
+        }
+        showIds.insert(id);
 
-    for (TvShow* show : shows) {
-        query.prepare("SELECT showMissingEpisodes, hideSpecialsInMissingEpisodes FROM showsSettings WHERE dir=:dir");
-        query.bindValue(":dir", show->dir().toString().toUtf8());
-        query.exec();
-        if (query.next()) {
-            show->setShowMissingEpisodes(
-                query.value(query.record().indexOf("showMissingEpisodes")).toInt() == 1, false);
-            show->setHideSpecialsInMissingEpisodes(
-                query.value(query.record().indexOf("hideSpecialsInMissingEpisodes")).toInt() == 1, false);
+        mediaelch::DirectoryPath dir(QString::fromUtf8(query.value(idxDir).toByteArray()));
+        auto* show = new TvShow(dir, Manager::instance()->tvShowFileSearcher());
+        show->setDatabaseId(id);
+        show->setNfoContent(QString::fromUtf8(query.value(idxContent).toByteArray()));
+        if (!query.isNull(idxShowMissing)) {
+            show->setShowMissingEpisodes(query.value(idxShowMissing).toInt() == 1, false);
+            show->setHideSpecialsInMissingEpisodes(query.value(idxHideSpecials).toInt() == 1, false);
         }
+        shows.append(show);
     }
 
     return shows;
@@ -573,27 +876,77 @@ QVector<TvShow*> Database::showsInDirectory(DirectoryPath path)
 
 QVector<TvShowEpisode*> Database::episodes(mediaelch::DatabaseId idShow)
 {
-    QVector<TvShowEpisode*> episodes;
     QSqlQuery query(db());
-    QSqlQuery queryFiles(db());
-    query.prepare("SELECT idEpisode, content, seasonNumber, episodeNumber FROM episodes WHERE idShow=:idShow");
+    query.prepare("SELECT E.idEpisode, E.idShow, E.content, E.seasonNumber, E.episodeNumber, EF.file "
+                  "FROM episodes E "
+                  "LEFT JOIN episodeFiles EF ON EF.idEpisode=E.idEpisode "
+                  "WHERE E.idShow=:idShow "
+                  "ORDER BY E.idEpisode, EF.idFile");
     query.bindValue(":idShow", idShow.toInt());
     query.exec();
-    while (query.next()) {
-        QStringList files;
-        queryFiles.prepare("SELECT file FROM episodeFiles WHERE idEpisode=:idEpisode");
-        queryFiles.bindValue(":idEpisode", query.value(query.record().indexOf("idEpisode")).toInt());
-        queryFiles.exec();
-        while (queryFiles.next()) {
-            files << QString::fromUtf8(queryFiles.value(queryFiles.record().indexOf("file")).toByteArray());
-        }
+    return episodesFromQuery(query).value(idShow.toInt());
+}
 
+QHash<int, QVector<TvShowEpisode*>> Database::episodesInDirectory(mediaelch::DirectoryPath path)
+{
+    QSqlQuery query(db());
+    query.prepare("SELECT E.idEpisode, E.idShow, E.content, E.seasonNumber, E.episodeNumber, EF.file "
+                  "FROM episodes E "
+                  "LEFT JOIN episodeFiles EF ON EF.idEpisode=E.idEpisode "
+                  "WHERE E.path=:path "
+                  "ORDER BY E.idEpisode, EF.idFile");
+    query.bindValue(":path", path.toString().toUtf8());
+    query.exec();
+    return episodesFromQuery(query);
+}
+
+QHash<int, QVector<TvShowEpisode*>> Database::episodesFromQuery(QSqlQuery& query)
+{
+    const QSqlRecord record = query.record();
+    const int idxId = record.indexOf("idEpisode");
+    const int idxShow = record.indexOf("idShow");
+    const int idxContent = record.indexOf("content");
+    const int idxSeason = record.indexOf("seasonNumber");
+    const int idxEpisode = record.indexOf("episodeNumber");
+    const int idxFile = record.indexOf("file");
+
+    QHash<int, QVector<TvShowEpisode*>> episodes;
+    int currentId = -1;
+    int currentShowId = -1;
+    QStringList files;
+    QByteArray content;
+    int seasonNumber = 0;
+    int episodeNumber = 0;
+
+    const auto createEpisode = [&]() {
         auto* episode = new TvShowEpisode(files);
-        episode->setSeason(SeasonNumber(query.value(query.record().indexOf("seasonNumber")).toInt()));
-        episode->setEpisode(EpisodeNumber(query.value(query.record().indexOf("episodeNumber")).toInt()));
-        episode->setDatabaseId(query.value(query.record().indexOf("idEpisode")).toInt());
-        episode->setNfoContent(QString::fromUtf8(query.value(query.record().indexOf("content")).toByteArray()));
-        episodes.append(episode);
+        episode->setSeason(SeasonNumber(seasonNumber));
+        episode->setEpisode(EpisodeNumber(episodeNumber));
+        episode->setDatabaseId(currentId);
+        episode->setNfoContent(QString::fromUtf8(content));
+        episodes[currentShowId].append(episode);
+    };
+
+    // Rows are ordered by episode, i.e. all files of an episode are consecutive.
+    while (query.next()) {
+        const int id = query.value(idxId).toInt();
+        if (id != currentId) {
+            if (currentId != -1) {
+                createEpisode();
+            }
+            currentId = id;
+            currentShowId = query.value(idxShow).toInt();
+            files.clear();
+            content = query.value(idxContent).toByteArray();
+            seasonNumber = query.value(idxSeason).toInt();
+            episodeNumber = query.value(idxEpisode).toInt();
+        }
+        if (!query.isNull(idxFile)) {
+            files << QString::fromUtf8(query.value(idxFile).toByteArray());
+        }
+    }
+    if (currentId != -1) {
+        createEpisode();
     }
     return episodes;
 }
@@ -832,6 +1185,33 @@ ColorLabel Database::getLabel(const mediaelch::FileList& fileNames)
     return ColorLabel::NoLabel;
 }
 
+QByteArray Database::cachedStreamDetails(const QString& files, qint64 size, qint64 lastModified)
+{
+    QSqlQuery query(db());
+    query.prepare("SELECT details FROM streamDetails WHERE files=:files AND size=:size AND lastModified=:lastModified");
+    query.bindValue(":files", files.toUtf8());
+    query.bindValue(":size", size);
+    query.bindValue(":lastModified", lastModified);
+    if (query.exec() && query.next()) {
+        return query.value(0).toByteArray();
+    }
+    return {};
+}
+
+void Database::setCachedStreamDetails(const QString& files, qint64 size, qint64 lastModified, const QByteArray& details)
+{
+    QSqlQuery query(db());
+    query.prepare("INSERT OR REPLACE INTO streamDetails(files, size, lastModified, details) "
+                  "VALUES(:files, :size, :lastModified, :details)");
+    query.bindValue(":files", files.toUtf8());
+    query.bindValue(":size", size);
+    query.bindValue(":lastModified", lastModified);
+    query.bindValue(":details", details);
+    if (!query.exec()) {
+        qCWarning(generic) << "[Database] Could not store stream details:" << query.lastError().text();
+    }
+}
+
 void Database::setupDatabase()
 {
     QSqlQuery query(*m_db);
@@ -1050,15 +1430,149 @@ void Database::setupDatabase()
         query.exec();
 
         myDbVersion = 17;
-        Q_UNUSED(myDbVersion);
         updateDbVersion(17);
     }
 
-    query.prepare("PRAGMA synchronous=0;");
+    if (myDbVersion < 18) {
+        query.prepare("DROP TABLE IF EXISTS movieDirectories;");
+        query.exec();
+
+        // Existing movies were not indexed, yet, and must be re-read on the next reload.
+        query.prepare(R"sql(CREATE TABLE IF NOT EXISTS movieDirectories (
+                      "idDirectory" integer NOT NULL PRIMARY KEY AUTOINCREMENT,
+                      "dir" text NOT NULL,
+                      "lastModified" integer NOT NULL,
+                      "files" text NOT NULL,
+                      "path" text NOT NULL);
+        )sql");
+        query.exec();
+        query.prepare("CREATE INDEX movie_directories_path_idx ON movieDirectories(path);");
+        query.exec();
+
+        myDbVersion = 18;
+        updateDbVersion(18);
+    }
+
+    if (myDbVersion < 19) {
+        // Nearly all queries filter by path, directory or parent ID.  Without
+        // these indices, each of them results in a full table scan.
+        // Note: "id_label_filename_idx" was previously created on a non-existent table.
+        const QStringList indices{
+            "CREATE INDEX IF NOT EXISTS movies_path_idx ON movies(path);",
+            "CREATE INDEX IF NOT EXISTS concerts_path_idx ON concerts(path);",
+            "CREATE INDEX IF NOT EXISTS shows_path_idx ON shows(path);",
+            "CREATE INDEX IF NOT EXISTS shows_dir_idx ON shows(dir);",
+            "CREATE INDEX IF NOT EXISTS shows_settings_dir_idx ON showsSettings(dir);",
+            "CREATE INDEX IF NOT EXISTS episodes_show_idx ON episodes(idShow);",
+            "CREATE INDEX IF NOT EXISTS episodes_path_idx ON episodes(path);",
+            "CREATE INDEX IF NOT EXISTS shows_episodes_show_idx ON showsEpisodes(idShow, updated);",
+            "CREATE INDEX IF NOT EXISTS shows_episodes_tmdbid_idx ON showsEpisodes(tmdbid);",
+            "CREATE INDEX IF NOT EXISTS id_label_filename_idx ON labels(fileName);",
+            "CREATE INDEX IF NOT EXISTS artists_path_idx ON artists(path);",
+            "CREATE INDEX IF NOT EXISTS albums_artist_idx ON albums(idArtist);",
+            "CREATE INDEX IF NOT EXISTS albums_path_idx ON albums(path);",
+        };
+        for (const QString& index : indices) {
+            query.prepare(index);
+            query.exec();
+        }
+
+        query.prepare("ANALYZE;");
+        query.exec();
+
+        myDbVersion = 19;
+        updateDbVersion(19);
+    }
+
+    if (myDbVersion < 20) {
+        // Movie NFO content is now stored zlib-compressed (see Movie::compressedNfoContent()).
+        // Compress the old plain text entries in place, so that movies don't have to be re-read from disk.
+        m_db->transaction();
+        QSqlQuery updateQuery(*m_db);
+        updateQuery.prepare("UPDATE movies SET content=:content WHERE idMovie=:idMovie");
+        query.prepare("SELECT idMovie, content FROM movies");
+        query.exec();
+        while (query.next()) {
+            const QByteArray content = query.value(1).toString().toUtf8();
+            updateQuery.bindValue(":content", content.isEmpty() ? QByteArray("") : qCompress(content));
+            updateQuery.bindValue(":idMovie", query.value(0).toInt());
+            updateQuery.exec();
+        }
+        m_db->commit();
+
+        query.prepare("VACUUM;");
+        query.exec();
+
+        myDbVersion = 20;
+        updateDbVersion(20);
+    }
+
+    if (myDbVersion < 21) {
+        // Stream details read by MediaInfo, so that files don't have to be probed again.
+        query.prepare("CREATE TABLE IF NOT EXISTS streamDetails ( "
+                      "\"files\" text NOT NULL PRIMARY KEY, "
+                      "\"size\" integer NOT NULL, "
+                      "\"lastModified\" integer NOT NULL, "
+                      "\"details\" blob NOT NULL "
+                      ");");
+        query.exec();
+
+        myDbVersion = 21;
+        updateDbVersion(21);
+    }
+
+    if (myDbVersion < 22) {
+        // Data shown in the movie list, so that NFO content is only parsed once a movie is opened.
+        // Existing movies have no list data (NULL title) and are parsed once on the next load.
+        const QStringList columns{
+            "title text",
+            "originalTitle text",
+            "sortTitle text",
+            "released text",
+            "playCount integer",
+            "lastPlayed text",
+            "imdbId text",
+            "tmdbId text",
+            "certification text",
+            "director text",
+            "setName text",
+            "genres text",
+            "tags text",
+            "studios text",
+            "countries text",
+            "trailer text",
+        };
+        for (const QString& column : columns) {
+            query.prepare(QStringLiteral("ALTER TABLE movies ADD COLUMN %1;").arg(column));
+            query.exec();
+        }
+
+        myDbVersion = 22;
+        Q_UNUSED(myDbVersion);
+        updateDbVersion(22);
+    }
+
+    // The database is only a cache that can be rebuilt from disk at any time.
+    // WAL allows readers in other threads while a loader writes and, together
+    // with synchronous=NORMAL, only syncs on checkpoints.
+    query.prepare("PRAGMA journal_mode=WAL;");
+    query.exec();
+
+    query.prepare("PRAGMA synchronous=NORMAL;");
+    query.exec();
+
+    // Multiple connections (one per loader thread) may write at the same time.
+    query.prepare("PRAGMA busy_timeout=5000;");
     query.exec();
 
     query.prepare("PRAGMA cache_size=20000;");
     query.exec();
+
+    query.prepare("PRAGMA temp_store=MEMORY;");
+    query.exec();
+
+    query.prepare("PRAGMA mmap_size=268435456;");
+    query.exec();
 }
 
 void Database::clearAllArtists()
@@ -6,12 +6,15 @@
 #include "media/Path.h"
 
 #include <QDateTime>
+#include <QHash>
 #include <QSqlDatabase>
 #include <QString>
 #include <QStringList>
 #include <QVector>
 #include <memory>
 
+class QSqlQuery;
+
 class Album;
 class Artist;
 class Concert;
@@ -19,6 +22,28 @@ class Movie;
 class TvShow;
 class TvShowEpisode;
 
+namespace mediaelch {
+
+/// \brief State of a directory containing movie files at the time it was scanned.
+/// \details Used by MovieDiskLoader to only re-read directories that changed since
+///          the last scan.  Two states are equal if the directory contains the same
+///          movie files and neither the directory nor any of its files (including
+///          NFO files, artwork and subtitles) was modified.
+struct MovieDirectoryState
+{
+    /// \brief Absolute path of the directory.
+    QString dir;
+    /// \brief Newest modification time (ms since epoch) of the directory and all of its files.
+    qint64 lastModified = 0;
+    /// \brief Sorted names of all movie files inside the directory.
+    QStringList files;
+};
+
+bool operator==(const MovieDirectoryState& lhs, const MovieDirectoryState& rhs);
+bool operator!=(const MovieDirectoryState& lhs, const MovieDirectoryState& rhs);
+
+} // namespace mediaelch
+
 class Database : public QObject
 {
     Q_OBJECT
@@ -35,8 +60,24 @@ public:
     void clearAllMovies();
     void clearMoviesInDirectory(mediaelch::DirectoryPath path);
     void addMovie(Movie* movie, mediaelch::DirectoryPath path);
+    /// \brief Adds all given movies to the database.  Statements are only prepared once.
+    /// \details Meant for loading movies from disk: Instead of storing the movies' labels,
+    ///          their stored labels are read and set on the movies.  Does not open a
+    ///          transaction; callers should wrap (many) calls in transaction() and commit().
+    void addMovies(const QVector<Movie*>& movies, mediaelch::DirectoryPath path);
     void update(Movie* movie);
+    /// \brief Only stores the list data of the given movies, i.e. no NFO content, files or subtitles.
+    /// \details Used for movies whose list data was not stored, yet.  Does not open a transaction.
+    void updateListData(const QVector<Movie*>& movies);
+    /// \brief Movies in the given directory.  Movies with stored list data are
+    ///        not parsed, yet; see MovieController::setListDataLoaded().
     QVector<Movie*> moviesInDirectory(mediaelch::DirectoryPath path, QObject* movieParent);
+    void removeMovies(const QVector<mediaelch::DatabaseId>& ids);
+
+    /// \brief Directory states of the last disk scan of the given movie directory, keyed by directory path.
+    QHash<QString, mediaelch::MovieDirectoryState> movieDirectoryStates(mediaelch::DirectoryPath path);
+    /// \brief Replaces all stored directory states of the given movie directory.
+    void setMovieDirectoryStates(mediaelch::DirectoryPath path, const QVector<mediaelch::MovieDirectoryState>& states);
 
     void clearAllConcerts();
     void clearConcertsInDirectory(mediaelch::DirectoryPath path);
@@ -46,6 +87,11 @@ public:
 
     void add(TvShow* show, mediaelch::DirectoryPath path);
     void add(TvShowEpisode* episode, mediaelch::DirectoryPath path, mediaelch::DatabaseId idShow);
+    /// \brief Adds all given episodes of a TV show to the database.  Statements are only prepared once.
+    /// \details Does not open a transaction; callers should wrap (many) calls in transaction() and commit().
+    void addEpisodes(const QVector<TvShowEpisode*>& episodes,
+        mediaelch::DirectoryPath path,
+        mediaelch::DatabaseId idShow);
     void update(TvShow* show);
     void update(TvShowEpisode* episode);
     void clearAllTvShows();
@@ -54,6 +100,8 @@ public:
     int showCount(mediaelch::DirectoryPath path);
     QVector<TvShow*> showsInDirectory(mediaelch::DirectoryPath path);
     QVector<TvShowEpisode*> episodes(mediaelch::DatabaseId idShow);
+    /// \brief Episodes of all TV shows in the given directory, keyed by their show's database ID.
+    QHash<int, QVector<TvShowEpisode*>> episodesInDirectory(mediaelch::DirectoryPath path);
     int episodeCount();
 
     void setShowMissingEpisodes(TvShow* show, bool showMissing);
@@ -82,8 +130,15 @@ public:
     void setLabel(const mediaelch::FileList& fileNames, ColorLabel color);
     ColorLabel getLabel(const mediaelch::FileList& fileNames);
 
+    /// \brief Serialized stream details of the given files, see mediaelch::StreamDetailsService.
+    /// \details Returns an empty array if there is no entry or if the files' size or
+    ///          modification time (ms since epoch) differ from the stored ones.
+    QByteArray cachedStreamDetails(const QString& files, qint64 size, qint64 lastModified);
+    void setCachedStreamDetails(const QString& files, qint64 size, qint64 lastModified, const QByteArray& details);
+
 private:
     void setupDatabase();
+    QHash<int, QVector<TvShowEpisode*>> episodesFromQuery(QSqlQuery& query);
 
 private:
     mediaelch::DirectoryPath m_dataLocation;
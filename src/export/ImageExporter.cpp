@@ -0,0 +1,128 @@
+#include "export/ImageExporter.h"
+
+#include "log/Log.h"
+#include "utils/Meta.h"
+
+#include <QDateTime>
+#include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QImage>
+#include <QThread>
+#include <QtConcurrent>
+
+namespace {
+
+/// \brief Modification time in seconds since epoch; not all file systems store milliseconds.
+qint64 lastModifiedSecs(const QFileInfo& fi)
+{
+    return fi.lastModified().toMSecsSinceEpoch() / 1000;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+ImageExporter::ImageExporter(QString directory, std::atomic_bool& cancelFlag, QObject* parent) :
+    QObject(parent), m_directory{std::move(directory)}, m_cancelFlag{cancelFlag}
+{
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+}
+
+ImageExporter::~ImageExporter()
+{
+    m_pool.waitForDone();
+}
+
+void ImageExporter::add(const QVector<ExportImage>& images)
+{
+    QHash<QString, Source> sources;
+    QVector<QString> order;
+    for (const ExportImage& image : images) {
+        if (m_destinations.contains(image.destination)) {
+            continue;
+        }
+        m_destinations.insert(image.destination);
+        auto source = sources.find(image.source);
+        if (source == sources.end()) {
+            order.push_back(image.source);
+            source = sources.insert(image.source, Source{image.source, {}});
+        }
+        source->images.push_back(image);
+    }
+
+    m_pending += qsizetype_to_int(order.size());
+    for (const QString& path : asConst(order)) {
+        const Source source = sources.value(path);
+        QtConcurrent::run(&m_pool, [this, source]() { exportSource(source); });
+    }
+}
+
+void ImageExporter::waitForDone()
+{
+    QEventLoop loop;
+    connect(this, &ImageExporter::finished, &loop, &QEventLoop::quit);
+    if (!isDone()) {
+        loop.exec();
+    }
+}
+
+void ImageExporter::exportSource(const Source& source)
+{
+    if (!m_cancelFlag.load()) {
+        const QFileInfo sourceInfo(source.path);
+        const qint64 sourceLastModified = lastModifiedSecs(sourceInfo);
+
+        QVector<ExportImage> outdated;
+        for (const ExportImage& image : source.images) {
+            if (!isUpToDate(m_directory + "/" + image.destination, sourceLastModified)) {
+                outdated.push_back(image);
+            }
+        }
+
+        // Decoding is the expensive part, so do it only once and only if necessary.
+        const QImage image = outdated.isEmpty() ? QImage{} : QImage(source.path);
+        if (!outdated.isEmpty() && image.isNull()) {
+            qCWarning(generic) << "[Export][ImageExporter] Cannot load image:" << source.path;
+        } else {
+            for (const ExportImage& exportImage : asConst(outdated)) {
+                const QString destination = m_directory + "/" + exportImage.destination;
+                if (saveImage(image, exportImage, destination)) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+                    QFile file(destination);
+                    if (file.open(QFile::Append)) {
+                        file.setFileTime(sourceInfo.lastModified(), QFileDevice::FileModificationTime);
+                    }
+#endif
+                }
+            }
+        }
+    }
+
+    if (--m_pending == 0) {
+        emit finished();
+    }
+}
+
+bool ImageExporter::saveImage(const QImage& image, const ExportImage& exportImage, const QString& destination)
+{
+    const QImage scaled = image.scaled(exportImage.size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    if (scaled.isNull()) {
+        qCWarning(generic) << "[Export][ImageExporter] Could not scale (result was empty):" << exportImage.source;
+        return false;
+    }
+    if (!scaled.save(destination)) {
+        qCWarning(generic) << "[Export][ImageExporter] Could not save image:" << destination;
+        return false;
+    }
+    return true;
+}
+
+bool ImageExporter::isUpToDate(const QString& destination, qint64 sourceLastModified)
+{
+    const QFileInfo fi(destination);
+    return fi.exists() && lastModifiedSecs(fi) == sourceLastModified;
+}
+
+} // namespace mediaelch
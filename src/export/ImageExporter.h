@@ -0,0 +1,66 @@
+#pragma once
+
+#include "export/SimpleTemplate.h"
+
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include <atomic>
+
+namespace mediaelch {
+
+/// \brief Scales and saves images of the HTML export in a thread pool.
+///
+/// Images are grouped by their source file, so that each source is only
+/// decoded once even if it is exported in multiple sizes.  An image is not
+/// exported again if its destination already exists and has the same
+/// modification time as its source.
+class ImageExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// \param directory Export directory that destinations are relative to.
+    /// \param cancelFlag Images that were not started, yet, are skipped once it is set.
+    ImageExporter(QString directory, std::atomic_bool& cancelFlag, QObject* parent = nullptr);
+    ~ImageExporter() override;
+
+    /// \brief Start exporting the given images.  Destinations that were already added are ignored.
+    void add(const QVector<ExportImage>& images);
+    /// \brief Whether all added images are exported.
+    bool isDone() const { return m_pending.load() == 0; }
+    /// \brief Block until all added images are exported, but keep processing events meanwhile.
+    void waitForDone();
+
+signals:
+    /// \brief All added images are exported.  May be emitted from a worker thread.
+    void finished();
+
+private:
+    struct Source
+    {
+        QString path;
+        QVector<ExportImage> images;
+    };
+
+    void exportSource(const Source& source);
+    /// \brief Scale the (already decoded) image and save it to the destination.
+    static bool saveImage(const QImage& image, const ExportImage& exportImage, const QString& destination);
+    /// \brief Whether the destination was exported from the source's current version.
+    static bool isUpToDate(const QString& destination, qint64 sourceLastModified);
+
+private:
+    const QString m_directory;
+    std::atomic_bool& m_cancelFlag;
+    QThreadPool m_pool;
+    /// \brief Destinations of all added images.  Only accessed by the GUI thread.
+    QSet<QString> m_destinations;
+    /// \brief Number of sources that are not exported, yet.
+    std::atomic_int m_pending{0};
+};
+
+} // namespace mediaelch
@@ -30,6 +30,7 @@ void MediaExport::doExport(ExportTemplate& exportTemplate,
         connect(&engine, &SimpleEngine::sigItemExported, this, [&]() { emit sigItemExported(); });
 
         if (!m_canceled && sections.contains(ExportTemplate::ExportSection::Movies)) {
+            Manager::instance()->movieModel()->loadMovieDetails();
             engine.exportMovies(Manager::instance()->movieModel()->movies());
         }
 
@@ -5,10 +5,17 @@
 #include "data/tv_show/TvShow.h"
 #include "data/tv_show/TvShowEpisode.h"
 #include "globals/Manager.h"
+#include "log/Log.h"
 #include "media/StreamDetails.h"
 
-#include <QApplication>
 #include <QEventLoop>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
 
 static QString colorLabelToString(ColorLabel label)
 {
@@ -25,13 +32,63 @@ static QString colorLabelToString(ColorLabel label)
     return "white";
 }
 
+namespace {
+
+/// \brief Image types of an item that can be used in templates, e.g. "poster".
+struct ImageTypeInfo
+{
+    const char* name;
+    ImageType type;
+    const char* extension;
+};
+
+template<class T>
+void addImages(mediaelch::TemplateData& data,
+    const T* item,
+    const QSet<QString>& usedTypes,
+    const QVector<ImageTypeInfo>& imageTypes,
+    const QString& destinationPrefix,
+    const QString& typeName)
+{
+    for (const ImageTypeInfo& info : imageTypes) {
+        const QString name = QString::fromLatin1(info.name);
+        // Only look for images that are used by the templates.
+        if (!usedTypes.contains(name)) {
+            continue;
+        }
+        mediaelch::TemplateImage image;
+        image.source = Manager::instance()->mediaCenterInterface()->imageFileName(item, info.type);
+        image.destinationPrefix = destinationPrefix;
+        image.extension = QString::fromLatin1(info.extension);
+        image.typeName = typeName;
+        data.images.insert(name, image);
+    }
+}
+
+QString dateTimeString(const QDateTime& dateTime)
+{
+    return dateTime.isValid() ? dateTime.toString("yyyy-MM-dd hh:mm") : "";
+}
+
+void writeFile(const QString& fileName, const QString& content)
+{
+    QFile file(fileName);
+    if (file.open(QFile::WriteOnly | QFile::Text)) {
+        file.write(content.toUtf8());
+        file.close();
+    }
+}
+
+} // namespace
+
 namespace mediaelch {
 
 SimpleEngine::SimpleEngine(ExportTemplate& exportTemplate,
     QDir directory,
     std::atomic_bool& cancelFlag,
     QObject* parent) :
-    QObject(parent), m_cancelFlag{cancelFlag}, m_template{&exportTemplate}, m_dir{directory}
+    QObject(parent), m_cancelFlag{cancelFlag}, m_template{&exportTemplate}, m_dir{directory},
+    m_images{directory.path(), cancelFlag}
 {
     // Create the base structure
     m_template->copyTo(mediaelch::DirectoryPath(m_dir));
@@ -40,445 +97,379 @@ SimpleEngine::SimpleEngine(ExportTemplate& exportTemplate,
 void SimpleEngine::exportMovies(QVector<Movie*> movies)
 {
     std::sort(movies.begin(), movies.end(), Movie::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Movies);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Movie);
-
-    QString listMovieItem;
-    QString listMovieBlock;
-    QStringList movieList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_MOVIE \}\}(.*)\{\{ END_BLOCK_MOVIE \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listMovieBlock = match.captured(0);
-        listMovieItem = match.captured(1).trimmed();
-    }
+    const SimpleTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Movies));
+    const SimpleTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Movie));
+    const SimpleTemplate listItemTemplate = listTemplate.block("MOVIE");
+    const QSet<QString> imageTypes = itemTemplate.imageTypes() + listItemTemplate.imageTypes();
 
     m_dir.mkdir("movies");
     m_dir.mkdir("movie_images");
 
-    for (Movie* movie : movies) {
+    m_listItems.clear();
+    QVector<RenderJob> jobs;
+    for (Movie* movie : asConst(movies)) {
         if (m_cancelFlag.load()) {
-            return;
+            break;
         }
-
+        RenderJob job;
+        job.page = itemTemplate.isEmpty() ? nullptr : &itemTemplate;
+        job.pageFile = QStringLiteral("movies/%1.html").arg(movie->movieId());
         // We can't replace an empty block...
-        if (!listMovieItem.isEmpty()) {
-            QString m = listMovieItem;
-            replaceVars(m, movie);
-            movieList << m;
-        }
-
-        if (!itemContent.isEmpty()) {
-            QString movieTemplate = itemContent;
-            replaceVars(movieTemplate, movie, true);
-            QFile file(m_dir.path() + QStringLiteral("/movies/%1.html").arg(movie->movieId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(movieTemplate.toUtf8());
-                file.close();
-            }
+        job.listItem = listItemTemplate.isEmpty() ? nullptr : &listItemTemplate;
+        job.data = movieData(movie, imageTypes);
+        jobs.push_back(std::move(job));
+        if (jobs.size() >= batchSize()) {
+            startBatch(std::move(jobs));
+            jobs.clear();
         }
-
-        emit sigItemExported();
-        QApplication::processEvents();
-    }
-
-    // If the movie block is empty, replacing it would result in add a line break after each character
-    if (!listMovieBlock.isEmpty()) {
-        listContent.replace(listMovieBlock, movieList.join("\n"));
     }
+    startBatch(std::move(jobs));
+    finishBatch();
+    m_images.waitForDone();
 
-    QFile file(m_dir.path() + "/movies.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    if (!m_cancelFlag.load()) {
+        writeListPage("movies.html", listTemplate, "MOVIE");
     }
 }
 
-void SimpleEngine::replaceVars(QString& m, Movie* movie, bool subDir)
+TemplateData SimpleEngine::movieData(Movie* movie, const QSet<QString>& imageTypes) const
 {
-    m.replace("{{ MOVIE.ID }}", QString::number(movie->movieId(), 'f', 0));
-    m.replace("{{ MOVIE.LINK }}", QString("movies/%1.html").arg(movie->movieId()));
-    m.replace("{{ MOVIE.IMDB_ID }}", movie->imdbId().toString());
-    m.replace("{{ MOVIE.TMDB_ID }}", movie->tmdbId().toString());
-    m.replace("{{ MOVIE.TITLE }}", movie->name().toHtmlEscaped());
-    m.replace("{{ MOVIE.YEAR }}", movie->released().isValid() ? movie->released().toString("yyyy") : "");
-    m.replace("{{ MOVIE.ORIGINAL_TITLE }}", movie->originalName().toHtmlEscaped());
-    m.replace("{{ MOVIE.PLOT }}", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.PLOT_SIMPLE }}", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ MOVIE.SET }}", movie->set().name.toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGLINE }}", movie->tagline().toHtmlEscaped());
-    m.replace("{{ MOVIE.GENRES }}", movie->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.COUNTRIES }}", movie->countries().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.STUDIOS }}", movie->studios().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.TAGS }}", movie->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ MOVIE.WRITER }}", movie->writer().toHtmlEscaped());
-    m.replace("{{ MOVIE.DIRECTOR }}", movie->director().toHtmlEscaped());
-    m.replace("{{ MOVIE.CERTIFICATION }}", movie->certification().toString().toHtmlEscaped());
-    m.replace("{{ MOVIE.TRAILER }}", movie->trailer().toString());
-    m.replace("{{ MOVIE.LABEL }}", colorLabelToString(movie->label()));
+    TemplateData data;
+    auto& m = data.variables;
+    m.insert("MOVIE.ID", QString::number(movie->movieId(), 'f', 0));
+    m.insert("MOVIE.LINK", QString("movies/%1.html").arg(movie->movieId()));
+    m.insert("MOVIE.IMDB_ID", movie->imdbId().toString());
+    m.insert("MOVIE.TMDB_ID", movie->tmdbId().toString());
+    m.insert("MOVIE.TITLE", movie->name().toHtmlEscaped());
+    m.insert("MOVIE.YEAR", movie->released().isValid() ? movie->released().toString("yyyy") : "");
+    m.insert("MOVIE.ORIGINAL_TITLE", movie->originalName().toHtmlEscaped());
+    m.insert("MOVIE.PLOT", movie->overview().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("MOVIE.PLOT_SIMPLE", movie->outline().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("MOVIE.SET", movie->set().name.toHtmlEscaped());
+    m.insert("MOVIE.TAGLINE", movie->tagline().toHtmlEscaped());
+    m.insert("MOVIE.GENRES", movie->genres().join(", ").toHtmlEscaped());
+    m.insert("MOVIE.COUNTRIES", movie->countries().join(", ").toHtmlEscaped());
+    m.insert("MOVIE.STUDIOS", movie->studios().join(", ").toHtmlEscaped());
+    m.insert("MOVIE.TAGS", movie->tags().join(", ").toHtmlEscaped());
+    m.insert("MOVIE.WRITER", movie->writer().toHtmlEscaped());
+    m.insert("MOVIE.DIRECTOR", movie->director().toHtmlEscaped());
+    m.insert("MOVIE.CERTIFICATION", movie->certification().toString().toHtmlEscaped());
+    m.insert("MOVIE.TRAILER", movie->trailer().toString());
+    m.insert("MOVIE.LABEL", colorLabelToString(movie->label()));
 
     // \todo multiple ratings
     if (!movie->ratings().isEmpty()) {
         double rating = movie->ratings().first().rating;
         int voteCount = movie->ratings().first().voteCount;
-        m.replace("{{ MOVIE.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ MOVIE.VOTES }}", QString::number(voteCount, 'f', 0));
+        m.insert("MOVIE.RATING", QString::number(rating, 'f', 1));
+        m.insert("MOVIE.VOTES", QString::number(voteCount, 'f', 0));
     } else {
-        m.replace("{{ MOVIE.RATING }}", "n/a");
-        m.replace("{{ MOVIE.VOTES }}", "n/a");
+        m.insert("MOVIE.RATING", "n/a");
+        m.insert("MOVIE.VOTES", "n/a");
     }
 
-    m.replace("{{ MOVIE.RUNTIME }}", QString::number(static_cast<double>(movie->runtime().count()), 'f', 0));
-    m.replace("{{ MOVIE.PLAY_COUNT }}", QString::number(movie->playcount(), 'f', 0));
-    m.replace("{{ MOVIE.LAST_PLAYED }}",
-        movie->lastPlayed().isValid() ? movie->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace(
-        "{{ MOVIE.DATE_ADDED }}", movie->dateAdded().isValid() ? movie->dateAdded().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILE_LAST_MODIFIED }}",
-        movie->fileLastModified().isValid() ? movie->fileLastModified().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ MOVIE.FILENAME }}", (!movie->files().isEmpty()) ? movie->files().first().toString() : "");
+    m.insert("MOVIE.RUNTIME", QString::number(static_cast<double>(movie->runtime().count()), 'f', 0));
+    m.insert("MOVIE.PLAY_COUNT", QString::number(movie->playcount(), 'f', 0));
+    m.insert("MOVIE.LAST_PLAYED", dateTimeString(movie->lastPlayed()));
+    m.insert("MOVIE.DATE_ADDED", dateTimeString(movie->dateAdded()));
+    m.insert("MOVIE.FILE_LAST_MODIFIED", dateTimeString(movie->fileLastModified()));
+    m.insert("MOVIE.FILENAME", (!movie->files().isEmpty()) ? movie->files().first().toString() : "");
     if (!movie->files().isEmpty()) {
         QFileInfo fi(movie->files().first().toString());
-        m.replace("{{ MOVIE.DIR }}", fi.absolutePath());
+        m.insert("MOVIE.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ MOVIE.DIR }}", "");
-    }
-
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", movie->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", movie->genres());
-    replaceSingleBlock(m, "COUNTRIES", "COUNTRY.NAME", movie->countries());
-    replaceSingleBlock(m, "STUDIOS", "STUDIO.NAME", movie->studios());
-
-    QStringList actorNames;
-    QStringList actorRoles;
-    for (const Actor* actor : movie->actors()) {
-        actorNames << actor->name;
-        actorRoles << actor->role;
-    }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, QVector<QStringList>() << actorNames << actorRoles);
-
-    replaceStreamDetailsVars(m, movie->streamDetails());
-    replaceImages(m, subDir, movie);
+        m.insert("MOVIE.DIR", "");
+    }
+
+    data.addList("TAGS", "TAG.NAME", movie->tags());
+    data.addList("GENRES", "GENRE.NAME", movie->genres());
+    data.addList("COUNTRIES", "COUNTRY.NAME", movie->countries());
+    data.addList("STUDIOS", "STUDIO.NAME", movie->studios());
+    addActors(data, movie->actors());
+    addStreamDetails(data, movie->streamDetails());
+
+    static const QVector<ImageTypeInfo> movieImages{{"poster", ImageType::MoviePoster, "jpg"},
+        {"fanart", ImageType::MovieBackdrop, "jpg"},
+        {"logo", ImageType::MovieLogo, "png"},
+        {"clearart", ImageType::MovieClearArt, "png"},
+        {"disc", ImageType::MovieCdArt, "png"}};
+    addImages(data, movie, imageTypes, movieImages, QStringLiteral("movie_images/%1-").arg(movie->movieId()), "movie");
+    return data;
 }
 
 void SimpleEngine::exportConcerts(QVector<Concert*> concerts)
 {
     std::sort(concerts.begin(), concerts.end(), Concert::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::Concerts);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::Concert);
-
-    QString listConcertItem;
-    QString listConcertBlock;
-    QStringList concertList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_CONCERT \}\}(.*)\{\{ END_BLOCK_CONCERT \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listConcertBlock = match.captured(0);
-        listConcertItem = match.captured(1).trimmed();
-    }
+    const SimpleTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Concerts));
+    const SimpleTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Concert));
+    const SimpleTemplate listItemTemplate = listTemplate.block("CONCERT");
+    const QSet<QString> imageTypes = itemTemplate.imageTypes() + listItemTemplate.imageTypes();
 
     m_dir.mkdir("concerts");
     m_dir.mkdir("concert_images");
 
+    m_listItems.clear();
+    QVector<RenderJob> jobs;
     int counter = 0;
-
-    for (const Concert* concert : concerts) {
+    for (const Concert* concert : asConst(concerts)) {
         if (m_cancelFlag.load()) {
-            return;
+            break;
         }
-
-        QString concertTemplate = itemContent;
-        replaceVars(concertTemplate, concert, QString::number(counter), true);
-        QFile file(m_dir.path() + QString("/concerts/%1.html").arg(counter));
-        if (file.open(QFile::WriteOnly | QFile::Text)) {
-            file.write(concertTemplate.toUtf8());
-            file.close();
+        const QString id = QString::number(counter++);
+        RenderJob job;
+        job.page = &itemTemplate;
+        job.pageFile = QStringLiteral("concerts/%1.html").arg(id);
+        job.listItem = &listItemTemplate;
+        job.data = concertData(concert, id, imageTypes);
+        jobs.push_back(std::move(job));
+        if (jobs.size() >= batchSize()) {
+            startBatch(std::move(jobs));
+            jobs.clear();
         }
-
-        QString c = listConcertItem;
-        replaceVars(c, concert, QString::number(counter));
-        concertList << c;
-        emit sigItemExported();
-        QApplication::processEvents();
     }
+    startBatch(std::move(jobs));
+    finishBatch();
+    m_images.waitForDone();
 
-    listContent.replace(listConcertBlock, concertList.join("\n"));
-
-    QFile file(m_dir.path() + "/concerts.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    if (!m_cancelFlag.load()) {
+        writeListPage("concerts.html", listTemplate, "CONCERT");
     }
 }
 
-void SimpleEngine::replaceVars(QString& m, const Concert* concert, const QString& id, bool subDir)
+TemplateData SimpleEngine::concertData(const Concert* concert, const QString& id, const QSet<QString>& imageTypes) const
 {
-    m.replace("{{ CONCERT.ID }}", id);
-    m.replace("{{ CONCERT.LINK }}", QString("concerts/%1.html").arg(id));
-    m.replace("{{ CONCERT.TITLE }}", concert->title().toHtmlEscaped());
-    m.replace("{{ CONCERT.ARTIST }}", concert->artist().toHtmlEscaped());
-    m.replace("{{ CONCERT.ALBUM }}", concert->album().toHtmlEscaped());
-    m.replace("{{ CONCERT.TAGLINE }}", concert->tagline().toHtmlEscaped());
+    TemplateData data;
+    auto& m = data.variables;
+    m.insert("CONCERT.ID", id);
+    m.insert("CONCERT.LINK", QString("concerts/%1.html").arg(id));
+    m.insert("CONCERT.TITLE", concert->title().toHtmlEscaped());
+    m.insert("CONCERT.ARTIST", concert->artist().toHtmlEscaped());
+    m.insert("CONCERT.ALBUM", concert->album().toHtmlEscaped());
+    m.insert("CONCERT.TAGLINE", concert->tagline().toHtmlEscaped());
 
     if (concert->ratings().isEmpty()) {
-        m.replace("{{ CONCERT.RATING }}", "n/a");
+        m.insert("CONCERT.RATING", "n/a");
     } else {
-        m.replace("{{ CONCERT.RATING }}", QString::number(concert->ratings().first().rating, 'f', 1));
+        m.insert("CONCERT.RATING", QString::number(concert->ratings().first().rating, 'f', 1));
     }
 
-    m.replace("{{ CONCERT.YEAR }}", concert->released().isValid() ? concert->released().toString("yyyy") : "");
-    m.replace("{{ CONCERT.RUNTIME }}", QString::number(static_cast<double>(concert->runtime().count()), 'f', 0));
-    m.replace("{{ CONCERT.CERTIFICATION }}", concert->certification().toString().toHtmlEscaped());
-    m.replace("{{ CONCERT.TRAILER }}", concert->trailer().toString());
-    m.replace("{{ CONCERT.PLAY_COUNT }}", QString::number(concert->playcount(), 'f', 0));
-    m.replace("{{ CONCERT.LAST_PLAYED }}",
-        concert->lastPlayed().isValid() ? concert->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ CONCERT.FILE_LAST_MODIFIED }}",
-        concert->lastModified().isValid() ? concert->lastModified().toString("yyyy-MM-dd hh:mm") : "");
-
-    m.replace("{{ CONCERT.FILENAME }}", (!concert->files().isEmpty()) ? concert->files().first().toString() : "");
+    m.insert("CONCERT.YEAR", concert->released().isValid() ? concert->released().toString("yyyy") : "");
+    m.insert("CONCERT.RUNTIME", QString::number(static_cast<double>(concert->runtime().count()), 'f', 0));
+    m.insert("CONCERT.CERTIFICATION", concert->certification().toString().toHtmlEscaped());
+    m.insert("CONCERT.TRAILER", concert->trailer().toString());
+    m.insert("CONCERT.PLAY_COUNT", QString::number(concert->playcount(), 'f', 0));
+    m.insert("CONCERT.LAST_PLAYED", dateTimeString(concert->lastPlayed()));
+    m.insert("CONCERT.FILE_LAST_MODIFIED", dateTimeString(concert->lastModified()));
+
+    m.insert("CONCERT.FILENAME", (!concert->files().isEmpty()) ? concert->files().first().toString() : "");
     if (!concert->files().isEmpty()) {
         QFileInfo fi(concert->files().first().toString());
-        m.replace("{{ CONCERT.DIR }}", fi.absolutePath());
+        m.insert("CONCERT.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ CONCERT.DIR }}", "");
+        m.insert("CONCERT.DIR", "");
     }
 
-    m.replace("{{ CONCERT.PLOT }}", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ CONCERT.TAGS }}", concert->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ CONCERT.GENRES }}", concert->genres().join(", ").toHtmlEscaped());
+    m.insert("CONCERT.PLOT", concert->overview().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("CONCERT.TAGS", concert->tags().join(", ").toHtmlEscaped());
+    m.insert("CONCERT.GENRES", concert->genres().join(", ").toHtmlEscaped());
 
-    replaceStreamDetailsVars(m, concert->streamDetails());
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", concert->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", concert->genres());
-    replaceImages(m, subDir, concert, id);
+    addStreamDetails(data, concert->streamDetails());
+    data.addList("TAGS", "TAG.NAME", concert->tags());
+    data.addList("GENRES", "GENRE.NAME", concert->genres());
+
+    static const QVector<ImageTypeInfo> concertImages{{"poster", ImageType::ConcertPoster, "jpg"},
+        {"fanart", ImageType::ConcertBackdrop, "jpg"},
+        {"logo", ImageType::ConcertLogo, "png"},
+        {"clearart", ImageType::ConcertClearArt, "png"},
+        {"disc", ImageType::ConcertCdArt, "png"}};
+    addImages(data, concert, imageTypes, concertImages, QStringLiteral("concert_images/%1-").arg(id), "concert");
+    return data;
 }
 
 void SimpleEngine::exportTvShows(QVector<TvShow*> shows)
 {
     std::sort(shows.begin(), shows.end(), TvShow::lessThan);
-    QString listContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShows);
-    QString itemContent = m_template->getTemplate(ExportTemplate::ExportSection::TvShow);
-    QString episodeContent = m_template->getTemplate(ExportTemplate::ExportSection::Episode);
-
-    QString listTvShowItem;
-    QString listTvShowBlock;
-    QStringList tvShowList;
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_TVSHOW \}\}(.*)\{\{ END_BLOCK_TVSHOW \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    QRegularExpressionMatchIterator matches = rx.globalMatch(listContent);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        listTvShowBlock = match.captured(0);
-        listTvShowItem = match.captured(1).trimmed();
-    }
+    const SimpleTemplate listTemplate(m_template->getTemplate(ExportTemplate::ExportSection::TvShows));
+    const SimpleTemplate itemTemplate(m_template->getTemplate(ExportTemplate::ExportSection::TvShow));
+    const SimpleTemplate episodeTemplate(m_template->getTemplate(ExportTemplate::ExportSection::Episode));
+    const SimpleTemplate listItemTemplate = listTemplate.block("TVSHOW");
+    const QSet<QString> imageTypes = itemTemplate.imageTypes() + listItemTemplate.imageTypes();
+    const QSet<QString> episodeImageTypes = episodeTemplate.imageTypes();
+    // Collecting all episodes of all seasons is only worth it if they are shown.
+    const bool withSeasons = itemTemplate.hasBlock("SEASON") || listItemTemplate.hasBlock("SEASON");
 
     m_dir.mkdir("tvshows");
     m_dir.mkdir("tvshow_images");
     m_dir.mkdir("episodes");
     m_dir.mkdir("episode_images");
 
-    for (TvShow* show : shows) {
+    m_listItems.clear();
+    QVector<RenderJob> jobs;
+    for (const TvShow* show : asConst(shows)) {
         if (m_cancelFlag.load()) {
-            return;
+            break;
         }
 
         // tvshow.html - Single TV show
-        {
-            QString showTemplate = itemContent;
-            replaceVars(showTemplate, show, true);
-            QFile file(m_dir.path() + QString("/tvshows/%1.html").arg(show->showId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(showTemplate.toUtf8());
-                file.close();
-            }
-            QApplication::processEvents();
-        }
-
         // tvshows.html - All TV shows listed
-        {
-            QString showBlock = listTvShowItem;
-            replaceVars(showBlock, show, false);
-            tvShowList << showBlock;
-            emit sigItemExported();
-            QApplication::processEvents();
-        }
+        RenderJob showJob;
+        showJob.page = &itemTemplate;
+        showJob.pageFile = QStringLiteral("tvshows/%1.html").arg(show->showId());
+        showJob.listItem = &listItemTemplate;
+        showJob.data = tvShowData(show, imageTypes, withSeasons);
+        jobs.push_back(std::move(showJob));
 
         // episode.html - Single episode
-        for (TvShowEpisode* episode : show->episodes()) {
+        for (const TvShowEpisode* episode : show->episodes()) {
             if (episode->isDummy()) {
                 continue;
             }
-            QString episodeTemplate = episodeContent;
-            replaceVars(episodeTemplate, episode, true);
-            QFile file(m_dir.path() + QString("/episodes/%1.html").arg(episode->episodeId()));
-            if (file.open(QFile::WriteOnly | QFile::Text)) {
-                file.write(episodeTemplate.toUtf8());
-                file.close();
-            }
-            emit sigItemExported();
-            QApplication::processEvents();
+            RenderJob episodeJob;
+            episodeJob.page = &episodeTemplate;
+            episodeJob.pageFile = QStringLiteral("episodes/%1.html").arg(episode->episodeId());
+            episodeJob.data = episodeData(episode, episodeImageTypes);
+            jobs.push_back(std::move(episodeJob));
         }
-    }
 
-    listContent.replace(listTvShowBlock, tvShowList.join("\n"));
+        if (jobs.size() >= batchSize()) {
+            startBatch(std::move(jobs));
+            jobs.clear();
+        }
+    }
+    startBatch(std::move(jobs));
+    finishBatch();
+    m_images.waitForDone();
 
-    QFile file(m_dir.path() + "/tvshows.html");
-    if (file.open(QFile::WriteOnly | QFile::Text)) {
-        file.write(listContent.toUtf8());
-        file.close();
+    if (!m_cancelFlag.load()) {
+        writeListPage("tvshows.html", listTemplate, "TVSHOW");
     }
 }
 
-void SimpleEngine::replaceVars(QString& m, const TvShow* show, bool subDir)
+TemplateData SimpleEngine::tvShowData(const TvShow* show, const QSet<QString>& imageTypes, bool withSeasons) const
 {
-    m.replace("{{ TVSHOW.ID }}", QString::number(show->showId(), 'f', 0));
-    m.replace("{{ TVSHOW.LINK }}", QString("tvshows/%1.html").arg(show->showId()));
-    m.replace("{{ TVSHOW.IMDB_ID }}", show->imdbId().toString());
-    m.replace("{{ TVSHOW.TITLE }}", show->title().toHtmlEscaped());
-    m.replace("{{ TVSHOW.SORTTITLE }}", show->sortTitle().toHtmlEscaped());
-    m.replace("{{ TVSHOW.ORIGINALTITLE }}", show->originalTitle().toHtmlEscaped());
+    TemplateData data;
+    auto& m = data.variables;
+    m.insert("TVSHOW.ID", QString::number(show->showId(), 'f', 0));
+    m.insert("TVSHOW.LINK", QString("tvshows/%1.html").arg(show->showId()));
+    m.insert("TVSHOW.IMDB_ID", show->imdbId().toString());
+    m.insert("TVSHOW.TITLE", show->title().toHtmlEscaped());
+    m.insert("TVSHOW.SORTTITLE", show->sortTitle().toHtmlEscaped());
+    m.insert("TVSHOW.ORIGINALTITLE", show->originalTitle().toHtmlEscaped());
 
     // \todo multiple ratings
     if (!show->ratings().isEmpty()) {
         double rating = show->ratings().first().rating;
         int voteCount = show->ratings().first().voteCount;
-        m.replace("{{ TVSHOW.RATING }}", QString::number(rating, 'f', 1));
-        m.replace("{{ TVSHOW.VOTES }}", QString::number(voteCount, 'f', 0));
+        m.insert("TVSHOW.RATING", QString::number(rating, 'f', 1));
+        m.insert("TVSHOW.VOTES", QString::number(voteCount, 'f', 0));
     } else {
-        m.replace("{{ TVSHOW.RATING }}", "n/a");
-        m.replace("{{ TVSHOW.VOTES }}", "n/a");
-    }
-
-    m.replace("{{ TVSHOW.CERTIFICATION }}", show->certification().toString().toHtmlEscaped());
-    m.replace(
-        "{{ TVSHOW.FIRST_AIRED }}", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ TVSHOW.STUDIO }}", show->network().toHtmlEscaped());
-    m.replace("{{ TVSHOW.PLOT }}", show->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ TVSHOW.TAGS }}", show->tags().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.GENRES }}", show->genres().join(", ").toHtmlEscaped());
-    m.replace("{{ TVSHOW.SEASONS_AMOUNT }}", QString::number(show->seasons(false).size()));
-
-    QStringList actorNames;
-    QStringList actorRoles;
-    for (const Actor* actor : show->actors()) {
-        actorNames << actor->name;
-        actorRoles << actor->role;
-    }
-    replaceMultiBlock(m, "ACTORS", {"ACTOR.NAME", "ACTOR.ROLE"}, {actorNames, actorRoles});
-    replaceSingleBlock(m, "TAGS", "TAG.NAME", show->tags());
-    replaceSingleBlock(m, "GENRES", "GENRE.NAME", show->genres());
-
-    QString listSeasonItem;
-    QString listSeasonBlock;
-    QStringList seasonList;
-
-    QRegularExpression rx(R"(\{\{ BEGIN_BLOCK_SEASON \}\}(.*)\{\{ END_BLOCK_SEASON \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-
-    {
-        QRegularExpressionMatchIterator matches = rx.globalMatch(m);
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            listSeasonBlock = match.captured(0);
-            listSeasonItem = match.captured(1).trimmed();
-        }
+        m.insert("TVSHOW.RATING", "n/a");
+        m.insert("TVSHOW.VOTES", "n/a");
     }
 
-    if (listSeasonBlock.isEmpty() || listSeasonItem.isEmpty()) {
-        replaceImages(m, subDir, show);
-        return;
-    }
+    m.insert("TVSHOW.CERTIFICATION", show->certification().toString().toHtmlEscaped());
+    m.insert("TVSHOW.FIRST_AIRED", show->firstAired().isValid() ? show->firstAired().toString("yyyy-MM-dd") : "");
+    m.insert("TVSHOW.STUDIO", show->network().toHtmlEscaped());
+    m.insert("TVSHOW.PLOT", show->overview().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("TVSHOW.TAGS", show->tags().join(", ").toHtmlEscaped());
+    m.insert("TVSHOW.GENRES", show->genres().join(", ").toHtmlEscaped());
 
     QVector<SeasonNumber> seasons = show->seasons(false);
-    std::sort(seasons.begin(), seasons.end());
-    for (const SeasonNumber& season : asConst(seasons)) {
-        QVector<TvShowEpisode*> episodes = show->episodes(season);
-        std::sort(episodes.begin(), episodes.end(), TvShowEpisode::lessThan);
-        QString s = listSeasonItem;
-        s.replace("{{ SEASON }}", season.toString());
-
-        QString listEpisodeItem;
-        QString listEpisodeBlock;
-        QStringList episodeList;
-
-        rx.setPattern(R"(\{\{ BEGIN_BLOCK_EPISODE \}\}(.*)\{\{ END_BLOCK_EPISODE \}\})");
-        QRegularExpressionMatchIterator matches = rx.globalMatch(s);
-        while (matches.hasNext()) {
-            QRegularExpressionMatch match = matches.next();
-            listEpisodeBlock = match.captured(0);
-            listEpisodeItem = match.captured(1).trimmed();
-        }
-
-        if (!listEpisodeItem.isEmpty()) {
-            for (TvShowEpisode* episode : asConst(episodes)) {
-                QString e = listEpisodeItem;
-                replaceVars(e, episode, subDir);
-                episodeList << e;
+    m.insert("TVSHOW.SEASONS_AMOUNT", QString::number(seasons.size()));
+
+    addActors(data, show->actors());
+    data.addList("TAGS", "TAG.NAME", show->tags());
+    data.addList("GENRES", "GENRE.NAME", show->genres());
+
+    if (withSeasons) {
+        TemplateBlock seasonBlock;
+        seasonBlock.separator = "\n";
+        std::sort(seasons.begin(), seasons.end());
+        for (const SeasonNumber& season : asConst(seasons)) {
+            QVector<TvShowEpisode*> episodes = show->episodes(season);
+            std::sort(episodes.begin(), episodes.end(), TvShowEpisode::lessThan);
+
+            TemplateBlock episodeBlock;
+            episodeBlock.separator = "\n";
+            for (const TvShowEpisode* episode : asConst(episodes)) {
+                episodeBlock.items.push_back(episodeData(episode, imageTypes));
             }
+
+            TemplateData seasonData;
+            seasonData.variables.insert("SEASON", season.toString());
+            seasonData.blocks.insert("EPISODE", std::move(episodeBlock));
+            seasonBlock.items.push_back(std::move(seasonData));
         }
-        s.replace(listEpisodeBlock, episodeList.join("\n"));
-        seasonList << s;
+        data.blocks.insert("SEASON", std::move(seasonBlock));
     }
 
-    m.replace(listSeasonBlock, seasonList.join("\n"));
-    replaceImages(m, subDir, show);
+    static const QVector<ImageTypeInfo> tvShowImages{{"poster", ImageType::TvShowPoster, "jpg"},
+        {"fanart", ImageType::TvShowBackdrop, "jpg"},
+        {"banner", ImageType::TvShowBanner, "jpg"},
+        {"logo", ImageType::TvShowLogos, "png"},
+        {"clearart", ImageType::TvShowClearArt, "png"},
+        {"characterart", ImageType::TvShowCharacterArt, "png"}};
+    addImages(data, show, imageTypes, tvShowImages, QStringLiteral("tvshow_images/%1-").arg(show->showId()), "tvshow");
+    return data;
 }
 
-void SimpleEngine::replaceVars(QString& m, const TvShowEpisode* episode, bool subDir)
+TemplateData SimpleEngine::episodeData(const TvShowEpisode* episode, const QSet<QString>& imageTypes) const
 {
-    m.replace("{{ SHOW.TITLE }}", episode->tvShow()->title().toHtmlEscaped());
-    m.replace("{{ SHOW.LINK }}", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
-    m.replace("{{ EPISODE.LINK }}", QString("../episodes/%1.html").arg(episode->episodeId()));
-    m.replace("{{ EPISODE.TITLE }}", episode->title().toHtmlEscaped());
-    m.replace("{{ EPISODE.SEASON }}", episode->seasonString().toHtmlEscaped());
-    m.replace("{{ EPISODE.EPISODE }}", episode->episodeString().toHtmlEscaped());
+    TemplateData data;
+    auto& m = data.variables;
+    m.insert("SHOW.TITLE", episode->tvShow()->title().toHtmlEscaped());
+    m.insert("SHOW.LINK", QString("../tvshows/%1.html").arg(episode->tvShow()->showId()));
+    m.insert("EPISODE.LINK", QString("../episodes/%1.html").arg(episode->episodeId()));
+    m.insert("EPISODE.TITLE", episode->title().toHtmlEscaped());
+    m.insert("EPISODE.SEASON", episode->seasonString().toHtmlEscaped());
+    m.insert("EPISODE.EPISODE", episode->episodeString().toHtmlEscaped());
     if (episode->ratings().isEmpty()) {
-        m.replace("{{ EPISODE.RATING }}", "n/a");
+        m.insert("EPISODE.RATING", "n/a");
     } else {
-        m.replace("{{ EPISODE.RATING }}", QString::number(episode->ratings().first().rating, 'f', 1));
+        m.insert("EPISODE.RATING", QString::number(episode->ratings().first().rating, 'f', 1));
     }
-    m.replace("{{ EPISODE.CERTIFICATION }}", episode->certification().toString().toHtmlEscaped());
-    m.replace("{{ EPISODE.FIRST_AIRED }}",
-        episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
-    m.replace("{{ EPISODE.LAST_PLAYED }}",
-        episode->lastPlayed().isValid() ? episode->lastPlayed().toString("yyyy-MM-dd hh:mm") : "");
-    m.replace("{{ EPISODE.STUDIO }}", episode->network().toHtmlEscaped());
-    m.replace("{{ EPISODE.PLOT }}", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
-    m.replace("{{ EPISODE.WRITERS }}", episode->writers().join(", ").toHtmlEscaped());
-    m.replace("{{ EPISODE.DIRECTORS }}", episode->directors().join(", ").toHtmlEscaped());
+    m.insert("EPISODE.CERTIFICATION", episode->certification().toString().toHtmlEscaped());
+    m.insert(
+        "EPISODE.FIRST_AIRED", episode->firstAired().isValid() ? episode->firstAired().toString("yyyy-MM-dd") : "");
+    m.insert("EPISODE.LAST_PLAYED", dateTimeString(episode->lastPlayed()));
+    m.insert("EPISODE.STUDIO", episode->network().toHtmlEscaped());
+    m.insert("EPISODE.PLOT", episode->overview().toHtmlEscaped().replace("\n", "<br />"));
+    m.insert("EPISODE.WRITERS", episode->writers().join(", ").toHtmlEscaped());
+    m.insert("EPISODE.DIRECTORS", episode->directors().join(", ").toHtmlEscaped());
 
     if (!episode->files().isEmpty()) {
         QFileInfo fi(episode->files().first().toString());
-        m.replace("{{ EPISODE.DIR }}", fi.absolutePath());
+        m.insert("EPISODE.DIR", fi.absolutePath());
     } else {
-        m.replace("{{ EPISODE.DIR }}", "");
-    }
-    m.replace("{{ EPISODE.FILENAME }}", (!episode->files().isEmpty()) ? episode->files().first().toString() : "");
-
-    replaceStreamDetailsVars(m, episode->streamDetails());
-    replaceSingleBlock(m, "WRITERS", "WRITER.NAME", episode->writers());
-    replaceSingleBlock(m, "DIRECTORS", "DIRECTOR.NAME", episode->directors());
-    replaceImages(m, subDir, episode);
+        m.insert("EPISODE.DIR", "");
+    }
+    m.insert("EPISODE.FILENAME", (!episode->files().isEmpty()) ? episode->files().first().toString() : "");
+
+    addStreamDetails(data, episode->streamDetails());
+    data.addList("WRITERS", "WRITER.NAME", episode->writers());
+    data.addList("DIRECTORS", "DIRECTOR.NAME", episode->directors());
+
+    static const QVector<ImageTypeInfo> episodeImages{{"thumbnail", ImageType::TvShowEpisodeThumb, "jpg"}};
+    addImages(data,
+        episode,
+        imageTypes,
+        episodeImages,
+        QStringLiteral("episode_images/%1-").arg(episode->episodeId()),
+        "episode");
+    return data;
 }
 
-void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* details)
+void SimpleEngine::addStreamDetails(TemplateData& data, const StreamDetails* details)
 {
     const auto videoDetails = (details != nullptr) ? details->videoDetails() : decltype(details->videoDetails()){};
     const auto audioDetails = (details != nullptr) ? details->audioDetails() : decltype(details->audioDetails()){};
 
-    m.replace("{{ FILEINFO.WIDTH }}", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
-    m.replace("{{ FILEINFO.HEIGHT }}", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
-    m.replace("{{ FILEINFO.ASPECT }}", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
-    m.replace("{{ FILEINFO.CODEC }}", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
-    m.replace("{{ FILEINFO.DURATION }}", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
+    auto& m = data.variables;
+    m.insert("FILEINFO.WIDTH", videoDetails.value(StreamDetails::VideoDetails::Width, "0"));
+    m.insert("FILEINFO.HEIGHT", videoDetails.value(StreamDetails::VideoDetails::Height, "0"));
+    m.insert("FILEINFO.ASPECT", videoDetails.value(StreamDetails::VideoDetails::Aspect, "0"));
+    m.insert("FILEINFO.CODEC", videoDetails.value(StreamDetails::VideoDetails::Codec, ""));
+    m.insert("FILEINFO.DURATION", videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds, "0"));
 
     QStringList audioCodecs;
     QStringList audioChannels;
@@ -488,9 +479,9 @@ void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* det
         audioChannels << audioDetails.at(i).value(StreamDetails::AudioDetails::Channels);
         audioLanguages << audioDetails.at(i).value(StreamDetails::AudioDetails::Language);
     }
-    m.replace("{{ FILEINFO.AUDIO.CODEC }}", audioCodecs.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.CHANNELS }}", audioChannels.join("|"));
-    m.replace("{{ FILEINFO.AUDIO.LANGUAGE }}", audioLanguages.join("|"));
+    m.insert("FILEINFO.AUDIO.CODEC", audioCodecs.join("|"));
+    m.insert("FILEINFO.AUDIO.CHANNELS", audioChannels.join("|"));
+    m.insert("FILEINFO.AUDIO.LANGUAGE", audioLanguages.join("|"));
 
     QStringList subtitleLanguages;
     if (details != nullptr) {
@@ -498,306 +489,97 @@ void SimpleEngine::replaceStreamDetailsVars(QString& m, const StreamDetails* det
             subtitleLanguages << subtitle.value(StreamDetails::SubtitleDetails::Language);
         }
     }
-    m.replace("{{ FILEINFO.SUBTITLES.LANGUAGE }}", subtitleLanguages.join("|"));
+    m.insert("FILEINFO.SUBTITLES.LANGUAGE", subtitleLanguages.join("|"));
 }
 
-void SimpleEngine::replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces)
+void SimpleEngine::addActors(TemplateData& data, const Actors& actors)
 {
-    replaceMultiBlock(m, blockName, QStringList() << itemName, QVector<QStringList>() << replaces);
+    TemplateBlock block;
+    for (const Actor* actor : actors.actors()) {
+        TemplateData item;
+        item.variables.insert("ACTOR.NAME", actor->name.toHtmlEscaped());
+        item.variables.insert("ACTOR.ROLE", actor->role.toHtmlEscaped());
+        block.items.push_back(std::move(item));
+    }
+    data.blocks.insert("ACTORS", std::move(block));
 }
 
-void SimpleEngine::replaceMultiBlock(QString& m,
-    QString blockName,
-    QStringList itemNames,
-    QVector<QStringList> replaces)
+int SimpleEngine::batchSize()
 {
-    QRegularExpression rx("\\{\\{ BEGIN_BLOCK_" + blockName + R"( \}\}(.*)\{\{ END_BLOCK_)" + blockName + " \\}\\}", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatch match = rx.match(m);
-    if (match.hasMatch()) {
-        QString block = match.captured(0);
-        QString item = match.captured(1).trimmed();
-        QStringList list;
-        for (elch_ssize_t i = 0, n = replaces.at(0).count(); i < n; ++i) {
-            QString subItem = item;
-            for (elch_ssize_t x = 0, y = itemNames.count(); x < y; ++x) {
-                subItem.replace("{{ " + itemNames.at(x) + " }}", replaces.at(x).at(i).toHtmlEscaped());
-            }
-            list << subItem;
-        }
-        m.replace(block, list.join(" "));
-    }
+    // Large enough to keep all threads busy while the next batch is prepared.
+    return qMax(1, QThread::idealThreadCount()) * 16;
 }
 
-void SimpleEngine::saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality)
+void SimpleEngine::startBatch(QVector<RenderJob> jobs)
 {
-    Q_UNUSED(format)
-    Q_UNUSED(quality)
-
-    QImage img(imageFile);
-    if (img.isNull()) {
-        qCWarning(generic) << "[Export][SimpleEngine] Cannot load image:" << imageFile;
+    finishBatch();
+    if (jobs.isEmpty()) {
         return;
     }
-
-    img = img.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-
-    if (!img.isNull()) {
-        img.save(destinationFile);
-    } else {
-        qCWarning(generic) << "[Export][SimpleEngine] Could not scale (result was empty):" << imageFile;
-    }
+    m_batch = std::move(jobs);
+    m_batchFuture = QtConcurrent::map(m_batch, [this](RenderJob& job) { renderJob(job); });
 }
 
-void SimpleEngine::replaceImages(QString& m,
-    const bool& subDir,
-    const Movie* movie,
-    const Concert* concert,
-    const QString& concertId,
-    const TvShow* tvShow,
-    const TvShowEpisode* episode)
+void SimpleEngine::finishBatch()
 {
-    QString item;
-    QSize size;
-    QRegularExpression rx(R"(\{\{ IMAGE.(.*)\[(\d*), ?(\d*)\] \}\})", //
-        QRegularExpression::InvertedGreedinessOption | QRegularExpression::DotMatchesEverythingOption);
-    QRegularExpressionMatchIterator matches = rx.globalMatch(m);
-    while (matches.hasNext()) {
-        QRegularExpressionMatch match = matches.next();
-        item = match.captured(0);
-        QString type = match.captured(1).toLower();
-        size.setWidth(match.captured(2).toInt());
-        size.setHeight(match.captured(3).toInt());
-
-        if (item.isEmpty() || size.isEmpty()) {
-            continue;
-        }
-
-        QString destFile;
-        bool imageSaved = false;
-        bool isPlaceholderUsed = true;
-        QString typeName;
-        if (movie != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, movie, &isPlaceholderUsed);
-            typeName = "movie";
-
-        } else if (concert != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, concert, concertId, &isPlaceholderUsed);
-            typeName = "concert";
-
-        } else if (tvShow != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, tvShow, &isPlaceholderUsed);
-            typeName = "tvshow";
-
-        } else if (episode != nullptr) {
-            imageSaved = saveImageForType(type, size, destFile, episode, &isPlaceholderUsed);
-            typeName = "episode";
-        }
-
-        if (!isPlaceholderUsed) {
-            continue;
-        }
-
-        if (imageSaved) {
-            m.replace(item, (subDir ? "../" : "") + destFile);
-        } else {
-            m.replace(item,
-                (subDir ? "../" : "")
-                    + QString("defaults/%1_%2_%3x%4.png").arg(typeName).arg(type).arg(size.width()).arg(size.height()));
-        }
+    if (m_batch.isEmpty()) {
+        return;
     }
-}
 
-void SimpleEngine::replaceImages(QString& m, const bool& subDir, const Movie* movie)
-{
-    replaceImages(m, subDir, movie, nullptr, {}, nullptr, nullptr);
-}
-
-void SimpleEngine::replaceImages(QString& m, const bool& subDir, const Concert* concert, const QString& concertId)
-{
-    replaceImages(m, subDir, nullptr, concert, concertId, nullptr, nullptr);
-}
-
-void SimpleEngine::replaceImages(QString& m, const bool& subDir, const TvShow* tvShow)
-{
-    replaceImages(m, subDir, nullptr, nullptr, {}, tvShow, nullptr);
-}
-
-void SimpleEngine::replaceImages(QString& m, const bool& subDir, const TvShowEpisode* episode)
-{
-    replaceImages(m, subDir, nullptr, nullptr, {}, nullptr, episode);
-}
-
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const Movie* movie,
-    bool* isPlaceHolderUsed)
-{
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::MoviePoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::MovieBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::MovieLogo;
-    } else if (type == "clearart") {
-        imageType = ImageType::MovieClearArt;
-    } else if (type == "disc") {
-        imageType = ImageType::MovieCdArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
+    // Keep the UI responsive while waiting.  Progress is reported for each rendered item.
+    int reported = 0;
+    QEventLoop loop;
+    QFutureWatcher<void> watcher;
+    connect(&watcher, &QFutureWatcherBase::progressValueChanged, this, [this, &reported](int progress) {
+        for (; reported < progress; ++reported) {
+            emit sigItemExported();
+        }
+    });
+    connect(&watcher, &QFutureWatcherBase::finished, &loop, &QEventLoop::quit);
+    watcher.setFuture(m_batchFuture);
+    if (!watcher.isFinished()) {
+        loop.exec();
+    }
+    watcher.waitForFinished();
+    for (const elch_ssize_t count = m_batch.size(); reported < count; ++reported) {
+        emit sigItemExported();
     }
 
-    *isPlaceHolderUsed = true;
-
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "movie_images/"
-               + QString("%1-%2_%3x%4.%5")
-                     .arg(movie->movieId())
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
-
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(movie, imageType);
-    if (filename.isEmpty()) {
-        return false;
+    QVector<ExportImage> images;
+    for (RenderJob& job : m_batch) {
+        if (job.listItem != nullptr) {
+            m_listItems << std::move(job.renderedListItem);
+        }
+        images << job.images;
     }
-
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
-
-    return true;
+    // Images are scaled while the next batch is rendered.
+    m_images.add(images);
+    m_batch.clear();
+    m_batchFuture = QFuture<void>();
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const Concert* concert,
-    const QString& concertId,
-    bool* isPlaceHolderUsed)
+void SimpleEngine::renderJob(RenderJob& job)
 {
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::ConcertPoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::ConcertBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::ConcertLogo;
-    } else if (type == "clearart") {
-        imageType = ImageType::ConcertClearArt;
-    } else if (type == "disc") {
-        imageType = ImageType::ConcertCdArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
-    }
-
-    *isPlaceHolderUsed = true;
-
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "movie_images/"
-               + QString("%1-%2_%3x%4.%5") //
-                     .arg(concertId)
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
-
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(concert, imageType);
-    if (filename.isEmpty()) {
-        return false;
+    if (m_cancelFlag.load()) {
+        return;
     }
 
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
-
-    return true;
-}
-
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const TvShow* tvShow,
-    bool* isPlaceHolderUsed)
-{
-    std::string imageFormat = "png";
-    ImageType imageType;
-
-    if (type == "poster") {
-        imageType = ImageType::TvShowPoster;
-        imageFormat = "jpg";
-    } else if (type == "fanart") {
-        imageType = ImageType::TvShowBackdrop;
-        imageFormat = "jpg";
-    } else if (type == "banner") {
-        imageType = ImageType::TvShowBanner;
-        imageFormat = "jpg";
-    } else if (type == "logo") {
-        imageType = ImageType::TvShowLogos;
-    } else if (type == "clearart") {
-        imageType = ImageType::TvShowClearArt;
-    } else if (type == "characterart") {
-        imageType = ImageType::TvShowCharacterArt;
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
+    if (job.listItem != nullptr) {
+        job.renderedListItem = job.listItem->render(job.data, false, &job.images);
     }
-    *isPlaceHolderUsed = true;
-
-    QString file_ending = QString::fromStdString(imageFormat);
-    destFile = "tvshow_images/"
-               + QString("%1-%2_%3x%4.%5")
-                     .arg(tvShow->showId())
-                     .arg(type)
-                     .arg(size.width())
-                     .arg(size.height())
-                     .arg(file_ending);
-
-    QString filename = Manager::instance()->mediaCenterInterface()->imageFileName(tvShow, imageType);
-    if (filename.isEmpty()) {
-        return false;
+    if (job.page != nullptr) {
+        writeFile(m_dir.filePath(job.pageFile), job.page->render(job.data, true, &job.images));
     }
-
-    int imageQuality = (imageFormat == "jpg") ? 90 : -1;
-    saveImage(size, filename, m_dir.path() + "/" + destFile, imageFormat.c_str(), imageQuality);
-
-    return true;
 }
 
-bool SimpleEngine::saveImageForType(const QString& type,
-    const QSize& size,
-    QString& destFile,
-    const TvShowEpisode* episode,
-    bool* isPlaceHolderUsed)
+void SimpleEngine::writeListPage(const QString& fileName, const SimpleTemplate& listTemplate, const QString& blockName)
 {
-    destFile = "episode_images/"
-               + QString("%1-%2_%3x%4.jpg").arg(episode->episodeId()).arg(type).arg(size.width()).arg(size.height());
-
-    if (type == "thumbnail") {
-        *isPlaceHolderUsed = true;
-        QString filename =
-            Manager::instance()->mediaCenterInterface()->imageFileName(episode, ImageType::TvShowEpisodeThumb);
-        if (filename.isEmpty()) {
-            return false;
-        }
-        saveImage(size, filename, m_dir.path() + "/" + destFile, "jpg", 90);
-    } else {
-        *isPlaceHolderUsed = false;
-        return false;
-    }
-
-    return true;
+    TemplateBlock block;
+    block.rendered = m_listItems;
+    block.separator = "\n";
+    TemplateData data;
+    data.blocks.insert(blockName, std::move(block));
+    writeFile(m_dir.filePath(fileName), listTemplate.render(data, false));
 }
 
 } // namespace mediaelch
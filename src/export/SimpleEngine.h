@@ -1,11 +1,18 @@
 #pragma once
 
 #include "export/ExportTemplate.h"
+#include "export/ImageExporter.h"
+#include "export/SimpleTemplate.h"
 
 #include <QDir>
+#include <QFuture>
 #include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
 #include <atomic>
 
+class Actors;
 class Concert;
 class Movie;
 class TvShow;
@@ -16,6 +23,11 @@ namespace mediaelch {
 
 /// Default export engine for MediaElch. Simple find&replace semantics,
 /// only basic functionality (e.g. condintional block)
+///
+/// Templates are parsed once, see SimpleTemplate.  Values of all items are
+/// collected in the GUI thread, but pages are rendered and written in worker
+/// threads, in batches so that the next batch can be prepared meanwhile.
+/// Images are exported by an ImageExporter while the next batch is rendered.
 class SimpleEngine : public QObject
 {
     Q_OBJECT
@@ -36,54 +48,48 @@ public:
     void exportTvShows(QVector<TvShow*> shows);
 
 private:
-    void saveImage(QSize size, QString imageFile, QString destinationFile, const char* format, int quality);
-    // TODO: Cleanup
-    void replaceImages(QString& m,
-        const bool& subDir,
-        const Movie* movie,
-        const Concert* concert,
-        const QString& concertId,
-        const TvShow* tvShow,
-        const TvShowEpisode* episode);
+    /// \brief An item that is rendered in a worker thread.
+    struct RenderJob
+    {
+        /// \brief Template of the item's own page.  Nothing is written if it is null.
+        const SimpleTemplate* page = nullptr;
+        /// \brief Path of the item's page relative to the export directory.
+        QString pageFile;
+        /// \brief Template of the item's entry in the list page.  Not rendered if it is null.
+        const SimpleTemplate* listItem = nullptr;
+        TemplateData data;
+        QString renderedListItem;
+        /// \brief Images referenced by the rendered pages.
+        QVector<ExportImage> images;
+    };
 
-    void replaceImages(QString& m, const bool& subDir, const Movie* movie);
-    void replaceImages(QString& m, const bool& subDir, const Concert* concert, const QString& concertId);
-    void replaceImages(QString& m, const bool& subDir, const TvShow* tvShow);
-    void replaceImages(QString& m, const bool& subDir, const TvShowEpisode* episode);
+    /// \brief Finishes the running batch and starts rendering the given jobs in worker threads.
+    /// \details Returns immediately so that the next batch can be prepared in the meantime.
+    void startBatch(QVector<RenderJob> jobs);
+    /// \brief Waits for the running batch, appends its rendered list items to m_listItems
+    ///        and passes its images on to m_images.
+    void finishBatch();
+    void renderJob(RenderJob& job);
+    void writeListPage(const QString& fileName, const SimpleTemplate& listTemplate, const QString& blockName);
 
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const Movie* movie,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const Concert* concert,
-        const QString& concertId,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const TvShow* tvShow,
-        bool* isPlaceHolderUsed);
-    bool saveImageForType(const QString& type,
-        const QSize& size,
-        QString& destFile,
-        const TvShowEpisode* episode,
-        bool* isPlaceHolderUsed);
-    void replaceVars(QString& m, Movie* movie, bool subDir = false);
-    void replaceVars(QString& m, const Concert* concert, const QString& id, bool subDir = false);
-    void replaceVars(QString& m, const TvShow* show, bool subDir = false);
-    void replaceVars(QString& m, const TvShowEpisode* episode, bool subDir = false);
-    void replaceSingleBlock(QString& m, QString blockName, QString itemName, QStringList replaces);
-    void replaceMultiBlock(QString& m, QString blockName, QStringList itemNames, QVector<QStringList> replaces);
-    void replaceStreamDetailsVars(QString& m, const StreamDetails* details);
+    TemplateData movieData(Movie* movie, const QSet<QString>& imageTypes) const;
+    TemplateData concertData(const Concert* concert, const QString& id, const QSet<QString>& imageTypes) const;
+    TemplateData tvShowData(const TvShow* show, const QSet<QString>& imageTypes, bool withSeasons) const;
+    TemplateData episodeData(const TvShowEpisode* episode, const QSet<QString>& imageTypes) const;
+
+    static void addStreamDetails(TemplateData& data, const StreamDetails* details);
+    static void addActors(TemplateData& data, const Actors& actors);
+    static int batchSize();
 
 private:
     std::atomic_bool& m_cancelFlag;
     ExportTemplate* m_template = nullptr;
     QDir m_dir;
+
+    QVector<RenderJob> m_batch;
+    QFuture<void> m_batchFuture;
+    QStringList m_listItems;
+    ImageExporter m_images;
 };
 
 } // namespace mediaelch
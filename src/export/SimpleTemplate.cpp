@@ -0,0 +1,344 @@
+#include "export/SimpleTemplate.h"
+
+#include "utils/Meta.h"
+
+#include <QRegularExpression>
+
+#include <algorithm>
+
+namespace mediaelch {
+
+void TemplateData::addList(const QString& blockName, const QString& variable, const QStringList& values)
+{
+    TemplateBlock block;
+    block.items.reserve(values.size());
+    for (const QString& value : values) {
+        TemplateData item;
+        item.variables.insert(variable, value.toHtmlEscaped());
+        block.items.push_back(std::move(item));
+    }
+    blocks.insert(blockName, std::move(block));
+}
+
+struct SimpleTemplate::Node
+{
+    enum class Type
+    {
+        Text,
+        Variable,
+        Image,
+        Block
+    };
+
+    Type type = Type::Text;
+    /// \brief Text, variable name, lower case image type or block name.
+    QString value;
+    /// \brief Original token, e.g. "{{ MOVIE.TITLE }}".  Used if there is no value for it.
+    QString token;
+    /// \brief Size of an image.
+    QSize size;
+    /// \brief Content of a block.
+    QVector<Node> children;
+    /// \brief Whitespace that was trimmed from the block's content.
+    QString leadingSpace;
+    QString trailingSpace;
+    /// \brief Whether a block has an end token.  Blocks without one are kept as they are.
+    bool isClosed = false;
+};
+
+void SimpleTemplate::appendText(QVector<Node>& nodes, const QString& text)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+    if (!nodes.isEmpty() && nodes.last().type == Node::Type::Text) {
+        nodes.last().value += text;
+        return;
+    }
+    Node node;
+    node.value = text;
+    nodes.push_back(std::move(node));
+}
+
+void SimpleTemplate::trimBlock(Node& block)
+{
+    auto& children = block.children;
+    if (!children.isEmpty() && children.first().type == Node::Type::Text) {
+        QString& text = children.first().value;
+        elch_ssize_t i = 0;
+        while (i < text.size() && text.at(i).isSpace()) {
+            ++i;
+        }
+        block.leadingSpace = text.left(i);
+        text.remove(0, i);
+        if (text.isEmpty()) {
+            children.removeFirst();
+        }
+    }
+    if (!children.isEmpty() && children.last().type == Node::Type::Text) {
+        QString& text = children.last().value;
+        elch_ssize_t i = text.size();
+        while (i > 0 && text.at(i - 1).isSpace()) {
+            --i;
+        }
+        block.trailingSpace = text.mid(i);
+        text.truncate(i);
+        if (text.isEmpty()) {
+            children.removeLast();
+        }
+    }
+}
+
+/// \brief Renders nodes with a stack of values: block items are pushed on top of the item containing the block.
+class SimpleTemplate::Renderer
+{
+public:
+    Renderer(bool subDir, QVector<ExportImage>* images) : m_subDir{subDir}, m_images{images} {}
+
+    void render(const QVector<Node>& nodes, QString& out)
+    {
+        for (const Node& node : nodes) {
+            switch (node.type) {
+            case Node::Type::Text: out += node.value; break;
+            case Node::Type::Variable: renderVariable(node, out); break;
+            case Node::Type::Image: renderImage(node, out); break;
+            case Node::Type::Block: renderBlock(node, out); break;
+            }
+        }
+    }
+
+    QVector<const TemplateData*> scopes;
+
+private:
+    /// \brief Looks up the key in the innermost scope first.
+    template<class T>
+    const T* find(QHash<QString, T> TemplateData::*member, const QString& key) const
+    {
+        for (auto scope = scopes.crbegin(); scope != scopes.crend(); ++scope) {
+            const QHash<QString, T>& values = (*scope)->*member;
+            auto value = values.constFind(key);
+            if (value != values.constEnd()) {
+                return &value.value();
+            }
+        }
+        return nullptr;
+    }
+
+    void renderVariable(const Node& node, QString& out) const
+    {
+        const QString* value = find(&TemplateData::variables, node.value);
+        out += (value != nullptr) ? *value : node.token;
+    }
+
+    void renderImage(const Node& node, QString& out) const
+    {
+        const TemplateImage* image = find(&TemplateData::images, node.value);
+        if (image == nullptr) {
+            out += node.token;
+            return;
+        }
+        if (m_subDir) {
+            out += QStringLiteral("../");
+        }
+        const QString width = QString::number(node.size.width());
+        const QString height = QString::number(node.size.height());
+        if (image->source.isEmpty()) {
+            out += QStringLiteral("defaults/%1_%2_%3x%4.png").arg(image->typeName, node.value, width, height);
+            return;
+        }
+        const QString destination = QStringLiteral("%1%2_%3x%4.%5")
+                                        .arg(image->destinationPrefix, node.value, width, height, image->extension);
+        if (m_images != nullptr) {
+            m_images->push_back(ExportImage{image->source, destination, node.size});
+        }
+        out += destination;
+    }
+
+    void renderBlock(const Node& node, QString& out)
+    {
+        const TemplateBlock* block = node.isClosed ? find(&TemplateData::blocks, node.value) : nullptr;
+        if (block == nullptr) {
+            out += node.token;
+            out += node.leadingSpace;
+            render(node.children, out);
+            out += node.trailingSpace;
+            if (node.isClosed) {
+                out += QStringLiteral("{{ END_BLOCK_%1 }}").arg(node.value);
+            }
+            return;
+        }
+        if (!block->rendered.isEmpty()) {
+            out += block->rendered.join(block->separator);
+            return;
+        }
+        if (node.children.isEmpty()) {
+            return;
+        }
+        bool isFirst = true;
+        for (const TemplateData& item : block->items) {
+            if (!isFirst) {
+                out += block->separator;
+            }
+            isFirst = false;
+            scopes.push_back(&item);
+            render(node.children, out);
+            scopes.pop_back();
+        }
+    }
+
+private:
+    bool m_subDir = false;
+    QVector<ExportImage>* m_images = nullptr;
+};
+
+SimpleTemplate::SimpleTemplate(const QString& text)
+{
+    static const QRegularExpression imageRx(R"(^IMAGE\.(.*)\[(\d*), ?(\d*)\]$)");
+    static const QString beginBlock = QStringLiteral("BEGIN_BLOCK_");
+    static const QString endBlock = QStringLiteral("END_BLOCK_");
+
+    auto root = std::make_shared<QVector<Node>>();
+    // Blocks whose end token was not found, yet.  Nested blocks are at the end.
+    QVector<Node> openBlocks;
+    const auto current = [&]() -> QVector<Node>& { return openBlocks.isEmpty() ? *root : openBlocks.last().children; };
+    const auto closeBlock = [&](bool isClosed) {
+        Node block = openBlocks.takeLast();
+        block.isClosed = isClosed;
+        if (isClosed) {
+            trimBlock(block);
+        }
+        current().push_back(std::move(block));
+    };
+
+    elch_ssize_t pos = 0;
+    while (pos < text.size()) {
+        const elch_ssize_t start = text.indexOf(QStringLiteral("{{ "), pos);
+        const elch_ssize_t end = (start < 0) ? -1 : text.indexOf(QStringLiteral(" }}"), start + 3);
+        if (end < 0) {
+            appendText(current(), text.mid(pos));
+            break;
+        }
+        const QString name = text.mid(start + 3, end - start - 3);
+        if (name.contains('\n') || name.contains(QStringLiteral("{{ "))) {
+            // Not a token, e.g. "{{ {{ MOVIE.TITLE }}": only the last "{{ " may start one.
+            appendText(current(), text.mid(pos, start + 3 - pos));
+            pos = start + 3;
+            continue;
+        }
+        appendText(current(), text.mid(pos, start - pos));
+        pos = end + 3;
+
+        Node node;
+        node.token = text.mid(start, end + 3 - start);
+
+        if (name.startsWith(beginBlock)) {
+            node.type = Node::Type::Block;
+            node.value = name.mid(beginBlock.size());
+            openBlocks.push_back(std::move(node));
+            continue;
+        }
+
+        if (name.startsWith(endBlock)) {
+            const QString blockName = name.mid(endBlock.size());
+            const bool isOpen = std::any_of(openBlocks.cbegin(), openBlocks.cend(), [&blockName](const Node& block) {
+                return block.value == blockName;
+            });
+            if (isOpen) {
+                while (openBlocks.last().value != blockName) {
+                    closeBlock(false);
+                }
+                closeBlock(true);
+                continue;
+            }
+        }
+
+        const QRegularExpressionMatch image = imageRx.match(name);
+        const QSize size =
+            image.hasMatch() ? QSize(image.captured(2).toInt(), image.captured(3).toInt()) : QSize{};
+        if (image.hasMatch() && !size.isEmpty()) {
+            node.type = Node::Type::Image;
+            node.value = image.captured(1).toLower();
+            node.size = size;
+        } else {
+            node.type = Node::Type::Variable;
+            node.value = name;
+        }
+        current().push_back(std::move(node));
+    }
+
+    while (!openBlocks.isEmpty()) {
+        closeBlock(false);
+    }
+    m_nodes = std::move(root);
+}
+
+bool SimpleTemplate::isEmpty() const
+{
+    return m_nodes == nullptr || m_nodes->isEmpty();
+}
+
+bool SimpleTemplate::hasBlock(const QString& name) const
+{
+    return m_nodes != nullptr && findBlock(*m_nodes, name) != nullptr;
+}
+
+SimpleTemplate SimpleTemplate::block(const QString& name) const
+{
+    SimpleTemplate blockTemplate;
+    const Node* node = (m_nodes != nullptr) ? findBlock(*m_nodes, name) : nullptr;
+    if (node != nullptr) {
+        blockTemplate.m_nodes = std::make_shared<const QVector<Node>>(node->children);
+    }
+    return blockTemplate;
+}
+
+QSet<QString> SimpleTemplate::imageTypes() const
+{
+    QSet<QString> types;
+    if (m_nodes != nullptr) {
+        collectImageTypes(*m_nodes, types);
+    }
+    return types;
+}
+
+QString SimpleTemplate::render(const TemplateData& data, bool subDir, QVector<ExportImage>* images) const
+{
+    QString out;
+    if (m_nodes == nullptr) {
+        return out;
+    }
+    Renderer renderer(subDir, images);
+    renderer.scopes.push_back(&data);
+    renderer.render(*m_nodes, out);
+    return out;
+}
+
+const SimpleTemplate::Node* SimpleTemplate::findBlock(const QVector<Node>& nodes, const QString& name)
+{
+    for (const Node& node : nodes) {
+        if (node.type != Node::Type::Block) {
+            continue;
+        }
+        if (node.isClosed && node.value == name) {
+            return &node;
+        }
+        const Node* nested = findBlock(node.children, name);
+        if (nested != nullptr) {
+            return nested;
+        }
+    }
+    return nullptr;
+}
+
+void SimpleTemplate::collectImageTypes(const QVector<Node>& nodes, QSet<QString>& types)
+{
+    for (const Node& node : nodes) {
+        if (node.type == Node::Type::Image) {
+            types.insert(node.value);
+        } else if (node.type == Node::Type::Block) {
+            collectImageTypes(node.children, types);
+        }
+    }
+}
+
+} // namespace mediaelch
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <memory>
+
+namespace mediaelch {
+
+struct TemplateBlock;
+
+/// \brief Image placeholder values of an item, e.g. for "{{ IMAGE.poster[200, 300] }}".
+struct TemplateImage
+{
+    /// \brief Original image.  If empty, the theme's default image is used.
+    QString source;
+    /// \brief Prefix of the exported image's path, e.g. "movie_images/42-".
+    QString destinationPrefix;
+    /// \brief File extension of the exported image, e.g. "jpg".
+    QString extension;
+    /// \brief Item type used for the theme's default images, e.g. "movie".
+    QString typeName;
+};
+
+/// \brief An image referenced by a rendered template that has to be exported.
+struct ExportImage
+{
+    QString source;
+    /// \brief Path relative to the export directory.
+    QString destination;
+    QSize size;
+};
+
+/// \brief Values of a single item, e.g. a movie, that are used to render a SimpleTemplate.
+///
+/// Values must already be HTML escaped, if required.  Blocks are rendered once
+/// per block item.  Values that are not found in a block item are looked up in
+/// the item containing the block, e.g. "{{ MOVIE.TITLE }}" inside of the
+/// actors block.
+struct TemplateData
+{
+    QHash<QString, QString> variables;
+    QHash<QString, TemplateBlock> blocks;
+    /// \brief Keyed by lower case image type, e.g. "poster".
+    QHash<QString, TemplateImage> images;
+
+    /// \brief Adds a block with one item per value, e.g. for all genres.  Values are HTML escaped.
+    void addList(const QString& blockName, const QString& variable, const QStringList& values);
+};
+
+struct TemplateBlock
+{
+    QVector<TemplateData> items;
+    /// \brief Already rendered items.  Used instead of items if not empty.
+    QStringList rendered;
+    QString separator = QStringLiteral(" ");
+};
+
+/// \brief Template of the simple export engine, parsed once and rendered for each item.
+///
+/// Supported syntax:
+///  - Variables: "{{ MOVIE.TITLE }}"
+///  - Blocks: "{{ BEGIN_BLOCK_GENRES }}{{ GENRE.NAME }}{{ END_BLOCK_GENRES }}".
+///    The block's content is trimmed.
+///  - Images: "{{ IMAGE.poster[200, 300] }}"
+///
+/// Variables, blocks and images without values are kept as they are, so that
+/// they can be rendered by another template.
+///
+/// Rendering does not modify the template, so it can be rendered by multiple
+/// threads at the same time.  Copies share the parsed template.
+class SimpleTemplate
+{
+public:
+    SimpleTemplate() = default;
+    explicit SimpleTemplate(const QString& text);
+
+    bool isEmpty() const;
+    bool hasBlock(const QString& name) const;
+    /// \brief Template consisting of the (trimmed) content of the first block with the given name.
+    SimpleTemplate block(const QString& name) const;
+    /// \brief Lower case types of all image placeholders, e.g. "poster".
+    QSet<QString> imageTypes() const;
+
+    /// \brief Render the template in a single pass.
+    /// \param subDir Whether the result is stored in a sub directory of the export directory.
+    ///        Paths to images are adjusted accordingly.
+    /// \param images Images that are referenced by the result are appended.
+    QString render(const TemplateData& data, bool subDir, QVector<ExportImage>* images = nullptr) const;
+
+private:
+    struct Node;
+    class Renderer;
+
+    static void appendText(QVector<Node>& nodes, const QString& text);
+    /// \brief Trims the block's content the same way as QString::trimmed() would trim its text.
+    static void trimBlock(Node& block);
+    static const Node* findBlock(const QVector<Node>& nodes, const QString& name);
+    static void collectImageTypes(const QVector<Node>& nodes, QSet<QString>& types);
+
+private:
+    std::shared_ptr<const QVector<Node>> m_nodes;
+};
+
+} // namespace mediaelch
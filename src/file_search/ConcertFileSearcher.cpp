@@ -1,14 +1,18 @@
 #include "ConcertFileSearcher.h"
 
+#include "file_search/DirectoryCrawler.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
 #include "log/Log.h"
 
 #include <QApplication>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRegularExpression>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <algorithm>
 
 ConcertFileSearcher::ConcertFileSearcher(QObject* parent) :
     QObject(parent), m_progressMessageId{Constants::ConcertFileSearcherProgressMessageId}
@@ -67,120 +71,129 @@ void ConcertFileSearcher::reload(bool force)
 /**
  * \brief Scans the given path for concert files.
  * Results are in a list which contains a QStringList for every concert.
- * \param startPath Scanning started at this path
+ * Directories are crawled in parallel.
  * \param path Path to scan
  * \param contents List of contents
- * \param separateFolders Are concerts in separate folders
- * \param firstScan When this is true, subfolders are scanned, regardless of separateFolders
+ * \param separateFolders Are concerts in separate folders. If true, only direct
+ *        subdirectories of path are scanned.
  */
-void ConcertFileSearcher::scanDir(QString startPath,
-    QString path,
-    QVector<QStringList>& contents,
-    bool separateFolders,
-    bool firstScan)
+void ConcertFileSearcher::scanDir(QString path, QVector<QStringList>& contents, bool separateFolders)
 {
-    emit currentDir(path.mid(startPath.length()));
-
-    QDir dir(path);
-    const auto dirEntries = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    for (const QString& cDir : dirEntries) {
-        if (m_aborted) {
-            return;
-        }
+    const auto& fileFilter = Settings::instance()->advanced()->concertFilters();
+    if (!fileFilter.hasFilter()) {
+        return;
+    }
 
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
+    QMutex mutex;
+    QVector<QStringList> newContents;
+    const auto addConcert = [&](const QStringList& files) {
+        QMutexLocker locker(&mutex);
+        newContents.append(files);
+    };
+
+    mediaelch::DirectoryCrawler crawler(fileFilter.filters(), QDir::System);
+    crawler.setDescendFilter([&](const QFileInfo& dirInfo, int depth) -> bool {
+        const QString cDir = dirInfo.fileName();
+        if (m_aborted || Settings::instance()->advanced()->isFolderExcluded(cDir)) {
+            return false;
         }
 
         // Skip "Extras" folder
         if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
             || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
             || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
-            continue;
+            return false;
         }
 
+        const QString dirPath = dirInfo.filePath();
+
         // Handle DVD
-        if (helper::isDvd(path + QDir::separator() + cDir)) {
-            contents.append({QDir(path + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO").path()});
-            continue;
+        if (helper::isDvd(dirPath)) {
+            addConcert({QDir(dirPath + "/VIDEO_TS/VIDEO_TS.IFO").path()});
+            return false;
         }
 
         // Handle BluRay
-        if (helper::isBluRay(path + QDir::separator() + cDir)) {
-            contents.append({QDir(path + "/" + cDir + "/BDMV/index.bdmv").path()});
-            continue;
+        if (helper::isBluRay(dirPath)) {
+            addConcert({QDir(dirPath + "/BDMV/index.bdmv").path()});
+            return false;
         }
 
         // Don't scan subfolders when separate folders is checked
-        if (!separateFolders || firstScan) {
-            scanDir(startPath, path + "/" + cDir, contents, separateFolders);
-        }
-    }
+        return !separateFolders || depth == 0;
+    });
 
-    QStringList files;
-    const QStringList entries = getFiles(mediaelch::DirectoryPath(path));
-    for (const QString& file : entries) {
+    crawler.crawl(path, [&](const mediaelch::DirectoryListing& listing) {
+        // Note: This lambda is called in parallel!
         if (m_aborted) {
+            crawler.abort();
             return;
         }
+        emit currentDir(listing.path.mid(path.length()));
 
-        if (Settings::instance()->advanced()->isFileExcluded(file)) {
-            continue;
-        }
-
-        // Skip Trailers and Sample files
-        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
-            continue;
-        }
-        files.append(file);
-    }
-    files.sort();
+        QStringList files;
+        for (const QFileInfo& fileInfo : listing.files) {
+            const QString file = fileInfo.fileName();
+            if (Settings::instance()->advanced()->isFileExcluded(file)) {
+                continue;
+            }
 
-    if (separateFolders) {
-        QStringList concertFiles;
-        for (const QString& file : files) {
-            concertFiles.append(QDir(path + "/" + file).path());
-        }
-        if (concertFiles.count() > 0) {
-            contents.append(concertFiles);
+            // Skip Trailers and Sample files
+            if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
+                continue;
+            }
+            files.append(file);
         }
-        return;
-    }
+        files.sort();
 
-    QRegularExpression rx("((part|cd)[\\s_]*)(\\d+)");
-    rx.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
-    for (elch_ssize_t i = 0, n = files.size(); i < n; i++) {
-        if (m_aborted) {
+        const QString dirPath = listing.path;
+        if (separateFolders) {
+            QStringList concertFiles;
+            for (const QString& file : files) {
+                concertFiles.append(QDir(dirPath + "/" + file).path());
+            }
+            if (concertFiles.count() > 0) {
+                addConcert(concertFiles);
+            }
             return;
         }
 
-        QStringList concertFiles;
-        QString file = files.at(i);
-        if (file.isEmpty()) {
-            continue;
-        }
+        static const QRegularExpression rx("((part|cd)[\\s_]*)(\\d+)", QRegularExpression::CaseInsensitiveOption);
+        for (elch_ssize_t i = 0, n = files.size(); i < n; i++) {
+            QStringList concertFiles;
+            QString file = files.at(i);
+            if (file.isEmpty()) {
+                continue;
+            }
 
-        concertFiles << QDir(path + QDir::separator() + file).path();
-
-        QRegularExpressionMatch match = rx.match(file);
-        const elch_ssize_t pos = match.capturedStart();
-        if (pos != -1) {
-            QString left = file.left(pos) + match.captured(1);
-            QString right = file.mid(pos + match.captured(1).size() + match.captured(2).size());
-            for (int x = 0; x < n; x++) {
-                QString subFile = files.at(x);
-                if (subFile != file) {
-                    if (subFile.startsWith(left) && subFile.endsWith(right)) {
-                        concertFiles << QDir(path + QDir::separator() + subFile).path();
-                        files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
+            concertFiles << QDir(dirPath + QDir::separator() + file).path();
+
+            QRegularExpressionMatch match = rx.match(file);
+            const elch_ssize_t pos = match.capturedStart();
+            if (pos != -1) {
+                QString left = file.left(pos) + match.captured(1);
+                QString right = file.mid(pos + match.captured(1).size() + match.captured(2).size());
+                for (int x = 0; x < n; x++) {
+                    QString subFile = files.at(x);
+                    if (subFile != file) {
+                        if (subFile.startsWith(left) && subFile.endsWith(right)) {
+                            concertFiles << QDir(dirPath + QDir::separator() + subFile).path();
+                            files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
+                        }
                     }
                 }
             }
+            if (concertFiles.count() > 0) {
+                addConcert(concertFiles);
+            }
         }
-        if (concertFiles.count() > 0) {
-            contents.append(concertFiles);
-        }
-    }
+    });
+
+    // Directories are crawled in parallel; sort concerts to get a stable order.
+    std::sort(newContents.begin(), newContents.end(), [](const QStringList& lhs, const QStringList& rhs) {
+        return lhs.first() < rhs.first();
+    });
+    contents.append(newContents);
 }
 
 void ConcertFileSearcher::clearOldConcerts(bool forceClear)
@@ -210,7 +223,7 @@ QVector<QStringList> ConcertFileSearcher::loadContentsFromDiskIfRequired(bool fo
         const QString path = dir.path.path();
         QVector<Concert*> concertsFromDb = database().concertsInDirectory(mediaelch::DirectoryPath(dir.path));
         if (dir.autoReload || forceReload || concertsFromDb.isEmpty()) {
-            scanDir(path, path, contents, dir.separateFolders, true);
+            scanDir(path, contents, dir.separateFolders);
         }
     }
     return contents;
@@ -291,13 +304,6 @@ void ConcertFileSearcher::addConcertsToGui(const QVector<Concert*>& concerts)
     }
 }
 
-/// Get a list of files in a directory
-QStringList ConcertFileSearcher::getFiles(mediaelch::DirectoryPath path)
-{
-    const auto& fileFilter = Settings::instance()->advanced()->concertFilters();
-    return fileFilter.files(path.dir());
-}
-
 void ConcertFileSearcher::abort()
 {
     m_aborted = true;
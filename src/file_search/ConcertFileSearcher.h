@@ -41,11 +41,5 @@ private:
     void setupDatabaseConcerts(const QVector<Concert*>& concerts);
     void addConcertsToGui(const QVector<Concert*>& concerts);
 
-    void scanDir(QString startPath,
-        QString path,
-        QVector<QStringList>& contents,
-        bool separateFolders = false,
-        bool firstScan = false);
-
-    QStringList getFiles(mediaelch::DirectoryPath path);
+    void scanDir(QString path, QVector<QStringList>& contents, bool separateFolders);
 };
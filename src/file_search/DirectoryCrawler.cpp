@@ -0,0 +1,150 @@
+#include "file_search/DirectoryCrawler.h"
+
+#include "utils/Meta.h"
+
+#include <QMutexLocker>
+#include <QPair>
+#include <QRunnable>
+#include <QThread>
+#include <QVector>
+#include <QtGlobal>
+
+namespace mediaelch {
+
+class DirectoryCrawler::Worker : public QRunnable
+{
+public:
+    explicit Worker(DirectoryCrawler& crawler) : m_crawler{crawler} {}
+    void run() override { m_crawler.work(); }
+
+private:
+    DirectoryCrawler& m_crawler;
+};
+
+DirectoryCrawler::DirectoryCrawler(QStringList nameFilters, QDir::Filters filters, int maxThreadCount) :
+    m_nameFilters{std::move(nameFilters)}, m_filters{filters}
+{
+    m_pool.setMaxThreadCount(qMax(1, maxThreadCount));
+}
+
+void DirectoryCrawler::setDescendFilter(DescendFilter filter)
+{
+    m_descendFilter = std::move(filter);
+}
+
+void DirectoryCrawler::crawl(const QString& root, const ListingCallback& callback)
+{
+    m_callback = callback;
+    m_aborted.store(false);
+
+    QMutexLocker locker(&m_mutex);
+    m_queue.clear();
+    m_visitedLinks.clear();
+    m_active = 0;
+    m_queue.enqueue({root, 0});
+    locker.unlock();
+
+    for (int i = 0; i < m_pool.maxThreadCount(); ++i) {
+        m_pool.start(new Worker(*this));
+    }
+    m_pool.waitForDone();
+    m_callback = nullptr;
+}
+
+void DirectoryCrawler::abort()
+{
+    m_aborted.store(true);
+    QMutexLocker locker(&m_mutex);
+    m_queueChanged.wakeAll();
+}
+
+bool DirectoryCrawler::isAborted() const
+{
+    return m_aborted.load();
+}
+
+int DirectoryCrawler::defaultThreadCount()
+{
+    return qBound(2, QThread::idealThreadCount() * 2, 16);
+}
+
+void DirectoryCrawler::work()
+{
+    while (true) {
+        QMutexLocker locker(&m_mutex);
+        while (m_queue.isEmpty() && m_active > 0 && !isAborted()) {
+            m_queueChanged.wait(&m_mutex);
+        }
+        if (isAborted() || m_queue.isEmpty()) {
+            // Either aborted or there is no pending directory and no other
+            // worker that may find new ones.
+            m_queueChanged.wakeAll();
+            return;
+        }
+        const QPair<QString, int> next = m_queue.dequeue();
+        ++m_active;
+        locker.unlock();
+
+        const DirectoryListing listing = listDirectory(next.first, next.second);
+
+        QVector<QPair<QString, int>> subDirs;
+        for (const QFileInfo& dir : listing.directories) {
+            if (!m_descendFilter || m_descendFilter(dir, listing.depth)) {
+                if (!dir.isSymLink() || isFirstVisit(dir)) {
+                    subDirs.append({dir.filePath(), listing.depth + 1});
+                }
+            }
+        }
+
+        locker.relock();
+        for (const auto& subDir : asConst(subDirs)) {
+            m_queue.enqueue(subDir);
+        }
+        --m_active;
+        m_queueChanged.wakeAll();
+        locker.unlock();
+
+        if (!isAborted()) {
+            m_callback(listing);
+        }
+    }
+}
+
+DirectoryListing DirectoryCrawler::listDirectory(const QString& path, int depth) const
+{
+    DirectoryListing listing;
+    listing.path = path;
+    listing.depth = depth;
+
+    // Only read the directory once and filter by name ourselves; subdirectories
+    // must be found regardless of the name filters.
+    QDir dir(path);
+    dir.setSorting(QDir::Unsorted);
+    const QFileInfoList entries = dir.entryInfoList(QDir::AllEntries | QDir::NoDotAndDotDot | m_filters);
+    for (const QFileInfo& entry : entries) {
+        if (entry.isDir()) {
+            listing.directories.append(entry);
+        } else if (m_nameFilters.isEmpty() || QDir::match(m_nameFilters, entry.fileName())) {
+            listing.files.append(entry);
+        } else {
+            listing.otherFiles.append(entry);
+        }
+    }
+    return listing;
+}
+
+bool DirectoryCrawler::isFirstVisit(const QFileInfo& dir)
+{
+    const QString target = dir.canonicalFilePath();
+    if (target.isEmpty()) {
+        return false; // broken link
+    }
+    QMutexLocker locker(&m_mutex);
+    if (m_visitedLinks.contains(target)) {
+        return false;
+    }
+    m_visitedLinks.insert(target);
+    return true;
+}
+
+} // namespace mediaelch
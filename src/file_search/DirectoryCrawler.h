@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QPair>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <atomic>
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Entries of a single directory found by DirectoryCrawler.
+struct DirectoryListing
+{
+    /// \brief Path of the listed directory.
+    QString path;
+    /// \brief Depth of the directory; the crawled root directory has depth 0.
+    int depth = 0;
+    /// \brief Files in the directory that match the crawler's name filters.
+    QFileInfoList files;
+    /// \brief Files in the directory that don't match the name filters, e.g. NFO files or images.
+    QFileInfoList otherFiles;
+    /// \brief All subdirectories of the directory, regardless of name filters.
+    QFileInfoList directories;
+};
+
+/// \brief Walks a directory tree in parallel.
+///
+/// Directories are listed by a bounded number of worker threads.  Each worker
+/// takes the next pending directory from a shared queue, lists it and enqueues
+/// its subdirectories, so that network shares with high latency are read
+/// concurrently instead of one directory at a time.  Each listing is passed to
+/// a callback as soon as it is available.
+///
+/// Symbolic links to directories are followed, but each target is only
+/// visited once.
+///
+/// \par Example
+/// \code{cpp}
+///   DirectoryCrawler crawler(QStringList{"*.mkv"});
+///   crawler.crawl(path, [](const DirectoryListing& listing) {
+///       // Note: Called from worker threads in parallel!
+///   });
+/// \endcode
+class DirectoryCrawler
+{
+public:
+    /// \brief Decides whether a subdirectory is crawled.
+    /// \param dir Subdirectory that was found.
+    /// \param depth Depth of the directory containing dir.
+    using DescendFilter = std::function<bool(const QFileInfo& dir, int depth)>;
+    /// \brief Called for each directory listing.  Is called in parallel from worker threads.
+    using ListingCallback = std::function<void(const DirectoryListing& listing)>;
+
+    /// \param nameFilters Wildcards that files must match, e.g. "*.mkv".  An empty
+    ///                    list matches all files.  Case insensitive.
+    /// \param filters Additional filters for QDir, e.g. QDir::System or QDir::Hidden.
+    explicit DirectoryCrawler(QStringList nameFilters = {},
+        QDir::Filters filters = QDir::NoFilter,
+        int maxThreadCount = defaultThreadCount());
+
+    /// \brief Only crawl subdirectories for which the filter returns true.
+    /// \details The filter is called in parallel from worker threads.
+    void setDescendFilter(DescendFilter filter);
+
+    /// \brief Crawl the given directory tree and call callback for each directory.
+    /// \details Blocks until all directories are listed or until abort() is called.
+    void crawl(const QString& root, const ListingCallback& callback);
+
+    /// \brief Stop crawling.  Directories that are currently listed are still reported.
+    /// \details Thread safe.  May be called from inside the listing callback.
+    void abort();
+    bool isAborted() const;
+
+    /// \brief Default number of threads; higher than the number of cores because
+    ///        crawling is mostly waiting for I/O.
+    static int defaultThreadCount();
+
+private:
+    class Worker;
+
+    void work();
+    DirectoryListing listDirectory(const QString& path, int depth) const;
+    bool isFirstVisit(const QFileInfo& dir);
+
+private:
+    QStringList m_nameFilters;
+    QDir::Filters m_filters;
+    DescendFilter m_descendFilter;
+    ListingCallback m_callback;
+    QThreadPool m_pool;
+
+    QMutex m_mutex;
+    QWaitCondition m_queueChanged;
+    /// \brief Pending directories with their depth.
+    QQueue<QPair<QString, int>> m_queue;
+    /// \brief Number of directories that are currently listed.
+    int m_active = 0;
+    /// \brief Canonical paths of visited symbolic link targets.
+    QSet<QString> m_visitedLinks;
+    std::atomic_bool m_aborted{false};
+};
+
+} // namespace mediaelch
@@ -2,16 +2,20 @@
 
 #include "data/tv_show/TvShow.h"
 #include "data/tv_show/TvShowEpisode.h"
+#include "file_search/DirectoryCrawler.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "globals/MessageIds.h"
 
 #include <QApplication>
 #include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSqlError>
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QtConcurrent/QtConcurrentMap>
+#include <algorithm>
 
 TvShowFileSearcher::TvShowFileSearcher(QObject* parent) :
     QObject(parent), m_progressMessageId{Constants::TvShowSearcherProgressMessageId}, m_aborted{false}
@@ -57,9 +61,10 @@ void TvShowFileSearcher::reload(bool force)
     int episodeCounter = 0;
     const int episodeSum = database().episodeCount();
 
-    QVector<TvShow*> dbShows = getShowsFromDatabase(force);
+    QHash<int, QVector<TvShowEpisode*>> dbEpisodes;
+    QVector<TvShow*> dbShows = getShowsFromDatabase(force, dbEpisodes);
     setupShows(files, episodeCounter, episodeSum);
-    setupShowsFromDatabase(dbShows, episodeCounter, episodeSum);
+    setupShowsFromDatabase(dbShows, dbEpisodes, episodeCounter, episodeSum);
 
     for (TvShow* show : Manager::instance()->tvShowModel()->tvShows()) {
         if (show->showMissingEpisodes()) {
@@ -144,8 +149,11 @@ void TvShowFileSearcher::reloadEpisodes(const mediaelch::DirectoryPath& showDir)
 
     QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
 
+    database().transaction();
+    database().addEpisodes(episodes, path, show->databaseId());
+    database().commit();
+
     for (TvShowEpisode* episode : episodes) {
-        database().add(episode, path, show->databaseId());
         show->addEpisode(episode);
         emit progress(++episodeCounter, episodeSum, m_progressMessageId);
         QApplication::processEvents();
@@ -168,21 +176,7 @@ TvShowEpisode* TvShowFileSearcher::reloadEpisodeData(TvShowEpisode* episode)
  */
 void TvShowFileSearcher::getTvShows(const mediaelch::DirectoryPath& path, QMap<QString, QVector<QStringList>>& contents)
 {
-    QDir dir(path.toString());
-    QStringList tvShows = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
-    for (const QString& cDir : tvShows) {
-        if (m_aborted) {
-            return;
-        }
-
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
-        }
-
-        QVector<QStringList> tvShowContents;
-        scanTvShowDir(path, path.subDir(cDir), tvShowContents);
-        contents.insert((dir.path() + '/' + cDir), tvShowContents);
-    }
+    crawlTvShowDir(path, 1, contents);
 }
 
 /**
@@ -198,94 +192,145 @@ void TvShowFileSearcher::scanTvShowDir(const mediaelch::DirectoryPath& startPath
 {
     emit currentDir(path.toString().mid(startPath.toString().length()));
 
-    QDir dir(path.toString());
-    for (const QString& cDir : dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-        if (m_aborted) {
-            return;
+    QMap<QString, QVector<QStringList>> showContents;
+    crawlTvShowDir(path, 0, showContents);
+    contents.append(showContents.value(path.toString()));
+}
+
+/// \brief Crawls the given directory in parallel and collects all episode files.
+/// \param showDepth Depth of TV show directories relative to path, i.e. 0 if
+///                  path is a TV show directory and 1 if it contains TV shows.
+/// \param contents Map of TV show directories and their episode files.
+void TvShowFileSearcher::crawlTvShowDir(const mediaelch::DirectoryPath& path,
+    int showDepth,
+    QMap<QString, QVector<QStringList>>& contents)
+{
+    const QString rootPath = path.toString();
+    const mediaelch::FileFilter& fileFilter = Settings::instance()->advanced()->tvShowFilters();
+    if (!fileFilter.hasFilter()) {
+        return;
+    }
+
+    QMutex mutex;
+    // Returns the TV show directory that the given directory belongs to.
+    const auto showDirOf = [&](const QString& dir) -> QString {
+        if (showDepth == 0) {
+            return rootPath;
         }
+        return rootPath + '/' + dir.mid(rootPath.length() + 1).section('/', 0, 0);
+    };
+    const auto addEpisode = [&](const QString& dir, const QStringList& files) {
+        QMutexLocker locker(&mutex);
+        contents[showDirOf(dir)].append(files);
+    };
 
-        if (Settings::instance()->advanced()->isFolderExcluded(cDir)) {
-            continue;
+    mediaelch::DirectoryCrawler crawler(fileFilter.filters(), QDir::System);
+    crawler.setDescendFilter([&](const QFileInfo& dirInfo, int depth) -> bool {
+        const QString cDir = dirInfo.fileName();
+        if (m_aborted || Settings::instance()->advanced()->isFolderExcluded(cDir)) {
+            return false;
+        }
+
+        if (depth < showDepth) {
+            // TV show directory: Ensure that it is listed even if it has no episodes.
+            QMutexLocker locker(&mutex);
+            contents.insert(dirInfo.filePath(), {});
+            return true;
         }
 
         // Skip "Extras" folder
         if (QString::compare(cDir, "Extras", Qt::CaseInsensitive) == 0
             || QString::compare(cDir, ".actors", Qt::CaseInsensitive) == 0
             || QString::compare(cDir, "extrafanarts", Qt::CaseInsensitive) == 0) {
-            continue;
+            return false;
         }
 
+        const QString dirPath = dirInfo.filePath();
+        const mediaelch::DirectoryPath subDir(dirPath);
+
         // Handle DVD
-        if (helper::isDvd(path.subDir(cDir))) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/VIDEO_TS/VIDEO_TS.IFO"));
-            continue;
+        if (helper::isDvd(subDir)) {
+            addEpisode(dirInfo.path(), {dirPath + "/VIDEO_TS/VIDEO_TS.IFO"});
+            return false;
         }
-        if (helper::isDvd(path.subDir(cDir), true)) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/VIDEO_TS.IFO"));
-            continue;
+        if (helper::isDvd(subDir, true)) {
+            addEpisode(dirInfo.path(), {dirPath + "/VIDEO_TS.IFO"});
+            return false;
         }
 
         // Handle BluRay
-        if (helper::isBluRay(path.subDir(cDir))) {
-            contents.append(QStringList() << (path.toString() + "/" + cDir + "/BDMV/index.bdmv"));
-            continue;
-        }
-        scanTvShowDir(startPath, path.subDir(cDir), contents);
-    }
-
-    QStringList files;
-    QStringList entries = getFiles(path);
-    for (const QString& file : entries) {
-        if (Settings::instance()->advanced()->isFileExcluded(file)) {
-            continue;
-        }
-        // Skip Trailers and Sample files
-        if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
-            continue;
+        if (helper::isBluRay(subDir)) {
+            addEpisode(dirInfo.path(), {dirPath + "/BDMV/index.bdmv"});
+            return false;
         }
-        files.append(file);
-    }
-    files.sort();
+        return true;
+    });
 
-    QRegularExpression rx("((?:part|cd)[\\s_]*)(\\d+)", QRegularExpression::CaseInsensitiveOption);
-    for (elch_ssize_t i = 0, n = files.size(); i < n; i++) {
+    crawler.crawl(rootPath, [&](const mediaelch::DirectoryListing& listing) {
+        // Note: This lambda is called in parallel!
         if (m_aborted) {
+            crawler.abort();
+            return;
+        }
+        if (listing.depth < showDepth) {
             return;
         }
+        if (listing.depth == showDepth) {
+            emit currentDir(listing.path.mid(rootPath.length()));
+        }
 
-        QStringList tvShowFiles;
-        QString file = files.at(i);
-        if (file.isEmpty()) {
-            continue;
+        QStringList files;
+        for (const QFileInfo& fileInfo : listing.files) {
+            const QString file = fileInfo.fileName();
+            if (Settings::instance()->advanced()->isFileExcluded(file)) {
+                continue;
+            }
+            // Skip Trailers and Sample files
+            if (file.contains("-trailer", Qt::CaseInsensitive) || file.contains("-sample", Qt::CaseInsensitive)) {
+                continue;
+            }
+            files.append(file);
         }
+        files.sort();
 
-        tvShowFiles << (path.toString() + '/' + file);
+        const QString dirPath = listing.path;
+        static const QRegularExpression rx("((?:part|cd)[\\s_]*)(\\d+)", QRegularExpression::CaseInsensitiveOption);
+        for (elch_ssize_t i = 0, n = files.size(); i < n; i++) {
+            QStringList tvShowFiles;
+            QString file = files.at(i);
+            if (file.isEmpty()) {
+                continue;
+            }
 
-        QRegularExpressionMatch match = rx.match(file);
-        elch_ssize_t pos = match.capturedStart(0);
-        if (pos != -1) {
-            QString left = file.left(pos) + match.captured(1);
-            QString right = file.mid(pos + match.captured(1).size() + match.captured(2).size());
-            for (int x = 0; x < n; x++) {
-                QString subFile = files.at(x);
-                if (subFile != file) {
-                    if (subFile.startsWith(left) && subFile.endsWith(right)) {
-                        tvShowFiles << (path.toString() + '/' + subFile);
-                        files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
+            tvShowFiles << (dirPath + '/' + file);
+
+            QRegularExpressionMatch match = rx.match(file);
+            elch_ssize_t pos = match.capturedStart(0);
+            if (pos != -1) {
+                QString left = file.left(pos) + match.captured(1);
+                QString right = file.mid(pos + match.captured(1).size() + match.captured(2).size());
+                for (int x = 0; x < n; x++) {
+                    QString subFile = files.at(x);
+                    if (subFile != file) {
+                        if (subFile.startsWith(left) && subFile.endsWith(right)) {
+                            tvShowFiles << (dirPath + '/' + subFile);
+                            files[x] = ""; // set an empty file name, this way we can skip this file in the main loop
+                        }
                     }
                 }
             }
+            if (tvShowFiles.count() > 0) {
+                addEpisode(dirPath, tvShowFiles);
+            }
         }
-        if (tvShowFiles.count() > 0) {
-            contents.append(tvShowFiles);
-        }
-    }
-}
+    });
 
-/// Get a list of files in a directory
-QStringList TvShowFileSearcher::getFiles(const mediaelch::DirectoryPath& path)
-{
-    return Settings::instance()->advanced()->tvShowFilters().files(QDir(path.toString()));
+    // Directories are crawled in parallel; sort episodes to get a stable order.
+    for (QVector<QStringList>& episodes : contents) {
+        std::sort(episodes.begin(), episodes.end(), [](const QStringList& lhs, const QStringList& rhs) {
+            return lhs.first() < rhs.first();
+        });
+    }
 }
 
 void TvShowFileSearcher::abort()
@@ -313,30 +358,19 @@ SeasonNumber TvShowFileSearcher::getSeasonNumber(QStringList files)
         }
     }
 
-    QRegularExpression rx(R"(S(\d+)[ ._-]?E)", QRegularExpression::CaseInsensitiveOption);
-    QRegularExpressionMatch match;
-
-    match = rx.match(filename);
-    if (match.hasMatch()) {
-        return SeasonNumber(match.captured(1).toInt());
-    }
-
-    rx.setPattern("(\\d+)?x(\\d+)");
-    match = rx.match(filename);
-    if (match.hasMatch()) {
-        return SeasonNumber(match.captured(1).toInt());
-    }
-
-    rx.setPattern("(\\d+).(\\d){2,4}");
-    match = rx.match(filename);
-    if (match.hasMatch()) {
-        return SeasonNumber(match.captured(1).toInt());
-    }
+    // The first capture group is the season number.
+    static const QVector<QRegularExpression> patterns{
+        QRegularExpression(R"(S(\d+)[ ._-]?E)", QRegularExpression::CaseInsensitiveOption),
+        QRegularExpression("(\\d+)?x(\\d+)", QRegularExpression::CaseInsensitiveOption),
+        QRegularExpression("(\\d+).(\\d){2,4}", QRegularExpression::CaseInsensitiveOption),
+        QRegularExpression("Season[ ._]?(\\d+)[ ._]?Episode", QRegularExpression::CaseInsensitiveOption),
+    };
 
-    rx.setPattern("Season[ ._]?(\\d+)[ ._]?Episode");
-    match = rx.match(filename);
-    if (match.hasMatch()) {
-        return SeasonNumber(match.captured(1).toInt());
+    for (const QRegularExpression& rx : patterns) {
+        const QRegularExpressionMatch match = rx.match(filename);
+        if (match.hasMatch()) {
+            return SeasonNumber(match.captured(1).toInt());
+        }
     }
 
     // Default if no valid season could be parsed.
@@ -368,9 +402,7 @@ QVector<EpisodeNumber> TvShowFileSearcher::getEpisodeNumbers(QStringList files)
 
     /// Scans a given filename for a given pattern.
     /// If mayBeAmbiguous is true, we apply a heuristic to avoid matching the video's resolution
-    auto scanWithPattern = [&](const QString& pattern, bool mayBeAmbiguous) -> bool {
-        QRegularExpression rx(pattern, QRegularExpression::CaseInsensitiveOption);
-
+    auto scanWithPattern = [&](const QRegularExpression& rx, bool mayBeAmbiguous) -> bool {
         QRegularExpressionMatchIterator matches = rx.globalMatch(filename);
 
         elch_ssize_t lastMatchEnd = -1;
@@ -394,13 +426,14 @@ QVector<EpisodeNumber> TvShowFileSearcher::getEpisodeNumbers(QStringList files)
         // To avoid false positives, we use a positive lookahead.
         // For example: "S01E01E02E03 - Name.mov"
         if (episodes.count() == 1) {
-            rx.setPattern(R"([-_EeXx]+(\d+)(?=$|[ -._sEeXx]))");
+            static const QRegularExpression multiEpisodeRx(
+                R"([-_EeXx]+(\d+)(?=$|[ -._sEeXx]))", QRegularExpression::CaseInsensitiveOption);
 
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-            matches = rx.globalMatch(
+            matches = multiEpisodeRx.globalMatch(
                 filename, lastMatchEnd, QRegularExpression::NormalMatch, QRegularExpression::AnchoredMatchOption);
 #else
-            matches = rx.globalMatch(
+            matches = multiEpisodeRx.globalMatch(
                 filename, lastMatchEnd, QRegularExpression::NormalMatch, QRegularExpression::AnchorAtOffsetMatchOption);
 #endif
 
@@ -413,15 +446,17 @@ QVector<EpisodeNumber> TvShowFileSearcher::getEpisodeNumbers(QStringList files)
 
     struct EpisodeNumberPattern
     {
-        QString regex;
+        QRegularExpression regex;
         bool mayBeAmbiguous = false;
     };
 
-    QVector<EpisodeNumberPattern> patterns{{R"(S(\d+)[ ._-]?E(\d+))", false},
-        {R"(S(\d+)[ ._-]?EP(\d+))", false},
-        {R"(Season[ ._-]?(\d+)[._ -]?Episode[ ._-]?(\d+))", false},
-        {R"((\d+)x(\d+))", true},
-        {R"((\d+).(\d){2,4})", true}};
+    // See getSeasonNumber() for why these are static.
+    constexpr auto ci = QRegularExpression::CaseInsensitiveOption;
+    static const QVector<EpisodeNumberPattern> patterns{{QRegularExpression(R"(S(\d+)[ ._-]?E(\d+))", ci), false},
+        {QRegularExpression(R"(S(\d+)[ ._-]?EP(\d+))", ci), false},
+        {QRegularExpression(R"(Season[ ._-]?(\d+)[._ -]?Episode[ ._-]?(\d+))", ci), false},
+        {QRegularExpression(R"((\d+)x(\d+))", ci), true},
+        {QRegularExpression(R"((\d+).(\d){2,4})", ci), true}};
 
     for (const auto& pattern : patterns) {
         if (scanWithPattern(pattern.regex, pattern.mayBeAmbiguous)) {
@@ -455,16 +490,28 @@ void TvShowFileSearcher::clearOldTvShows(bool forceClear)
     }
 }
 
-void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int episodeCounter, int episodeSum)
+void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows,
+    QHash<int, QVector<TvShowEpisode*>>& dbEpisodes,
+    int episodeCounter,
+    int episodeSum)
 {
+    // Episodes of shows that are not set up are not used anymore.
+    const auto deleteRemainingEpisodes = [&dbEpisodes]() {
+        for (const QVector<TvShowEpisode*>& episodes : asConst(dbEpisodes)) {
+            qDeleteAll(episodes);
+        }
+        dbEpisodes.clear();
+    };
+
     for (TvShow* show : dbShows) {
         if (m_aborted) {
+            deleteRemainingEpisodes();
             return;
         }
 
         show->loadData(Manager::instance()->mediaCenterInterfaceTvShow(), false);
 
-        QVector<TvShowEpisode*> episodes = database().episodes(show->databaseId());
+        QVector<TvShowEpisode*> episodes = dbEpisodes.take(show->databaseId().toInt());
         QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::loadEpisodeData);
         for (TvShowEpisode* episode : episodes) {
             if (episode == nullptr) {
@@ -480,6 +527,8 @@ void TvShowFileSearcher::setupShowsFromDatabase(QVector<TvShow*>& dbShows, int e
 
         Manager::instance()->tvShowModel()->appendShow(show);
     }
+
+    deleteRemainingEpisodes();
 }
 
 void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& contents, int& episodeCounter, int episodeSum)
@@ -491,10 +540,14 @@ void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& content
     }
     it.toFront();
 
+    // All shows and episodes are written in one transaction; this is a lot
+    // faster than committing each show on its own.
+    database().transaction();
+
     // Setup shows
     while (it.hasNext()) {
         if (m_aborted) {
-            return;
+            break;
         }
 
         it.next();
@@ -520,7 +573,6 @@ void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& content
         emit currentDir(show->title());
         database().add(show, path);
 
-        database().transaction();
         QVector<TvShowEpisode*> episodes;
 
         // Setup episodes list
@@ -538,17 +590,18 @@ void TvShowFileSearcher::setupShows(QMap<QString, QVector<QStringList>>& content
         // Load episodes data
         QtConcurrent::blockingMapped(episodes, TvShowFileSearcher::reloadEpisodeData);
 
+        database().addEpisodes(episodes, path, show->databaseId());
+
         // Add episodes to model
         for (TvShowEpisode* episode : asConst(episodes)) {
-            database().add(episode, path, show->databaseId());
             show->addEpisode(episode);
             emit progress(++episodeCounter, episodeSum, m_progressMessageId);
         }
 
-        database().commit();
         Manager::instance()->tvShowModel()->appendShow(show);
     }
 
+    database().commit();
     emit currentDir("");
 }
 
@@ -580,7 +633,8 @@ QMap<QString, QVector<QStringList>> TvShowFileSearcher::readTvShowContent(bool f
 }
 
 
-QVector<TvShow*> TvShowFileSearcher::getShowsFromDatabase(bool forceReload)
+QVector<TvShow*> TvShowFileSearcher::getShowsFromDatabase(bool forceReload,
+    QHash<int, QVector<TvShowEpisode*>>& episodes)
 {
     if (forceReload) {
         return {};
@@ -597,6 +651,12 @@ QVector<TvShow*> TvShowFileSearcher::getShowsFromDatabase(bool forceReload)
         QVector<TvShow*> showsFromDatabase = database().showsInDirectory(mediaelch::DirectoryPath(dir.path));
         if (!showsFromDatabase.isEmpty()) {
             dbShows.append(showsFromDatabase);
+            // Load all episodes of the directory at once instead of one query per show.
+            const QHash<int, QVector<TvShowEpisode*>> dirEpisodes =
+                database().episodesInDirectory(mediaelch::DirectoryPath(dir.path));
+            for (auto it = dirEpisodes.cbegin(); it != dirEpisodes.cend(); ++it) {
+                episodes[it.key()].append(it.value());
+            }
         }
     }
     return dbShows;
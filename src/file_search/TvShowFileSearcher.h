@@ -4,6 +4,7 @@
 #include "media/Path.h"
 
 #include <QDir>
+#include <QHash>
 #include <QObject>
 
 class Database;
@@ -37,7 +38,9 @@ private:
     void scanTvShowDir(const mediaelch::DirectoryPath& startPath,
         const mediaelch::DirectoryPath& path,
         QVector<QStringList>& contents);
-    QStringList getFiles(const mediaelch::DirectoryPath& path);
+    void crawlTvShowDir(const mediaelch::DirectoryPath& path,
+        int showDepth,
+        QMap<QString, QVector<QStringList>>& contents);
     bool m_aborted;
 
 private:
@@ -46,7 +49,11 @@ private:
     void clearOldTvShows(bool forceClear);
     /// \brief Get a map of TV show paths and their respective files in the show folder.
     QMap<QString, QVector<QStringList>> readTvShowContent(bool forceReload);
-    QVector<TvShow*> getShowsFromDatabase(bool forceReload);
+    /// \brief Get all TV shows from the database as well as their episodes, keyed by show ID.
+    QVector<TvShow*> getShowsFromDatabase(bool forceReload, QHash<int, QVector<TvShowEpisode*>>& episodes);
     void setupShows(QMap<QString, QVector<QStringList>>& contents, int& episodeCounter, int episodeSum);
-    void setupShowsFromDatabase(QVector<TvShow*>& dbShows, int episodeCounter, int episodeSum);
+    void setupShowsFromDatabase(QVector<TvShow*>& dbShows,
+        QHash<int, QVector<TvShowEpisode*>>& dbEpisodes,
+        int episodeCounter,
+        int episodeSum);
 };
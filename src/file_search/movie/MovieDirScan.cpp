@@ -92,8 +92,8 @@ void MovieDirScan::scanDir(QString startPath,
     }
 
     /* detect movies with multiple files*/
-    QRegularExpression rx("([\\-_\\s\\.\\(\\)]+((a|b|c|d|e|f)|((part|cd|xvid)"
-                          "[\\-_\\s\\.\\(\\)]*\\d+))[\\-_\\s\\.\\(\\)]+)",
+    static const QRegularExpression rx("([\\-_\\s\\.\\(\\)]+((a|b|c|d|e|f)|((part|cd|xvid)"
+                                       "[\\-_\\s\\.\\(\\)]*\\d+))[\\-_\\s\\.\\(\\)]+)",
         QRegularExpression::CaseInsensitiveOption);
     for (elch_ssize_t i = 0, n = files.size(); i < n; i++) {
         if (m_aborted) {
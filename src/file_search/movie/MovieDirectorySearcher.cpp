@@ -1,17 +1,32 @@
 #include "MovieDirectorySearcher.h"
 
 #include "database/Database.h"
+#include "file_search/DirectoryCrawler.h"
 #include "globals/Manager.h"
 #include "media/FilenameUtils.h"
 
-#include "media/FilenameUtils.h"
-
 #include <QMutexLocker>
 #include <QtConcurrent>
+#include <algorithm>
 #include <memory>
 
 namespace mediaelch {
 
+/// \brief Number of movies that are stored in the database at once while loading from disk.
+static constexpr int MOVIE_BATCH_SIZE = 500;
+
+/// \brief Movies from the database without stored list data, which must be parsed before they can be shown.
+static QVector<Movie*> moviesWithoutListData(const QVector<Movie*>& movies)
+{
+    QVector<Movie*> result;
+    for (Movie* movie : movies) {
+        if (!movie->controller()->infoLoaded()) {
+            result.append(movie);
+        }
+    }
+    return result;
+}
+
 MovieLoader::MovieLoader(MovieLoaderStore* store, QObject* parent) : worker::Job(parent), m_store{store}
 {
     // Note: Because instances of this class are run in another thread with
@@ -31,6 +46,12 @@ void MovieLoaderStore::addMovie(Movie* movie)
 
     QMutexLocker locker(&m_lock);
     m_movies.append(movie);
+    const bool isBatchFull = m_batchSize > 0 && m_movies.size() >= m_batchSize;
+    locker.unlock();
+
+    if (isBatchFull) {
+        emit batchAvailable();
+    }
 }
 
 void MovieLoaderStore::addMovies(const QVector<Movie*>& movies)
@@ -43,6 +64,12 @@ void MovieLoaderStore::addMovies(const QVector<Movie*>& movies)
 
     QMutexLocker locker(&m_lock);
     m_movies.append(movies);
+    const bool isBatchFull = m_batchSize > 0 && m_movies.size() >= m_batchSize;
+    locker.unlock();
+
+    if (isBatchFull) {
+        emit batchAvailable();
+    }
 }
 
 QVector<Movie*> MovieLoaderStore::takeAll(QObject* parent)
@@ -65,6 +92,11 @@ void MovieLoaderStore::clear()
     m_movies.clear();
 }
 
+void MovieLoaderStore::setBatchSize(int batchSize)
+{
+    m_batchSize = batchSize;
+}
+
 MovieDiskLoader::MovieDiskLoader(SettingsDir dir, MovieLoaderStore& store, FileFilter filter, QObject* parent) :
     MovieLoader(&store, parent), m_dir{std::move(dir)}, m_filter{std::move(filter)}, m_db{Database::newConnection(this)}
 {
@@ -74,6 +106,8 @@ MovieDiskLoader::~MovieDiskLoader()
 {
     qDeleteAll(m_movies);
     m_movies.clear();
+    qDeleteAll(m_cachedMovies);
+    m_cachedMovies.clear();
     delete m_db;
 }
 
@@ -98,17 +132,42 @@ void MovieDiskLoader::doStart()
         return;
     }
 
+    reuseUnchangedDirectories();
+
+    if (isAborted()) {
+        return;
+    }
+
+    // Movies of unchanged directories are already stored in the database.
+    m_store->addMovies(m_cachedMovies);
+    m_cachedMovies.clear();
+
     m_processed = 0;
     m_approxTotal = m_dir.separateFolders ? m_contents.size() : 0;
     emitPercent(m_processed, m_approxTotal);
 
     qCDebug(c_movie) << "[Movie] Creating movies for directory:" << QDir::toNativeSeparators(m_dir.path.path());
 
-    // Can be blocking as this class should NOT be run in the GUI thread and
-    // emitting signals is thread safe.
-    QtConcurrent::blockingMap(m_contents, [this](const QStringList& files) { createMovie(files); });
+    // Movies are created in parallel.  Meanwhile, store created movies in batches
+    // so that they are shown before all directories are processed.
+    QFuture<void> future = QtConcurrent::map(m_contents, [this](const QStringList& files) { createMovie(files); });
+    while (!future.isFinished()) {
+        QMutexLocker lock(&m_mutex);
+        if (m_movies.size() < MOVIE_BATCH_SIZE) {
+            m_batchReady.wait(&m_mutex, 250);
+        }
+        lock.unlock();
+
+        if (isAborted()) {
+            future.cancel();
+            future.waitForFinished();
+            return;
+        }
+        storeAndAddToDatabase();
+    }
 
     storeAndAddToDatabase();
+    storeDirectoryStates();
 
     if (!isAborted()) {
         emitFinished();
@@ -123,67 +182,59 @@ bool MovieDiskLoader::doKill()
 
 void MovieDiskLoader::loadMovieContents()
 {
-    QDirIterator it(m_dir.path.path(),
-        m_filter.filters(),
-        QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files,
-        QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
-
-    QString lastDir;
-
-    while (it.hasNext()) {
+    DirectoryCrawler crawler(m_filter.filters());
+    crawler.crawl(m_dir.path.path(), [this, &crawler](const DirectoryListing& listing) {
+        // Note: This lambda is called in parallel!
         if (isAborted()) {
+            crawler.abort();
             return;
         }
-        it.next();
-
-        QString dirName = it.fileInfo().dir().dirName();
-        QString fileName = it.fileName(); // may actually be a directory name
-
-        const bool isFile = it.fileInfo().isFile();
-        const bool isDir = it.fileInfo().isDir();
-        bool isSpecialDir = false; // set to true for DVD or BluRay Structure
+        addDirectoryContents(listing);
+    });
+}
 
-        if (isFile && Settings::instance()->advanced()->isFileExcluded(fileName)) {
-            continue;
-        }
+void MovieDiskLoader::addDirectoryContents(const DirectoryListing& listing)
+{
+    const QString dirName = QFileInfo(listing.path).fileName();
 
-        // TODO: If there is a BluRay structure then the directory filter may not work
-        // because BDMV's parent directory is not listed.
-        if ((isDir && Settings::instance()->advanced()->isFolderExcluded(fileName))
-            || Settings::instance()->advanced()->isFolderExcluded(dirName)) {
-            continue;
-        }
+    // TODO: If there is a BluRay structure then the directory filter may not work
+    // because BDMV's parent directory is not listed.
+    if (Settings::instance()->advanced()->isFolderExcluded(dirName)) {
+        return;
+    }
 
-        // Skips Extras files
-        if (isFile
-            && (fileName.contains("-trailer", Qt::CaseInsensitive)            //
-                || fileName.contains("-sample", Qt::CaseInsensitive)          //
-                || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
-                || fileName.contains("-deleted", Qt::CaseInsensitive)         //
-                || fileName.contains("-featurette", Qt::CaseInsensitive)      //
-                || fileName.contains("-interview", Qt::CaseInsensitive)       //
-                || fileName.contains("-scene", Qt::CaseInsensitive)           //
-                || fileName.contains("-short", Qt::CaseInsensitive))) {
-            continue;
-        }
+    // Skip actors folder and all files inside it
+    // Skip extras folder and all files inside it
+    // Skip extra fanarts folder and all files inside it
+    // Skip extra thumbs folder and all files inside it
+    if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0
+        || QString::compare("extras", dirName, Qt::CaseInsensitive) == 0
+        || QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0
+        || QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0) {
+        return;
+    }
 
-        // Skip actors folder and all files inside it
-        if (QString::compare(".actors", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+    QStringList files;
+    QStringList bluRayDirectories;
+    QStringList dvdDirectories;
+    QHash<QString, QDateTime> lastModifications;
 
-        // Skip extras folder and all files inside it
-        if (QString::compare("extras", dirName, Qt::CaseInsensitive) == 0) {
-            continue;
-        }
+    for (const QFileInfo& fileInfo : listing.files) {
+        const QString fileName = fileInfo.fileName();
 
-        // Skip extra fanarts folder and all files inside it
-        if (QString::compare("extrafanart", dirName, Qt::CaseInsensitive) == 0) {
+        if (Settings::instance()->advanced()->isFileExcluded(fileName)) {
             continue;
         }
 
-        // Skip extra thumbs folder and all files inside it
-        if (QString::compare("extrathumbs", dirName, Qt::CaseInsensitive) == 0) {
+        // Skips Extras files
+        if (fileName.contains("-trailer", Qt::CaseInsensitive)            //
+            || fileName.contains("-sample", Qt::CaseInsensitive)          //
+            || fileName.contains("-behindthescenes", Qt::CaseInsensitive) //
+            || fileName.contains("-deleted", Qt::CaseInsensitive)         //
+            || fileName.contains("-featurette", Qt::CaseInsensitive)      //
+            || fileName.contains("-interview", Qt::CaseInsensitive)       //
+            || fileName.contains("-scene", Qt::CaseInsensitive)           //
+            || fileName.contains("-short", Qt::CaseInsensitive)) {
             continue;
         }
 
@@ -193,39 +244,127 @@ void MovieDiskLoader::loadMovieContents()
             continue;
         }
 
-        if (isFile && QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
-            QDir bluRayDir(it.fileInfo().dir());
+        if (QString::compare("index.bdmv", fileName, Qt::CaseInsensitive) == 0) {
+            QDir bluRayDir(fileInfo.dir());
             if (QString::compare(bluRayDir.dirName(), "BDMV", Qt::CaseInsensitive) == 0) {
                 bluRayDir.cdUp();
             }
-            m_bluRayDirectories << bluRayDir.path();
-            isSpecialDir = true;
+            bluRayDirectories << bluRayDir.path();
         }
         if (QString::compare("VIDEO_TS.IFO", fileName, Qt::CaseInsensitive) == 0) {
-            QDir videoDir(it.fileInfo().dir());
+            QDir videoDir(fileInfo.dir());
             if (QString::compare(videoDir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
                 videoDir.cdUp();
             }
-            m_dvdDirectories << videoDir.path();
-            isSpecialDir = true;
+            dvdDirectories << videoDir.path();
         }
 
-        const QString dirPath = it.fileInfo().path();
-        if (!m_contents.contains(dirPath)) {
-            m_contents.insert(dirPath, {});
+        files.append(fileInfo.filePath());
+        lastModifications.insert(fileInfo.filePath(), fileInfo.lastModified());
+    }
+
+    // Not only movie files are relevant for detecting changes, but also NFO
+    // files, artwork and subtitles that may have been edited in place.
+    qint64 newestModification = QFileInfo(listing.path).lastModified().toMSecsSinceEpoch();
+    for (const QFileInfo& fileInfo : listing.files) {
+        newestModification = std::max(newestModification, fileInfo.lastModified().toMSecsSinceEpoch());
+    }
+    for (const QFileInfo& fileInfo : listing.otherFiles) {
+        newestModification = std::max(newestModification, fileInfo.lastModified().toMSecsSinceEpoch());
+    }
+
+    QMutexLocker locker(&m_mutex);
+    // Also stored for directories without movie files, because BluRay and DVD
+    // structures have their NFO files and artwork in the parent directory.
+    m_directoryModifications.insert(QDir::cleanPath(listing.path), newestModification);
+    if (files.isEmpty()) {
+        return;
+    }
+
+    m_contents.insert(QDir::cleanPath(listing.path), files);
+    for (auto it = lastModifications.cbegin(); it != lastModifications.cend(); ++it) {
+        m_lastModifications.insert(it.key(), it.value());
+    }
+    m_bluRayDirectories << bluRayDirectories;
+    m_dvdDirectories << dvdDirectories;
+    const int count = qsizetype_to_int(m_contents.count());
+    locker.unlock();
+
+    // TODO: Use SignalThrottler
+    if (count % 40 == 0) {
+        emit progressText(this, dirName);
+    }
+}
+
+void MovieDiskLoader::reuseUnchangedDirectories()
+{
+    const DirectoryPath path(m_dir.path);
+    const QHash<QString, MovieDirectoryState> oldStates = m_db->movieDirectoryStates(path);
+
+    m_directoryStates.clear();
+    m_directoryStates.reserve(m_contents.size());
+    for (auto it = m_contents.cbegin(); it != m_contents.cend(); ++it) {
+        MovieDirectoryState state;
+        state.dir = it.key();
+        state.lastModified = m_directoryModifications.value(it.key());
+        QDir dir(it.key());
+        if (QString::compare(dir.dirName(), "BDMV", Qt::CaseInsensitive) == 0
+            || QString::compare(dir.dirName(), "VIDEO_TS", Qt::CaseInsensitive) == 0) {
+            dir.cdUp();
+            state.lastModified =
+                std::max(state.lastModified, m_directoryModifications.value(QDir::cleanPath(dir.path())));
         }
-        if (isFile || isSpecialDir) {
-            m_contents[dirPath].append(it.filePath());
-            m_lastModifications.insert(it.filePath(), it.fileInfo().lastModified());
+        for (const QString& file : it.value()) {
+            state.files << QFileInfo(file).fileName();
         }
+        state.files.sort();
+        m_directoryStates.append(state);
+    }
 
-        if (dirName != lastDir) {
-            lastDir = dirName;
-            // TODO: Use SignalThrottler
-            if (m_contents.count() % 40 == 0) {
-                emit progressText(this, dirName);
-            }
+    // Group cached movies by the directory of their first file, which is the
+    // same directory that is used as key in m_contents.
+    QHash<QString, QVector<Movie*>> cachedMovies;
+    const QVector<Movie*> moviesFromDb = m_db->moviesInDirectory(path, nullptr);
+    for (Movie* movie : moviesFromDb) {
+        if (movie->files().isEmpty() || movie->inSeparateFolder() != m_dir.separateFolders) {
+            m_staleMovieIds.append(movie->databaseId());
+            delete movie;
+            continue;
+        }
+        cachedMovies[QDir::cleanPath(QFileInfo(movie->files().first().toString()).path())].append(movie);
+    }
+
+    for (const MovieDirectoryState& state : asConst(m_directoryStates)) {
+        const auto oldState = oldStates.constFind(state.dir);
+        if (oldState == oldStates.cend() || *oldState != state) {
+            continue;
         }
+        // Directories without movies from the database, e.g. BluRay "STREAM"
+        // directories, have not resulted in movies last time, either.
+        m_cachedMovies.append(cachedMovies.take(state.dir));
+        m_contents.remove(state.dir);
+    }
+
+    // All remaining movies belong to directories that changed or no longer exist.
+    for (const QVector<Movie*>& movies : asConst(cachedMovies)) {
+        for (Movie* movie : movies) {
+            m_staleMovieIds.append(movie->databaseId());
+        }
+        qDeleteAll(movies);
+    }
+
+    qCDebug(c_movie) << "[Movie] Reusing" << m_cachedMovies.size() << "movies from the database;" << m_contents.size()
+                     << "directories changed";
+
+    // Movies with stored list data are only parsed once they are opened.
+    const QVector<Movie*> moviesToParse = moviesWithoutListData(m_cachedMovies);
+    QtConcurrent::blockingMap(moviesToParse, [](Movie* movie) { //
+        movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
+    });
+    if (!moviesToParse.isEmpty()) {
+        m_db->transaction();
+        m_db->updateListData(moviesToParse);
+        m_db->commit();
     }
 }
 
@@ -285,7 +424,8 @@ void MovieDiskLoader::createMovie(QStringList files)
                 QStringList{"*.sub", "*.srt", "*.smi", "*.ssa"}, QDir::Files | QDir::NoDotAndDotDot);
             for (const QFileInfo& subFi : subFiles) {
                 QString subFileName = subFi.fileName().mid(mFi.completeBaseName().length() + 1);
-                QStringList parts = subFileName.split(QRegularExpression(R"(\s+|\-+|\.+)"));
+                static const QRegularExpression separatorRx(R"(\s+|\-+|\.+)");
+                QStringList parts = subFileName.split(separatorRx);
                 if (parts.isEmpty()) {
                     continue;
                 }
@@ -312,18 +452,7 @@ void MovieDiskLoader::createMovie(QStringList files)
             }
         }
 
-        // As this method is called in parallel, we may be in another thread.
-        movie->moveToThread(thread());
-
-        QMutexLocker lock(&m_mutex);
-        m_movies.append(movie);
-        lock.unlock();
-
-        emitPercent(++m_processed, m_approxTotal);
-        if (m_movies.size() % 40 == 0) {
-            // TODO: Use SignalThrottler
-            emit progressText(this, movie->name());
-        }
+        addCreatedMovie(movie);
 
     } else {
         QMap<QString, QStringList> stacked;
@@ -357,19 +486,28 @@ void MovieDiskLoader::createMovie(QStringList files)
             movie->setFileLastModified(m_lastModifications.value(it.value().at(0)));
             movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
 
-            // As this method is called in parallel, we may be in another thread.
-            movie->moveToThread(thread());
+            addCreatedMovie(movie);
+        }
+    }
+}
 
-            QMutexLocker lock(&m_mutex);
-            m_movies.append(movie);
-            lock.unlock();
+void MovieDiskLoader::addCreatedMovie(Movie* movie)
+{
+    // As this method is called in parallel, we may be in another thread.
+    movie->moveToThread(thread());
 
-            emitPercent(++m_processed, m_approxTotal);
-            if (m_movies.size() % 40 == 0) {
-                // TODO: Use SignalThrottler
-                emit progressText(this, movie->name());
-            }
-        }
+    QMutexLocker lock(&m_mutex);
+    m_movies.append(movie);
+    if (m_movies.size() >= MOVIE_BATCH_SIZE) {
+        m_batchReady.wakeOne();
+    }
+    lock.unlock();
+
+    const int processed = ++m_processed;
+    emitPercent(processed, m_approxTotal);
+    if (processed % 40 == 0) {
+        // TODO: Use SignalThrottler
+        emit progressText(this, movie->name());
     }
 }
 
@@ -379,19 +517,34 @@ void MovieDiskLoader::storeAndAddToDatabase()
         return;
     }
 
-    emitPercent(0, 0);
-    emit progressText(this, tr("Storing movies in database..."));
+    QMutexLocker lock(&m_mutex);
+    const QVector<Movie*> movies = std::move(m_movies);
+    m_movies = {};
+    lock.unlock();
 
+    if (movies.isEmpty() && m_staleMovieIds.isEmpty()) {
+        return;
+    }
+
+    // See also: Use https://stackoverflow.com/a/47473949/1603627
+    // We do this in just one thread.  Labels are read by addMovies().
     m_db->transaction();
-    for (Movie* movie : asConst(m_movies)) {
-        // See also: Use https://stackoverflow.com/a/47473949/1603627
-        // We do this in just one thread.
-        movie->setLabel(m_db->getLabel(movie->files()));
-        m_db->addMovie(movie, DirectoryPath(m_dir.path));
-        m_store->addMovie(movie);
+    m_db->removeMovies(m_staleMovieIds);
+    m_staleMovieIds.clear();
+    m_db->addMovies(movies, DirectoryPath(m_dir.path));
+    m_db->commit();
+
+    m_store->addMovies(movies);
+}
+
+void MovieDiskLoader::storeDirectoryStates()
+{
+    if (isAborted()) {
+        return;
     }
+    m_db->transaction();
+    m_db->setMovieDirectoryStates(DirectoryPath(m_dir.path), m_directoryStates);
     m_db->commit();
-    m_movies.clear();
 }
 
 void MovieDatabaseLoader::doStart()
@@ -402,11 +555,8 @@ void MovieDatabaseLoader::doStart()
     emitPercent(0, 0);
     emit progressText(this, "");
 
-    QVector<Movie*> movies;
-    {
-        std::unique_ptr<Database> db(Database::newConnection(this));
-        movies = db->moviesInDirectory(DirectoryPath(m_dir.path), this);
-    }
+    std::unique_ptr<Database> db(Database::newConnection(this));
+    const QVector<Movie*> movies = db->moviesInDirectory(DirectoryPath(m_dir.path), this);
     if (isAborted()) {
         return;
     }
@@ -415,21 +565,31 @@ void MovieDatabaseLoader::doStart()
         return;
     }
 
-    // Note, this takes less than a few seconds. No need to check whether we're aborted or not.
-    QtConcurrent::blockingMap(movies,
-        [](Movie* movie) { //
-            movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
-        });
-
-    if (isAborted()) {
-        return;
+    // Movies with stored list data are only parsed once they are opened.  All others, e.g. from
+    // older versions, are parsed in batches so that the first movies are shown while the rest
+    // is still parsed.  Their list data is stored for the next time.
+    const elch_ssize_t movieCount = movies.size();
+    for (elch_ssize_t i = 0; i < movieCount; i += MOVIE_BATCH_SIZE) {
+        if (isAborted()) {
+            return;
+        }
+        QVector<Movie*> batch = movies.mid(i, MOVIE_BATCH_SIZE);
+        const QVector<Movie*> moviesToParse = moviesWithoutListData(batch);
+        QtConcurrent::blockingMap(moviesToParse,
+            [](Movie* movie) { //
+                movie->controller()->loadData(Manager::instance()->mediaCenterInterface(), false, false);
+            });
+        if (!moviesToParse.isEmpty()) {
+            db->transaction();
+            db->updateListData(moviesToParse);
+            db->commit();
+        }
+        m_store->addMovies(batch);
+        emitPercent(i + batch.size(), movieCount);
     }
 
-    emitPercent(1, 1);
     emit progressText(this, "");
 
-    m_store->addMovies(movies);
-
     if (!isAborted()) {
         emitFinished();
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "database/Database.h"
 #include "globals/Globals.h"
 #include "media/FileFilter.h"
 #include "workers/Job.h"
@@ -11,13 +12,15 @@
 #include <QThread>
 #include <QTimer>
 #include <QVector>
+#include <QWaitCondition>
 #include <atomic>
 
 class Movie;
-class Database;
 
 namespace mediaelch {
 
+struct DirectoryListing;
+
 /// \brief   Thread safe store for movies.
 /// \details An instance of this class must be provided when using any MovieLoader.
 ///          All MovieLoaders move their newly created movies into a store.
@@ -35,9 +38,20 @@ public:
     /// \brief Clear and delete all stored movies.
     void clear();
 
+    /// \brief Emit batchAvailable() once at least this many movies are stored.
+    ///        A value of 0 disables the signal.
+    void setBatchSize(int batchSize);
+
+signals:
+    /// \brief   Emitted if at least batchSize() movies are stored.
+    /// \details Allows users to take movies while loaders are still running.
+    ///          May be emitted from other threads.
+    void batchAvailable();
+
 private:
     QVector<Movie*> m_movies;
     QMutex m_lock;
+    std::atomic_int m_batchSize{0};
 };
 
 /// \brief Interface for loading movies.
@@ -67,6 +81,10 @@ protected:
 QThread* createAutoDeleteThreadWithMovieLoader(MovieLoader* worker, QObject* threadParent);
 
 /// \brief Load movies from disk.
+/// \details Only directories that changed since the last scan are read again.
+///          Movies of all other directories are taken from the database.
+///          Changes are detected using the directory's movie file list and the
+///          modification times of the directory and all of its files.
 class MovieDiskLoader : public MovieLoader
 {
     Q_OBJECT
@@ -83,22 +101,41 @@ protected:
 
 private:
     void loadMovieContents();
+    /// \brief Add movie files of the given directory to m_contents and
+    ///        its modification time to m_directoryModifications. Thread safe.
+    void addDirectoryContents(const DirectoryListing& listing);
+    /// \brief Take movies of unchanged directories from the database.
+    /// \details Unchanged directories are removed from m_contents so that only
+    ///          changed directories are read from disk.
+    void reuseUnchangedDirectories();
     void createMovie(QStringList files);
-    /// \brief Store all loaded movies into the MovieLoaderStore and database.
+    /// \brief Add a newly created movie to m_movies. Thread safe.
+    void addCreatedMovie(Movie* movie);
+    /// \brief Store all movies created so far into the MovieLoaderStore and database.
     void storeAndAddToDatabase();
+    void storeDirectoryStates();
 
 private:
     SettingsDir m_dir;
     FileFilter m_filter;
     Database* m_db = nullptr;
     QMutex m_mutex;
+    /// \brief Woken if enough movies were created to store them as a batch.
+    QWaitCondition m_batchReady;
     QVector<Movie*> m_movies;
+    /// \brief Movies of unchanged directories; already stored in the database.
+    QVector<Movie*> m_cachedMovies;
+    /// \brief Movies in the database that belong to changed or removed directories.
+    QVector<mediaelch::DatabaseId> m_staleMovieIds;
+    QVector<MovieDirectoryState> m_directoryStates;
     std::atomic_bool m_aborted{false};
     std::atomic_int m_processed{0};
     int m_approxTotal{0};
 
     // TODO: Streamline, e.g. use one vector of directories with DiscType tags
     QHash<QString, QDateTime> m_lastModifications;
+    /// \brief Newest modification time (ms since epoch) of each directory and all of its files.
+    QHash<QString, qint64> m_directoryModifications;
     QStringList m_bluRayDirectories;
     QStringList m_dvdDirectories;
     QMap<QString, QStringList> m_contents;
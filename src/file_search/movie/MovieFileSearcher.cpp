@@ -15,6 +15,15 @@ namespace mediaelch {
 
 MovieFileSearcher::MovieFileSearcher(QObject* parent) : QObject(parent), m_store{new MovieLoaderStore(this)}
 {
+    // Show movies in batches so that users see the first ones without having
+    // to wait for the whole directory to be loaded.
+    m_store->setBatchSize(500);
+    connect(m_store,
+        &MovieLoaderStore::batchAvailable,
+        this,
+        &MovieFileSearcher::onMovieBatchAvailable,
+        Qt::QueuedConnection);
+
     connect(this, &MovieFileSearcher::started, this, [this]() { m_reloadTimer.start(); });
     connect(this, &MovieFileSearcher::finished, this, [this]() {
         qCDebug(c_movie) << "[Movies] Reloading took" << m_reloadTimer.elapsed() << "ms";
@@ -62,10 +71,9 @@ void MovieFileSearcher::reload(bool reloadFromDisk)
         return;
     }
 
-    if (reloadFromDisk) {
-        Manager::instance()->database()->clearAllMovies();
-    }
-
+    // Note: The database is not cleared when reloading from disk.  MovieDiskLoader
+    //       compares each directory's stored state with the current one, only
+    //       re-reads changed directories and removes outdated entries itself.
     Manager::instance()->movieModel()->clear();
 
     emit percentChanged(0.f, Constants::MovieFileSearcherProgressMessageId);
@@ -105,6 +113,15 @@ void MovieFileSearcher::onDirectoryLoaded(MovieLoader* job)
     }
 }
 
+void MovieFileSearcher::onMovieBatchAvailable()
+{
+    // The signal is queued; the user may have aborted in the meantime.
+    if (m_aborted || !m_running) {
+        return;
+    }
+    Manager::instance()->movieModel()->addMovies(m_store->takeAll(this));
+}
+
 void MovieFileSearcher::onPercentChange(worker::Job* job, float percent)
 {
     Q_UNUSED(job)
@@ -53,6 +53,8 @@ signals:
 
 private slots:
     void onDirectoryLoaded(MovieLoader* job);
+    /// \brief Add movies to the model while the current directory is still being loaded.
+    void onMovieBatchAvailable();
     void onPercentChange(worker::Job* job, float percent);
     void onProgressText(MovieLoader* job, QString text);
 
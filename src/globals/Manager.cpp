@@ -26,6 +26,7 @@ Manager::Manager(QObject* parent) : QObject(parent)
     m_concertFileSearcher = new ConcertFileSearcher(this);
     m_musicFileSearcher = new MusicFileSearcher(this);
     m_movieModel = new MovieModel(this);
+    m_movieDuplicates = new mediaelch::MovieDuplicateIndex(m_movieModel, this);
     m_tvShowModel = new TvShowModel(this);
     m_concertModel = new ConcertModel(this);
     m_musicModel = new MusicModel(this);
@@ -126,6 +127,12 @@ MovieModel* Manager::movieModel()
     return m_movieModel;
 }
 
+/// \brief Returns the index of duplicate movies in movieModel().
+mediaelch::MovieDuplicateIndex* Manager::movieDuplicates()
+{
+    return m_movieDuplicates;
+}
+
 /**
  * \brief Returns an instance of the TvShowModel
  * \return Instance of the TvShowModel
@@ -8,6 +8,7 @@
 #include "globals/ScraperManager.h"
 #include "media_center/MediaCenterInterface.h"
 #include "model/ConcertModel.h"
+#include "model/MovieDuplicateIndex.h"
 #include "model/MovieModel.h"
 #include "model/TvShowModel.h"
 #include "model/TvShowProxyModel.h"
@@ -50,6 +51,7 @@ public:
     ELCH_NODISCARD MusicFileSearcher* musicFileSearcher();
     ELCH_NODISCARD Database* database();
     ELCH_NODISCARD MovieModel* movieModel();
+    ELCH_NODISCARD mediaelch::MovieDuplicateIndex* movieDuplicates();
     ELCH_NODISCARD TvShowModel* tvShowModel();
     ELCH_NODISCARD ConcertModel* concertModel();
     ELCH_NODISCARD MusicModel* musicModel();
@@ -74,6 +76,7 @@ private:
     TvShowFileSearcher* m_tvShowFileSearcher = nullptr;
     ConcertFileSearcher* m_concertFileSearcher = nullptr;
     MovieModel* m_movieModel = nullptr;
+    mediaelch::MovieDuplicateIndex* m_movieDuplicates = nullptr;
     TvShowModel* m_tvShowModel = nullptr;
     ConcertModel* m_concertModel = nullptr;
     MusicModel* m_musicModel = nullptr;
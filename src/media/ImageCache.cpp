@@ -4,18 +4,45 @@
 #include "media/ImageUtils.h"
 #include "settings/Settings.h"
 
+#include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QDataStream>
 #include <QDateTime>
 #include <QDir>
+#include <QFile>
 #include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QSaveFile>
+#include <QThread>
+#include <QtConcurrent>
 
-ImageCache::ImageCache(QObject* parent) : QObject(parent)
+#include <algorithm>
+
+/// \brief Identifies MediaElch's image cache index file.
+static constexpr quint32 INDEX_MAGIC = 0x4d45494d; // "MEIM"
+/// \brief Increase if the format of the index file or of cached images changes.
+static constexpr quint32 INDEX_VERSION = 1;
+/// \brief Maximum size of decoded images kept in memory.
+static constexpr int MEMORY_CACHE_BYTES = 128 * 1024 * 1024;
+
+static int imageCost(const QImage& image)
+{
+    return image.bytesPerLine() * image.height();
+}
+
+ImageCache::ImageCache(QObject* parent) : ImageCache(Settings::instance()->imageCacheDir(), MEMORY_CACHE_BYTES, parent)
 {
-    mediaelch::DirectoryPath location = Settings::instance()->imageCacheDir();
+}
+
+ImageCache::ImageCache(mediaelch::DirectoryPath cacheDir, int memoryCacheBytes, QObject* parent) : QObject(parent)
+{
+    mediaelch::DirectoryPath location = std::move(cacheDir);
     QDir dir(location.dir());
     if (!dir.exists()) {
         dir.mkdir(location.toString());
     }
+    m_indexFile = location.filePath("images.index");
     location = location.subDir("images");
     dir.setPath(location.toString());
     bool exists = dir.exists();
@@ -28,6 +55,35 @@ ImageCache::ImageCache(QObject* parent) : QObject(parent)
     qCDebug(generic) << "[ImageCache] Using cache dir:" << m_cacheDir;
 
     m_forceCache = Settings::instance()->advanced()->forceCache();
+    m_memoryCache.setMaxCost(memoryCacheBytes);
+    // Leave some cores for the GUI and for other work, e.g. loading movies.
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+
+    // The index is written with a delay so that scrolling through many images
+    // does not result in writing the index for each of them.
+    m_saveIndexTimer.setSingleShot(true);
+    m_saveIndexTimer.setInterval(2000);
+    connect(&m_saveIndexTimer, &QTimer::timeout, this, &ImageCache::saveIndex);
+    if (QCoreApplication::instance() != nullptr) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+            if (m_saveIndexTimer.isActive()) {
+                m_saveIndexTimer.stop();
+                saveIndex();
+            }
+        });
+    }
+
+    if (m_cacheDir.isValid()) {
+        loadIndex();
+    }
+}
+
+ImageCache::~ImageCache()
+{
+    if (m_saveIndexTimer.isActive()) {
+        saveIndex();
+    }
+    waitForPendingWrites();
 }
 
 ImageCache* ImageCache::instance(QObject* parent)
@@ -37,46 +93,225 @@ ImageCache* ImageCache::instance(QObject* parent)
 }
 
 QImage ImageCache::image(mediaelch::FilePath path, int width, int height, int& origWidth, int& origHeight)
+{
+    QImage img = cachedImage(path, width, height, origWidth, origHeight);
+    if (!img.isNull()) {
+        return img;
+    }
+
+    const LoadJob job = prepareLoad(path, width, height);
+    const LoadResult result = load(job);
+    store(job, result);
+    origWidth = result.originalSize.width();
+    origHeight = result.originalSize.height();
+    return result.image;
+}
+
+QImage ImageCache::cachedImage(const mediaelch::FilePath& path, int width, int height, int& origWidth, int& origHeight)
 {
     if (!m_cacheDir.isValid()) {
-        return scaledImage(mediaelch::getImage(path), width, height);
-    }
-
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_%2_%3_").arg(md5).arg(width).arg(height);
-
-    bool update = true;
-    QDir dir = m_cacheDir.dir();
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (!files.isEmpty()) {
-        QString fileName = files.first();
-        QStringList parts = fileName.split("_");
-        if (parts.count() > 6) {
-            origWidth = parts.at(3).toInt();
-            origHeight = parts.at(4).toInt();
-            if (m_forceCache || (parts.at(5).toInt() > 0 && parts.at(5).toUInt() == getLastModified(path))) {
-                update = false;
+        return {};
+    }
+
+    const QString hash = pathHash(path);
+    auto info = m_index.constFind(hash);
+    if (info == m_index.constEnd() || !info->scaledSizes.contains(QSize(width, height))) {
+        return {};
+    }
+    QImage* cached = m_memoryCache.object(cacheKey(hash, width, height));
+    if (cached == nullptr || !isUpToDate(path, *info)) {
+        return {};
+    }
+    origWidth = info->originalSize.width();
+    origHeight = info->originalSize.height();
+    return *cached;
+}
+
+void ImageCache::requestImage(const mediaelch::FilePath& path,
+    int width,
+    int height,
+    const QObject* requester,
+    Priority priority)
+{
+    const QString key = cacheKey(pathHash(path), width, height);
+    if (m_loading.contains(key)) {
+        // imageLoaded() will be emitted.
+        return;
+    }
+    if (hasFailed(path, width, height)) {
+        // Loading it again would fail again.
+        return;
+    }
+
+    for (Request& request : m_requests) {
+        if (request.key == key) {
+            request.requesters.insert(requester);
+            if (priority == Priority::Visible) {
+                request.priority = priority;
             }
+            startRequests();
+            return;
         }
     }
 
-    if (update) {
-        QImage origImg = mediaelch::getImage(path);
-        origWidth = origImg.width();
-        origHeight = origImg.height();
-        QImage img = scaledImage(origImg, width, height);
-        QString fileName = QString("%1_%2_%3_%4_%5_%6_.png")
-                               .arg(md5)
-                               .arg(width)
-                               .arg(height)
-                               .arg(origWidth)
-                               .arg(origHeight)
-                               .arg(getLastModified(path));
-        img.save(m_cacheDir.filePath(fileName), "png", -1);
-        return img;
+    Request request;
+    request.path = path;
+    request.width = width;
+    request.height = height;
+    request.key = key;
+    request.priority = priority;
+    request.requesters.insert(requester);
+    m_requests.append(request);
+    startRequests();
+}
+
+bool ImageCache::hasFailed(const mediaelch::FilePath& path, int width, int height)
+{
+    auto failed = m_failed.constFind(cacheKey(pathHash(path), width, height));
+    return failed != m_failed.constEnd() && *failed == getLastModified(path);
+}
+
+void ImageCache::cancelRequests(const QObject* requester)
+{
+    for (auto request = m_requests.begin(); request != m_requests.end();) {
+        request->requesters.remove(requester);
+        if (request->requesters.isEmpty()) {
+            request = m_requests.erase(request);
+        } else {
+            ++request;
+        }
+    }
+}
+
+void ImageCache::startRequests()
+{
+    while (!m_requests.isEmpty() && m_loading.size() < m_pool.maxThreadCount()) {
+        // Visible images first, each in the order in which they were requested.
+        auto next = std::find_if(m_requests.begin(), m_requests.end(), [](const Request& request) {
+            return request.priority == Priority::Visible;
+        });
+        if (next == m_requests.end()) {
+            next = m_requests.begin();
+        }
+        const Request request = *next;
+        m_requests.erase(next);
+        startLoading(request);
+    }
+}
+
+void ImageCache::startLoading(const Request& request)
+{
+    // The job is prepared when the request is started instead of when it is made,
+    // because the image may have been loaded or invalidated in the meantime.
+    const LoadJob job = prepareLoad(request.path, request.width, request.height);
+    m_loading.insert(job.key);
+
+    auto* watcher = new QFutureWatcher<LoadResult>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, job]() {
+        watcher->deleteLater();
+        m_loading.remove(job.key);
+        // Outdated images are not stored: the requester loads the image again after imageLoaded().
+        if (!m_outdated.remove(job.key)) {
+            store(job, watcher->result());
+        }
+        emit imageLoaded(job.path, job.width, job.height);
+        startRequests();
+    });
+    watcher->setFuture(QtConcurrent::run(&m_pool, &ImageCache::load, job));
+}
+
+ImageCache::LoadJob ImageCache::prepareLoad(const mediaelch::FilePath& path, int width, int height)
+{
+    LoadJob job;
+    job.path = path;
+    job.width = width;
+    job.height = height;
+    job.hash = pathHash(path);
+    job.key = cacheKey(job.hash, width, height);
+    if (!m_cacheDir.isValid()) {
+        return job;
+    }
+
+    job.cacheFile = cacheFilePath(job.key);
+    auto info = m_index.constFind(job.hash);
+    if (info != m_index.constEnd() && info->scaledSizes.contains(QSize(width, height)) && isUpToDate(path, *info)) {
+        job.useCacheFile = true;
+        job.originalSize = info->originalSize;
+    }
+    return job;
+}
+
+ImageCache::LoadResult ImageCache::load(const LoadJob& job)
+{
+    LoadResult result;
+    if (job.useCacheFile) {
+        result.image = mediaelch::getImage(mediaelch::FilePath(job.cacheFile));
+        if (!result.image.isNull()) {
+            result.originalSize = job.originalSize;
+            result.fromCacheFile = true;
+            return result;
+        }
+        // The cached file was removed or is still being written.
     }
 
-    return mediaelch::getImage(mediaelch::FilePath(m_cacheDir.filePath(files.first())));
+    const QImage origImg = mediaelch::getImage(job.path);
+    result.originalSize = origImg.size();
+    result.image = scaledImage(origImg, job.width, job.height);
+    return result;
+}
+
+void ImageCache::store(const LoadJob& job, const LoadResult& result)
+{
+    if (result.image.isNull()) {
+        // Null images are never cached, see cachedImage().  Remember the failure instead, so
+        // that the file is not decoded over and over again.
+        qCWarning(generic) << "[ImageCache] Could not load image:" << job.path;
+        m_failed.insert(job.key, getLastModified(job.path));
+        return;
+    }
+    m_failed.remove(job.key);
+
+    if (!m_cacheDir.isValid()) {
+        return;
+    }
+
+    if (result.fromCacheFile) {
+        if (m_index.contains(job.hash)) {
+            m_memoryCache.insert(job.key, new QImage(result.image), imageCost(result.image));
+        }
+        return;
+    }
+
+    const QSize size(job.width, job.height);
+    const qint64 lastModified = getLastModified(job.path);
+    ImageInfo newInfo = m_index.take(job.hash);
+    if (newInfo.lastModified != lastModified || newInfo.originalSize != result.originalSize) {
+        // All scaled versions of the image are outdated.
+        removeCachedImages(job.hash, newInfo);
+        newInfo = ImageInfo{};
+        newInfo.originalSize = result.originalSize;
+        newInfo.lastModified = lastModified;
+    }
+    if (!newInfo.scaledSizes.contains(size)) {
+        newInfo.scaledSizes.append(size);
+    }
+    m_index.insert(job.hash, newInfo);
+    m_memoryCache.insert(job.key, new QImage(result.image), imageCost(result.image));
+
+    // Encoding PNGs is expensive; don't block the caller (usually the GUI thread).
+    // QImage is implicitly shared, so the copy is cheap.
+    waitForPendingWrite(job.key);
+    for (auto write = m_pendingWrites.begin(); write != m_pendingWrites.end();) {
+        if (write->isFinished()) {
+            write = m_pendingWrites.erase(write);
+        } else {
+            ++write;
+        }
+    }
+    const QImage img = result.image;
+    const QString fileName = job.cacheFile;
+    m_pendingWrites.insert(job.key, QtConcurrent::run(&m_pool, [img, fileName]() { img.save(fileName, "png", -1); }));
+    scheduleSaveIndex();
 }
 
 QImage ImageCache::scaledImage(QImage img, int width, int height)
@@ -99,35 +334,162 @@ void ImageCache::invalidateImages(mediaelch::FilePath path)
         return;
     }
 
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QDir dir = m_cacheDir.dir();
-    const QStringList entries = dir.entryList(QStringList() << md5 + "*");
-    for (const QString& file : entries) {
-        QFile f(dir.absolutePath() + "/" + file);
-        f.remove();
+    const QString hash = pathHash(path);
+    for (const QString& key : asConst(m_loading)) {
+        if (key.startsWith(hash)) {
+            m_outdated.insert(key);
+        }
     }
+    for (auto failed = m_failed.begin(); failed != m_failed.end();) {
+        if (failed.key().startsWith(hash)) {
+            failed = m_failed.erase(failed);
+        } else {
+            ++failed;
+        }
+    }
+    if (!m_index.contains(hash)) {
+        return;
+    }
+    removeCachedImages(hash, m_index.take(hash));
+    m_lastModifiedTimes.remove(path);
+    scheduleSaveIndex();
 }
 
 QSize ImageCache::imageSize(mediaelch::FilePath path)
+{
+    if (m_cacheDir.isValid()) {
+        auto info = m_index.constFind(pathHash(path));
+        if (info != m_index.constEnd() && isUpToDate(path, *info)) {
+            return info->originalSize;
+        }
+    }
+
+    // Most image formats store the size in their header; no need to decode the whole image.
+    QImageReader reader(path.toString());
+    const QSize size = reader.size();
+    if (size.isValid()) {
+        return size;
+    }
+    return mediaelch::getImage(path).size();
+}
+
+QString ImageCache::pathHash(const mediaelch::FilePath& path)
+{
+    return QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+QString ImageCache::cacheKey(const QString& hash, int width, int height)
+{
+    return QStringLiteral("%1_%2_%3").arg(hash).arg(width).arg(height);
+}
+
+QString ImageCache::cacheFilePath(const QString& key) const
+{
+    return m_cacheDir.filePath(key + ".png");
+}
+
+bool ImageCache::isUpToDate(const mediaelch::FilePath& path, const ImageInfo& info)
+{
+    return m_forceCache || (info.lastModified > 0 && info.lastModified == getLastModified(path));
+}
+
+void ImageCache::removeCachedImages(const QString& hash, const ImageInfo& info)
+{
+    for (const QSize& size : info.scaledSizes) {
+        const QString key = cacheKey(hash, size.width(), size.height());
+        m_memoryCache.remove(key);
+        // Otherwise the file may be written after it was removed.
+        waitForPendingWrite(key);
+        QFile::remove(cacheFilePath(key));
+    }
+}
+
+void ImageCache::waitForPendingWrite(const QString& key)
+{
+    QFuture<void> write = m_pendingWrites.take(key);
+    write.waitForFinished();
+}
+
+void ImageCache::waitForPendingWrites()
+{
+    for (QFuture<void>& write : m_pendingWrites) {
+        write.waitForFinished();
+    }
+    m_pendingWrites.clear();
+}
+
+void ImageCache::loadIndex()
+{
+    QFile file(m_indexFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        // Either a new cache or one of an older MediaElch version, which encoded all
+        // information in file names.  Old files would never be used again.
+        removeCacheFiles();
+        return;
+    }
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+        // Files of unknown indices would never be used nor removed again.
+        qCWarning(generic) << "[ImageCache] Ignoring index file with unknown format:" << m_indexFile;
+        removeCacheFiles();
+        return;
+    }
+
+    quint32 count = 0;
+    in >> count;
+    m_index.reserve(static_cast<int>(count));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString hash;
+        ImageInfo info;
+        in >> hash >> info.originalSize >> info.lastModified >> info.scaledSizes;
+        m_index.insert(hash, info);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(generic) << "[ImageCache] Index file is corrupt:" << m_indexFile;
+        m_index.clear();
+        removeCacheFiles();
+    }
+}
+
+void ImageCache::removeCacheFiles()
+{
+    waitForPendingWrites();
+    const auto entries = m_cacheDir.dir().entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
+    for (const QFileInfo& entry : entries) {
+        QFile::remove(entry.absoluteFilePath());
+    }
+}
+
+void ImageCache::saveIndex()
 {
     if (!m_cacheDir.isValid()) {
-        return mediaelch::getImage(path).size();
+        return;
     }
 
-    QString md5 = QCryptographicHash::hash(path.toString().toUtf8(), QCryptographicHash::Md5).toHex();
-    QString baseName = QString("%1_").arg(md5);
-    QDir dir = m_cacheDir.dir();
-    QStringList files = dir.entryList(QStringList() << baseName + "*");
-    if (files.isEmpty() || files.first().split("_").count() < 7) {
-        return mediaelch::getImage(path).size();
+    QSaveFile file(m_indexFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(generic) << "[ImageCache] Could not write index file:" << m_indexFile;
+        return;
     }
 
-    QStringList parts = files.first().split("_");
-    if (!m_forceCache && parts.at(5).toInt() > 0 && getLastModified(path) != parts.at(5).toUInt()) {
-        return mediaelch::getImage(path).size();
+    QDataStream out(&file);
+    out << INDEX_MAGIC << INDEX_VERSION << static_cast<quint32>(m_index.size());
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        out << it.key() << it->originalSize << it->lastModified << it->scaledSizes;
     }
+    file.commit();
+}
 
-    return {parts.at(3).toInt(), parts.at(4).toInt()};
+void ImageCache::scheduleSaveIndex()
+{
+    if (!m_saveIndexTimer.isActive()) {
+        m_saveIndexTimer.start();
+    }
 }
 
 qint64 ImageCache::getLastModified(const mediaelch::FilePath& fileName)
@@ -146,8 +508,11 @@ void ImageCache::clearCache()
     if (!m_cacheDir.isValid() || !Settings::instance()->advanced()->forceCache()) {
         return;
     }
-    const auto entries = m_cacheDir.dir().entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
-    for (const QFileInfo& file : entries) {
-        QFile(file.absoluteFilePath()).remove();
-    }
+    removeCacheFiles();
+    m_outdated = m_loading;
+    m_failed.clear();
+    m_index.clear();
+    m_memoryCache.clear();
+    m_saveIndexTimer.stop();
+    saveIndex();
 }
@@ -2,27 +2,165 @@
 
 #include "media/Path.h"
 
+#include <QCache>
+#include <QFuture>
 #include <QHash>
 #include <QImage>
+#include <QList>
+#include <QSet>
 #include <QSize>
 #include <QString>
+#include <QThreadPool>
+#include <QTimer>
 #include <QVector>
 
+/// \brief Cache for scaled images, e.g. posters in the image grid.
+///
+/// There are two levels:
+///  1. Decoded images in memory, the least recently used ones are evicted first.
+///  2. PNG files on disk.  Their file names only depend on the original image's
+///     path and the requested size, so that no directory has to be scanned.
+///     The original image's size and last modification time are stored in an
+///     index file next to the cache directory.
+///
+/// Images can either be loaded synchronously using image() or in a background
+/// thread using requestImage().  The latter should be used by widgets, so that
+/// decoding and scaling large images does not block the GUI thread.
 class ImageCache : public QObject
 {
     Q_OBJECT
 public:
+    enum class Priority
+    {
+        /// \brief The image is currently visible.
+        Visible,
+        /// \brief The image will likely be visible soon, e.g. it belongs to a neighbouring item.
+        Prefetch
+    };
+
     explicit ImageCache(QObject* parent = nullptr);
+    /// \brief Cache in the given directory that keeps at most memoryCacheBytes of decoded
+    ///        images in memory.  Used by tests; use instance() otherwise.
+    ImageCache(mediaelch::DirectoryPath cacheDir, int memoryCacheBytes, QObject* parent = nullptr);
+    ~ImageCache() override;
     static ImageCache* instance(QObject* parent = nullptr);
     QImage image(mediaelch::FilePath path, int width, int height, int& origWidth, int& origHeight);
+    /// \brief Returns the scaled image if it is in memory or a null image otherwise.  Never blocks.
+    QImage cachedImage(const mediaelch::FilePath& path, int width, int height, int& origWidth, int& origHeight);
+    /// \brief Load the scaled image in a background thread.  imageLoaded() is emitted once it is
+    ///        available via cachedImage().  Multiple requests for the same image are merged.
+    /// \param requester Object that needs the image, see cancelRequests().
+    void requestImage(const mediaelch::FilePath& path,
+        int width,
+        int height,
+        const QObject* requester,
+        Priority priority = Priority::Visible);
+    /// \brief Whether the image could not be loaded, e.g. because the file is not a valid image.
+    ///        Failed images are not requested again until the file changes.
+    bool hasFailed(const mediaelch::FilePath& path, int width, int height);
+    /// \brief Cancel all of the requester's requests that were not started, yet.
+    void cancelRequests(const QObject* requester);
     QSize imageSize(mediaelch::FilePath path);
     void invalidateImages(mediaelch::FilePath path);
     void clearCache();
 
+signals:
+    /// \brief A requested image was loaded, see requestImage().
+    void imageLoaded(mediaelch::FilePath path, int width, int height);
+
+private:
+    /// \brief Metadata of an original image whose scaled versions are cached.
+    struct ImageInfo
+    {
+        QSize originalSize;
+        /// \brief Last modification time of the original image in seconds since epoch.
+        qint64 lastModified = 0;
+        /// \brief Sizes of all cached scaled versions.
+        QVector<QSize> scaledSizes;
+    };
+
+    /// \brief Everything needed to load a scaled image in a background thread.
+    struct LoadJob
+    {
+        mediaelch::FilePath path;
+        int width = 0;
+        int height = 0;
+        QString hash;
+        QString key;
+        /// \brief Scaled image on disk; only loaded if useCacheFile is true.
+        QString cacheFile;
+        bool useCacheFile = false;
+        QSize originalSize;
+    };
+
+    struct LoadResult
+    {
+        QImage image;
+        QSize originalSize;
+        bool fromCacheFile = false;
+    };
+
+    struct Request
+    {
+        mediaelch::FilePath path;
+        int width = 0;
+        int height = 0;
+        QString key;
+        Priority priority = Priority::Visible;
+        QSet<const QObject*> requesters;
+    };
+
+    LoadJob prepareLoad(const mediaelch::FilePath& path, int width, int height);
+    /// \brief Load and scale an image.  Thread safe.
+    static LoadResult load(const LoadJob& job);
+    /// \brief Add a loaded image to the memory cache and index; the scaled image is written to disk.
+    void store(const LoadJob& job, const LoadResult& result);
+
+    void startRequests();
+    void startLoading(const Request& request);
+
+    static QString pathHash(const mediaelch::FilePath& path);
+    static QString cacheKey(const QString& hash, int width, int height);
+    QString cacheFilePath(const QString& key) const;
+
+    /// \brief Whether the cached information about the given image is still valid.
+    bool isUpToDate(const mediaelch::FilePath& path, const ImageInfo& info);
+    /// \brief Remove all scaled versions of an image from memory and disk.
+    void removeCachedImages(const QString& hash, const ImageInfo& info);
+    /// \brief Wait until the scaled image with the given key is written to disk.
+    void waitForPendingWrite(const QString& key);
+    void waitForPendingWrites();
+
+    void loadIndex();
+    void saveIndex();
+    /// \brief Remove all files from the cache directory.  Does not touch the index.
+    void removeCacheFiles();
+    void scheduleSaveIndex();
+
+    static QImage scaledImage(QImage img, int width, int height);
+    qint64 getLastModified(const mediaelch::FilePath& fileName);
+
 private:
     mediaelch::DirectoryPath m_cacheDir;
+    QString m_indexFile;
+    /// \brief Metadata of cached images; keyed by pathHash().
+    QHash<QString, ImageInfo> m_index;
+    /// \brief Decoded scaled images; keyed by cacheKey(), cost is their size in bytes.
+    QCache<QString, QImage> m_memoryCache;
+    QTimer m_saveIndexTimer;
     QHash<mediaelch::FilePath, QVector<qint64>> m_lastModifiedTimes;
-    QImage scaledImage(QImage img, int width, int height);
-    qint64 getLastModified(const mediaelch::FilePath& fileName);
     bool m_forceCache;
+
+    /// \brief Decodes and scales requested images and writes them to disk.
+    QThreadPool m_pool;
+    /// \brief Scaled images that are written to disk; keyed by cacheKey().
+    QHash<QString, QFuture<void>> m_pendingWrites;
+    /// \brief Requests that were not started, yet; in the order in which they were made.
+    QList<Request> m_requests;
+    /// \brief Cache keys of images that are currently loaded.
+    QSet<QString> m_loading;
+    /// \brief Cache keys of images that were invalidated while they were loaded.
+    QSet<QString> m_outdated;
+    /// \brief Last modification time of images that could not be loaded; keyed by cacheKey().
+    QHash<QString, qint64> m_failed;
 };
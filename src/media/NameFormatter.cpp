@@ -85,11 +85,16 @@ QString NameFormatter::excludeWords(QString name)
         }
     }
 
-    name.replace(QRegularExpression("[.][.]+"), ".");
-    name.replace(QRegularExpression("[-][-]+"), "-");
+    // Static, because constructing and JIT-compiling them for each name is expensive.
+    // QRegularExpression is thread-safe, so they can be shared between threads.
+    static const QRegularExpression multipleDotsRegEx("[.][.]+");
+    static const QRegularExpression multipleDashesRegEx("[-][-]+");
+    static const QRegularExpression delimiterRegEx("[-\\s_]+$");
+
+    name.replace(multipleDotsRegEx, ".");
+    name.replace(multipleDashesRegEx, "-");
 
     // remove "- _" at the end of a name
-    QRegularExpression delimiterRegEx("[-\\s_]+$");
     name.remove(delimiterRegEx);
 
     // remove spaces at the start end end which may have been introduced
@@ -110,26 +115,24 @@ QString NameFormatter::formatName(QString name, bool replaceDots, bool replaceUn
     name = excludeWords(name);
 
     // remove resulting empty brackets
-    QRegularExpression rx(R"(\([-\s]*\))");
-    QRegularExpressionMatch match = rx.match(name);
+    static const QRegularExpression emptyBracketsRegEx(R"(\([-\s]*\))");
+    QRegularExpressionMatch match = emptyBracketsRegEx.match(name);
     auto pos = match.capturedStart();
     while (pos >= 0) {
         name = name.remove(pos, match.captured(0).length());
-        match = rx.match(name);
+        match = emptyBracketsRegEx.match(name);
         pos = match.capturedStart();
     }
 
     // remove " - _" at the end of a name
-    rx.setPattern("[-\\s_]");
-    while (name.length() > 0 && name.lastIndexOf(rx) == name.length() - 1) {
-        name.chop(1);
-    }
+    static const QRegularExpression delimiterRegEx("[-\\s_]+$");
+    name.remove(delimiterRegEx);
     return name;
 }
 
 QString NameFormatter::removeParts(QString name)
 {
-    QRegularExpression rx(R"re([-_\s().]+([a-f]|(?:(?:part|cd|xvid)[-_\s.]*\d+))[-_\s().]*$)re",
+    static const QRegularExpression rx(R"re([-_\s().]+([a-f]|(?:(?:part|cd|xvid)[-_\s.]*\d+))[-_\s().]*$)re",
         QRegularExpression::CaseInsensitiveOption);
     auto pos = name.lastIndexOf(rx);
     name = name.left(pos);
@@ -2,6 +2,7 @@
 
 #include "log/Log.h"
 #include "media/MediaInfoFile.h"
+#include "media/StreamDetailsService.h"
 
 #include <QApplication>
 #include <QDir>
@@ -65,9 +66,30 @@ void StreamDetails::clear()
     m_availableQualities.clear();
 }
 
-bool StreamDetails::loadStreamDetails()
+bool StreamDetails::loadStreamDetails(bool forceReprobe)
 {
     m_hasLoadedStreamDetails = true;
+    Details details;
+    if (!mediaelch::StreamDetailsService::instance()->loadNow(m_files, details, forceReprobe)) {
+        return false;
+    }
+    setDetails(details);
+    return true;
+}
+
+bool StreamDetails::probe(const mediaelch::FileList& files, Details& details)
+{
+    // Only used as a temporary, therefore it's fine to create it in a worker thread.
+    StreamDetails streamDetails(nullptr, files);
+    if (!streamDetails.loadFromFiles()) {
+        return false;
+    }
+    details = streamDetails.details();
+    return true;
+}
+
+bool StreamDetails::loadFromFiles()
+{
     if (m_files.isEmpty()) {
         return false;
     }
@@ -125,6 +147,41 @@ bool StreamDetails::hasLoaded() const
     return m_hasLoadedStreamDetails;
 }
 
+const mediaelch::FileList& StreamDetails::files() const
+{
+    return m_files;
+}
+
+StreamDetails::Details StreamDetails::details() const
+{
+    Details details;
+    details.video = m_videoDetails;
+    details.audio = m_audioDetails;
+    details.subtitles = m_subtitles;
+    return details;
+}
+
+void StreamDetails::setDetails(const Details& details)
+{
+    clear();
+    // Use the setters so that available channels and qualities are updated as well.
+    for (auto it = details.video.constBegin(); it != details.video.constEnd(); ++it) {
+        setVideoDetail(it.key(), it.value());
+    }
+    for (int i = 0, n = qsizetype_to_int(details.audio.size()); i < n; ++i) {
+        const auto& audio = details.audio.at(i);
+        for (auto it = audio.constBegin(); it != audio.constEnd(); ++it) {
+            setAudioDetail(i, it.key(), it.value());
+        }
+    }
+    for (int i = 0, n = qsizetype_to_int(details.subtitles.size()); i < n; ++i) {
+        const auto& subtitle = details.subtitles.at(i);
+        for (auto it = subtitle.constBegin(); it != subtitle.constEnd(); ++it) {
+            setSubtitleDetail(i, it.key(), it.value());
+        }
+    }
+}
+
 bool StreamDetails::loadWithLibrary()
 {
     mediaelch::FilePath filePath = m_files.first();
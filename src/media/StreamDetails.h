@@ -35,12 +35,25 @@ public:
         Language
     };
 
+    /// \brief Plain stream details without the QObject, e.g. for passing them between threads.
+    struct Details
+    {
+        QMap<VideoDetails, QString> video;
+        QVector<QMap<AudioDetails, QString>> audio;
+        QVector<QMap<SubtitleDetails, QString>> subtitles;
+    };
+
     static QString detailToString(VideoDetails details);
     static QString detailToString(AudioDetails details);
     static QString detailToString(SubtitleDetails details);
 
     /// \brief Loads stream details from the file. Returns true if successful.
-    ELCH_NODISCARD bool loadStreamDetails();
+    /// \details Results of earlier loads are reused if the files have not changed and
+    ///          forceReprobe is false, see mediaelch::StreamDetailsService.
+    ELCH_NODISCARD bool loadStreamDetails(bool forceReprobe = false);
+    /// \brief Reads the stream details of the given files using MediaInfo.
+    /// \details Blocks until MediaInfo is done but is safe to be called from any thread.
+    ELCH_NODISCARD static bool probe(const mediaelch::FileList& files, Details& details);
     /// \brief Indicates whether the stream details were loaded at least once.
     /// \details Returns true, f the stream details were either loaded through
     ///          \see loadStreamDetails or if set through \see setLoaded.
@@ -50,6 +63,11 @@ public:
     /// \brief Set the list of files without reloading/changing the current streamdetails.
     /// \details Useful if files were renamed, but their contents did not change.
     void setFilesWithoutReloading(mediaelch::FileList files);
+    const mediaelch::FileList& files() const;
+
+    Details details() const;
+    /// \brief Replaces all stream details.  Does not change whether they are loaded.
+    void setDetails(const Details& details);
 
     void setVideoDetail(VideoDetails key, QString value);
     void setAudioDetail(int streamNumber, AudioDetails key, QString value);
@@ -73,6 +91,7 @@ public:
     QStringList allSubtitleLanguages() const;
 
 private:
+    bool loadFromFiles();
     bool loadWithLibrary();
 
     mediaelch::FileList m_files;
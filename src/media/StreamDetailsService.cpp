@@ -0,0 +1,297 @@
+#include "media/StreamDetailsService.h"
+
+#include "database/Database.h"
+#include "log/Log.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QSet>
+#include <QStringList>
+#include <QThreadStorage>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace {
+
+/// \brief Incremented each time the serialized format changes; older entries are ignored.
+constexpr quint8 s_formatVersion = 1;
+
+/// \brief Size and modification time of a list of files, used to detect changed files.
+struct FileState
+{
+    qint64 size = 0;
+    /// \brief Newest modification time of all files in ms since epoch.
+    qint64 lastModified = 0;
+};
+
+bool fileState(const mediaelch::FileList& files, FileState& state)
+{
+    state = FileState{};
+    for (const mediaelch::FilePath& file : files) {
+        const QFileInfo fi(file.toString());
+        if (!fi.exists()) {
+            return false;
+        }
+        state.size += fi.size();
+        state.lastModified = std::max(state.lastModified, fi.lastModified().toMSecsSinceEpoch());
+    }
+    return !files.isEmpty();
+}
+
+/// \brief Database connection of the calling thread.  Connections can't be shared between threads.
+///        Used by the threads of StreamDetailsService's pool, which never expire, and by threads
+///        that call loadNow(), e.g. the GUI thread.  A connection is closed when its thread finishes.
+Database* threadDatabase()
+{
+    static QThreadStorage<Database*> s_databases;
+    if (!s_databases.hasLocalData()) {
+        s_databases.setLocalData(Database::newConnection(nullptr));
+    }
+    return s_databases.localData();
+}
+
+template<class Key>
+void writeMap(QDataStream& stream, const QMap<Key, QString>& map)
+{
+    stream << static_cast<quint32>(map.size());
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it) {
+        stream << static_cast<qint32>(it.key()) << it.value();
+    }
+}
+
+template<class Key>
+void writeMaps(QDataStream& stream, const QVector<QMap<Key, QString>>& maps)
+{
+    stream << static_cast<quint32>(maps.size());
+    for (const auto& map : maps) {
+        writeMap(stream, map);
+    }
+}
+
+template<class Key>
+bool readMap(QDataStream& stream, QMap<Key, QString>& map)
+{
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        qint32 key = 0;
+        QString value;
+        stream >> key >> value;
+        map.insert(static_cast<Key>(key), value);
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+template<class Key>
+bool readMaps(QDataStream& stream, QVector<QMap<Key, QString>>& maps)
+{
+    quint32 count = 0;
+    stream >> count;
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QMap<Key, QString> map;
+        if (!readMap(stream, map)) {
+            return false;
+        }
+        maps.push_back(map);
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+} // namespace
+
+namespace mediaelch {
+
+StreamDetailsService::StreamDetailsService(QObject* parent) : QObject(parent)
+{
+    // MediaInfo mostly waits for the disk.  More threads would only compete for it.
+    m_pool.setMaxThreadCount(2);
+    // Each thread has its own database connection (see threadDatabase()).  Threads must
+    // not expire, otherwise a new connection would be opened after each idle period.
+    m_pool.setExpiryTimeout(-1);
+}
+
+StreamDetailsService::~StreamDetailsService()
+{
+    m_pool.waitForDone();
+}
+
+StreamDetailsService* StreamDetailsService::instance(QObject* parent)
+{
+    static auto* s_instance = new StreamDetailsService(parent);
+    return s_instance;
+}
+
+void StreamDetailsService::load(const mediaelch::FileList& files, QObject* context, Callback callback)
+{
+    const QString key = cacheKey(files);
+    Receiver receiver{context, std::move(callback)};
+
+    auto loading = m_loading.find(key);
+    if (loading != m_loading.end()) {
+        loading->push_back(std::move(receiver));
+        return;
+    }
+
+    auto queued = std::find_if(
+        m_requests.begin(), m_requests.end(), [&key](const Request& request) { return request.key == key; });
+    if (queued != m_requests.end()) {
+        queued->isPrefetch = false;
+        queued->receivers.push_back(std::move(receiver));
+    } else {
+        Request request;
+        request.files = files;
+        request.key = key;
+        request.receivers.push_back(std::move(receiver));
+        m_requests.push_back(std::move(request));
+    }
+    startRequests();
+}
+
+void StreamDetailsService::prefetch(const QVector<mediaelch::FileList>& files)
+{
+    QSet<QString> queued;
+    for (const Request& request : asConst(m_requests)) {
+        queued.insert(request.key);
+    }
+    for (const mediaelch::FileList& itemFiles : files) {
+        const QString key = cacheKey(itemFiles);
+        if (itemFiles.isEmpty() || queued.contains(key) || m_loading.contains(key)) {
+            continue;
+        }
+        queued.insert(key);
+        Request request;
+        request.files = itemFiles;
+        request.key = key;
+        request.isPrefetch = true;
+        m_requests.push_back(std::move(request));
+    }
+    startRequests();
+}
+
+bool StreamDetailsService::loadNow(const mediaelch::FileList& files, StreamDetails::Details& details, bool forceReprobe)
+{
+    Result result = probe(files, forceReprobe);
+    if (result.success) {
+        details = std::move(result.details);
+    }
+    return result.success;
+}
+
+void StreamDetailsService::startRequests()
+{
+    while (!m_requests.isEmpty() && m_loading.size() < m_pool.maxThreadCount()) {
+        // Requested items first, each in the order in which they were requested.
+        auto next = std::find_if(
+            m_requests.begin(), m_requests.end(), [](const Request& request) { return !request.isPrefetch; });
+        if (next == m_requests.end()) {
+            // Keep the other threads free for items that the user opens.
+            if (m_prefetchCount > 0) {
+                break;
+            }
+            next = m_requests.begin();
+        }
+        const Request request = *next;
+        m_requests.erase(next);
+        startLoading(request);
+    }
+}
+
+void StreamDetailsService::startLoading(const Request& request)
+{
+    m_loading.insert(request.key, request.receivers);
+    if (request.isPrefetch) {
+        ++m_prefetchCount;
+    }
+
+    auto* watcher = new QFutureWatcher<Result>(this);
+    const QString key = request.key;
+    const bool isPrefetch = request.isPrefetch;
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, key, isPrefetch]() {
+        watcher->deleteLater();
+        if (isPrefetch) {
+            --m_prefetchCount;
+        }
+        const Result result = watcher->result();
+        const QVector<Receiver> receivers = m_loading.take(key);
+        for (const Receiver& receiver : receivers) {
+            if (!receiver.context.isNull()) {
+                receiver.callback(result.success, result.details);
+            }
+        }
+        startRequests();
+    });
+    watcher->setFuture(QtConcurrent::run(&m_pool, &StreamDetailsService::probe, request.files, false));
+}
+
+StreamDetailsService::Result StreamDetailsService::probe(const mediaelch::FileList& files, bool forceReprobe)
+{
+    Result result;
+    FileState state;
+    if (!fileState(files, state)) {
+        // Don't cache anything for files that don't exist (anymore).
+        result.success = StreamDetails::probe(files, result.details);
+        return result;
+    }
+
+    const QString key = cacheKey(files);
+    Database* database = threadDatabase();
+    if (!forceReprobe) {
+        const QByteArray cached = database->cachedStreamDetails(key, state.size, state.lastModified);
+        if (!cached.isEmpty() && deserialize(cached, result.details)) {
+            result.success = true;
+            return result;
+        }
+    }
+
+    // Failures are not cached: MediaInfo may not be available or the file may still be copied.
+    result.success = StreamDetails::probe(files, result.details);
+    if (result.success) {
+        database->setCachedStreamDetails(key, state.size, state.lastModified, serialize(result.details));
+    } else {
+        qCDebug(generic) << "[StreamDetailsService] Could not load stream details of" << key;
+    }
+    return result;
+}
+
+QString StreamDetailsService::cacheKey(const mediaelch::FileList& files)
+{
+    QStringList paths;
+    for (const mediaelch::FilePath& file : files) {
+        paths << file.toString();
+    }
+    return paths.join('\n');
+}
+
+QByteArray StreamDetailsService::serialize(const StreamDetails::Details& details)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_6);
+    stream << s_formatVersion;
+    writeMap(stream, details.video);
+    writeMaps(stream, details.audio);
+    writeMaps(stream, details.subtitles);
+    return data;
+}
+
+bool StreamDetailsService::deserialize(const QByteArray& data, StreamDetails::Details& details)
+{
+    QDataStream stream(data);
+    stream.setVersion(QDataStream::Qt_5_6);
+    quint8 version = 0;
+    stream >> version;
+    if (stream.status() != QDataStream::Ok || version != s_formatVersion) {
+        return false;
+    }
+    StreamDetails::Details read;
+    if (!readMap(stream, read.video) || !readMaps(stream, read.audio) || !readMaps(stream, read.subtitles)) {
+        return false;
+    }
+    details = std::move(read);
+    return true;
+}
+
+} // namespace mediaelch
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "media/Path.h"
+#include "media/StreamDetails.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include <functional>
+
+namespace mediaelch {
+
+/// \brief Reads stream details with MediaInfo in background threads.
+///
+/// MediaInfo has to parse (parts of) each file, which may take seconds for files
+/// on network shares.  Results are stored in the database, keyed by the files'
+/// paths, their total size and newest modification time, so that each file only
+/// has to be probed once as long as it does not change.
+///
+/// Requests for items that the user opened are started before prefetch requests,
+/// e.g. for all movies of a directory.  Only a single prefetch request runs at
+/// a time so that opened items never have to wait for a whole directory.
+class StreamDetailsService : public QObject
+{
+    Q_OBJECT
+public:
+    using Callback = std::function<void(bool success, const StreamDetails::Details& details)>;
+
+    explicit StreamDetailsService(QObject* parent = nullptr);
+    ~StreamDetailsService() override;
+    static StreamDetailsService* instance(QObject* parent = nullptr);
+
+    /// \brief Load the stream details of the given files in a background thread.
+    /// \details The callback is called in the GUI thread, but not if the context was
+    ///          destroyed in the meantime.  Multiple requests for the same files are merged.
+    void load(const mediaelch::FileList& files, QObject* context, Callback callback);
+    /// \brief Probe the given files in the background and store the results in the database.
+    ///        Files whose stream details are already cached are skipped.
+    void prefetch(const QVector<mediaelch::FileList>& files);
+    /// \brief Load the stream details of the given files in the calling thread and block until
+    ///        they are available.
+    /// \param forceReprobe Ignore cached stream details, e.g. because the user explicitly wants to
+    ///        reload them.  The new result replaces the cached one.
+    ELCH_NODISCARD bool
+    loadNow(const mediaelch::FileList& files, StreamDetails::Details& details, bool forceReprobe = false);
+
+    static QByteArray serialize(const StreamDetails::Details& details);
+    ELCH_NODISCARD static bool deserialize(const QByteArray& data, StreamDetails::Details& details);
+
+private:
+    struct Receiver
+    {
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    struct Request
+    {
+        mediaelch::FileList files;
+        QString key;
+        bool isPrefetch = false;
+        QVector<Receiver> receivers;
+    };
+
+    struct Result
+    {
+        bool success = false;
+        StreamDetails::Details details;
+    };
+
+    void startRequests();
+    void startLoading(const Request& request);
+
+    /// \brief Cached or freshly probed stream details.  Thread safe.
+    static Result probe(const mediaelch::FileList& files, bool forceReprobe);
+    static QString cacheKey(const mediaelch::FileList& files);
+
+private:
+    QThreadPool m_pool;
+    /// \brief Requests that were not started, yet; in the order in which they were made.
+    QList<Request> m_requests;
+    /// \brief Receivers of requests that are currently loaded, keyed by cacheKey().
+    QHash<QString, QVector<Receiver>> m_loading;
+    int m_prefetchCount = 0;
+};
+
+} // namespace mediaelch
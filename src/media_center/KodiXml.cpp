@@ -18,9 +18,11 @@
 #include "media_center/kodi/EpisodeXmlWriter.h"
 #include "media_center/kodi/MovieXmlReader.h"
 #include "media_center/kodi/MovieXmlWriter.h"
+#include "media_center/kodi/NfoFileWriter.h"
 #include "media_center/kodi/TvShowXmlReader.h"
 #include "media_center/kodi/TvShowXmlWriter.h"
 #include "settings/Settings.h"
+#include "utils/Meta.h"
 
 #include <QApplication>
 #include <QBuffer>
@@ -75,17 +77,8 @@ bool KodiXml::saveMovie(Movie* movie)
     for (auto dataFile : Settings::instance()->dataFiles(DataFileType::MovieNfo)) {
         QString saveFileName = dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, movie->files().count() > 1);
         QString saveFilePath = fi.absolutePath() + "/" + saveFileName;
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        qCDebug(generic) << "Saving to" << file.fileName();
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "File could not be openend";
-        } else {
-            file.write(xmlContent);
-            file.close();
+        qCDebug(generic) << "Saving to" << saveFilePath;
+        if (mediaelch::kodi::saveNfoFile(saveFilePath, xmlContent) != mediaelch::kodi::NfoSaveResult::Failed) {
             saved = true;
         }
     }
@@ -321,13 +314,16 @@ bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
+    if (movie->streamDetails() != nullptr) {
+        movie->streamDetails()->clear();
+    }
 
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::MovieXmlReader reader(*movie);
-    reader.parseNfoDom(domDoc);
-
-    loadStreamDetails(movie->streamDetails(), domDoc);
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error while parsing movie NFO:" << xml.errorString();
+    }
 
     // Existence of images
     if (initialNfoContent.isEmpty()) {
@@ -340,85 +336,6 @@ bool KodiXml::loadMovie(Movie* movie, QString initialNfoContent)
     return true;
 }
 
-/// \brief Loads the stream details from the dom document
-/// \param streamDetails StreamDetails object
-/// \param domDoc Nfo document
-/// \return Infos loaded
-bool KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc)
-{
-    streamDetails->clear();
-    QDomNodeList elements = domDoc.elementsByTagName("streamdetails");
-    if (elements.isEmpty()) {
-        return false;
-    }
-    QDomElement elem = elements.at(0).toElement();
-    return loadStreamDetails(streamDetails, elem);
-}
-
-bool KodiXml::loadStreamDetails(StreamDetails* streamDetails, QDomElement elem)
-{
-    bool hasDetails = false;
-    if (!elem.elementsByTagName("video").isEmpty()) {
-        hasDetails = true;
-        QDomElement videoElem = elem.elementsByTagName("video").at(0).toElement();
-
-        std::array<StreamDetails::VideoDetails, 7> details{StreamDetails::VideoDetails::Codec,
-            StreamDetails::VideoDetails::Aspect,
-            StreamDetails::VideoDetails::Width,
-            StreamDetails::VideoDetails::Height,
-            StreamDetails::VideoDetails::DurationInSeconds,
-            StreamDetails::VideoDetails::ScanType,
-            StreamDetails::VideoDetails::StereoMode};
-
-        for (const auto detail : details) {
-            const QString detailStr = StreamDetails::detailToString(detail);
-            QDomNodeList elements = videoElem.elementsByTagName(detailStr);
-            if (!elements.isEmpty()) {
-                streamDetails->setVideoDetail(detail, elements.at(0).toElement().text());
-            }
-        }
-    }
-
-    QDomNodeList audioElements = elem.elementsByTagName("audio");
-    std::array<StreamDetails::AudioDetails, 3> audioDetails{StreamDetails::AudioDetails::Codec,
-        StreamDetails::AudioDetails::Language,
-        StreamDetails::AudioDetails::Channels};
-
-    hasDetails = hasDetails || !audioElements.isEmpty();
-    for (int i = 0, n = audioElements.count(); i < n; ++i) {
-        QDomElement audioElem = audioElements.at(i).toElement();
-
-        for (const auto detail : audioDetails) {
-            const QString detailStr = StreamDetails::detailToString(detail);
-            QDomNodeList detailElements = audioElem.elementsByTagName(detailStr);
-
-            if (!detailElements.isEmpty()) {
-                streamDetails->setAudioDetail(i, detail, detailElements.at(0).toElement().text());
-            }
-        }
-    }
-
-    QDomNodeList subtitleElements = elem.elementsByTagName("subtitle");
-    std::array<StreamDetails::SubtitleDetails, 1> subtitleDetails{StreamDetails::SubtitleDetails::Language};
-
-    hasDetails = hasDetails || !subtitleElements.isEmpty();
-    for (int i = 0, n = subtitleElements.count(); i < n; ++i) {
-        QDomElement subtitleElem = subtitleElements.at(i).toElement();
-        if (!subtitleElem.elementsByTagName("file").isEmpty()) {
-            continue;
-        }
-        for (const auto detail : subtitleDetails) {
-            const auto detailStr = StreamDetails::detailToString(detail);
-            if (!subtitleElem.elementsByTagName(detailStr).isEmpty()) {
-                streamDetails->setSubtitleDetail(
-                    i, detail, subtitleElem.elementsByTagName(detailStr).at(0).toElement().text());
-            }
-        }
-    }
-    streamDetails->setLoaded(hasDetails);
-    return hasDetails;
-}
-
 /// \brief Writes streamdetails to xml stream
 /// \param xml XML Stream
 /// \param streamDetails Stream Details object
@@ -563,17 +480,8 @@ bool KodiXml::saveConcert(Concert* concert)
         QString saveFileName =
             dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, concert->files().size() > 1);
         QString saveFilePath = mediaelch::DirectoryPath(fi.absolutePath()).filePath(saveFileName);
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        qCDebug(generic) << "[KodiXml] Saving to" << file.fileName();
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] File could not be openend";
-        } else {
-            file.write(xmlContent);
-            file.close();
+        qCDebug(generic) << "[KodiXml] Saving to" << saveFilePath;
+        if (mediaelch::kodi::saveNfoFile(saveFilePath, xmlContent) != mediaelch::kodi::NfoSaveResult::Failed) {
             saved = true;
         }
     }
@@ -760,15 +668,54 @@ bool KodiXml::loadTvShow(TvShow* show, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::TvShowXmlReader reader(*show);
-    reader.parseNfoDom(domDoc);
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error while parsing TV show NFO:" << xml.errorString();
+    }
 
     return true;
 }
 
+/// \brief Returns the index of the <episodedetails> element with the given season and episode number
+///        or -1 if there is none.  Only the first <season> and <episode> of each element are read.
+static elch_ssize_t findEpisodeDetailsIndex(const QString& episodesXml, SeasonNumber season, EpisodeNumber episode)
+{
+    QXmlStreamReader xml(episodesXml);
+    if (!xml.readNextStartElement()) {
+        return -1;
+    }
+    elch_ssize_t index = 0;
+    while (xml.readNextStartElement()) {
+        if (xml.name() != QLatin1String("episodedetails")) {
+            xml.skipCurrentElement();
+            continue;
+        }
+        QString seasonText;
+        QString episodeText;
+        bool hasSeason = false;
+        bool hasEpisode = false;
+        while (xml.readNextStartElement()) {
+            if (!hasSeason && xml.name() == QLatin1String("season")) {
+                hasSeason = true;
+                seasonText = xml.readElementText();
+            } else if (!hasEpisode && xml.name() == QLatin1String("episode")) {
+                hasEpisode = true;
+                episodeText = xml.readElementText();
+            } else {
+                xml.skipCurrentElement();
+            }
+        }
+        if (hasSeason && hasEpisode && seasonText.toInt() == season.toInt()
+            && episodeText.toInt() == episode.toInt()) {
+            return index;
+        }
+        ++index;
+    }
+    return -1;
+}
+
 /**
  * \brief Loads TV show episode information
  * \param episode Episode to load infos for
@@ -802,46 +749,42 @@ bool KodiXml::loadTvShowEpisode(TvShowEpisode* episode, QString initialNfoConten
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(mediaelch::kodi::EpisodeXmlReader::makeValidEpisodeXml(nfoContent));
+    const QString episodesXml = mediaelch::kodi::EpisodeXmlReader::makeValidEpisodeXml(nfoContent);
 
-    QDomNodeList episodeDetailsList = domDoc.elementsByTagName("episodedetails");
-    if (episodeDetailsList.isEmpty()) {
-        return false;
-    }
-
-    QDomElement episodeDetails;
-    if (episodeDetailsList.count() > 1) {
-        bool found = false;
-        for (int i = 0, n = episodeDetailsList.count(); i < n; ++i) {
-            episodeDetails = episodeDetailsList.at(i).toElement();
-            if (!episodeDetails.elementsByTagName("season").isEmpty()
-                && episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt()
-                       == episode->seasonNumber().toInt()
-                && !episodeDetails.elementsByTagName("episode").isEmpty()
-                && episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt()
-                       == episode->episodeNumber().toInt()) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) {
+    // Multi-episode files contain several <episodedetails>.  Find the matching one with a cheap
+    // first pass so that only a single element has to be parsed completely.
+    elch_ssize_t episodeIndex = 0;
+    if (episodesXml.indexOf("<episodedetails") != episodesXml.lastIndexOf("<episodedetails")) {
+        episodeIndex = findEpisodeDetailsIndex(episodesXml, episode->seasonNumber(), episode->episodeNumber());
+        if (episodeIndex < 0) {
             return false;
         }
-
-    } else {
-        episodeDetails = episodeDetailsList.at(0).toElement();
     }
 
-    mediaelch::kodi::EpisodeXmlReader reader(*episode);
-    reader.parseNfoDom(episodeDetails);
-
-    if (episodeDetails.elementsByTagName("streamdetails").count() > 0) {
-        loadStreamDetails(
-            episode->streamDetails(), episodeDetails.elementsByTagName("streamdetails").at(0).toElement());
+    QXmlStreamReader xml(episodesXml);
+    if (!xml.readNextStartElement()) {
+        return false;
+    }
+    elch_ssize_t currentIndex = 0;
+    while (xml.readNextStartElement()) {
+        if (xml.name() != QLatin1String("episodedetails")) {
+            xml.skipCurrentElement();
+            continue;
+        }
+        if (currentIndex != episodeIndex) {
+            ++currentIndex;
+            xml.skipCurrentElement();
+            continue;
+        }
+        mediaelch::kodi::EpisodeXmlReader reader(*episode);
+        reader.parse(xml);
+        if (xml.hasError()) {
+            qCWarning(generic) << "[KodiXml] Error while parsing episode NFO:" << xml.errorString();
+        }
+        return true;
     }
 
-    return true;
+    return false;
 }
 
 /**
@@ -863,17 +806,9 @@ bool KodiXml::saveTvShow(TvShow* show)
 
     for (DataFile dataFile : Settings::instance()->dataFiles(DataFileType::TvShowNfo)) {
         QString saveFilePath = show->dir().filePath(dataFile.saveFileName(""));
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] NFO file could not be openend for writing" << file.fileName();
+        if (mediaelch::kodi::saveNfoFile(saveFilePath, xmlContent) == mediaelch::kodi::NfoSaveResult::Failed) {
             return false;
         }
-        file.write(xmlContent);
-        file.close();
     }
 
     for (const auto imageType : TvShow::imageTypes()) {
@@ -977,17 +912,9 @@ bool KodiXml::saveTvShowEpisode(TvShowEpisode* episode)
         QString saveFileName =
             dataFile.saveFileName(fi.fileName(), SeasonNumber::NoSeason, episode->files().count() > 1);
         QString saveFilePath = fi.absolutePath() + "/" + saveFileName;
-        QDir saveFileDir = QFileInfo(saveFilePath).dir();
-        if (!saveFileDir.exists()) {
-            saveFileDir.mkpath(".");
-        }
-        QFile file(saveFilePath);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] NFO file could not be opened for writing" << saveFileName;
+        if (mediaelch::kodi::saveNfoFile(saveFilePath, xmlContent) == mediaelch::kodi::NfoSaveResult::Failed) {
             return false;
         }
-        file.write(xmlContent);
-        file.close();
     }
 
     fi.setFile(episode->files().first().toString());
@@ -1464,11 +1391,12 @@ bool KodiXml::loadArtist(Artist* artist, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::ArtistXmlReader reader(*artist);
-    reader.parseNfoDom(domDoc);
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error while parsing artist NFO:" << xml.errorString();
+    }
 
     return true;
 }
@@ -1503,11 +1431,12 @@ bool KodiXml::loadAlbum(Album* album, QString initialNfoContent)
         nfoContent = initialNfoContent;
     }
 
-    QDomDocument domDoc;
-    domDoc.setContent(nfoContent);
-
+    QXmlStreamReader xml(nfoContent);
     mediaelch::kodi::AlbumXmlReader reader(*album);
-    reader.parseNfoDom(domDoc);
+    reader.parse(xml);
+    if (xml.hasError()) {
+        qCWarning(generic) << "[KodiXml] Error while parsing album NFO:" << xml.errorString();
+    }
 
     return true;
 }
@@ -1587,19 +1516,10 @@ bool KodiXml::saveArtist(Artist* artist)
         return false;
     }
 
-    QDir saveFileDir = QFileInfo(fileName).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    {
-        QFile file(fileName);
-        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-            qCWarning(generic) << "[KodiXml] File could not be openend";
-            return false;
-        }
-        file.write(xmlContent);
-        file.close();
+    if (mediaelch::kodi::saveNfoFile(fileName, xmlContent) == mediaelch::kodi::NfoSaveResult::Failed) {
+        return false;
     }
+
     for (const auto imageType : Artist::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
 
@@ -1654,17 +1574,9 @@ bool KodiXml::saveAlbum(Album* album)
         return false;
     }
 
-    QDir saveFileDir = QFileInfo(nfoFileName).dir();
-    if (!saveFileDir.exists()) {
-        saveFileDir.mkpath(".");
-    }
-    QFile nfo(nfoFileName);
-    if (!nfo.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        qCWarning(generic) << "[KodiXml] File could not be openend";
+    if (mediaelch::kodi::saveNfoFile(nfoFileName, xmlContent) == mediaelch::kodi::NfoSaveResult::Failed) {
         return false;
     }
-    nfo.write(xmlContent);
-    nfo.close();
 
     for (const auto imageType : Album::imageTypes()) {
         DataFileType dataFileType = DataFile::dataFileTypeForImageType(imageType);
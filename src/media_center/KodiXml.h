@@ -7,7 +7,6 @@
 #include "media_center/MediaCenterInterface.h"
 
 #include <QByteArray>
-#include <QDomDocument>
 #include <QObject>
 #include <QString>
 #include <QVector>
@@ -112,8 +111,6 @@ private:
     QByteArray getEpisodeXml(const QVector<TvShowEpisode*>& episodes);
     QByteArray getArtistXml(Artist* artist);
     QByteArray getAlbumXml(Album* album);
-    bool loadStreamDetails(StreamDetails* streamDetails, QDomDocument domDoc);
-    bool loadStreamDetails(StreamDetails* streamDetails, QDomElement elem);
     bool saveFile(QString filename, QByteArray data);
     mediaelch::DirectoryPath getPath(const Movie* movie);
     mediaelch::DirectoryPath getPath(const Concert* concert);
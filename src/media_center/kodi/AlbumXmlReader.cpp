@@ -5,6 +5,8 @@
 #include "data/music/Album.h"
 #include "globals/Globals.h"
 
+#include <QSet>
+
 namespace mediaelch {
 namespace kodi {
 
@@ -12,80 +14,143 @@ AlbumXmlReader::AlbumXmlReader(Album& album) : m_album{album}
 {
 }
 
-void AlbumXmlReader::parseNfoDom(QDomDocument domDoc)
+void AlbumXmlReader::parse(QXmlStreamReader& reader)
 {
-    // v16 CamelCase tag
-    if (!domDoc.elementsByTagName("musicBrainzReleaseGroupID").isEmpty()) {
-        m_album.setMbReleaseGroupId(
-            MusicBrainzId(domDoc.elementsByTagName("musicBrainzReleaseGroupID").at(0).toElement().text()));
+    if (!reader.readNextStartElement()) {
+        return;
     }
-    // v17 lowercase tag
-    if (!domDoc.elementsByTagName("musicbrainzreleasegroupid").isEmpty()) {
-        m_album.setMbReleaseGroupId(
-            MusicBrainzId(domDoc.elementsByTagName("musicbrainzreleasegroupid").at(0).toElement().text()));
+    if (reader.name() != QLatin1String("album")) {
+        reader.raiseError(QObject::tr("No valid album root entry found"));
+        return;
+    }
+
+    // Tags that may only exist once.  They are applied after all others, see applyDeferredValues().
+    static const QSet<QString> singleValueTags{"musicBrainzReleaseGroupID",
+        "musicbrainzreleasegroupid",
+        "musicBrainzAlbumID",
+        "musicbrainzalbumid",
+        "allmusicid",
+        "title",
+        "artist",
+        "review",
+        "label",
+        "releasedate",
+        "year",
+        "rating"};
+
+    while (reader.readNextStartElement()) {
+        const QString tagName = reader.name().toString();
+
+        if (singleValueTags.contains(tagName)) {
+            storeFirstValue(tagName, reader.readElementText());
+
+        } else if (tagName == "albumArtistCredits") {
+            albumArtistCredits(reader);
+
+        } else if (tagName == "genre") {
+            m_genres << reader.readElementText().split(" / ", ElchSplitBehavior::SkipEmptyParts);
+
+        } else if (tagName == "style") {
+            m_album.addStyle(reader.readElementText());
+
+        } else if (tagName == "mood") {
+            m_album.addMood(reader.readElementText());
+
+        } else if (tagName == "thumb") {
+            albumThumb(reader);
+
+        } else {
+            reader.skipCurrentElement();
+        }
     }
 
+    applyDeferredValues();
+    m_album.setHasChanged(false);
+}
+
+void AlbumXmlReader::storeFirstValue(const QString& tagName, const QString& value)
+{
+    if (!m_firstValues.contains(tagName)) {
+        m_firstValues.insert(tagName, value);
+    }
+}
+
+void AlbumXmlReader::albumArtistCredits(QXmlStreamReader& reader)
+{
+    // <albumArtistCredits>
+    //   <artist>AC/DC</artist>
+    // </albumArtistCredits>
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("artist")) {
+            storeFirstValue("artist", reader.readElementText());
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+void AlbumXmlReader::albumThumb(QXmlStreamReader& reader)
+{
+    Poster p;
+    const QString preview = reader.attributes().value("preview").toString();
+    p.originalUrl = QUrl(reader.readElementText());
+    if (!preview.isEmpty()) {
+        p.thumbUrl = QUrl(preview);
+    } else {
+        p.thumbUrl = p.originalUrl;
+    }
+    m_album.addImage(ImageType::AlbumThumb, p);
+}
+
+void AlbumXmlReader::applyDeferredValues()
+{
+    // Order matters: Some of these tags override others.
+
     // v16 CamelCase tag
-    if (!domDoc.elementsByTagName("musicBrainzAlbumID").isEmpty()) {
-        m_album.setMbAlbumId(MusicBrainzId(domDoc.elementsByTagName("musicBrainzAlbumID").at(0).toElement().text()));
+    if (m_firstValues.contains("musicBrainzReleaseGroupID")) {
+        m_album.setMbReleaseGroupId(MusicBrainzId(m_firstValues.value("musicBrainzReleaseGroupID")));
     }
     // v17 lowercase tag
-    if (!domDoc.elementsByTagName("musicbrainzalbumid").isEmpty()) {
-        m_album.setMbAlbumId(MusicBrainzId(domDoc.elementsByTagName("musicbrainzalbumid").at(0).toElement().text()));
+    if (m_firstValues.contains("musicbrainzreleasegroupid")) {
+        m_album.setMbReleaseGroupId(MusicBrainzId(m_firstValues.value("musicbrainzreleasegroupid")));
     }
 
-    if (!domDoc.elementsByTagName("allmusicid").isEmpty()) {
-        m_album.setAllMusicId(AllMusicId(domDoc.elementsByTagName("allmusicid").at(0).toElement().text()));
-    }
-    if (!domDoc.elementsByTagName("title").isEmpty()) {
-        m_album.setTitle(domDoc.elementsByTagName("title").at(0).toElement().text());
+    // v16 CamelCase tag
+    if (m_firstValues.contains("musicBrainzAlbumID")) {
+        m_album.setMbAlbumId(MusicBrainzId(m_firstValues.value("musicBrainzAlbumID")));
     }
-    if (!domDoc.elementsByTagName("artist").isEmpty()) {
-        m_album.setArtist(domDoc.elementsByTagName("artist").at(0).toElement().text());
+    // v17 lowercase tag
+    if (m_firstValues.contains("musicbrainzalbumid")) {
+        m_album.setMbAlbumId(MusicBrainzId(m_firstValues.value("musicbrainzalbumid")));
     }
-    {
-        QDomNodeList genreElements = domDoc.elementsByTagName("genre");
-        QStringList genres;
-        for (int i = 0, n = genreElements.size(); i < n; i++) {
-            genres << genreElements.at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
-        }
-        if (!genres.isEmpty()) {
-            m_album.setGenres(genres);
-        }
+
+    if (m_firstValues.contains("allmusicid")) {
+        m_album.setAllMusicId(AllMusicId(m_firstValues.value("allmusicid")));
     }
-    for (int i = 0, n = domDoc.elementsByTagName("style").size(); i < n; i++) {
-        m_album.addStyle(domDoc.elementsByTagName("style").at(i).toElement().text());
+    if (m_firstValues.contains("title")) {
+        m_album.setTitle(m_firstValues.value("title"));
     }
-    for (int i = 0, n = domDoc.elementsByTagName("mood").size(); i < n; i++) {
-        m_album.addMood(domDoc.elementsByTagName("mood").at(i).toElement().text());
+    if (m_firstValues.contains("artist")) {
+        m_album.setArtist(m_firstValues.value("artist"));
     }
-    if (!domDoc.elementsByTagName("review").isEmpty()) {
-        m_album.setReview(domDoc.elementsByTagName("review").at(0).toElement().text());
+    if (!m_genres.isEmpty()) {
+        m_album.setGenres(m_genres);
     }
-    if (!domDoc.elementsByTagName("label").isEmpty()) {
-        m_album.setLabel(domDoc.elementsByTagName("label").at(0).toElement().text());
+    if (m_firstValues.contains("review")) {
+        m_album.setReview(m_firstValues.value("review"));
     }
-    if (!domDoc.elementsByTagName("releasedate").isEmpty()) {
-        m_album.setReleaseDate(domDoc.elementsByTagName("releasedate").at(0).toElement().text());
+    if (m_firstValues.contains("label")) {
+        m_album.setLabel(m_firstValues.value("label"));
     }
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_album.setYear(domDoc.elementsByTagName("year").at(0).toElement().text().toInt());
+    if (m_firstValues.contains("releasedate")) {
+        m_album.setReleaseDate(m_firstValues.value("releasedate"));
     }
-    if (!domDoc.elementsByTagName("rating").isEmpty()) {
-        m_album.setRating(domDoc.elementsByTagName("rating").at(0).toElement().text().replace(",", ".").toDouble());
+    if (m_firstValues.contains("year")) {
+        m_album.setYear(m_firstValues.value("year").toInt());
     }
-    for (int i = 0, n = domDoc.elementsByTagName("thumb").size(); i < n; i++) {
-        Poster p;
-        p.originalUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().text());
-        if (!domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview").isEmpty()) {
-            p.thumbUrl = QUrl(domDoc.elementsByTagName("thumb").at(i).toElement().attribute("preview"));
-        } else {
-            p.thumbUrl = p.originalUrl;
-        }
-        m_album.addImage(ImageType::AlbumThumb, p);
+    if (m_firstValues.contains("rating")) {
+        m_album.setRating(m_firstValues.value("rating").replace(",", ".").toDouble());
     }
-
-    m_album.setHasChanged(false);
 }
 
 } // namespace kodi
@@ -1,6 +1,9 @@
 #pragma once
 
-#include <QDomElement>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QXmlStreamReader>
 
 class Album;
 
@@ -11,10 +14,19 @@ class AlbumXmlReader
 {
 public:
     explicit AlbumXmlReader(Album& album);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Parses the <album> element of an album NFO file in a single pass.
+    void parse(QXmlStreamReader& reader);
 
 private:
+    void albumArtistCredits(QXmlStreamReader& reader);
+    void albumThumb(QXmlStreamReader& reader);
+    void storeFirstValue(const QString& tagName, const QString& value);
+    void applyDeferredValues();
+
     Album& m_album;
+    /// \brief Texts of tags that are only read once, i.e. the first occurrence wins.
+    QHash<QString, QString> m_firstValues;
+    QStringList m_genres;
 };
 
 } // namespace kodi
@@ -3,10 +3,7 @@
 #include "data/music/Artist.h"
 #include "globals/Globals.h"
 
-#include <QDate>
-#include <QDomElement>
-#include <QFileInfo>
-#include <QTime>
+#include <QSet>
 #include <QUrl>
 
 namespace mediaelch {
@@ -16,85 +13,137 @@ ArtistXmlReader::ArtistXmlReader(Artist& artist) : m_artist{artist}
 {
 }
 
-void ArtistXmlReader::parseNfoDom(QDomDocument domDoc)
+void ArtistXmlReader::parse(QXmlStreamReader& reader)
 {
-    if (!domDoc.elementsByTagName("musicBrainzArtistID").isEmpty()) {
-        m_artist.setMbId(MusicBrainzId(domDoc.elementsByTagName("musicBrainzArtistID").at(0).toElement().text()));
+    if (!reader.readNextStartElement()) {
+        return;
     }
-    if (!domDoc.elementsByTagName("allmusicid").isEmpty()) {
-        m_artist.setAllMusicId(AllMusicId(domDoc.elementsByTagName("allmusicid").at(0).toElement().text()));
+    if (reader.name() != QLatin1String("artist")) {
+        reader.raiseError(QObject::tr("No valid artist root entry found"));
+        return;
     }
-    if (!domDoc.elementsByTagName("name").isEmpty()) {
-        m_artist.setName(domDoc.elementsByTagName("name").at(0).toElement().text());
+
+    // Tags that may only exist once.  They are applied after all others, see applyDeferredValues().
+    static const QSet<QString> singleValueTags{"musicBrainzArtistID",
+        "allmusicid",
+        "name",
+        "yearsactive",
+        "formed",
+        "biography",
+        "born",
+        "died",
+        "disbanded"};
+
+    while (reader.readNextStartElement()) {
+        const QString tagName = reader.name().toString();
+
+        if (singleValueTags.contains(tagName)) {
+            const QString value = reader.readElementText();
+            if (!m_firstValues.contains(tagName)) {
+                m_firstValues.insert(tagName, value);
+            }
+
+        } else if (tagName == "genre") {
+            m_genres << reader.readElementText().split(" / ", ElchSplitBehavior::SkipEmptyParts);
+
+        } else if (tagName == "style") {
+            m_artist.addStyle(reader.readElementText());
+
+        } else if (tagName == "mood") {
+            m_artist.addMood(reader.readElementText());
+
+        } else if (tagName == "thumb") {
+            artistThumb(reader, ImageType::ArtistThumb);
+
+        } else if (tagName == "fanart") {
+            artistFanart(reader);
+
+        } else if (tagName == "album") {
+            artistAlbum(reader);
+
+        } else {
+            reader.skipCurrentElement();
+        }
     }
-    {
-        QDomNodeList genreElements = domDoc.elementsByTagName("genre");
-        QStringList genres;
-        for (int i = 0, n = genreElements.size(); i < n; i++) {
-            genres << genreElements.at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
+
+    applyDeferredValues();
+    m_artist.setHasChanged(false);
+}
+
+void ArtistXmlReader::artistThumb(QXmlStreamReader& reader, ImageType type)
+{
+    const QString preview = reader.attributes().value("preview").toString();
+    const QString aspect = reader.attributes().value("aspect").toString();
+
+    Poster p;
+    p.originalUrl = reader.readElementText();
+    p.thumbUrl = preview.trimmed().isEmpty() ? p.originalUrl : preview;
+    p.aspect = aspect.trimmed();
+    m_artist.addImage(type, p);
+}
+
+void ArtistXmlReader::artistFanart(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("thumb")) {
+            artistThumb(reader, ImageType::ArtistFanart);
+        } else {
+            reader.skipCurrentElement();
         }
-        if (!genres.isEmpty()) {
-            m_artist.setGenres(genres);
+    }
+}
+
+void ArtistXmlReader::artistAlbum(QXmlStreamReader& reader)
+{
+    DiscographyAlbum a;
+    bool hasTitle = false;
+    bool hasYear = false;
+    while (reader.readNextStartElement()) {
+        if (!hasTitle && reader.name() == QLatin1String("title")) {
+            hasTitle = true;
+            a.title = reader.readElementText();
+        } else if (!hasYear && reader.name() == QLatin1String("year")) {
+            hasYear = true;
+            a.year = reader.readElementText();
+        } else {
+            reader.skipCurrentElement();
         }
     }
-    for (int i = 0, n = domDoc.elementsByTagName("style").size(); i < n; i++) {
-        m_artist.addStyle(domDoc.elementsByTagName("style").at(i).toElement().text());
+    m_artist.addDiscographyAlbum(a);
+}
+
+void ArtistXmlReader::applyDeferredValues()
+{
+    if (m_firstValues.contains("musicBrainzArtistID")) {
+        m_artist.setMbId(MusicBrainzId(m_firstValues.value("musicBrainzArtistID")));
     }
-    for (int i = 0, n = domDoc.elementsByTagName("mood").size(); i < n; i++) {
-        m_artist.addMood(domDoc.elementsByTagName("mood").at(i).toElement().text());
+    if (m_firstValues.contains("allmusicid")) {
+        m_artist.setAllMusicId(AllMusicId(m_firstValues.value("allmusicid")));
     }
-    if (!domDoc.elementsByTagName("yearsactive").isEmpty()) {
-        m_artist.setYearsActive(domDoc.elementsByTagName("yearsactive").at(0).toElement().text());
+    if (m_firstValues.contains("name")) {
+        m_artist.setName(m_firstValues.value("name"));
     }
-    if (!domDoc.elementsByTagName("formed").isEmpty()) {
-        m_artist.setFormed(domDoc.elementsByTagName("formed").at(0).toElement().text());
+    if (!m_genres.isEmpty()) {
+        m_artist.setGenres(m_genres);
     }
-    if (!domDoc.elementsByTagName("biography").isEmpty()) {
-        m_artist.setBiography(domDoc.elementsByTagName("biography").at(0).toElement().text());
+    if (m_firstValues.contains("yearsactive")) {
+        m_artist.setYearsActive(m_firstValues.value("yearsactive"));
     }
-    if (!domDoc.elementsByTagName("born").isEmpty()) {
-        m_artist.setBorn(domDoc.elementsByTagName("born").at(0).toElement().text());
+    if (m_firstValues.contains("formed")) {
+        m_artist.setFormed(m_firstValues.value("formed"));
     }
-    if (!domDoc.elementsByTagName("died").isEmpty()) {
-        m_artist.setDied(domDoc.elementsByTagName("died").at(0).toElement().text());
+    if (m_firstValues.contains("biography")) {
+        m_artist.setBiography(m_firstValues.value("biography"));
     }
-    if (!domDoc.elementsByTagName("disbanded").isEmpty()) {
-        m_artist.setDisbanded(domDoc.elementsByTagName("disbanded").at(0).toElement().text());
+    if (m_firstValues.contains("born")) {
+        m_artist.setBorn(m_firstValues.value("born"));
     }
-
-    QDomNodeList thumbElements = domDoc.elementsByTagName("thumb");
-    for (int i = 0, n = thumbElements.size(); i < n; i++) {
-        QString parentTag = thumbElements.at(i).parentNode().toElement().tagName();
-        QDomElement thumb = thumbElements.at(i).toElement();
-
-        Poster p;
-        p.originalUrl = thumb.text();
-        p.thumbUrl = thumb.attribute("preview").trimmed().isEmpty() ? p.originalUrl : thumb.attribute("preview");
-        p.aspect = thumb.attribute("aspect").trimmed();
-
-        if (parentTag == "artist") {
-            m_artist.addImage(ImageType::ArtistThumb, p);
-
-        } else if (parentTag == "fanart") {
-            m_artist.addImage(ImageType::ArtistFanart, p);
-        }
+    if (m_firstValues.contains("died")) {
+        m_artist.setDied(m_firstValues.value("died"));
     }
-
-    QDomNodeList albumElements = domDoc.elementsByTagName("album");
-    for (int i = 0, n = albumElements.size(); i < n; i++) {
-        QDomElement album = albumElements.at(i).toElement();
-
-        DiscographyAlbum a;
-        if (!album.elementsByTagName("title").isEmpty()) {
-            a.title = album.elementsByTagName("title").at(0).toElement().text();
-        }
-        if (!album.elementsByTagName("year").isEmpty()) {
-            a.year = album.elementsByTagName("year").at(0).toElement().text();
-        }
-        m_artist.addDiscographyAlbum(a);
+    if (m_firstValues.contains("disbanded")) {
+        m_artist.setDisbanded(m_firstValues.value("disbanded"));
     }
-
-    m_artist.setHasChanged(false);
 }
 
 } // namespace kodi
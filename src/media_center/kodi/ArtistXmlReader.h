@@ -1,6 +1,11 @@
 #pragma once
 
-#include <QDomElement>
+#include "globals/Globals.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QXmlStreamReader>
 
 class Artist;
 
@@ -11,10 +16,19 @@ class ArtistXmlReader
 {
 public:
     explicit ArtistXmlReader(Artist& artist);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Parses the <artist> element of an artist NFO file in a single pass.
+    void parse(QXmlStreamReader& reader);
 
 private:
+    void artistThumb(QXmlStreamReader& reader, ImageType type);
+    void artistFanart(QXmlStreamReader& reader);
+    void artistAlbum(QXmlStreamReader& reader);
+    void applyDeferredValues();
+
     Artist& m_artist;
+    /// \brief Texts of tags that are only read once, i.e. the first occurrence wins.
+    QHash<QString, QString> m_firstValues;
+    QStringList m_genres;
 };
 
 } // namespace kodi
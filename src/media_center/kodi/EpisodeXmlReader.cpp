@@ -3,10 +3,11 @@
 #include "data/tv_show/TvShowEpisode.h"
 #include "globals/Globals.h"
 #include "log/Log.h"
+#include "media_center/kodi/KodiXmlReader.h"
+#include "utils/Meta.h"
 
 #include <QDate>
-#include <QDomElement>
-#include <QFileInfo>
+#include <QSet>
 #include <QTime>
 #include <QUrl>
 
@@ -17,33 +18,92 @@ EpisodeXmlReader::EpisodeXmlReader(TvShowEpisode& episode) : m_episode{episode}
 {
 }
 
-void EpisodeXmlReader::parseNfoDom(QDomElement episodeDetails)
+void EpisodeXmlReader::parse(QXmlStreamReader& reader)
 {
+    // Tags that may only exist once.  They are applied after all others, see applyDeferredValues().
+    static const QSet<QString> singleValueTags{"id",
+        "tvdbid",
+        "imdbid",
+        "title",
+        "showtitle",
+        "season",
+        "episode",
+        "displayseason",
+        "displayepisode",
+        "rating",
+        "votes",
+        "top250",
+        "plot",
+        "mpaa",
+        "aired",
+        "playcount",
+        "epbookmark",
+        "lastplayed",
+        "studio",
+        "thumb"};
+
+    while (reader.readNextStartElement()) {
+        const QString tagName = reader.name().toString();
+
+        if (singleValueTags.contains(tagName)) {
+            const QString value = reader.readElementText();
+            if (!m_firstValues.contains(tagName)) {
+                m_firstValues.insert(tagName, value);
+            }
+
+        } else if (tagName == "uniqueid") {
+            const QString type = reader.attributes().value("type").toString();
+            m_uniqueIds.append({type, reader.readElementText().trimmed()});
+
+        } else if (tagName == "ratings" && !m_hasRatings) {
+            episodeRatings(reader);
+
+        } else if (tagName == "tag") {
+            // tags are officially not yet supported, even by Kodi 19 but scraper providers start
+            // to support them
+            m_episode.addTag(reader.readElementText());
+
+        } else if (tagName == "credits") {
+            m_episode.addWriter(reader.readElementText());
+
+        } else if (tagName == "director") {
+            m_episode.addDirector(reader.readElementText());
+
+        } else if (tagName == "actor") {
+            episodeActor(reader);
+
+        } else if (tagName == "fileinfo") {
+            episodeFileInfo(reader);
+
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    applyDeferredValues();
+}
+
+void EpisodeXmlReader::applyDeferredValues()
+{
+    // Order matters: Some of these tags override others.
+
     // v17/v18 TvDbId
-    if (!episodeDetails.elementsByTagName("id").isEmpty()) {
-        m_episode.setTvdbId(TvDbId(episodeDetails.elementsByTagName("id").at(0).toElement().text()));
+    if (m_firstValues.contains("id")) {
+        m_episode.setTvdbId(TvDbId(m_firstValues.value("id")));
     }
 
     // v16 TvDbId/ImdbId
-    if (!episodeDetails.elementsByTagName("tvdbid").isEmpty()) {
-        QString value = episodeDetails.elementsByTagName("tvdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_episode.setTvdbId(TvDbId(value));
-        }
+    if (!m_firstValues.value("tvdbid").isEmpty()) {
+        m_episode.setTvdbId(TvDbId(m_firstValues.value("tvdbid")));
     }
-    if (!episodeDetails.elementsByTagName("imdbid").isEmpty()) {
-        QString value = episodeDetails.elementsByTagName("imdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_episode.setImdbId(ImdbId(value));
-        }
+    if (!m_firstValues.value("imdbid").isEmpty()) {
+        m_episode.setImdbId(ImdbId(m_firstValues.value("imdbid")));
     }
 
     // v17 ids
-    auto uniqueIds = episodeDetails.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        const QString& type = uniqueId.first;
+        const QString& value = uniqueId.second;
 
         if (value.isEmpty()) {
             // Silently skip empty values; we wouldn't get any benefit from them
@@ -63,77 +123,35 @@ void EpisodeXmlReader::parseNfoDom(QDomElement episodeDetails)
         }
     }
 
-    if (!episodeDetails.elementsByTagName("title").isEmpty()) {
-        m_episode.setTitle(episodeDetails.elementsByTagName("title").at(0).toElement().text());
+    if (m_firstValues.contains("title")) {
+        m_episode.setTitle(m_firstValues.value("title"));
     }
-    if (!episodeDetails.elementsByTagName("showtitle").isEmpty()) {
-        m_episode.setShowTitle(episodeDetails.elementsByTagName("showtitle").at(0).toElement().text());
+    if (m_firstValues.contains("showtitle")) {
+        m_episode.setShowTitle(m_firstValues.value("showtitle"));
     }
-    if (!episodeDetails.elementsByTagName("season").isEmpty()) {
-        m_episode.setSeason(SeasonNumber(episodeDetails.elementsByTagName("season").at(0).toElement().text().toInt()));
+    if (m_firstValues.contains("season")) {
+        m_episode.setSeason(SeasonNumber(m_firstValues.value("season").toInt()));
     }
-    if (!episodeDetails.elementsByTagName("episode").isEmpty()) {
-        m_episode.setEpisode(
-            EpisodeNumber(episodeDetails.elementsByTagName("episode").at(0).toElement().text().toInt()));
+    if (m_firstValues.contains("episode")) {
+        m_episode.setEpisode(EpisodeNumber(m_firstValues.value("episode").toInt()));
     }
-    if (!episodeDetails.elementsByTagName("displayseason").isEmpty()) {
-        m_episode.setDisplaySeason(
-            SeasonNumber(episodeDetails.elementsByTagName("displayseason").at(0).toElement().text().toInt()));
+    if (m_firstValues.contains("displayseason")) {
+        m_episode.setDisplaySeason(SeasonNumber(m_firstValues.value("displayseason").toInt()));
     }
-    if (!episodeDetails.elementsByTagName("displayepisode").isEmpty()) {
-        m_episode.setDisplayEpisode(
-            EpisodeNumber(episodeDetails.elementsByTagName("displayepisode").at(0).toElement().text().toInt()));
+    if (m_firstValues.contains("displayepisode")) {
+        m_episode.setDisplayEpisode(EpisodeNumber(m_firstValues.value("displayepisode").toInt()));
     }
 
-    // check for new ratings syntax
-    if (!episodeDetails.elementsByTagName("ratings").isEmpty()) {
-        // <ratings>
-        //   <rating name="default" default="true">
-        //     <value>10</value>
-        //     <votes>10</votes>
-        //   </rating>
-        // </ratings>
-        auto ratings = episodeDetails.elementsByTagName("ratings").at(0).toElement().elementsByTagName("rating");
-        m_episode.ratings().clear();
-
-        for (int i = 0; i < ratings.length(); ++i) {
-            Rating rating;
-            auto ratingElement = ratings.at(i).toElement();
-            rating.source = ratingElement.attribute("name", "default");
-            bool ok = false;
-            const int max = ratingElement.attribute("max", "0").toInt(&ok);
-            if (ok && max > 0) {
-                rating.maxRating = max;
-            }
-            rating.rating =
-                ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-            rating.voteCount = ratingElement.elementsByTagName("votes")
-                                   .at(0)
-                                   .toElement()
-                                   .text()
-                                   .replace(",", "")
-                                   .replace(".", "")
-                                   .toInt();
-            m_episode.ratings().setOrAddRating(rating);
-            m_episode.setChanged(true);
-        }
-
-    } else if (!episodeDetails.elementsByTagName("rating").isEmpty()) {
+    if (!m_hasRatings && m_firstValues.contains("rating")) {
         // otherwise use "old" syntax:
         // <rating>10.0</rating>
         // <votes>10.0</votes>
-        QString value = episodeDetails.elementsByTagName("rating").at(0).toElement().text();
+        QString value = m_firstValues.value("rating");
         if (!value.isEmpty()) {
             Rating rating;
             rating.rating = value.replace(",", ".").toDouble();
-            if (!episodeDetails.elementsByTagName("votes").isEmpty()) {
-                rating.voteCount = episodeDetails.elementsByTagName("votes")
-                                       .at(0)
-                                       .toElement()
-                                       .text()
-                                       .replace(",", "")
-                                       .replace(".", "")
-                                       .toInt();
+            if (m_firstValues.contains("votes")) {
+                rating.voteCount = m_firstValues.value("votes").replace(",", "").replace(".", "").toInt();
             }
             // Note: We clear exiting ratings because there can only be one v16 rating tag.
             m_episode.ratings().clear();
@@ -142,81 +160,103 @@ void EpisodeXmlReader::parseNfoDom(QDomElement episodeDetails)
         }
     }
 
-    if (!episodeDetails.elementsByTagName("top250").isEmpty()) {
-        m_episode.setTop250(episodeDetails.elementsByTagName("top250").at(0).toElement().text().toInt());
+    if (m_firstValues.contains("top250")) {
+        m_episode.setTop250(m_firstValues.value("top250").toInt());
     }
-    if (!episodeDetails.elementsByTagName("plot").isEmpty()) {
-        m_episode.setOverview(episodeDetails.elementsByTagName("plot").at(0).toElement().text());
+    if (m_firstValues.contains("plot")) {
+        m_episode.setOverview(m_firstValues.value("plot"));
     }
-    if (!episodeDetails.elementsByTagName("mpaa").isEmpty()) {
-        m_episode.setCertification(Certification(episodeDetails.elementsByTagName("mpaa").at(0).toElement().text()));
+    if (m_firstValues.contains("mpaa")) {
+        m_episode.setCertification(Certification(m_firstValues.value("mpaa")));
     }
-    if (!episodeDetails.elementsByTagName("aired").isEmpty()) {
-        const QDomElement aired = episodeDetails.elementsByTagName("aired").at(0).toElement();
-        if (!aired.isNull() && !aired.text().isEmpty()) {
-            const QDate date = QDate::fromString(aired.text(), "yyyy-MM-dd");
-            if (date.isValid()) {
-                m_episode.setFirstAired(date);
-            }
+    if (!m_firstValues.value("aired").isEmpty()) {
+        const QDate date = QDate::fromString(m_firstValues.value("aired"), "yyyy-MM-dd");
+        if (date.isValid()) {
+            m_episode.setFirstAired(date);
         }
     }
-    if (!episodeDetails.elementsByTagName("playcount").isEmpty()) {
-        m_episode.setPlayCount(episodeDetails.elementsByTagName("playcount").at(0).toElement().text().toInt());
-    }
-    if (!episodeDetails.elementsByTagName("epbookmark").isEmpty()) {
-        m_episode.setEpBookmark(
-            QTime(0, 0, 0).addSecs(episodeDetails.elementsByTagName("epbookmark").at(0).toElement().text().toInt()));
-    }
-    if (!episodeDetails.elementsByTagName("lastplayed").isEmpty()) {
-        const QDomElement lastplayed = episodeDetails.elementsByTagName("lastplayed").at(0).toElement();
-        if (!lastplayed.isNull() && !lastplayed.text().isEmpty()) {
-            const QDateTime dateTime = QDateTime::fromString(lastplayed.text(), "yyyy-MM-dd HH:mm:ss");
-            if (dateTime.isValid()) {
-                m_episode.setLastPlayed(dateTime);
-            } else {
-                const QDateTime date = QDateTime::fromString(lastplayed.text(), "yyyy-MM-dd");
-                if (date.isValid()) {
-                    m_episode.setLastPlayed(date);
-                }
+    if (m_firstValues.contains("playcount")) {
+        m_episode.setPlayCount(m_firstValues.value("playcount").toInt());
+    }
+    if (m_firstValues.contains("epbookmark")) {
+        m_episode.setEpBookmark(QTime(0, 0, 0).addSecs(m_firstValues.value("epbookmark").toInt()));
+    }
+    if (!m_firstValues.value("lastplayed").isEmpty()) {
+        const QString lastplayed = m_firstValues.value("lastplayed");
+        const QDateTime dateTime = QDateTime::fromString(lastplayed, "yyyy-MM-dd HH:mm:ss");
+        if (dateTime.isValid()) {
+            m_episode.setLastPlayed(dateTime);
+        } else {
+            const QDateTime date = QDateTime::fromString(lastplayed, "yyyy-MM-dd");
+            if (date.isValid()) {
+                m_episode.setLastPlayed(date);
             }
         }
     }
-    if (!episodeDetails.elementsByTagName("studio").isEmpty()) {
-        m_episode.setNetwork(episodeDetails.elementsByTagName("studio").at(0).toElement().text());
+    if (m_firstValues.contains("studio")) {
+        m_episode.setNetwork(m_firstValues.value("studio"));
     }
-
-    // tags are officially not yet supported, even by Kodi 19 but scraper providers start
-    // to support them
-    for (int i = 0, n = episodeDetails.elementsByTagName("tag").size(); i < n; i++) {
-        m_episode.addTag(episodeDetails.elementsByTagName("tag").at(i).toElement().text());
+    if (m_firstValues.contains("thumb")) {
+        m_episode.setThumbnail(QUrl(m_firstValues.value("thumb")));
     }
+}
 
-    if (!episodeDetails.elementsByTagName("thumb").isEmpty()) {
-        m_episode.setThumbnail(QUrl(episodeDetails.elementsByTagName("thumb").at(0).toElement().text()));
-    }
-    for (int i = 0, n = episodeDetails.elementsByTagName("credits").size(); i < n; i++) {
-        m_episode.addWriter(episodeDetails.elementsByTagName("credits").at(i).toElement().text());
-    }
-    for (int i = 0, n = episodeDetails.elementsByTagName("director").size(); i < n; i++) {
-        m_episode.addDirector(episodeDetails.elementsByTagName("director").at(i).toElement().text());
+void EpisodeXmlReader::episodeRatings(QXmlStreamReader& reader)
+{
+    // <ratings>
+    //   <rating name="default" default="true">
+    //     <value>10</value>
+    //     <votes>10</votes>
+    //   </rating>
+    // </ratings>
+    m_hasRatings = true;
+    const QVector<Rating> ratings = readRatings(reader);
+    m_episode.ratings().clear();
+
+    for (const Rating& rating : ratings) {
+        m_episode.ratings().setOrAddRating(rating);
+        m_episode.setChanged(true);
     }
-    for (int i = 0, n = episodeDetails.elementsByTagName("actor").size(); i < n; i++) {
-        QDomElement actorElement = episodeDetails.elementsByTagName("actor").at(i).toElement();
-        Actor a;
-        a.imageHasChanged = false;
-        if (!actorElement.elementsByTagName("name").isEmpty()) {
-            a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("role").isEmpty()) {
-            a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-            a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
+}
+
+void EpisodeXmlReader::episodeActor(QXmlStreamReader& reader)
+{
+    Actor a;
+    a.imageHasChanged = false;
+    bool hasName = false;
+    bool hasRole = false;
+    bool hasThumb = false;
+    bool hasOrder = false;
+    while (reader.readNextStartElement()) {
+        if (!hasName && reader.name() == QLatin1String("name")) {
+            hasName = true;
+            a.name = reader.readElementText();
+        } else if (!hasRole && reader.name() == QLatin1String("role")) {
+            hasRole = true;
+            a.role = reader.readElementText();
+        } else if (!hasThumb && reader.name() == QLatin1String("thumb")) {
+            hasThumb = true;
+            a.thumb = reader.readElementText();
+        } else if (!hasOrder && reader.name() == QLatin1String("order")) {
+            hasOrder = true;
+            a.order = reader.readElementText().toInt();
+        } else {
+            reader.skipCurrentElement();
         }
-        if (!actorElement.elementsByTagName("order").isEmpty()) {
-            a.order = actorElement.elementsByTagName("order").at(0).toElement().text().toInt();
+    }
+    m_episode.addActor(a);
+}
+
+void EpisodeXmlReader::episodeFileInfo(QXmlStreamReader& reader)
+{
+    while (reader.readNextStartElement()) {
+        if (!m_hasStreamDetails && reader.name() == QLatin1String("streamdetails")
+            && m_episode.streamDetails() != nullptr) {
+            m_hasStreamDetails = true;
+            readStreamDetails(reader, *m_episode.streamDetails());
+        } else {
+            reader.skipCurrentElement();
         }
-        m_episode.addActor(a);
     }
 }
 
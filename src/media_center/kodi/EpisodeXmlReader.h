@@ -1,7 +1,10 @@
 #pragma once
 
-#include <QDomElement>
+#include <QHash>
+#include <QPair>
 #include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
 
 class TvShowEpisode;
 
@@ -12,12 +15,25 @@ class EpisodeXmlReader
 {
 public:
     explicit EpisodeXmlReader(TvShowEpisode& episode);
-    void parseNfoDom(QDomElement episodeDetails);
+    /// \brief Parses an <episodedetails> element in a single pass.
+    ///        The reader must be positioned at its start element.
+    void parse(QXmlStreamReader& reader);
 
     static QString makeValidEpisodeXml(const QString& nfoContent);
 
 private:
+    void episodeRatings(QXmlStreamReader& reader);
+    void episodeActor(QXmlStreamReader& reader);
+    void episodeFileInfo(QXmlStreamReader& reader);
+    void applyDeferredValues();
+
     TvShowEpisode& m_episode;
+    /// \brief Texts of tags that are only read once, i.e. the first occurrence wins.
+    QHash<QString, QString> m_firstValues;
+    /// \brief Pairs of (type, id)
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    bool m_hasRatings = false;
+    bool m_hasStreamDetails = false;
 };
 
 } // namespace kodi
@@ -0,0 +1,88 @@
+#include "media_center/kodi/KodiFileIndex.h"
+
+#include <algorithm>
+
+namespace mediaelch {
+namespace kodi {
+
+void KodiFileIndex::insert(int id, const QString& file)
+{
+    QStringList files;
+    if (file.startsWith("stack://")) {
+        files = file.mid(8).split(" , ");
+    } else {
+        files << file;
+    }
+
+    for (int level = 0; level <= MAX_LEVEL; ++level) {
+        const QString k = key(files, level);
+        if (k.isNull()) {
+            // Longer suffixes won't exist either.
+            break;
+        }
+        m_levels[level][k].append(id);
+    }
+}
+
+void KodiFileIndex::clear()
+{
+    for (auto& level : m_levels) {
+        level.clear();
+    }
+}
+
+int KodiFileIndex::findId(const QStringList& files) const
+{
+    if (files.isEmpty()) {
+        return -1;
+    }
+
+    // Items that match on a higher level also match on all lower ones, so we
+    // only need to go up as long as there is more than one match.
+    for (int level = 0; level <= MAX_LEVEL; ++level) {
+        const QString k = key(files, level);
+        if (k.isNull()) {
+            return 0;
+        }
+        const QVector<int> matches = m_levels[level].value(k);
+        if (matches.isEmpty()) {
+            return 0;
+        }
+        if (matches.size() == 1) {
+            return matches.first();
+        }
+    }
+    return -1;
+}
+
+QStringList KodiFileIndex::splitFile(const QString& file)
+{
+    // Windows file names must not contain /
+    if (file.contains("/")) {
+        return file.split("/");
+    }
+    return file.split("\\");
+}
+
+QString KodiFileIndex::key(const QStringList& files, int level)
+{
+    QStringList suffixes;
+    for (const QString& file : files) {
+        const QStringList parts = splitFile(file);
+        if (parts.size() < level + 1) {
+            return QString();
+        }
+        suffixes << parts.mid(parts.size() - level - 1).join("/");
+    }
+
+    // Single files are compared case-insensitively, stacked files are not
+    // but their order does not matter.
+    if (suffixes.size() == 1) {
+        return QStringLiteral("1\n") + suffixes.first().toCaseFolded();
+    }
+    std::sort(suffixes.begin(), suffixes.end());
+    return QString::number(suffixes.size()) + "\n" + suffixes.join("\n");
+}
+
+} // namespace kodi
+} // namespace mediaelch
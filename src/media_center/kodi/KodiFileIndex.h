@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <array>
+
+namespace mediaelch {
+namespace kodi {
+
+/// \brief Finds Kodi library items by their files.
+///
+/// Kodi and MediaElch may see the same file under different paths, e.g.
+/// "smb://nas/movies/Movie/Movie.mkv" and "/mnt/movies/Movie/Movie.mkv".
+/// Files are therefore matched by their last path components: first only by
+/// the file name and, if that is ambiguous, by more and more parent directories.
+///
+/// For each of these levels, the index contains a hash table, so that looking
+/// up a file does not require comparing it to all items in Kodi's library.
+///
+/// \par Example
+/// \code{cpp}
+///   KodiFileIndex index;
+///   index.insert(42, "smb://nas/movies/Movie/Movie.mkv");
+///   index.findId({"/mnt/movies/Movie/Movie.mkv"}); // == 42
+/// \endcode
+class KodiFileIndex
+{
+public:
+    /// \brief Add a Kodi item.
+    /// \param id Kodi's ID, e.g. "movieid"
+    /// \param file Kodi's file, may be a stack, i.e. "stack://a.mkv , b.mkv"
+    void insert(int id, const QString& file);
+    void clear();
+
+    /// \brief Find the Kodi item for the given (local) files.
+    /// \return The item's ID, 0 if no item matches or -1 if the match is ambiguous.
+    int findId(const QStringList& files) const;
+
+private:
+    /// \brief Number of additional parent directories that are compared if file names are ambiguous.
+    static constexpr int MAX_LEVEL = 4;
+
+    static QStringList splitFile(const QString& file);
+    /// \brief Key of the given files for the given level.  Null if there are
+    ///        not enough path components.
+    static QString key(const QStringList& files, int level);
+
+private:
+    std::array<QHash<QString, QVector<int>>, MAX_LEVEL + 1> m_levels;
+};
+
+} // namespace kodi
+} // namespace mediaelch
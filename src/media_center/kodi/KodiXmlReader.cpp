@@ -0,0 +1,268 @@
+#include "media_center/kodi/KodiXmlReader.h"
+
+#include "media/StreamDetails.h"
+#include "utils/Meta.h"
+
+#include <QHash>
+#include <QStringList>
+#include <array>
+
+namespace mediaelch {
+namespace kodi {
+
+static bool isBlockTag(const QString& tagName)
+{
+    static const QStringList blockTags{"p", "div", "li", "ul", "ol", "h1", "h2", "h3", "h4", "h5", "h6", "tr"};
+    return blockTags.contains(tagName);
+}
+
+/// \brief Decodes the entity, e.g. "amp" or "#x27".  Returns a null string for unknown entities.
+static QString decodeEntity(const QString& entity)
+{
+    if (entity.startsWith('#')) {
+        bool ok = false;
+        const uint code = (entity.size() > 1 && (entity.at(1) == 'x' || entity.at(1) == 'X'))
+                              ? entity.mid(2).toUInt(&ok, 16)
+                              : entity.mid(1).toUInt(&ok, 10);
+        if (!ok || code == 0 || code > 0x10FFFF) {
+            return QString();
+        }
+        if (QChar::requiresSurrogates(code)) {
+            return QString(QChar(QChar::highSurrogate(code))) + QChar(QChar::lowSurrogate(code));
+        }
+        return QString(QChar(code));
+    }
+
+    static const QHash<QString, QChar> namedEntities{
+        {"amp", '&'},
+        {"lt", '<'},
+        {"gt", '>'},
+        {"quot", '"'},
+        {"apos", '\''},
+        {"nbsp", ' '}, // QTextDocument::toPlainText() replaces non-breaking spaces as well
+        {"copy", QChar(0x00A9)},
+        {"reg", QChar(0x00AE)},
+        {"trade", QChar(0x2122)},
+        {"hellip", QChar(0x2026)},
+        {"ndash", QChar(0x2013)},
+        {"mdash", QChar(0x2014)},
+        {"lsquo", QChar(0x2018)},
+        {"rsquo", QChar(0x2019)},
+        {"ldquo", QChar(0x201C)},
+        {"rdquo", QChar(0x201D)},
+        {"laquo", QChar(0x00AB)},
+        {"raquo", QChar(0x00BB)},
+        {"euro", QChar(0x20AC)},
+    };
+    const auto decoded = namedEntities.constFind(entity);
+    return decoded != namedEntities.constEnd() ? QString(*decoded) : QString();
+}
+
+QString htmlToPlainText(const QString& html)
+{
+    QString text;
+    text.reserve(html.size());
+
+    // Same as in HTML: Whitespace is collapsed and only written if it is followed by text.
+    bool pendingSpace = false;
+    const auto append = [&](const QString& str) {
+        if (pendingSpace && !text.isEmpty() && !text.endsWith('\n')) {
+            text.append(' ');
+        }
+        pendingSpace = false;
+        text.append(str);
+    };
+    const auto newLine = [&]() {
+        pendingSpace = false;
+        if (!text.isEmpty() && !text.endsWith('\n')) {
+            text.append('\n');
+        }
+    };
+
+    for (elch_ssize_t i = 0, n = html.size(); i < n; ++i) {
+        const QChar c = html.at(i);
+
+        if (c == '<') {
+            const elch_ssize_t end = html.indexOf('>', i);
+            if (end < 0) {
+                append(c);
+                continue;
+            }
+            // Tag name without "/" of closing tags and without attributes
+            QString tagName;
+            for (elch_ssize_t j = html.at(i + 1) == '/' ? i + 2 : i + 1; j < end; ++j) {
+                if (html.at(j).isSpace() || html.at(j) == '/') {
+                    break;
+                }
+                tagName.append(html.at(j).toLower());
+            }
+            if (tagName == "br") {
+                pendingSpace = false;
+                text.append('\n');
+            } else if (isBlockTag(tagName)) {
+                newLine();
+            }
+            i = end;
+
+        } else if (c == '&') {
+            const elch_ssize_t end = html.indexOf(';', i);
+            QString decoded;
+            // Entities are short; a far away semicolon belongs to the text.
+            if (end > i + 1 && end - i <= 10) {
+                decoded = decodeEntity(html.mid(i + 1, end - i - 1));
+            }
+            if (decoded.isNull()) {
+                append(c);
+            } else {
+                append(decoded);
+                i = end;
+            }
+
+        } else if (c.isSpace() && c != QChar::Nbsp) {
+            pendingSpace = true;
+
+        } else if (c == QChar::Nbsp) {
+            append(" ");
+
+        } else {
+            append(c);
+        }
+    }
+
+    while (text.endsWith('\n')) {
+        text.chop(1);
+    }
+    return text;
+}
+
+QVector<Rating> readRatings(QXmlStreamReader& reader)
+{
+    QVector<Rating> ratings;
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("rating")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+
+        Rating rating;
+        const QXmlStreamAttributes attributes = reader.attributes();
+        if (attributes.hasAttribute("name")) {
+            rating.source = attributes.value("name").toString();
+        }
+        bool ok = false;
+        const int max = attributes.value("max").toString().toInt(&ok);
+        if (ok && max > 0) {
+            rating.maxRating = max;
+        }
+
+        bool hasValue = false;
+        bool hasVotes = false;
+        while (reader.readNextStartElement()) {
+            if (!hasValue && reader.name() == QLatin1String("value")) {
+                hasValue = true;
+                rating.rating = reader.readElementText().replace(",", ".").toDouble();
+
+            } else if (!hasVotes && reader.name() == QLatin1String("votes")) {
+                hasVotes = true;
+                rating.voteCount = reader.readElementText().replace(",", "").replace(".", "").toInt();
+
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+        ratings.append(rating);
+    }
+    return ratings;
+}
+
+/// \brief Reads the child elements of the current element that are named like the given details.
+///        Only the first element of each detail is stored.
+template<class Detail, std::size_t N, class Store>
+static void readDetails(QXmlStreamReader& reader, const std::array<Detail, N>& details, Store store)
+{
+    std::array<bool, N> found{};
+    while (reader.readNextStartElement()) {
+        bool handled = false;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (!found[i] && reader.name() == StreamDetails::detailToString(details[i])) {
+                found[i] = true;
+                handled = true;
+                store(details[i], reader.readElementText());
+                break;
+            }
+        }
+        if (!handled) {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+bool readStreamDetails(QXmlStreamReader& reader, StreamDetails& streamDetails)
+{
+    static const std::array<StreamDetails::VideoDetails, 7> videoDetails{StreamDetails::VideoDetails::Codec,
+        StreamDetails::VideoDetails::Aspect,
+        StreamDetails::VideoDetails::Width,
+        StreamDetails::VideoDetails::Height,
+        StreamDetails::VideoDetails::DurationInSeconds,
+        StreamDetails::VideoDetails::ScanType,
+        StreamDetails::VideoDetails::StereoMode};
+    static const std::array<StreamDetails::AudioDetails, 3> audioDetails{StreamDetails::AudioDetails::Codec,
+        StreamDetails::AudioDetails::Language,
+        StreamDetails::AudioDetails::Channels};
+    const QString subtitleLanguage = StreamDetails::detailToString(StreamDetails::SubtitleDetails::Language);
+
+    bool hasVideo = false;
+    int audioStream = 0;
+    int subtitleStream = 0;
+
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("video")) {
+            if (hasVideo) {
+                // Only the first video stream is supported.
+                reader.skipCurrentElement();
+                continue;
+            }
+            hasVideo = true;
+            readDetails(reader, videoDetails, [&](StreamDetails::VideoDetails detail, const QString& value) {
+                streamDetails.setVideoDetail(detail, value);
+            });
+
+        } else if (reader.name() == QLatin1String("audio")) {
+            readDetails(reader, audioDetails, [&](StreamDetails::AudioDetails detail, const QString& value) {
+                streamDetails.setAudioDetail(audioStream, detail, value);
+            });
+            ++audioStream;
+
+        } else if (reader.name() == QLatin1String("subtitle")) {
+            // External subtitles have a <file> tag and are not part of the stream details.
+            bool isExternal = false;
+            bool hasLanguage = false;
+            QString language;
+            while (reader.readNextStartElement()) {
+                if (reader.name() == QLatin1String("file")) {
+                    isExternal = true;
+                    reader.skipCurrentElement();
+                } else if (!hasLanguage && reader.name() == subtitleLanguage) {
+                    hasLanguage = true;
+                    language = reader.readElementText();
+                } else {
+                    reader.skipCurrentElement();
+                }
+            }
+            if (!isExternal && hasLanguage) {
+                streamDetails.setSubtitleDetail(subtitleStream, StreamDetails::SubtitleDetails::Language, language);
+            }
+            ++subtitleStream;
+
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    const bool hasDetails = hasVideo || audioStream > 0 || subtitleStream > 0;
+    streamDetails.setLoaded(hasDetails);
+    return hasDetails;
+}
+
+} // namespace kodi
+} // namespace mediaelch
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "data/Rating.h"
+
+#include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
+
+class StreamDetails;
+
+namespace mediaelch {
+namespace kodi {
+
+/// \brief Converts an HTML string into plain text, i.e. decodes entities such as
+///        "&amp;amp;", removes tags and collapses whitespace.
+/// \details Lightweight replacement for QTextDocument::setHtml() + toPlainText(),
+///          which is far too expensive to be used for each value of an NFO file.
+QString htmlToPlainText(const QString& html);
+
+/// \brief Reads Kodi's <ratings> element.  The reader must be positioned at its start element.
+/// \code{xml}
+///   <ratings>
+///     <rating name="default" default="true" max="10">
+///       <value>10</value>
+///       <votes>10</votes>
+///     </rating>
+///   </ratings>
+/// \endcode
+QVector<Rating> readRatings(QXmlStreamReader& reader);
+
+/// \brief Reads Kodi's <streamdetails> element.  The reader must be positioned at its start element.
+/// \return Whether there is at least one video, audio or subtitle stream.
+bool readStreamDetails(QXmlStreamReader& reader, StreamDetails& streamDetails);
+
+} // namespace kodi
+} // namespace mediaelch
@@ -1,153 +1,169 @@
 #include "media_center/kodi/MovieXmlReader.h"
 
 #include "data/movie/Movie.h"
-#include "log/Log.h"
-#include "media_center/kodi/KodiXmlWriter.h"
+#include "media_center/kodi/KodiXmlReader.h"
 
 #include <QDate>
-#include <QDomDocument>
-#include <QDomNodeList>
 #include <QStringList>
-#include <QTextDocument>
 #include <QUrl>
 
 namespace mediaelch {
 namespace kodi {
 
-static QString htmlUnescape(const QString& htmlEscaped)
-{
-    QTextDocument doc;
-    doc.setHtml(htmlEscaped);
-    return doc.toPlainText();
-}
-
 MovieXmlReader::MovieXmlReader(Movie& movie) : m_movie{movie}
 {
 }
 
-void MovieXmlReader::parseNfoDom(QDomDocument domDoc)
+void MovieXmlReader::parse(QXmlStreamReader& reader)
 {
-    if (domDoc.elementsByTagName("movie").isEmpty()) {
-        qCWarning(generic) << "[MovieXmlReader] No <movie> tag in the document";
+    if (!reader.readNextStartElement()) {
         return;
     }
-    QDomElement movieElement = domDoc.elementsByTagName("movie").at(0).toElement();
-    QMap<QString, void (MovieXmlReader::*)(const QDomElement&)> tagParsers;
-    // clang-format off
-    tagParsers.insert("title",         &MovieXmlReader::simpleString<&Movie::setName>);
-    tagParsers.insert("originaltitle", &MovieXmlReader::simpleString<&Movie::setOriginalName>);
-    tagParsers.insert("sorttitle",     &MovieXmlReader::simpleString<&Movie::setSortTitle>);
-    tagParsers.insert("plot",          &MovieXmlReader::simpleString<&Movie::setOverview>);
-    tagParsers.insert("outline",       &MovieXmlReader::simpleString<&Movie::setOutline>);
-    tagParsers.insert("tagline",       &MovieXmlReader::simpleString<&Movie::setTagline>);
-    tagParsers.insert("set",           &MovieXmlReader::movieSet);
-    tagParsers.insert("actor",         &MovieXmlReader::movieActor);
-    tagParsers.insert("thumb",         &MovieXmlReader::movieThumbnail);
-    tagParsers.insert("fanart",        &MovieXmlReader::movieFanart);
-    tagParsers.insert("playcount",     &MovieXmlReader::simpleInt<&Movie::setPlayCount>);
-    tagParsers.insert("top250",        &MovieXmlReader::simpleInt<&Movie::setTop250>);
-    tagParsers.insert("tag",           &MovieXmlReader::simpleString<&Movie::addTag>);
-    tagParsers.insert("studio",        &MovieXmlReader::stringList<&Movie::addStudio, '/'>);
-    tagParsers.insert("genre",         &MovieXmlReader::stringList<&Movie::addGenre, '/'>);
-    tagParsers.insert("country",       &MovieXmlReader::stringList<&Movie::addCountry, '/'>);
-    tagParsers.insert("ratings",       &MovieXmlReader::movieRatingV17);
-    tagParsers.insert("rating",        &MovieXmlReader::movieRatingV16);
-    tagParsers.insert("userrating",    &MovieXmlReader::simpleDouble<&Movie::setUserRating>);
-    tagParsers.insert("votes",         &MovieXmlReader::movieVoteCountV16);
-    tagParsers.insert("dateadded",     &MovieXmlReader::simpleDateTime<&Movie::setDateAdded>);
-    tagParsers.insert("resume",        &MovieXmlReader::movieResumeTime);
-    // clang-format on
-
-    QDomNodeList nodes = movieElement.childNodes();
-    for (int i = 0; i < nodes.size(); ++i) {
-        if (nodes.at(i).isElement()) {
-            QDomElement element = nodes.at(i).toElement();
-            if (tagParsers.contains(element.tagName())) {
-                // call the stored method pointer
-                (this->*tagParsers[element.tagName()])(element);
-            }
+    if (reader.name() != QLatin1String("movie")) {
+        reader.raiseError(QObject::tr("No valid movie root entry found"));
+        return;
+    }
+
+    // Built once; looking up a tag is a single hash lookup.
+    static const QHash<QString, TagParser> tagParsers{
+        // clang-format off
+        {"title",         &MovieXmlReader::simpleString<&Movie::setName>},
+        {"originaltitle", &MovieXmlReader::simpleString<&Movie::setOriginalName>},
+        {"sorttitle",     &MovieXmlReader::simpleString<&Movie::setSortTitle>},
+        {"plot",          &MovieXmlReader::simpleString<&Movie::setOverview>},
+        {"outline",       &MovieXmlReader::simpleString<&Movie::setOutline>},
+        {"tagline",       &MovieXmlReader::simpleString<&Movie::setTagline>},
+        {"set",           &MovieXmlReader::movieSet},
+        {"actor",         &MovieXmlReader::movieActor},
+        {"thumb",         &MovieXmlReader::movieThumbnail},
+        {"fanart",        &MovieXmlReader::movieFanart},
+        {"playcount",     &MovieXmlReader::simpleInt<&Movie::setPlayCount>},
+        {"top250",        &MovieXmlReader::simpleInt<&Movie::setTop250>},
+        {"tag",           &MovieXmlReader::simpleString<&Movie::addTag>},
+        {"studio",        &MovieXmlReader::stringList<&Movie::addStudio, '/'>},
+        {"genre",         &MovieXmlReader::stringList<&Movie::addGenre, '/'>},
+        {"country",       &MovieXmlReader::stringList<&Movie::addCountry, '/'>},
+        {"ratings",       &MovieXmlReader::movieRatingV17},
+        {"rating",        &MovieXmlReader::movieRatingV16},
+        {"userrating",    &MovieXmlReader::simpleDouble<&Movie::setUserRating>},
+        {"votes",         &MovieXmlReader::movieVoteCountV16},
+        {"dateadded",     &MovieXmlReader::simpleDateTime<&Movie::setDateAdded>},
+        {"resume",        &MovieXmlReader::movieResumeTime},
+        {"fileinfo",      &MovieXmlReader::movieFileInfo},
+        {"uniqueid",      &MovieXmlReader::uniqueId},
+        {"credits",       &MovieXmlReader::credits},
+        {"director",      &MovieXmlReader::director},
+        {"year",          &MovieXmlReader::firstValue},
+        {"premiered",     &MovieXmlReader::firstValue},
+        {"runtime",       &MovieXmlReader::firstValue},
+        {"mpaa",          &MovieXmlReader::firstValue},
+        {"lastplayed",    &MovieXmlReader::firstValue},
+        {"id",            &MovieXmlReader::firstValue},
+        {"tmdbid",        &MovieXmlReader::firstValue},
+        {"trailer",       &MovieXmlReader::firstValue},
+        // clang-format on
+    };
+
+    while (reader.readNextStartElement()) {
+        const auto parser = tagParsers.constFind(reader.name().toString());
+        if (parser != tagParsers.constEnd()) {
+            // call the stored method pointer
+            (this->*parser.value())(reader);
+        } else {
+            reader.skipCurrentElement();
         }
     }
 
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_movie.setReleased(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
+    applyDeferredValues();
+}
+
+void MovieXmlReader::firstValue(QXmlStreamReader& reader)
+{
+    const QString tagName = reader.name().toString();
+    const QString value = reader.readElementText();
+    if (!m_firstValues.contains(tagName)) {
+        m_firstValues.insert(tagName, value);
+    }
+}
+
+void MovieXmlReader::uniqueId(QXmlStreamReader& reader)
+{
+    const QString type = reader.attributes().value("type").toString();
+    m_uniqueIds.append({type, reader.readElementText().trimmed()});
+}
+
+void MovieXmlReader::credits(QXmlStreamReader& reader)
+{
+    const auto credits = reader.readElementText().split(",", ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& writer : credits) {
+        m_writers.append(writer.trimmed());
+    }
+}
+
+void MovieXmlReader::director(QXmlStreamReader& reader)
+{
+    const auto directorsFound = reader.readElementText().split(",", ElchSplitBehavior::SkipEmptyParts);
+    for (const QString& director : directorsFound) {
+        m_directors.append(director.trimmed());
+    }
+}
+
+void MovieXmlReader::applyDeferredValues()
+{
+    // Order matters: Some of these tags override others.
+    if (m_firstValues.contains("year")) {
+        m_movie.setReleased(QDate::fromString(m_firstValues.value("year"), "yyyy"));
     }
     // will overwrite the release date set by <year>
-    if (!domDoc.elementsByTagName("premiered").isEmpty()) {
-        QString value = domDoc.elementsByTagName("premiered").at(0).toElement().text().trimmed();
-        QDate released = QDate::fromString(value, "yyyy-MM-dd");
+    if (m_firstValues.contains("premiered")) {
+        QDate released = QDate::fromString(m_firstValues.value("premiered").trimmed(), "yyyy-MM-dd");
         if (released.isValid()) {
             m_movie.setReleased(released);
         }
     }
 
-    if (!domDoc.elementsByTagName("runtime").isEmpty()) {
-        m_movie.setRuntime(std::chrono::minutes(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt()));
+    if (m_firstValues.contains("runtime")) {
+        m_movie.setRuntime(std::chrono::minutes(m_firstValues.value("runtime").toInt()));
     }
-    if (!domDoc.elementsByTagName("mpaa").isEmpty()) {
-        m_movie.setCertification(Certification(domDoc.elementsByTagName("mpaa").at(0).toElement().text()));
+    if (m_firstValues.contains("mpaa")) {
+        m_movie.setCertification(Certification(m_firstValues.value("mpaa")));
     }
-    if (!domDoc.elementsByTagName("lastplayed").isEmpty()) {
-        QDateTime lastPlayed = QDateTime::fromString(
-            domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss");
+    if (m_firstValues.contains("lastplayed")) {
+        const QString value = m_firstValues.value("lastplayed");
+        QDateTime lastPlayed = QDateTime::fromString(value, "yyyy-MM-dd HH:mm:ss");
         if (!lastPlayed.isValid()) {
-            lastPlayed =
-                QDateTime::fromString(domDoc.elementsByTagName("lastplayed").at(0).toElement().text(), "yyyy-MM-dd");
+            lastPlayed = QDateTime::fromString(value, "yyyy-MM-dd");
         }
         m_movie.setLastPlayed(lastPlayed);
     }
 
     // v16 imdbid
-    if (!domDoc.elementsByTagName("id").isEmpty()) {
-        m_movie.setImdbId(ImdbId(domDoc.elementsByTagName("id").at(0).toElement().text()));
+    if (m_firstValues.contains("id")) {
+        m_movie.setImdbId(ImdbId(m_firstValues.value("id")));
     }
     // v16 tmdbid
-    if (!domDoc.elementsByTagName("tmdbid").isEmpty()) {
-        m_movie.setTmdbId(TmdbId(domDoc.elementsByTagName("tmdbid").at(0).toElement().text()));
+    if (m_firstValues.contains("tmdbid")) {
+        m_movie.setTmdbId(TmdbId(m_firstValues.value("tmdbid")));
     }
     // >v17 ids
-    auto uniqueIds = domDoc.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
-        if (type == "imdb") {
-            m_movie.setImdbId(ImdbId(value));
-        } else if (type == "tmdb") {
-            m_movie.setTmdbId(TmdbId(value));
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        if (uniqueId.first == "imdb") {
+            m_movie.setImdbId(ImdbId(uniqueId.second));
+        } else if (uniqueId.first == "tmdb") {
+            m_movie.setTmdbId(TmdbId(uniqueId.second));
         }
     }
 
-    if (!domDoc.elementsByTagName("trailer").isEmpty()) {
-        m_movie.setTrailer(QUrl(domDoc.elementsByTagName("trailer").at(0).toElement().text()));
+    if (m_firstValues.contains("trailer")) {
+        m_movie.setTrailer(QUrl(m_firstValues.value("trailer")));
     }
 
-    QStringList writers;
-    for (int i = 0, n = domDoc.elementsByTagName("credits").size(); i < n; i++) {
-        const auto credits =
-            domDoc.elementsByTagName("credits").at(i).toElement().text().split(",", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& writer : credits) {
-            writers.append(writer.trimmed());
-        }
-    }
-    m_movie.setWriter(writers.join(", "));
-
-    QStringList directors;
-    for (int i = 0, n = domDoc.elementsByTagName("director").size(); i < n; i++) {
-        const auto directorsFound =
-            domDoc.elementsByTagName("director").at(i).toElement().text().split(",", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& director : directorsFound) {
-            directors.append(director.trimmed());
-        }
-    }
-    m_movie.setDirector(directors.join(", "));
+    m_movie.setWriter(m_writers.join(", "));
+    m_movie.setDirector(m_directors.join(", "));
 }
 
-void MovieXmlReader::movieSet(const QDomElement& movieSetElement)
+void MovieXmlReader::movieSet(QXmlStreamReader& reader)
 {
-    const QDomNodeList setNameElements = movieSetElement.elementsByTagName("name");
-    const QDomNodeList setOverviewElements = movieSetElement.elementsByTagName("overview");
-
     // We need to support both the old and new XML syntax.
     //
     // New Kodi v17 XML Syntax:
@@ -160,96 +176,110 @@ void MovieXmlReader::movieSet(const QDomElement& movieSetElement)
     //   <set>Movie Set Name</set>
     //
     MovieSet set;
-    if (!setNameElements.isEmpty()) {
-        set.name = setNameElements.at(0).toElement().text();
-    } else {
-        set.name = movieSetElement.text();
+    QString text;
+    bool hasName = false;
+    bool hasOverview = false;
+
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isEndElement()) {
+            // </set>, because child elements are read completely
+            break;
+        }
+        if (reader.isCharacters() && !reader.isWhitespace()) {
+            text.append(reader.text());
+
+        } else if (reader.isStartElement()) {
+            if (!hasName && reader.name() == QLatin1String("name")) {
+                hasName = true;
+                set.name = reader.readElementText();
+            } else if (!hasOverview && reader.name() == QLatin1String("overview")) {
+                hasOverview = true;
+                set.overview = htmlToPlainText(reader.readElementText());
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
     }
-    if (!setOverviewElements.isEmpty()) {
-        set.overview = htmlUnescape(setOverviewElements.at(0).toElement().text());
+
+    if (!hasName) {
+        set.name = text;
     }
     m_movie.setSet(set);
 }
 
-void MovieXmlReader::movieActor(const QDomElement& actorElement)
+void MovieXmlReader::movieActor(QXmlStreamReader& reader)
 {
     Actor a;
     a.imageHasChanged = false;
-    if (!actorElement.elementsByTagName("name").isEmpty()) {
-        a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-    }
-    if (!actorElement.elementsByTagName("role").isEmpty()) {
-        a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-    }
-    if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-        a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
+    bool hasName = false;
+    bool hasRole = false;
+    bool hasThumb = false;
+    while (reader.readNextStartElement()) {
+        if (!hasName && reader.name() == QLatin1String("name")) {
+            hasName = true;
+            a.name = reader.readElementText();
+        } else if (!hasRole && reader.name() == QLatin1String("role")) {
+            hasRole = true;
+            a.role = reader.readElementText();
+        } else if (!hasThumb && reader.name() == QLatin1String("thumb")) {
+            hasThumb = true;
+            a.thumb = reader.readElementText();
+        } else {
+            reader.skipCurrentElement();
+        }
     }
     m_movie.addActor(a);
 }
 
-void MovieXmlReader::movieThumbnail(const QDomElement& thumbElement)
+void MovieXmlReader::movieThumbnail(QXmlStreamReader& reader)
 {
-    QString aspect = thumbElement.attribute("aspect").trimmed();
+    QString aspect = reader.attributes().value("aspect").toString().trimmed();
     // if (aspect == "set.poster") {
     //     // TODO: special handling of set-posters, etc.
     // }
 
     Poster p;
-    p.originalUrl = QUrl(thumbElement.text());
-    p.thumbUrl = QUrl(thumbElement.attribute("preview"));
+    p.thumbUrl = QUrl(reader.attributes().value("preview").toString());
     p.aspect = aspect;
+    p.originalUrl = QUrl(reader.readElementText());
     m_movie.images().addPoster(p);
 }
 
-void MovieXmlReader::movieFanart(const QDomElement& fanartElement)
+void MovieXmlReader::movieFanart(QXmlStreamReader& reader)
 {
-    QDomNodeList thumbs = fanartElement.elementsByTagName("thumb");
-    for (int i = 0; i < thumbs.size(); ++i) {
-        QDomElement thumbElement = thumbs.at(i).toElement();
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("thumb")) {
+            reader.skipCurrentElement();
+            continue;
+        }
         Poster p;
-        p.originalUrl = QUrl(thumbElement.text());
-        p.thumbUrl = QUrl(thumbElement.attribute("preview"));
+        p.thumbUrl = QUrl(reader.attributes().value("preview").toString());
+        p.originalUrl = QUrl(reader.readElementText());
         m_movie.images().addBackdrop(p);
     }
 }
 
-void MovieXmlReader::movieRatingV17(const QDomElement& element)
+void MovieXmlReader::movieRatingV17(QXmlStreamReader& reader)
 {
-    // <ratings>
-    //   <rating name="default" default="true">
-    //     <value>10</value>
-    //     <votes>10</votes>
-    //   </rating>
-    // </ratings>
-    auto ratings = element.elementsByTagName("rating");
+    const QVector<Rating> ratings = readRatings(reader);
 
     // clear all ratings in case that there are <rating> tags to avoid
     // duplicated and/or old ratings
-    if (ratings.length() > 0) {
+    if (!ratings.isEmpty()) {
         m_movie.ratings().clear();
     }
 
-    for (int i = 0; i < ratings.length(); ++i) {
-        Rating rating;
-        auto ratingElement = ratings.at(i).toElement();
-        rating.source = ratingElement.attribute("name", "default");
-        bool ok = false;
-        int max = ratingElement.attribute("max", "0").toInt(&ok);
-        if (ok && max > 0) {
-            rating.maxRating = max;
-        }
-        rating.rating = ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-        rating.voteCount =
-            ratingElement.elementsByTagName("votes").at(0).toElement().text().replace(",", "").replace(".", "").toInt();
+    for (const Rating& rating : ratings) {
         m_movie.ratings().setOrAddRating(rating);
         m_movie.setChanged(true);
     }
 }
 
-void MovieXmlReader::movieRatingV16(const QDomElement& element)
+void MovieXmlReader::movieRatingV16(QXmlStreamReader& reader)
 {
     // <rating>10.0</rating>
-    QString value = element.text();
+    QString value = reader.readElementText();
     if (!value.isEmpty()) {
         if (m_movie.ratings().isEmpty()) {
             m_movie.ratings().setOrAddRating(Rating{});
@@ -259,10 +289,10 @@ void MovieXmlReader::movieRatingV16(const QDomElement& element)
     }
 }
 
-void MovieXmlReader::movieVoteCountV16(const QDomElement& element)
+void MovieXmlReader::movieVoteCountV16(QXmlStreamReader& reader)
 {
     // <votes>100</votes>
-    QString value = element.text();
+    QString value = reader.readElementText();
     if (!value.isEmpty()) {
         if (m_movie.ratings().isEmpty()) {
             m_movie.ratings().setOrAddRating(Rating{});
@@ -272,31 +302,50 @@ void MovieXmlReader::movieVoteCountV16(const QDomElement& element)
     }
 }
 
-void MovieXmlReader::movieResumeTime(const QDomElement& element)
+void MovieXmlReader::movieResumeTime(QXmlStreamReader& reader)
 {
-    auto positions = element.elementsByTagName("position");
-    auto totals = element.elementsByTagName("total");
-
     mediaelch::ResumeTime time;
+    bool hasPosition = false;
+    bool hasTotal = false;
 
-    if (!positions.isEmpty()) {
-        bool ok = false;
-        const double position = positions.at(0).toElement().text().replace(",", ".").toDouble(&ok);
-        if (ok) {
-            time.position = position;
-        }
-    }
+    while (reader.readNextStartElement()) {
+        if (!hasPosition && reader.name() == QLatin1String("position")) {
+            hasPosition = true;
+            bool ok = false;
+            const double position = reader.readElementText().replace(",", ".").toDouble(&ok);
+            if (ok) {
+                time.position = position;
+            }
 
-    if (!totals.isEmpty()) {
-        bool ok = false;
-        const double total = totals.at(0).toElement().text().replace(",", ".").toDouble(&ok);
-        if (ok) {
-            time.total = total;
+        } else if (!hasTotal && reader.name() == QLatin1String("total")) {
+            hasTotal = true;
+            bool ok = false;
+            const double total = reader.readElementText().replace(",", ".").toDouble(&ok);
+            if (ok) {
+                time.total = total;
+            }
+
+        } else {
+            reader.skipCurrentElement();
         }
     }
 
     m_movie.setResumeTime(time);
 }
 
+void MovieXmlReader::movieFileInfo(QXmlStreamReader& reader)
+{
+    // Stream details require the movie's files.
+    while (reader.readNextStartElement()) {
+        if (!m_hasStreamDetails && reader.name() == QLatin1String("streamdetails")
+            && m_movie.streamDetails() != nullptr) {
+            m_hasStreamDetails = true;
+            readStreamDetails(reader, *m_movie.streamDetails());
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
 } // namespace kodi
 } // namespace mediaelch
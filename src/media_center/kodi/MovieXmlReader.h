@@ -3,8 +3,12 @@
 #include "globals/Globals.h"
 
 #include <QDate>
-#include <QDomDocument>
+#include <QHash>
+#include <QPair>
 #include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QXmlStreamReader>
 
 class Movie;
 
@@ -15,59 +19,77 @@ class MovieXmlReader
 {
 public:
     explicit MovieXmlReader(Movie& movie);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Parses the <movie> element of a movie NFO file in a single pass.
+    void parse(QXmlStreamReader& reader);
 
 private:
+    using TagParser = void (MovieXmlReader::*)(QXmlStreamReader&);
+
     template<class T>
     using MovieStoreMethod = void (Movie::*)(T);
 
     template<MovieStoreMethod<QString> method>
-    void simpleString(const QDomElement& element)
+    void simpleString(QXmlStreamReader& reader)
     {
-        const QString value = element.text();
+        const QString value = reader.readElementText();
         (m_movie.*method)(value);
     }
 
     template<MovieStoreMethod<QString> method, const char splitChar>
-    void stringList(const QDomElement& element)
+    void stringList(QXmlStreamReader& reader)
     {
-        QStringList values = element.text().split(splitChar, ElchSplitBehavior::SkipEmptyParts);
+        QStringList values = reader.readElementText().split(splitChar, ElchSplitBehavior::SkipEmptyParts);
         for (const QString& value : asConst(values)) {
             (m_movie.*method)(value.trimmed());
         }
     }
 
     template<MovieStoreMethod<int> method>
-    void simpleInt(const QDomElement& element)
+    void simpleInt(QXmlStreamReader& reader)
     {
-        (m_movie.*method)(element.text().toInt());
+        (m_movie.*method)(reader.readElementText().toInt());
     }
 
     template<MovieStoreMethod<double> method>
-    void simpleDouble(const QDomElement& element)
+    void simpleDouble(QXmlStreamReader& reader)
     {
-        (m_movie.*method)(element.text().toDouble());
+        (m_movie.*method)(reader.readElementText().toDouble());
     }
 
     template<MovieStoreMethod<QDateTime> method>
-    void simpleDateTime(const QDomElement& element)
+    void simpleDateTime(QXmlStreamReader& reader)
     {
-        const QDateTime value = QDateTime::fromString(element.text(), "yyyy-MM-dd HH:mm:ss");
+        const QDateTime value = QDateTime::fromString(reader.readElementText(), "yyyy-MM-dd HH:mm:ss");
         if (value.isValid()) {
             (m_movie.*method)(value);
         }
     }
 
-    void movieSet(const QDomElement& element);
-    void movieActor(const QDomElement& element);
-    void movieThumbnail(const QDomElement& element);
-    void movieFanart(const QDomElement& element);
-    void movieRatingV17(const QDomElement& element);
-    void movieRatingV16(const QDomElement& element);
-    void movieVoteCountV16(const QDomElement& element);
-    void movieResumeTime(const QDomElement& element);
+    void movieSet(QXmlStreamReader& reader);
+    void movieActor(QXmlStreamReader& reader);
+    void movieThumbnail(QXmlStreamReader& reader);
+    void movieFanart(QXmlStreamReader& reader);
+    void movieRatingV17(QXmlStreamReader& reader);
+    void movieRatingV16(QXmlStreamReader& reader);
+    void movieVoteCountV16(QXmlStreamReader& reader);
+    void movieResumeTime(QXmlStreamReader& reader);
+    void movieFileInfo(QXmlStreamReader& reader);
+
+    /// \brief Stores the element's text if it is the first element with that name.
+    ///        Used for tags that are applied after all others, see applyDeferredValues().
+    void firstValue(QXmlStreamReader& reader);
+    void uniqueId(QXmlStreamReader& reader);
+    void credits(QXmlStreamReader& reader);
+    void director(QXmlStreamReader& reader);
+    void applyDeferredValues();
 
     Movie& m_movie;
+    QHash<QString, QString> m_firstValues;
+    /// \brief Pairs of (type, id)
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    QStringList m_writers;
+    QStringList m_directors;
+    bool m_hasStreamDetails = false;
 };
 
 } // namespace kodi
@@ -0,0 +1,81 @@
+#include "media_center/kodi/NfoFileWriter.h"
+
+#include "log/Log.h"
+#include "utils/Meta.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPair>
+#include <QSaveFile>
+#include <algorithm>
+
+namespace mediaelch {
+namespace kodi {
+
+/// \brief Range of the first <generator> element including its tags or an empty range.
+static QPair<elch_ssize_t, elch_ssize_t> generatorRange(const QByteArray& nfo)
+{
+    const elch_ssize_t start = nfo.indexOf("<generator>");
+    if (start < 0) {
+        return {0, 0};
+    }
+    const QByteArray endTag("</generator>");
+    const elch_ssize_t end = nfo.indexOf(endTag, start);
+    if (end < 0) {
+        return {0, 0};
+    }
+    return {start, end + endTag.size()};
+}
+
+bool isSameNfoContent(const QByteArray& lhs, const QByteArray& rhs)
+{
+    const QPair<elch_ssize_t, elch_ssize_t> lhsGenerator = generatorRange(lhs);
+    const QPair<elch_ssize_t, elch_ssize_t> rhsGenerator = generatorRange(rhs);
+
+    const elch_ssize_t lhsRest = lhs.size() - lhsGenerator.second;
+    const elch_ssize_t rhsRest = rhs.size() - rhsGenerator.second;
+    if (lhsGenerator.first != rhsGenerator.first || lhsRest != rhsRest) {
+        return false;
+    }
+    // Compare everything before and after the generator tag without creating copies.
+    return std::equal(lhs.constData(), lhs.constData() + lhsGenerator.first, rhs.constData())
+           && std::equal(lhs.constData() + lhsGenerator.second,
+               lhs.constData() + lhs.size(),
+               rhs.constData() + rhsGenerator.second);
+}
+
+NfoSaveResult saveNfoFile(const QString& filePath, const QByteArray& content)
+{
+    {
+        QFile existing(filePath);
+        // Text mode, so that line endings on Windows match the written content.
+        if (existing.size() > 0 && existing.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            if (isSameNfoContent(existing.readAll(), content)) {
+                return NfoSaveResult::Unchanged;
+            }
+        }
+    }
+
+    QDir saveFileDir = QFileInfo(filePath).dir();
+    if (!saveFileDir.exists()) {
+        saveFileDir.mkpath(".");
+    }
+
+    QSaveFile file(filePath);
+    // Some network shares do not allow creating files next to the NFO file.
+    file.setDirectWriteFallback(true);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qCWarning(generic) << "[NfoFileWriter] NFO file could not be opened for writing" << filePath;
+        return NfoSaveResult::Failed;
+    }
+    file.write(content);
+    if (!file.commit()) {
+        qCWarning(generic) << "[NfoFileWriter] NFO file could not be written" << filePath << file.errorString();
+        return NfoSaveResult::Failed;
+    }
+    return NfoSaveResult::Written;
+}
+
+} // namespace kodi
+} // namespace mediaelch
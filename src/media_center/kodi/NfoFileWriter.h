@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+namespace mediaelch {
+namespace kodi {
+
+enum class NfoSaveResult
+{
+    Written,
+    /// \brief The file already has the same content and was not touched.
+    Unchanged,
+    Failed
+};
+
+/// \brief Returns true if both NFO contents are equal, ignoring the <generator> tag.
+/// \details The generator tag contains the time of writing, so that otherwise
+///          two NFO files with the same content would never be equal.
+bool isSameNfoContent(const QByteArray& lhs, const QByteArray& rhs);
+
+/// \brief Saves the NFO content to the given file.
+///
+/// If the file already contains the same NFO content (see isSameNfoContent()),
+/// it is not rewritten. Its modification time stays the same and Kodi does not
+/// rescan the directory. Otherwise the content is written to a temporary file
+/// that replaces the NFO file, so that readers never see a half-written NFO.
+NfoSaveResult saveNfoFile(const QString& filePath, const QByteArray& content);
+
+} // namespace kodi
+} // namespace mediaelch
@@ -3,11 +3,13 @@
 #include "data/Poster.h"
 #include "data/tv_show/TvShow.h"
 #include "log/Log.h"
+#include "media_center/kodi/KodiXmlReader.h"
+#include "utils/Meta.h"
 
 #include <QDate>
 #include <QDateTime>
-#include <QDomDocument>
 #include <QFileInfo>
+#include <QSet>
 #include <QUrl>
 
 namespace mediaelch {
@@ -17,31 +19,107 @@ TvShowXmlReader::TvShowXmlReader(TvShow& tvShow) : m_show{tvShow}
 {
 }
 
-void TvShowXmlReader::parseNfoDom(QDomDocument domDoc)
+void TvShowXmlReader::parse(QXmlStreamReader& reader)
 {
+    if (!reader.readNextStartElement()) {
+        return;
+    }
+    if (reader.name() != QLatin1String("tvshow")) {
+        reader.raiseError(QObject::tr("No valid tvshow root entry found"));
+        return;
+    }
+
+    // Tags that may only exist once.  They are applied after all others, see applyDeferredValues().
+    static const QSet<QString> singleValueTags{"id",
+        "tvdbid",
+        "imdbid",
+        "title",
+        "sorttitle",
+        "originaltitle",
+        "showtitle",
+        "rating",
+        "votes",
+        "userrating",
+        "top250",
+        "plot",
+        "mpaa",
+        "year",
+        "premiered",
+        "dateadded",
+        "studio",
+        "runtime",
+        "status"};
+
+    while (reader.readNextStartElement()) {
+        const QString tagName = reader.name().toString();
+
+        if (singleValueTags.contains(tagName)) {
+            const QString value = reader.readElementText();
+            if (!m_firstValues.contains(tagName)) {
+                m_firstValues.insert(tagName, value);
+            }
+
+        } else if (tagName == "uniqueid") {
+            const QString type = reader.attributes().value("type").toString();
+            m_uniqueIds.append({type, reader.readElementText().trimmed()});
+
+        } else if (tagName == "namedseason") {
+            showNamedSeason(reader);
+
+        } else if (tagName == "ratings" && !m_hasRatings) {
+            showRatings(reader);
+
+        } else if (tagName == "episodeguide" && !m_hasEpisodeGuide) {
+            showEpisodeGuide(reader);
+
+        } else if (tagName == "genre") {
+            const auto genres = reader.readElementText().split(" / ", ElchSplitBehavior::SkipEmptyParts);
+            for (const QString& genre : genres) {
+                m_show.addGenre(genre);
+            }
+
+        } else if (tagName == "tag") {
+            m_show.addTag(reader.readElementText());
+
+        } else if (tagName == "actor") {
+            showActor(reader);
+
+        } else if (tagName == "thumb") {
+            showThumb(reader);
+
+        } else if (tagName == "fanart") {
+            showFanart(reader);
+
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+
+    applyDeferredValues();
+
+    QFileInfo fi(m_show.dir().filePath("theme.mp3"));
+    m_show.setHasTune(fi.isFile());
+}
+
+void TvShowXmlReader::applyDeferredValues()
+{
+    // Order matters: Some of these tags override others.
+
     // v17/v18 TvDbId
-    if (!domDoc.elementsByTagName("id").isEmpty()) {
-        m_show.setTvdbId(TvDbId(domDoc.elementsByTagName("id").at(0).toElement().text()));
+    if (m_firstValues.contains("id")) {
+        m_show.setTvdbId(TvDbId(m_firstValues.value("id")));
     }
     // v16 TvDbId/ImdbId
-    if (!domDoc.elementsByTagName("tvdbid").isEmpty()) {
-        QString value = domDoc.elementsByTagName("tvdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_show.setTvdbId(TvDbId(value));
-        }
+    if (!m_firstValues.value("tvdbid").isEmpty()) {
+        m_show.setTvdbId(TvDbId(m_firstValues.value("tvdbid")));
     }
-    if (!domDoc.elementsByTagName("imdbid").isEmpty()) {
-        QString value = domDoc.elementsByTagName("imdbid").at(0).toElement().text();
-        if (!value.isEmpty()) {
-            m_show.setImdbId(ImdbId(value));
-        }
+    if (!m_firstValues.value("imdbid").isEmpty()) {
+        m_show.setImdbId(ImdbId(m_firstValues.value("imdbid")));
     }
     // v17 ids
-    auto uniqueIds = domDoc.elementsByTagName("uniqueid");
-    for (int i = 0; i < uniqueIds.size(); ++i) {
-        QDomElement element = uniqueIds.at(i).toElement();
-        QString type = element.attribute("type");
-        QString value = element.text().trimmed();
+    for (const auto& uniqueId : asConst(m_uniqueIds)) {
+        const QString& type = uniqueId.first;
+        const QString& value = uniqueId.second;
 
         if (value.isEmpty()) {
             // Silently skip empty values; we wouldn't get any benefit from them
@@ -60,187 +138,160 @@ void TvShowXmlReader::parseNfoDom(QDomDocument domDoc)
             qCWarning(generic) << "[TvShowXmlReader] Unsupported unique id type:" << type << "with value" << value;
         }
     }
-    if (!domDoc.elementsByTagName("title").isEmpty()) {
-        m_show.setTitle(domDoc.elementsByTagName("title").at(0).toElement().text());
+    if (m_firstValues.contains("title")) {
+        m_show.setTitle(m_firstValues.value("title"));
     }
-    if (!domDoc.elementsByTagName("sorttitle").isEmpty()) {
-        m_show.setSortTitle(domDoc.elementsByTagName("sorttitle").at(0).toElement().text());
+    if (m_firstValues.contains("sorttitle")) {
+        m_show.setSortTitle(m_firstValues.value("sorttitle"));
     }
     // since v17
-    if (!domDoc.elementsByTagName("originaltitle").isEmpty()) {
-        m_show.setOriginalTitle(domDoc.elementsByTagName("originaltitle").at(0).toElement().text());
+    if (m_firstValues.contains("originaltitle")) {
+        m_show.setOriginalTitle(m_firstValues.value("originaltitle"));
     }
-    if (!domDoc.elementsByTagName("showtitle").isEmpty()) {
-        m_show.setShowTitle(domDoc.elementsByTagName("showtitle").at(0).toElement().text());
+    if (m_firstValues.contains("showtitle")) {
+        m_show.setShowTitle(m_firstValues.value("showtitle"));
     }
-    QDomNodeList namedSeasons = domDoc.elementsByTagName("namedseason");
-    for (int i = 0; i < namedSeasons.size(); ++i) {
-        QDomElement seasonElement = namedSeasons.at(i).toElement();
-        SeasonNumber season(seasonElement.attribute("number", SeasonNumber::NoSeason.toString()).toInt());
-        QString name = seasonElement.text();
-        if (season != SeasonNumber::NoSeason) {
-            m_show.setSeasonName(season, name);
-        }
-    }
-    // check for new ratings syntax
-    if (!domDoc.elementsByTagName("ratings").isEmpty()) {
-        // <ratings>
-        //   <rating name="default" default="true">
-        //     <value>10</value>
-        //     <votes>10</votes>
-        //   </rating>
-        // </ratings>
-        auto ratings = domDoc.elementsByTagName("ratings").at(0).toElement().elementsByTagName("rating");
-        m_show.ratings().clear();
-
-        for (int i = 0; i < ratings.length(); ++i) {
-            Rating rating;
-            auto ratingElement = ratings.at(i).toElement();
-            rating.source = ratingElement.attribute("name", "default");
-            bool ok = false;
-            const int max = ratingElement.attribute("max", "0").toInt(&ok);
-            if (ok && max > 0) {
-                rating.maxRating = max;
-            }
-            rating.rating =
-                ratingElement.elementsByTagName("value").at(0).toElement().text().replace(",", ".").toDouble();
-            rating.voteCount = ratingElement.elementsByTagName("votes")
-                                   .at(0)
-                                   .toElement()
-                                   .text()
-                                   .replace(",", "")
-                                   .replace(".", "")
-                                   .toInt();
-            m_show.ratings().setOrAddRating(rating);
-            m_show.setChanged(true);
-        }
-
-    } else if (!domDoc.elementsByTagName("rating").isEmpty()) {
+    if (!m_hasRatings && m_firstValues.contains("rating")) {
         // otherwise use "old" syntax:
         // <rating>10.0</rating>
         // <votes>10.0</votes>
-        QString value = domDoc.elementsByTagName("rating").at(0).toElement().text();
+        QString value = m_firstValues.value("rating");
         if (!value.isEmpty()) {
             Rating rating;
             rating.rating = value.replace(",", ".").toDouble();
-            if (!domDoc.elementsByTagName("votes").isEmpty()) {
-                rating.voteCount = domDoc.elementsByTagName("votes")
-                                       .at(0)
-                                       .toElement()
-                                       .text()
-                                       .replace(",", "")
-                                       .replace(".", "")
-                                       .toInt();
+            if (m_firstValues.contains("votes")) {
+                rating.voteCount = m_firstValues.value("votes").replace(",", "").replace(".", "").toInt();
             }
             m_show.ratings().clear();
             m_show.ratings().setOrAddRating(rating);
             m_show.setChanged(true);
         }
     }
-    if (!domDoc.elementsByTagName("userrating").isEmpty()) {
-        m_show.setUserRating(domDoc.elementsByTagName("userrating").at(0).toElement().text().toDouble());
+    if (m_firstValues.contains("userrating")) {
+        m_show.setUserRating(m_firstValues.value("userrating").toDouble());
     }
-    if (!domDoc.elementsByTagName("top250").isEmpty()) {
-        m_show.setTop250(domDoc.elementsByTagName("top250").at(0).toElement().text().toInt());
+    if (m_firstValues.contains("top250")) {
+        m_show.setTop250(m_firstValues.value("top250").toInt());
     }
-    if (!domDoc.elementsByTagName("plot").isEmpty()) {
-        m_show.setOverview(domDoc.elementsByTagName("plot").at(0).toElement().text());
+    if (m_firstValues.contains("plot")) {
+        m_show.setOverview(m_firstValues.value("plot"));
     }
-    if (!domDoc.elementsByTagName("mpaa").isEmpty()) {
-        m_show.setCertification(Certification(domDoc.elementsByTagName("mpaa").at(0).toElement().text()));
+    if (m_firstValues.contains("mpaa")) {
+        m_show.setCertification(Certification(m_firstValues.value("mpaa")));
     }
-    if (!domDoc.elementsByTagName("year").isEmpty()) {
-        m_show.setFirstAired(QDate::fromString(domDoc.elementsByTagName("year").at(0).toElement().text(), "yyyy"));
+    if (m_firstValues.contains("year")) {
+        m_show.setFirstAired(QDate::fromString(m_firstValues.value("year"), "yyyy"));
     }
     // will override the first-aired date set by <year>
-    if (!domDoc.elementsByTagName("premiered").isEmpty()) {
-        QString value = domDoc.elementsByTagName("premiered").at(0).toElement().text().trimmed();
-        QDate released = QDate::fromString(value, "yyyy-MM-dd");
+    if (m_firstValues.contains("premiered")) {
+        QDate released = QDate::fromString(m_firstValues.value("premiered").trimmed(), "yyyy-MM-dd");
         if (released.isValid()) {
             m_show.setFirstAired(released);
         }
     }
-    if (!domDoc.elementsByTagName("dateadded").isEmpty()) {
-        m_show.setDateAdded(QDateTime::fromString(
-            domDoc.elementsByTagName("dateadded").at(0).toElement().text(), "yyyy-MM-dd HH:mm:ss"));
+    if (m_firstValues.contains("dateadded")) {
+        m_show.setDateAdded(QDateTime::fromString(m_firstValues.value("dateadded"), "yyyy-MM-dd HH:mm:ss"));
     }
-    if (!domDoc.elementsByTagName("studio").isEmpty()) {
-        m_show.setNetwork(domDoc.elementsByTagName("studio").at(0).toElement().text());
+    if (m_firstValues.contains("studio")) {
+        m_show.setNetwork(m_firstValues.value("studio"));
     }
-    if (!domDoc.elementsByTagName("episodeguide").isEmpty()
-        && !domDoc.elementsByTagName("episodeguide").at(0).toElement().elementsByTagName("url").isEmpty()) {
-        m_show.setEpisodeGuideUrl(domDoc.elementsByTagName("episodeguide")
-                                      .at(0)
-                                      .toElement()
-                                      .elementsByTagName("url")
-                                      .at(0)
-                                      .toElement()
-                                      .text());
+    if (m_firstValues.contains("runtime")) {
+        m_show.setRuntime(std::chrono::minutes(m_firstValues.value("runtime").toInt()));
     }
-    if (!domDoc.elementsByTagName("runtime").isEmpty()) {
-        m_show.setRuntime(std::chrono::minutes(domDoc.elementsByTagName("runtime").at(0).toElement().text().toInt()));
-    }
-    if (!domDoc.elementsByTagName("status").isEmpty()) {
-        m_show.setStatus(domDoc.elementsByTagName("status").at(0).toElement().text());
+    if (m_firstValues.contains("status")) {
+        m_show.setStatus(m_firstValues.value("status"));
     }
+}
 
-    for (int i = 0, n = domDoc.elementsByTagName("genre").size(); i < n; i++) {
-        const auto genres =
-            domDoc.elementsByTagName("genre").at(i).toElement().text().split(" / ", ElchSplitBehavior::SkipEmptyParts);
-        for (const QString& genre : genres) {
-            m_show.addGenre(genre);
-        }
+void TvShowXmlReader::showNamedSeason(QXmlStreamReader& reader)
+{
+    const QXmlStreamAttributes attributes = reader.attributes();
+    SeasonNumber season(attributes.hasAttribute("number") ? attributes.value("number").toString().toInt()
+                                                          : SeasonNumber::NoSeason.toInt());
+    QString name = reader.readElementText();
+    if (season != SeasonNumber::NoSeason) {
+        m_show.setSeasonName(season, name);
     }
-    for (int i = 0, n = domDoc.elementsByTagName("tag").size(); i < n; i++) {
-        m_show.addTag(domDoc.elementsByTagName("tag").at(i).toElement().text());
+}
+
+void TvShowXmlReader::showRatings(QXmlStreamReader& reader)
+{
+    // <ratings>
+    //   <rating name="default" default="true">
+    //     <value>10</value>
+    //     <votes>10</votes>
+    //   </rating>
+    // </ratings>
+    m_hasRatings = true;
+    const QVector<Rating> ratings = readRatings(reader);
+    m_show.ratings().clear();
+
+    for (const Rating& rating : ratings) {
+        m_show.ratings().setOrAddRating(rating);
+        m_show.setChanged(true);
     }
-    for (int i = 0, n = domDoc.elementsByTagName("actor").size(); i < n; i++) {
-        QDomElement actorElement = domDoc.elementsByTagName("actor").at(i).toElement();
-        Actor a;
-        a.imageHasChanged = false;
-        if (!actorElement.elementsByTagName("name").isEmpty()) {
-            a.name = actorElement.elementsByTagName("name").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("role").isEmpty()) {
-            a.role = actorElement.elementsByTagName("role").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("thumb").isEmpty()) {
-            a.thumb = actorElement.elementsByTagName("thumb").at(0).toElement().text();
-        }
-        if (!actorElement.elementsByTagName("order").isEmpty()) {
-            a.order = actorElement.elementsByTagName("order").at(0).toElement().text().toInt();
+}
+
+void TvShowXmlReader::showEpisodeGuide(QXmlStreamReader& reader)
+{
+    // <episodeguide>
+    //   <url>https://...</url>
+    // </episodeguide>
+    m_hasEpisodeGuide = true;
+    bool hasUrl = false;
+    while (reader.readNextStartElement()) {
+        if (!hasUrl && reader.name() == QLatin1String("url")) {
+            hasUrl = true;
+            m_show.setEpisodeGuideUrl(reader.readElementText());
+        } else {
+            reader.skipCurrentElement();
         }
-        m_show.addActor(a);
     }
-    for (int i = 0, n = domDoc.elementsByTagName("thumb").size(); i < n; i++) {
-        QString parentTag = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().tagName();
-        QDomElement thumbElement = domDoc.elementsByTagName("thumb").at(i).toElement();
-
-        if (parentTag == "tvshow") {
-            showThumb(thumbElement);
+}
 
-        } else if (parentTag == "fanart") {
-            QString url = domDoc.elementsByTagName("thumb").at(i).parentNode().toElement().attribute("url");
-            showFanartThumb(thumbElement, url);
+void TvShowXmlReader::showActor(QXmlStreamReader& reader)
+{
+    Actor a;
+    a.imageHasChanged = false;
+    bool hasName = false;
+    bool hasRole = false;
+    bool hasThumb = false;
+    bool hasOrder = false;
+    while (reader.readNextStartElement()) {
+        if (!hasName && reader.name() == QLatin1String("name")) {
+            hasName = true;
+            a.name = reader.readElementText();
+        } else if (!hasRole && reader.name() == QLatin1String("role")) {
+            hasRole = true;
+            a.role = reader.readElementText();
+        } else if (!hasThumb && reader.name() == QLatin1String("thumb")) {
+            hasThumb = true;
+            a.thumb = reader.readElementText();
+        } else if (!hasOrder && reader.name() == QLatin1String("order")) {
+            hasOrder = true;
+            a.order = reader.readElementText().toInt();
+        } else {
+            reader.skipCurrentElement();
         }
     }
-
-    QFileInfo fi(m_show.dir().filePath("theme.mp3"));
-    m_show.setHasTune(fi.isFile());
+    m_show.addActor(a);
 }
 
-void TvShowXmlReader::showThumb(const QDomElement& element)
+void TvShowXmlReader::showThumb(QXmlStreamReader& reader)
 {
-    QString aspect = element.attribute("aspect", "poster").toLower().trimmed();
+    const QXmlStreamAttributes attributes = reader.attributes();
+    const QString aspect = attributes.hasAttribute("aspect")
+                               ? attributes.value("aspect").toString().toLower().trimmed()
+                               : QStringLiteral("poster");
 
     Poster p;
-    p.originalUrl = QUrl(element.text());
-    p.thumbUrl = element.attribute("preview");
-    p.language = element.attribute("language");
+    p.thumbUrl = attributes.value("preview").toString();
+    p.language = attributes.value("language").toString();
     p.aspect = aspect;
+    p.originalUrl = QUrl(reader.readElementText());
 
-    if (element.hasAttribute("type") && element.attribute("type").toLower() == "season") {
-        SeasonNumber season = SeasonNumber(element.attribute("season").toInt());
+    if (attributes.hasAttribute("type") && attributes.value("type").toString().toLower() == "season") {
+        SeasonNumber season = SeasonNumber(attributes.value("season").toString().toInt());
         if (season != SeasonNumber::NoSeason) {
             p.season = season;
             if (aspect == "banner") {
@@ -260,20 +311,34 @@ void TvShowXmlReader::showThumb(const QDomElement& element)
     m_show.addPoster(p);
 }
 
-void TvShowXmlReader::showFanartThumb(const QDomElement& element, QString thumbUrl)
+void TvShowXmlReader::showFanart(QXmlStreamReader& reader)
+{
+    const QString url = reader.attributes().value("url").toString();
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("thumb")) {
+            showFanartThumb(reader, url);
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+void TvShowXmlReader::showFanartThumb(QXmlStreamReader& reader, const QString& thumbUrl)
 {
+    const QXmlStreamAttributes attributes = reader.attributes();
+
     Poster p;
-    p.originalUrl = QUrl(thumbUrl + element.text());
-    if (!element.attribute("preview").isEmpty()) {
-        p.thumbUrl = QUrl(thumbUrl + element.attribute("preview"));
+    if (!attributes.value("preview").isEmpty()) {
+        p.thumbUrl = QUrl(thumbUrl + attributes.value("preview").toString());
     }
-    QStringList dimensions = element.attribute("dim").split("x");
+    QStringList dimensions = attributes.value("dim").toString().split("x");
     if (dimensions.size() == 2) {
         QSize size;
         size.setWidth(dimensions.first().toInt());
         size.setHeight(dimensions.last().toInt());
         p.originalSize = size;
     }
+    p.originalUrl = QUrl(thumbUrl + reader.readElementText());
 
     m_show.addBackdrop(p);
 }
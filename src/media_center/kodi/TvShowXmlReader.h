@@ -1,7 +1,10 @@
 #pragma once
 
-#include <QDomDocument>
+#include <QHash>
+#include <QPair>
 #include <QString>
+#include <QVector>
+#include <QXmlStreamReader>
 
 class TvShow;
 
@@ -12,13 +15,26 @@ class TvShowXmlReader
 {
 public:
     explicit TvShowXmlReader(TvShow& tvShow);
-    void parseNfoDom(QDomDocument domDoc);
+    /// \brief Parses the <tvshow> element of a TV show NFO file in a single pass.
+    void parse(QXmlStreamReader& reader);
 
 private:
-    void showThumb(const QDomElement& element);
-    void showFanartThumb(const QDomElement& element, QString thumbUrl);
+    void showNamedSeason(QXmlStreamReader& reader);
+    void showRatings(QXmlStreamReader& reader);
+    void showEpisodeGuide(QXmlStreamReader& reader);
+    void showActor(QXmlStreamReader& reader);
+    void showThumb(QXmlStreamReader& reader);
+    void showFanart(QXmlStreamReader& reader);
+    void showFanartThumb(QXmlStreamReader& reader, const QString& thumbUrl);
+    void applyDeferredValues();
 
     TvShow& m_show;
+    /// \brief Texts of tags that are only read once, i.e. the first occurrence wins.
+    QHash<QString, QString> m_firstValues;
+    /// \brief Pairs of (type, id)
+    QVector<QPair<QString, QString>> m_uniqueIds;
+    bool m_hasRatings = false;
+    bool m_hasEpisodeGuide = false;
 };
 
 } // namespace kodi
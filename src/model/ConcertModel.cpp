@@ -25,6 +25,7 @@ void ConcertModel::addConcert(Concert* concert)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_concerts.append(concert);
+    m_searchIndex.insert(concert, searchTerms(*concert));
     endInsertRows();
     connect(concert, &Concert::sigChanged, this, &ConcertModel::onConcertChanged, Qt::UniqueConnection);
 }
@@ -36,6 +37,7 @@ void ConcertModel::addConcert(Concert* concert)
  */
 void ConcertModel::onConcertChanged(Concert* concert)
 {
+    m_searchIndex.update(concert, searchTerms(*concert));
     QModelIndex index = createIndex(qsizetype_to_int(m_concerts.indexOf(concert)), 0);
     emit dataChanged(index, index);
 }
@@ -174,9 +176,17 @@ void ConcertModel::clear()
         concert->deleteLater();
     }
     m_concerts.clear();
+    m_searchIndex.clear();
     endRemoveRows();
 }
 
+mediaelch::SearchTerms ConcertModel::searchTerms(const Concert& concert)
+{
+    mediaelch::SearchTerms terms;
+    terms.addText("title", concert.title());
+    return terms;
+}
+
 /// \brief Returns a list of all concerts
 /// \return List of concerts
 QVector<Concert*> ConcertModel::concerts()
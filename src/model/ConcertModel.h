@@ -1,5 +1,7 @@
 #pragma once
 
+#include "model/SearchIndex.h"
+
 #include <QAbstractItemModel>
 #include <QIcon>
 
@@ -34,11 +36,16 @@ public:
     int countNewConcerts() const;
     void update();
 
+    /// \brief Terms by which concerts are found, e.g. by ConcertProxyModel's filters.
+    static mediaelch::SearchTerms searchTerms(const Concert& concert);
+    const mediaelch::SearchIndex<Concert>& searchIndex() const { return m_searchIndex; }
+
 private slots:
     void onConcertChanged(Concert* concert);
 
 private:
     QVector<Concert*> m_concerts;
+    mediaelch::SearchIndex<Concert> m_searchIndex;
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
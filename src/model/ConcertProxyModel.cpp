@@ -1,10 +1,13 @@
 #include "ConcertProxyModel.h"
 
 #include "data/Filter.h"
+#include "globals/Helper.h"
 #include "globals/Manager.h"
 
 ConcertProxyModel::ConcertProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
+    // Sort keys are cached per item; don't keep them for items that no longer exist.
+    m_sortKeys.attach(this);
 }
 
 /**
@@ -14,12 +17,20 @@ ConcertProxyModel::ConcertProxyModel(QObject* parent) : QSortFilterProxyModel(pa
 bool ConcertProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
 {
     Q_UNUSED(sourceParent);
-    QVector<Concert*> concerts = Manager::instance()->concertModel()->concerts();
-    if (sourceRow < 0 || sourceRow >= concerts.count()) {
+    Concert* concert = Manager::instance()->concertModel()->concert(sourceRow);
+    if (concert == nullptr) {
         return true;
     }
 
-    Concert* concert = concerts.at(sourceRow);
+    m_candidates.update(Manager::instance()->concertModel()->searchIndex(),
+        m_filters,
+        [](const mediaelch::SearchIndex<Concert>& index, const Filter* filter, QSet<Concert*>& result) {
+            return filter->isInfo(ConcertFilters::Title) && index.findText("title", filter->shortText(), result);
+        });
+    if (!m_candidates.contains(concert)) {
+        return false;
+    }
+
     for (Filter* filter : m_filters) {
         if (!filter->accepts(concert)) {
             return false;
@@ -34,15 +45,23 @@ bool ConcertProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourc
  */
 bool ConcertProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    if (sourceModel()->data(left, Qt::UserRole + 1).toBool()
-        && !sourceModel()->data(right, Qt::UserRole + 1).toBool()) {
-        return true;
+    ConcertModel* model = Manager::instance()->concertModel();
+    Concert* leftConcert = model->concert(left.row());
+    Concert* rightConcert = model->concert(right.row());
+    if (leftConcert == nullptr || rightConcert == nullptr) {
+        return QSortFilterProxyModel::lessThan(left, right);
     }
-    if (!sourceModel()->data(left, Qt::UserRole + 1).toBool()
-        && sourceModel()->data(right, Qt::UserRole + 1).toBool()) {
-        return false;
+
+    const bool leftLoaded = leftConcert->controller()->infoLoaded();
+    const bool rightLoaded = rightConcert->controller()->infoLoaded();
+    if (leftLoaded != rightLoaded) {
+        return leftLoaded;
     }
-    int cmp = QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString());
+
+    const int cmp = m_sortKeys.compare(leftConcert,
+        helper::appendArticle(leftConcert->title()),
+        rightConcert,
+        helper::appendArticle(rightConcert->title()));
     return !(cmp < 0);
 }
 
@@ -53,4 +72,5 @@ void ConcertProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
     m_filters = filters;
     m_filterText = text;
+    m_candidates.invalidate();
 }
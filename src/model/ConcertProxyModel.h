@@ -1,7 +1,11 @@
 #pragma once
 
+#include "model/SearchIndex.h"
+#include "model/SortKeyCache.h"
+
 #include <QSortFilterProxyModel>
 
+class Concert;
 class Filter;
 
 class ConcertProxyModel : public QSortFilterProxyModel
@@ -18,4 +22,6 @@ protected:
 private:
     QVector<Filter*> m_filters;
     QString m_filterText;
+    mutable mediaelch::SortKeyCache m_sortKeys;
+    mutable mediaelch::SearchCandidates<Concert> m_candidates;
 };
@@ -0,0 +1,149 @@
+#include "model/MovieDuplicateIndex.h"
+
+#include "data/movie/Movie.h"
+#include "model/MovieModel.h"
+
+#include <QModelIndex>
+
+namespace mediaelch {
+
+MovieDuplicateIndex::MovieDuplicateIndex(MovieModel* model, QObject* parent) : QObject(parent), m_model{model}
+{
+    // clang-format off
+    connect(m_model, &MovieModel::rowsInserted,         this, &MovieDuplicateIndex::onRowsInserted);
+    connect(m_model, &MovieModel::rowsAboutToBeRemoved, this, &MovieDuplicateIndex::onRowsAboutToBeRemoved);
+    connect(m_model, &MovieModel::dataChanged,          this, &MovieDuplicateIndex::onDataChanged);
+    connect(m_model, &MovieModel::modelReset,           this, &MovieDuplicateIndex::rebuild);
+    // clang-format on
+
+    rebuild();
+}
+
+void MovieDuplicateIndex::rebuild()
+{
+    m_keys.clear();
+    m_buckets.clear();
+    for (int row = 0, n = m_model->rowCount(); row < n; ++row) {
+        insert(m_model->movie(row));
+    }
+    emit duplicatesChanged();
+}
+
+bool MovieDuplicateIndex::hasDuplicates(Movie* movie) const
+{
+    for (const QString& key : m_keys.value(movie)) {
+        if (m_buckets.value(key).size() > 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QVector<Movie*> MovieDuplicateIndex::duplicatesOf(Movie* movie) const
+{
+    QVector<Movie*> duplicates{movie};
+    for (const QString& key : m_keys.value(movie)) {
+        for (Movie* other : m_buckets.value(key)) {
+            if (!duplicates.contains(other)) {
+                duplicates.append(other);
+            }
+        }
+    }
+    if (duplicates.size() < 2) {
+        return {};
+    }
+    return duplicates;
+}
+
+void MovieDuplicateIndex::onRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    Q_UNUSED(parent)
+    for (int row = first; row <= last; ++row) {
+        insert(m_model->movie(row));
+    }
+    emit duplicatesChanged();
+}
+
+void MovieDuplicateIndex::onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    Q_UNUSED(parent)
+    if (first == 0 && last == m_model->rowCount() - 1) {
+        // MovieModel::clear()
+        m_keys.clear();
+        m_buckets.clear();
+    } else {
+        for (int row = first; row <= last; ++row) {
+            remove(m_model->movie(row));
+        }
+    }
+    emit duplicatesChanged();
+}
+
+void MovieDuplicateIndex::onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+{
+    bool changed = false;
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        Movie* movie = m_model->movie(row);
+        if (movie != nullptr) {
+            changed = update(movie) || changed;
+        }
+    }
+    if (changed) {
+        emit duplicatesChanged();
+    }
+}
+
+QStringList MovieDuplicateIndex::keysOf(const Movie* movie)
+{
+    // Same criteria as Movie::isDuplicate()
+    QStringList keys;
+    if (movie->imdbId().isValid()) {
+        keys << QStringLiteral("imdb:") + movie->imdbId().toString();
+    }
+    if (movie->tmdbId().isValid()) {
+        keys << QStringLiteral("tmdb:") + movie->tmdbId().toString();
+    }
+    if (!movie->name().isEmpty()) {
+        keys << QStringLiteral("title:") + movie->name();
+    }
+    return keys;
+}
+
+void MovieDuplicateIndex::insert(Movie* movie)
+{
+    if (movie == nullptr) {
+        return;
+    }
+    const QStringList keys = keysOf(movie);
+    for (const QString& key : keys) {
+        m_buckets[key].append(movie);
+    }
+    m_keys.insert(movie, keys);
+}
+
+void MovieDuplicateIndex::remove(Movie* movie)
+{
+    const QStringList keys = m_keys.take(movie);
+    for (const QString& key : keys) {
+        auto bucket = m_buckets.find(key);
+        if (bucket == m_buckets.end()) {
+            continue;
+        }
+        bucket->removeOne(movie);
+        if (bucket->isEmpty()) {
+            m_buckets.erase(bucket);
+        }
+    }
+}
+
+bool MovieDuplicateIndex::update(Movie* movie)
+{
+    if (m_keys.value(movie) == keysOf(movie)) {
+        return false;
+    }
+    remove(movie);
+    insert(movie);
+    return true;
+}
+
+} // namespace mediaelch
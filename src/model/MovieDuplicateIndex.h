@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class Movie;
+class MovieModel;
+class QModelIndex;
+
+namespace mediaelch {
+
+/// \brief Index of duplicate movies in a MovieModel.
+///
+/// Movies are duplicates if they share the IMDb ID, the TMDb ID or the title,
+/// see Movie::isDuplicate().  Instead of comparing each movie with every other
+/// movie, each movie is put into one bucket per key.  The index follows the
+/// model: it is updated whenever movies are added, removed or changed.
+class MovieDuplicateIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MovieDuplicateIndex(MovieModel* model, QObject* parent = nullptr);
+
+    /// \brief Rebuild the whole index from the model's movies.
+    void rebuild();
+
+    /// \brief Whether there is at least one other movie that is a duplicate of the given one.
+    bool hasDuplicates(Movie* movie) const;
+    /// \brief All duplicates of the given movie.  The movie itself is the first element.
+    ///        Returns an empty list if the movie has no duplicates.
+    QVector<Movie*> duplicatesOf(Movie* movie) const;
+
+signals:
+    /// \brief Emitted if the duplicate state of any movie may have changed.
+    void duplicatesChanged();
+
+private slots:
+    void onRowsInserted(const QModelIndex& parent, int first, int last);
+    void onRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    void onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+
+private:
+    static QStringList keysOf(const Movie* movie);
+
+    void insert(Movie* movie);
+    void remove(Movie* movie);
+    /// \brief Re-index the movie if its keys changed.  Returns true if they did.
+    bool update(Movie* movie);
+
+private:
+    MovieModel* m_model = nullptr;
+    /// \brief Keys of each indexed movie at the time it was indexed.
+    QHash<Movie*, QStringList> m_keys;
+    /// \brief Movies per key, e.g. "imdb:tt0133093".
+    QHash<QString, QVector<Movie*>> m_buckets;
+};
+
+} // namespace mediaelch
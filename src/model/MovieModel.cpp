@@ -2,6 +2,7 @@
 
 #include "globals/Globals.h"
 #include "globals/Helper.h"
+#include "globals/Manager.h"
 #include "model/MediaStatusColumn.h"
 #include "ui/main/MyIconFont.h"
 
@@ -27,15 +28,20 @@ void MovieModel::addMovie(Movie* movie)
 {
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     m_movies.append(movie);
+    m_searchIndex.insert(movie, searchTerms(*movie));
     endInsertRows();
     connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
 }
 
 void MovieModel::addMovies(const QVector<Movie*>& movies)
 {
+    if (movies.isEmpty()) {
+        return;
+    }
     beginInsertRows(QModelIndex(), rowCount(), rowCount() + qsizetype_to_int(movies.size()) - 1);
     m_movies.append(movies);
     for (Movie* movie : movies) {
+        m_searchIndex.insert(movie, searchTerms(*movie));
         connect(movie, &Movie::sigChanged, this, &MovieModel::onMovieChanged, Qt::UniqueConnection);
     }
     endInsertRows();
@@ -48,6 +54,7 @@ void MovieModel::addMovies(const QVector<Movie*>& movies)
  */
 void MovieModel::onMovieChanged(Movie* movie)
 {
+    m_searchIndex.update(movie, searchTerms(*movie));
     const QModelIndex index = createIndex(qsizetype_to_int(m_movies.indexOf(movie)), 0);
     emit dataChanged(index, index);
 }
@@ -139,12 +146,7 @@ QVariant MovieModel::data(const QModelIndex& index, int role) const
             return movie->syncNeeded();
         }
         if (role == Roles::SortTitleRole) {
-            // 8: Sort title or the "normalized" title if the former does not exist.
-            QString sortTitle = movie->sortTitle();
-            if (sortTitle.isEmpty()) {
-                return helper::appendArticle(movie->name());
-            }
-            return sortTitle;
+            return sortTitle(*movie);
         }
         if (role == Qt::FontRole) {
             if (movie->hasChanged()) {
@@ -274,9 +276,39 @@ void MovieModel::clear()
         movie->deleteLater();
     }
     m_movies.clear();
+    m_searchIndex.clear();
     endRemoveRows();
 }
 
+QString MovieModel::sortTitle(const Movie& movie)
+{
+    // Sort title or the "normalized" title if the former does not exist.
+    QString sortTitle = movie.sortTitle();
+    if (sortTitle.isEmpty()) {
+        return helper::appendArticle(movie.name());
+    }
+    return sortTitle;
+}
+
+mediaelch::SearchTerms MovieModel::searchTerms(const Movie& movie)
+{
+    // Field names must match the ones used by MovieProxyModel.
+    mediaelch::SearchTerms terms;
+    terms.addText("title", movie.name());
+    terms.addText("originalTitle", movie.originalName());
+    for (const mediaelch::FilePath& file : movie.files()) {
+        terms.addText("path", file.toNativePathString());
+    }
+    terms.addValues("genre", movie.genres());
+    terms.addValues("studio", movie.studios());
+    terms.addValues("country", movie.countries());
+    terms.addValues("tag", movie.tags());
+    terms.addValue("set", movie.set().name);
+    terms.addValue("director", movie.director());
+    terms.addValue("certification", movie.certification().toString());
+    return terms;
+}
+
 QVector<Movie*> MovieModel::movies()
 {
     return m_movies;
@@ -290,6 +322,13 @@ int MovieModel::countNewMovies()
     return static_cast<int>(std::count_if(m_movies.cbegin(), m_movies.cend(), checkInfoLoaded));
 }
 
+void MovieModel::loadMovieDetails()
+{
+    for (Movie* movie : asConst(m_movies)) {
+        movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
+    }
+}
+
 int MovieModel::mediaStatusToColumn(MediaStatusColumn column)
 {
     switch (column) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data/movie/Movie.h"
+#include "model/SearchIndex.h"
 
 #include <QAbstractItemModel>
 #include <QIcon>
@@ -61,6 +62,15 @@ public:
     void update();
     void clear();
     int countNewMovies();
+    /// \brief Parses the cached NFO content of all movies of which only the list data is loaded.
+    /// \details Required before all details are accessed, e.g. by exports and some filters.
+    void loadMovieDetails();
+
+    /// \brief Title used for sorting: the sort title or the title with its article moved to the end.
+    static QString sortTitle(const Movie& movie);
+    /// \brief Terms by which movies are found, e.g. by MovieProxyModel's filters.
+    static mediaelch::SearchTerms searchTerms(const Movie& movie);
+    const mediaelch::SearchIndex<Movie>& searchIndex() const { return m_searchIndex; }
 
     static int mediaStatusToColumn(MediaStatusColumn column);
     static QString mediaStatusToText(MediaStatusColumn column);
@@ -71,6 +81,7 @@ private slots:
 
 private:
     QVector<Movie*> m_movies;
+    mediaelch::SearchIndex<Movie> m_searchIndex;
     QIcon m_newIcon;
     QIcon m_syncIcon;
 };
@@ -6,10 +6,69 @@
 #include "globals/Globals.h"
 #include "globals/Manager.h"
 
+namespace {
+
+/// \brief Look up the movies that may be accepted by the given filter.  Field names must
+///        match the ones used by MovieModel::searchTerms().
+/// \returns False if the filter is not indexed, e.g. "has no poster".
+bool findCandidates(const mediaelch::SearchIndex<Movie>& index, const Filter* filter, QSet<Movie*>& result)
+{
+    if (filter->isInfo(MovieFilters::Title)) {
+        return index.findText("title", filter->shortText(), result);
+    }
+    if (filter->isInfo(MovieFilters::OriginalTitle)) {
+        return index.findText("originalTitle", filter->shortText(), result);
+    }
+    if (filter->isInfo(MovieFilters::Path)) {
+        return index.findText("path", filter->shortText(), result);
+    }
+    if (!filter->hasInfo() || filter->shortText().isEmpty()) {
+        // E.g. "movies without genre"; the index only knows existing values.
+        return false;
+    }
+
+    const auto findValue = [&](const char* field) {
+        result = index.findValue(field, filter->shortText());
+        return true;
+    };
+    if (filter->isInfo(MovieFilters::Genres)) {
+        return findValue("genre");
+    }
+    if (filter->isInfo(MovieFilters::Studio)) {
+        return findValue("studio");
+    }
+    if (filter->isInfo(MovieFilters::Country)) {
+        return findValue("country");
+    }
+    if (filter->isInfo(MovieFilters::Tags)) {
+        return findValue("tag");
+    }
+    if (filter->isInfo(MovieFilters::Set)) {
+        return findValue("set");
+    }
+    if (filter->isInfo(MovieFilters::Director)) {
+        return findValue("director");
+    }
+    if (filter->isInfo(MovieFilters::Certification)) {
+        return findValue("certification");
+    }
+    return false;
+}
+
+} // namespace
+
 MovieProxyModel::MovieProxyModel(QObject* parent) :
     QSortFilterProxyModel(parent), m_sortBy{SortBy::New}, m_filterDuplicates{false}
 {
     sort(0, Qt::AscendingOrder);
+    // Sort keys are cached per item; don't keep them for items that no longer exist.
+    m_sortKeys.attach(this);
+    auto* duplicates = Manager::instance()->movieDuplicates();
+    connect(duplicates, &mediaelch::MovieDuplicateIndex::duplicatesChanged, this, [this]() {
+        if (m_filterDuplicates) {
+            invalidateFilter();
+        }
+    });
 }
 
 /**
@@ -19,69 +78,75 @@ MovieProxyModel::MovieProxyModel(QObject* parent) :
 bool MovieProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const
 {
     Q_UNUSED(sourceParent);
-    QVector<Movie*> movies = Manager::instance()->movieModel()->movies();
-    if (sourceRow < 0 || sourceRow >= movies.count()) {
+    Movie* movie = Manager::instance()->movieModel()->movie(sourceRow);
+    if (movie == nullptr) {
         return true;
     }
 
-    Movie* movie = movies.at(sourceRow);
+    // Movies that are not in the index's results can't be accepted by the filters.
+    m_candidates.update(Manager::instance()->movieModel()->searchIndex(), m_filters, findCandidates);
+    if (!m_candidates.contains(movie)) {
+        return false;
+    }
+
     for (Filter* filter : m_filters) {
         if (!filter->accepts(movie)) {
             return false;
         }
     }
 
-    return !(m_filterDuplicates && !movies.at(sourceRow)->hasDuplicates());
+    return !m_filterDuplicates || Manager::instance()->movieDuplicates()->hasDuplicates(movie);
 }
 
 bool MovieProxyModel::lessThan(const QModelIndex& left, const QModelIndex& right) const
 {
-    const QString leftTitle = sourceModel()->data(left, MovieModel::SortTitleRole).toString();
-    const QString rightTitle = sourceModel()->data(right, MovieModel::SortTitleRole).toString();
-    const int cmp = QString::localeAwareCompare(leftTitle, rightTitle);
+    MovieModel* model = Manager::instance()->movieModel();
+    Movie* leftMovie = model->movie(left.row());
+    Movie* rightMovie = model->movie(right.row());
+    if (leftMovie == nullptr || rightMovie == nullptr) {
+        return QSortFilterProxyModel::lessThan(left, right);
+    }
+
+    const auto compareTitles = [&]() {
+        return m_sortKeys.compare(
+                   leftMovie, MovieModel::sortTitle(*leftMovie), rightMovie, MovieModel::sortTitle(*rightMovie))
+               < 0;
+    };
 
     switch (m_sortBy) {
-    case SortBy::Name: return (cmp < 0);
+    case SortBy::Name: return compareTitles();
 
-    case SortBy::Added:
-        return sourceModel()->data(left, MovieModel::FileLastModifiedRole).toDateTime()
-               >= sourceModel()->data(right, MovieModel::FileLastModifiedRole).toDateTime();
+    case SortBy::Added: return leftMovie->fileLastModified() >= rightMovie->fileLastModified();
 
     case SortBy::Seen:
-        if (sourceModel()->data(left, MovieModel::HasWatchedRole).toBool()
-            && !sourceModel()->data(right, MovieModel::HasWatchedRole).toBool()) {
-            return false;
-        }
-        if (!sourceModel()->data(left, MovieModel::HasWatchedRole).toBool()
-            && sourceModel()->data(right, MovieModel::HasWatchedRole).toBool()) {
-            return true;
+        if (leftMovie->watched() != rightMovie->watched()) {
+            return rightMovie->watched();
         }
         // Otherwise sort by name because both are either seen or not.
         break;
 
-    case SortBy::Year:
-        if (sourceModel()->data(left, MovieModel::ReleasedRole).toDate().year()
-            != sourceModel()->data(right, MovieModel::ReleasedRole).toDate().year()) {
-            return sourceModel()->data(left, MovieModel::ReleasedRole).toDate().year()
-                   >= sourceModel()->data(right, MovieModel::ReleasedRole).toDate().year();
+    case SortBy::Year: {
+        const int leftYear = leftMovie->released().year();
+        const int rightYear = rightMovie->released().year();
+        if (leftYear != rightYear) {
+            return leftYear >= rightYear;
         }
         // Otherwise sort by name because both have the same year.
         break;
+    }
 
-    case SortBy::New:
-        if (sourceModel()->data(left, MovieModel::InfoLoadedRole).toBool()
-            && !sourceModel()->data(right, MovieModel::InfoLoadedRole).toBool()) {
-            return false;
-        }
-        if (!sourceModel()->data(left, MovieModel::InfoLoadedRole).toBool()
-            && sourceModel()->data(right, MovieModel::InfoLoadedRole).toBool()) {
-            return true;
+    case SortBy::New: {
+        const bool leftLoaded = leftMovie->controller()->infoLoaded();
+        const bool rightLoaded = rightMovie->controller()->infoLoaded();
+        if (leftLoaded != rightLoaded) {
+            return rightLoaded;
         }
         // Otherwise sort by name because both are new or not.
         break;
     }
+    }
 
-    return (cmp < 0);
+    return compareTitles();
 }
 
 bool MovieProxyModel::filterDuplicates() const
@@ -99,6 +164,7 @@ void MovieProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
     m_filters = std::move(filters);
     m_filterText = std::move(text);
+    m_candidates.invalidate();
     invalidate();
 }
 
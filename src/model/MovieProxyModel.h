@@ -1,6 +1,8 @@
 #pragma once
 
 #include "data/Filter.h"
+#include "model/SearchIndex.h"
+#include "model/SortKeyCache.h"
 
 #include <QSortFilterProxyModel>
 
@@ -25,4 +27,7 @@ private:
     QString m_filterText;
     SortBy m_sortBy;
     bool m_filterDuplicates;
+    mutable mediaelch::SortKeyCache m_sortKeys;
+    /// \brief Movies that may be accepted by m_filters according to MovieModel's search index.
+    mutable mediaelch::SearchCandidates<Movie> m_candidates;
 };
@@ -0,0 +1,53 @@
+#include "model/SearchIndex.h"
+
+namespace mediaelch {
+
+QStringList searchTokens(const QString& text)
+{
+    // Case folding is what QString::contains(..., Qt::CaseInsensitive) uses as well.
+    const QString folded = text.toCaseFolded();
+    QStringList tokens;
+    elch_ssize_t start = -1;
+    for (elch_ssize_t i = 0, n = folded.size(); i <= n; ++i) {
+        const bool isTokenChar = i < n && folded.at(i).isLetterOrNumber();
+        if (isTokenChar && start < 0) {
+            start = i;
+        } else if (!isTokenChar && start >= 0) {
+            tokens << folded.mid(start, i - start);
+            start = -1;
+        }
+    }
+    return tokens;
+}
+
+void SearchTerms::addText(const QString& field, const QString& text)
+{
+    const QStringList textTokens = searchTokens(text);
+    for (const QString& token : textTokens) {
+        QPair<QString, QString> term{field, token};
+        if (!tokens.contains(term)) {
+            tokens << std::move(term);
+        }
+    }
+}
+
+void SearchTerms::addValue(const QString& field, const QString& value)
+{
+    if (!value.isEmpty()) {
+        values << QPair<QString, QString>{field, value};
+    }
+}
+
+void SearchTerms::addValues(const QString& field, const QStringList& fieldValues)
+{
+    for (const QString& value : fieldValues) {
+        addValue(field, value);
+    }
+}
+
+bool SearchTerms::operator==(const SearchTerms& other) const
+{
+    return tokens == other.tokens && values == other.values;
+}
+
+} // namespace mediaelch
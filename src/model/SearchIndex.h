@@ -0,0 +1,225 @@
+#pragma once
+
+#include "utils/Meta.h"
+
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <algorithm>
+
+namespace mediaelch {
+
+/// \brief Splits text into case-folded tokens of letters and numbers.
+QStringList searchTokens(const QString& text);
+
+/// \brief Searchable fields and values of a single item, see SearchIndex.
+struct SearchTerms
+{
+    /// \brief Pairs of field name and token, e.g. {"title", "matrix"}.
+    QVector<QPair<QString, QString>> tokens;
+    /// \brief Pairs of field name and exact value, e.g. {"genre", "Action"}.
+    QVector<QPair<QString, QString>> values;
+
+    void addText(const QString& field, const QString& text);
+    void addValue(const QString& field, const QString& value);
+    void addValues(const QString& field, const QStringList& values);
+
+    bool operator==(const SearchTerms& other) const;
+    bool operator!=(const SearchTerms& other) const { return !(*this == other); }
+};
+
+/// \brief Inverted index from search terms to items, e.g. movies.
+///
+/// Text is split into tokens, see searchTokens().  An item's text field matches
+/// a query if each of the query's tokens is part of one of the field's tokens.
+/// Every item whose field contains the query (case insensitive) matches, but
+/// not every match contains the query, e.g. "rix mat" matches "The Matrix".
+/// The result is meant to narrow down the items that have to be checked by
+/// the actual filters: instead of checking each item, only the index's
+/// vocabulary is searched and the results are intersected.
+///
+/// Values, e.g. genres, only match exactly.
+template<class T>
+class SearchIndex
+{
+public:
+    void insert(T* item, SearchTerms terms)
+    {
+        for (const auto& token : terms.tokens) {
+            m_tokens[token.first][token.second].insert(item);
+        }
+        for (const auto& value : terms.values) {
+            m_values[value.first][value.second].insert(item);
+        }
+        m_terms.insert(item, std::move(terms));
+        ++m_generation;
+    }
+
+    void remove(T* item)
+    {
+        auto terms = m_terms.find(item);
+        if (terms == m_terms.end()) {
+            return;
+        }
+        for (const auto& token : terms->tokens) {
+            removeFrom(m_tokens, token.first, token.second, item);
+        }
+        for (const auto& value : terms->values) {
+            removeFrom(m_values, value.first, value.second, item);
+        }
+        m_terms.erase(terms);
+        ++m_generation;
+    }
+
+    /// \brief Re-index the item if its terms have changed.
+    void update(T* item, SearchTerms terms)
+    {
+        if (m_terms.contains(item) && m_terms.value(item) == terms) {
+            return;
+        }
+        remove(item);
+        insert(item, std::move(terms));
+    }
+
+    void clear()
+    {
+        m_terms.clear();
+        m_tokens.clear();
+        m_values.clear();
+        ++m_generation;
+    }
+
+    bool contains(T* item) const { return m_terms.contains(item); }
+
+    /// \brief Changes each time the index is modified.  Can be used to invalidate results.
+    quint64 generation() const { return m_generation; }
+
+    /// \brief Items whose field may contain the query.
+    /// \returns False if the query has no tokens and therefore can't narrow down the items.
+    bool findText(const QString& field, const QString& query, QSet<T*>& result) const
+    {
+        QStringList queryTokens = searchTokens(query);
+        if (queryTokens.isEmpty()) {
+            return false;
+        }
+        // Long tokens match fewer items, which makes the intersection cheaper.
+        std::sort(queryTokens.begin(), queryTokens.end(), [](const QString& lhs, const QString& rhs) {
+            return lhs.size() > rhs.size();
+        });
+
+        const auto vocabulary = m_tokens.constFind(field);
+        result.clear();
+        if (vocabulary == m_tokens.constEnd()) {
+            return true;
+        }
+
+        bool first = true;
+        for (const QString& queryToken : asConst(queryTokens)) {
+            QSet<T*> matches;
+            for (auto token = vocabulary->constBegin(); token != vocabulary->constEnd(); ++token) {
+                if (token.key().contains(queryToken)) {
+                    matches.unite(token.value());
+                }
+            }
+            if (first) {
+                result = std::move(matches);
+                first = false;
+            } else {
+                result.intersect(matches);
+            }
+            if (result.isEmpty()) {
+                break;
+            }
+        }
+        return true;
+    }
+
+    /// \brief Items with exactly the given value.
+    QSet<T*> findValue(const QString& field, const QString& value) const
+    {
+        return m_values.value(field).value(value);
+    }
+
+private:
+    using Postings = QHash<QString, QHash<QString, QSet<T*>>>;
+
+    static void removeFrom(Postings& postings, const QString& field, const QString& key, T* item)
+    {
+        auto fieldPostings = postings.find(field);
+        if (fieldPostings == postings.end()) {
+            return;
+        }
+        auto items = fieldPostings->find(key);
+        if (items == fieldPostings->end()) {
+            return;
+        }
+        items->remove(item);
+        if (items->isEmpty()) {
+            fieldPostings->erase(items);
+        }
+    }
+
+private:
+    QHash<T*, SearchTerms> m_terms;
+    /// \brief Items per field and token.  The tokens of a field are its vocabulary.
+    Postings m_tokens;
+    /// \brief Items per field and value.
+    Postings m_values;
+    quint64 m_generation = 0;
+};
+
+/// \brief Items that may be accepted by a set of filters.  Used by proxy models.
+///
+/// The candidates are the intersection of the index's results for each filter.
+/// They are recomputed lazily once the index or the filters have changed.
+template<class T>
+class SearchCandidates
+{
+public:
+    /// \brief Forget the candidates, e.g. because the filters have changed.
+    void invalidate() { m_valid = false; }
+
+    /// \brief Update the candidates if the index has changed.
+    /// \param find Called for each filter with (index, filter, result).  Returns false if
+    ///        the filter can't be answered by the index.
+    template<class Filters, class Find>
+    void update(const SearchIndex<T>& index, const Filters& filters, Find find)
+    {
+        if (m_valid && m_generation == index.generation()) {
+            return;
+        }
+        m_valid = true;
+        m_generation = index.generation();
+        m_narrowed = false;
+        m_items.clear();
+        for (const auto& filter : filters) {
+            QSet<T*> matches;
+            if (!find(index, filter, matches)) {
+                continue;
+            }
+            if (m_narrowed) {
+                m_items.intersect(matches);
+            } else {
+                m_items = std::move(matches);
+                m_narrowed = true;
+            }
+        }
+    }
+
+    /// \brief Whether any filter narrowed down the items.  If not, all items are candidates.
+    bool isNarrowed() const { return m_narrowed; }
+    bool contains(T* item) const { return !m_narrowed || m_items.contains(item); }
+    const QSet<T*>& items() const { return m_items; }
+
+private:
+    QSet<T*> m_items;
+    quint64 m_generation = 0;
+    bool m_valid = false;
+    bool m_narrowed = false;
+};
+
+} // namespace mediaelch
@@ -0,0 +1,52 @@
+#include "model/SortKeyCache.h"
+
+#include <QSortFilterProxyModel>
+
+namespace mediaelch {
+
+SortKeyCache::SortKeyCache()
+{
+    // Same as QString::localeAwareCompare() which was used before.
+    m_collator.setCaseSensitivity(Qt::CaseSensitive);
+}
+
+int SortKeyCache::compare(const void* left, const QString& leftTitle, const void* right, const QString& rightTitle)
+{
+    return sortKey(left, leftTitle).compare(sortKey(right, rightTitle));
+}
+
+void SortKeyCache::clear()
+{
+    m_keys.clear();
+}
+
+void SortKeyCache::attach(QSortFilterProxyModel* proxy)
+{
+    const auto connectSourceModel = [this, proxy]() {
+        QObject::disconnect(m_rowsRemoved);
+        QObject::disconnect(m_modelReset);
+        clear();
+        const QAbstractItemModel* model = proxy->sourceModel();
+        if (model == nullptr) {
+            return;
+        }
+        m_rowsRemoved = QObject::connect(model, &QAbstractItemModel::rowsRemoved, proxy, [this]() { clear(); });
+        m_modelReset = QObject::connect(model, &QAbstractItemModel::modelReset, proxy, [this]() { clear(); });
+    };
+    QObject::connect(proxy, &QAbstractProxyModel::sourceModelChanged, proxy, connectSourceModel);
+    connectSourceModel();
+}
+
+const QCollatorSortKey& SortKeyCache::sortKey(const void* item, const QString& title)
+{
+    auto entry = m_keys.find(item);
+    if (entry == m_keys.end()) {
+        entry = m_keys.emplace(item, Entry{title, m_collator.sortKey(title)}).first;
+
+    } else if (entry->second.title != title) {
+        entry->second = Entry{title, m_collator.sortKey(title)};
+    }
+    return entry->second.key;
+}
+
+} // namespace mediaelch
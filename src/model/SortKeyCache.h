@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QAbstractItemModel>
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QMetaObject>
+#include <QString>
+
+#include <unordered_map>
+
+class QSortFilterProxyModel;
+
+namespace mediaelch {
+
+/// \brief Cache of collation sort keys, e.g. for the titles of movies.
+///
+/// Comparing strings locale-aware is expensive.  Proxy models compare the same
+/// titles many times when sorting, so each item's title is converted to a
+/// QCollatorSortKey once, which can be compared cheaply.  A key is recomputed
+/// if the item's title has changed since it was cached.
+///
+/// Items are identified by their address.  Because the title is stored as well,
+/// a new item at the address of a deleted one can't get a wrong key.
+class SortKeyCache
+{
+public:
+    SortKeyCache();
+
+    /// \brief Compares the titles of two items; same semantics as QString::compare().
+    int compare(const void* left, const QString& leftTitle, const void* right, const QString& rightTitle);
+    void clear();
+    /// \brief Number of cached keys.
+    std::size_t size() const { return m_keys.size(); }
+    /// \brief Clear the cache whenever the proxy's source model changes, its rows are removed
+    ///        or it is reset.
+    /// \details Otherwise keys of removed items would be kept as long as the cache exists.
+    ///          Only the current source model is connected.  The proxy must not outlive this
+    ///          cache, e.g. the cache is a member of the proxy.
+    void attach(QSortFilterProxyModel* proxy);
+
+private:
+    const QCollatorSortKey& sortKey(const void* item, const QString& title);
+
+private:
+    struct Entry
+    {
+        QString title;
+        QCollatorSortKey key;
+    };
+
+    QCollator m_collator;
+    std::unordered_map<const void*, Entry> m_keys;
+    QMetaObject::Connection m_rowsRemoved;
+    QMetaObject::Connection m_modelReset;
+};
+
+} // namespace mediaelch
@@ -242,6 +242,7 @@ void TvShowModel::appendShow(TvShow* show)
 
         connect(showItem, &TvShowModelItem::sigChanged, this, &TvShowModel::onSigChanged);
         connect(show, &TvShow::sigChanged, this, &TvShowModel::onShowChanged);
+        m_showSearchIndex.insert(show, searchTerms(*show));
 
         QMap<SeasonNumber, SeasonModelItem*> seasonItems;
         for (TvShowEpisode* episode : show->episodes()) {
@@ -250,6 +251,7 @@ void TvShowModel::appendShow(TvShow* show)
                     showItem->appendSeason(episode->seasonNumber(), episode->seasonString(), show));
             }
             seasonItems.value(episode->seasonNumber())->appendEpisode(episode);
+            m_episodeSearchIndex.insert(episode, searchTerms(*episode));
         }
     }
     endInsertRows();
@@ -295,7 +297,11 @@ QModelIndex TvShowModel::parent(const QModelIndex& index) const
 bool TvShowModel::removeRows(int row, int count, const QModelIndex& parent)
 {
     beginRemoveRows(parent, row, row + count - 1);
-    const bool success = getItem(parent).removeChildren(row, count);
+    TvShowBaseModelItem& parentItem = getItem(parent);
+    for (int i = row; i < row + count && i < parentItem.childCount(); ++i) {
+        removeFromSearchIndex(*parentItem.child(i));
+    }
+    const bool success = parentItem.removeChildren(row, count);
     endRemoveRows();
 
     return success;
@@ -320,6 +326,8 @@ void TvShowModel::clear()
     if (size > 0) {
         beginRemoveRows(QModelIndex(), 0, size - 1);
         m_rootItem.removeChildren(0, size);
+        m_showSearchIndex.clear();
+        m_episodeSearchIndex.clear();
         endRemoveRows();
     }
 }
@@ -329,11 +337,16 @@ void TvShowModel::onSigChanged(TvShowModelItem* showItem, SeasonModelItem* seaso
     const QModelIndex showIndex = index(showItem->indexInParent(), 0);
     const QModelIndex seasonIndex = index(seasonItem->indexInParent(), 0, showIndex);
     const QModelIndex modelIndex = index(episodeItem->indexInParent(), 0, seasonIndex);
+    TvShowEpisode* episode = episodeItem->tvShowEpisode();
+    if (episode != nullptr) {
+        m_episodeSearchIndex.update(episode, searchTerms(*episode));
+    }
     emit dataChanged(modelIndex, modelIndex);
 }
 
 void TvShowModel::onShowChanged(TvShow* show)
 {
+    m_showSearchIndex.update(show, searchTerms(*show));
     const QModelIndex modelIndex = index(show->modelItem()->indexInParent(), 0);
 
     // Season names may have changed
@@ -371,6 +384,34 @@ int TvShowModel::hasNewShowOrEpisode()
     return newShows;
 }
 
+mediaelch::SearchTerms TvShowModel::searchTerms(const TvShow& show)
+{
+    mediaelch::SearchTerms terms;
+    terms.addText("title", show.title());
+    return terms;
+}
+
+mediaelch::SearchTerms TvShowModel::searchTerms(const TvShowEpisode& episode)
+{
+    mediaelch::SearchTerms terms;
+    terms.addText("title", episode.completeEpisodeName());
+    return terms;
+}
+
+void TvShowModel::removeFromSearchIndex(TvShowBaseModelItem& item)
+{
+    // Use the model's items instead of the show's episodes: episodes may have been
+    // added to or removed from the show since it was appended.
+    if (item.type() == TvShowType::TvShow) {
+        m_showSearchIndex.remove(item.tvShow());
+    } else if (item.type() == TvShowType::Episode) {
+        m_episodeSearchIndex.remove(static_cast<EpisodeModelItem&>(item).tvShowEpisode());
+    }
+    for (int i = 0; i < item.childCount(); ++i) {
+        removeFromSearchIndex(*item.child(i));
+    }
+}
+
 TvShowModelItem* TvShowModel::findModelForShow(TvShow* show)
 {
     const auto found = std::find_if(m_rootItem.shows().cbegin(),
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "data/tv_show/TvShow.h"
+#include "model/SearchIndex.h"
 #include "model/tv_show/TvShowRootModelItem.h"
 
 #include <QAbstractItemModel>
@@ -69,15 +70,26 @@ public:
     QVector<TvShow*> tvShows();
     int hasNewShowOrEpisode();
 
+    /// \brief Terms by which shows and episodes are found, e.g. by TvShowProxyModel's filter.
+    /// The episode's text is the one shown in the tree view, i.e. including its number.
+    static mediaelch::SearchTerms searchTerms(const TvShow& show);
+    static mediaelch::SearchTerms searchTerms(const TvShowEpisode& episode);
+    const mediaelch::SearchIndex<TvShow>& showSearchIndex() const { return m_showSearchIndex; }
+    const mediaelch::SearchIndex<TvShowEpisode>& episodeSearchIndex() const { return m_episodeSearchIndex; }
+
 private slots:
     void onSigChanged(TvShowModelItem* showItem, SeasonModelItem* seasonItem, EpisodeModelItem* episodeItem);
     void onShowChanged(TvShow* show);
 
 private:
     TvShowModelItem* findModelForShow(TvShow* show);
+    /// \brief Remove the item and all of its children from the search indices.
+    void removeFromSearchIndex(TvShowBaseModelItem& item);
 
 private:
     TvShowRootModelItem m_rootItem;
+    mediaelch::SearchIndex<TvShow> m_showSearchIndex;
+    mediaelch::SearchIndex<TvShowEpisode> m_episodeSearchIndex;
 
     QMap<int, QMap<bool, QIcon>> m_icons;
     QIcon m_newIcon;
@@ -1,12 +1,15 @@
 #include "TvShowProxyModel.h"
 
 #include "globals/Globals.h"
+#include "globals/Helper.h"
 #include "globals/Manager.h"
 #include "model/tv_show/EpisodeModelItem.h"
 #include "model/tv_show/SeasonModelItem.h"
 
 TvShowProxyModel::TvShowProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
 {
+    // Sort keys are cached per item; don't keep them for items that no longer exist.
+    m_sortKeys.attach(this);
 }
 
 /**
@@ -51,6 +54,18 @@ bool TvShowProxyModel::filterAcceptsRow(int source_row, const QModelIndex& sourc
 
 bool TvShowProxyModel::filterAcceptsRowItself(int sourceRow, const QModelIndex& sourceParent) const
 {
+    updateCandidates();
+    if (m_showCandidates.isNarrowed()) {
+        auto* model = Manager::instance()->tvShowModel();
+        TvShowBaseModelItem& item = model->getItem(model->index(sourceRow, 0, sourceParent));
+        if (item.type() == TvShowType::TvShow && !m_showCandidates.contains(item.tvShow())) {
+            return false;
+        }
+        if (item.type() == TvShowType::Episode
+            && !m_episodeCandidates.contains(static_cast<EpisodeModelItem&>(item).tvShowEpisode())) {
+            return false;
+        }
+    }
     return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
 }
 
@@ -62,6 +77,20 @@ bool TvShowProxyModel::hasAcceptedChildren(int source_row, const QModelIndex& so
         return false;
     }
 
+    if (m_episodeCandidates.isNarrowed()) {
+        TvShowBaseModelItem& baseItem = Manager::instance()->tvShowModel()->getItem(item);
+        if (baseItem.type() == TvShowType::Season) {
+            // Only episodes that may match have to be checked.
+            for (EpisodeModelItem* episodeItem : static_cast<SeasonModelItem&>(baseItem).episodes()) {
+                if (m_episodeCandidates.contains(episodeItem->tvShowEpisode())
+                    && filterAcceptsRowItself(episodeItem->indexInParent(), item)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
     // check if there are children
     int childCount = item.model()->rowCount(item);
     if (childCount == 0) {
@@ -111,12 +140,34 @@ bool TvShowProxyModel::lessThan(const QModelIndex& left, const QModelIndex& righ
         }
     }
 
-    return (
-        QString::localeAwareCompare(sourceModel()->data(left).toString(), sourceModel()->data(right).toString()) < 0);
+    const int cmp = m_sortKeys.compare(&leftItem,
+        helper::appendArticle(leftItem.data(0).toString()),
+        &rightItem,
+        helper::appendArticle(rightItem.data(0).toString()));
+    return cmp < 0;
 }
 
 void TvShowProxyModel::setFilter(QVector<Filter*> filters, QString text)
 {
+    // Same text as the filter wildcard, see TvShowFilesWidget::setFilter().
+    // Wildcards can't be looked up in the index, e.g. "[ab]" matches "a".
+    const QString searchText = filters.isEmpty() ? text : filters.first()->shortText();
+    m_searchQueries.clear();
+    if (!searchText.contains('*') && !searchText.contains('?') && !searchText.contains('[')) {
+        m_searchQueries << searchText;
+    }
     m_filters = std::move(filters);
     m_filterText = std::move(text);
+    m_showCandidates.invalidate();
+    m_episodeCandidates.invalidate();
+}
+
+void TvShowProxyModel::updateCandidates() const
+{
+    const auto findTitle = [](const auto& index, const QString& query, auto& result) {
+        return index.findText("title", query, result);
+    };
+    auto* model = Manager::instance()->tvShowModel();
+    m_showCandidates.update(model->showSearchIndex(), m_searchQueries, findTitle);
+    m_episodeCandidates.update(model->episodeSearchIndex(), m_searchQueries, findTitle);
 }
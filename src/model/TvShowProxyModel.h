@@ -1,6 +1,8 @@
 #pragma once
 
 #include "data/Filter.h"
+#include "model/SearchIndex.h"
+#include "model/SortKeyCache.h"
 
 #include <QSortFilterProxyModel>
 
@@ -18,7 +20,16 @@ protected:
     bool hasAcceptedChildren(int source_row, const QModelIndex& source_parent) const;
     bool lessThan(const QModelIndex& left, const QModelIndex& right) const override;
 
+private:
+    void updateCandidates() const;
+
 private:
     QVector<Filter*> m_filters;
     QString m_filterText;
+    /// \brief Text of the filter wildcard if it can be looked up in the search index.
+    QStringList m_searchQueries;
+    mutable mediaelch::SortKeyCache m_sortKeys;
+    /// \brief Shows and episodes that may match m_searchQueries according to TvShowModel's search indexes.
+    mutable mediaelch::SearchCandidates<TvShow> m_showCandidates;
+    mutable mediaelch::SearchCandidates<TvShowEpisode> m_episodeCandidates;
 };
@@ -200,7 +200,10 @@ void DownloadManager::startNextDownload()
         // TODO: Also emit allXXXFinished() signal
 
     } else {
-        QNetworkReply* reply = network()->getWithWatcher(mediaelch::network::requestWithDefaults(download.url));
+        QNetworkRequest request = mediaelch::network::requestWithDefaults(download.url);
+        // Scraper requests should not have to wait for image downloads.
+        request.setPriority(QNetworkRequest::LowPriority);
+        QNetworkReply* reply = network()->getWithWatcher(request);
         reply->setProperty(PROP_DOWNLOAD_ELEMENT, QVariant::fromValue(download));
         m_currentReplies.push_back(reply);
 
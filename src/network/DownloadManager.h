@@ -84,5 +84,7 @@ private:
     QVector<QNetworkReply*> m_currentReplies;
     QQueue<DownloadManagerElement> m_queue;
 
-    int numberOfParellelDownloads = 5;
+    /// \brief Per-host limits are enforced by the RequestScheduler, so this can be
+    ///        larger than the number of parallel requests to a single host.
+    int numberOfParellelDownloads = 24;
 };
@@ -0,0 +1,263 @@
+#include "network/HttpCache.h"
+
+#include "log/Log.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QPair>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+
+/// \brief Identifies MediaElch's HTTP cache files.
+static constexpr quint32 ENTRY_MAGIC = 0x4d454843; // "MEHC"
+/// \brief Increase if the format of cache files changes.
+static constexpr quint32 ENTRY_VERSION = 1;
+/// \brief Maximum size of responses kept in memory.
+static constexpr int MEMORY_CACHE_BYTES = 32 * 1024 * 1024;
+
+namespace mediaelch {
+namespace network {
+
+bool HttpCache::Entry::isFresh() const
+{
+    return date.isValid() && date.addSecs(maxAge.count()) >= QDateTime::currentDateTimeUtc();
+}
+
+HttpCache::HttpCache(QString directory, qint64 maxSizeBytes) :
+    m_directory{std::move(directory)}, m_maxSizeBytes{maxSizeBytes}
+{
+    m_memoryCache.setMaxCost(MEMORY_CACHE_BYTES);
+}
+
+HttpCache& HttpCache::instance()
+{
+    // The cache location may be cleared by the operating system, which is fine for HTTP responses.
+    static HttpCache s_instance(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/http");
+    return s_instance;
+}
+
+bool HttpCache::find(const QString& key, HttpCache::Entry& entry)
+{
+    const QString hash = keyHash(key);
+    QMutexLocker locker(&m_mutex);
+
+    if (Entry* cached = m_memoryCache.object(hash)) {
+        entry = *cached;
+        applyExpiry(entry);
+        return true;
+    }
+
+    loadIndex();
+    if (!m_index.contains(hash)) {
+        return false;
+    }
+    if (!readEntry(hash, entry)) {
+        // The file was removed or is corrupt.
+        removeEntry(hash);
+        return false;
+    }
+    m_memoryCache.insert(hash, new Entry(entry), static_cast<int>(entry.data.size()));
+    applyExpiry(entry);
+    return true;
+}
+
+void HttpCache::insert(const QString& key, HttpCache::Entry entry)
+{
+    const QString hash = keyHash(key);
+    QMutexLocker locker(&m_mutex);
+
+    loadIndex();
+    writeEntry(hash, entry);
+    const int cost = static_cast<int>(entry.data.size());
+    m_memoryCache.insert(hash, new Entry(std::move(entry)), cost);
+    prune();
+}
+
+void HttpCache::revalidate(const QString& key, std::chrono::seconds maxAge)
+{
+    const QString hash = keyHash(key);
+    QMutexLocker locker(&m_mutex);
+
+    Entry entry;
+    if (Entry* cached = m_memoryCache.object(hash)) {
+        entry = *cached;
+    } else {
+        loadIndex();
+        if (!m_index.contains(hash) || !readEntry(hash, entry)) {
+            return;
+        }
+    }
+    entry.date = QDateTime::currentDateTimeUtc();
+    entry.maxAge = maxAge;
+    writeEntry(hash, entry);
+    const int cost = static_cast<int>(entry.data.size());
+    m_memoryCache.insert(hash, new Entry(std::move(entry)), cost);
+}
+
+void HttpCache::remove(const QString& key)
+{
+    const QString hash = keyHash(key);
+    QMutexLocker locker(&m_mutex);
+    loadIndex();
+    removeEntry(hash);
+}
+
+void HttpCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    loadIndex();
+    const QStringList hashes = m_index.keys();
+    for (const QString& hash : hashes) {
+        removeEntry(hash);
+    }
+    m_memoryCache.clear();
+}
+
+void HttpCache::expireAll()
+{
+    QMutexLocker locker(&m_mutex);
+    m_expiredBefore = QDateTime::currentDateTimeUtc();
+}
+
+qint64 HttpCache::diskSize()
+{
+    QMutexLocker locker(&m_mutex);
+    loadIndex();
+    return m_diskSize;
+}
+
+QString HttpCache::keyHash(const QString& key)
+{
+    return QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5).toHex();
+}
+
+QString HttpCache::cacheFilePath(const QString& hash) const
+{
+    return m_directory + "/" + hash;
+}
+
+void HttpCache::loadIndex()
+{
+    if (m_indexLoaded || m_directory.isEmpty()) {
+        return;
+    }
+    m_indexLoaded = true;
+
+    QDir dir(m_directory);
+    if (!dir.exists() && !dir.mkpath(".")) {
+        qCWarning(generic) << "[HttpCache] Could not create cache directory:" << m_directory;
+        m_directory.clear();
+        return;
+    }
+    qCDebug(generic) << "[HttpCache] Using cache dir:" << m_directory;
+
+    // Only done once per session; file sizes and times are part of the directory listing.
+    const auto entries = dir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot);
+    m_index.reserve(entries.size());
+    for (const QFileInfo& entry : entries) {
+        IndexEntry info;
+        info.size = entry.size();
+        info.lastWritten = entry.lastModified().toMSecsSinceEpoch();
+        m_index.insert(entry.fileName(), info);
+        m_diskSize += info.size;
+    }
+}
+
+bool HttpCache::readEntry(const QString& hash, HttpCache::Entry& entry) const
+{
+    QFile file(cacheFilePath(hash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != ENTRY_MAGIC || version != ENTRY_VERSION) {
+        return false;
+    }
+
+    qint64 date = 0;
+    qint64 maxAge = 0;
+    in >> date >> maxAge >> entry.eTag >> entry.lastModified >> entry.data;
+    entry.date = QDateTime::fromMSecsSinceEpoch(date);
+    entry.maxAge = std::chrono::seconds(maxAge);
+    return in.status() == QDataStream::Ok;
+}
+
+void HttpCache::applyExpiry(HttpCache::Entry& entry) const
+{
+    if (m_expiredBefore.isValid() && entry.date < m_expiredBefore) {
+        entry.maxAge = std::chrono::seconds(0);
+    }
+}
+
+bool HttpCache::writeEntry(const QString& hash, const HttpCache::Entry& entry)
+{
+    if (m_directory.isEmpty()) {
+        return false;
+    }
+
+    QSaveFile file(cacheFilePath(hash));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(generic) << "[HttpCache] Could not write cache file:" << file.fileName();
+        return false;
+    }
+    QDataStream out(&file);
+    out << ENTRY_MAGIC << ENTRY_VERSION << entry.date.toMSecsSinceEpoch() << static_cast<qint64>(entry.maxAge.count())
+        << entry.eTag << entry.lastModified << entry.data;
+    if (!file.commit()) {
+        qCWarning(generic) << "[HttpCache] Could not write cache file:" << file.fileName();
+        return false;
+    }
+
+    IndexEntry info;
+    info.size = QFileInfo(file.fileName()).size();
+    info.lastWritten = QDateTime::currentMSecsSinceEpoch();
+    m_diskSize += info.size - m_index.value(hash).size;
+    m_index.insert(hash, info);
+    return true;
+}
+
+void HttpCache::removeEntry(const QString& hash)
+{
+    m_memoryCache.remove(hash);
+    if (m_index.contains(hash)) {
+        m_diskSize -= m_index.take(hash).size;
+        QFile::remove(cacheFilePath(hash));
+    }
+}
+
+void HttpCache::prune()
+{
+    if (m_diskSize <= m_maxSizeBytes) {
+        return;
+    }
+
+    QVector<QPair<qint64, QString>> byAge;
+    byAge.reserve(m_index.size());
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        byAge.append({it->lastWritten, it.key()});
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    // Remove some more than necessary so that pruning is not needed for each new response.
+    const qint64 targetSize = m_maxSizeBytes / 10 * 9;
+    for (const auto& entry : byAge) {
+        if (m_diskSize <= targetSize) {
+            break;
+        }
+        removeEntry(entry.second);
+    }
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QByteArray>
+#include <QCache>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+#include <chrono>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Persistent cache for HTTP responses, shared by all scraper APIs.
+///
+/// Each response is stored in its own file in the cache directory.  The file
+/// name is a hash of the cache key, so that no URL (which may contain API keys)
+/// ends up in the file system.  Recently used responses are kept in memory as well.
+///
+/// The size of the cache directory is bounded: if it exceeds the maximum size,
+/// the oldest responses are removed first.
+///
+/// The cache is thread safe.
+class HttpCache
+{
+public:
+    struct Entry
+    {
+        QByteArray data;
+        /// \brief Time when the response was received or last revalidated.
+        QDateTime date;
+        /// \brief Time span after `date` in which the entry can be used without asking the server.
+        std::chrono::seconds maxAge{0};
+        /// \brief Value of the response's ETag header; used for revalidation.
+        QByteArray eTag;
+        /// \brief Value of the response's Last-Modified header; used for revalidation.
+        QByteArray lastModified;
+
+        bool isFresh() const;
+    };
+
+    static constexpr qint64 defaultMaxSizeBytes = 256 * 1024 * 1024;
+
+    /// \brief Creates a cache in the given directory.  If the directory is empty,
+    ///        responses are only cached in memory.
+    explicit HttpCache(QString directory, qint64 maxSizeBytes = defaultMaxSizeBytes);
+    /// \brief Cache in the user's cache directory.
+    static HttpCache& instance();
+
+    /// \brief Returns true and sets entry if there is an entry for the given key.
+    ///        The entry may not be fresh anymore.
+    bool find(const QString& key, Entry& entry);
+    void insert(const QString& key, Entry entry);
+    /// \brief Marks the entry as up to date, e.g. because the server responded
+    ///        with "304 Not Modified".
+    void revalidate(const QString& key, std::chrono::seconds maxAge);
+    void remove(const QString& key);
+    void clear();
+    /// \brief Marks all current entries as stale, so that they are revalidated before they
+    ///        are used again.  Used for explicit re-scrapes, which should not return
+    ///        outdated responses.
+    void expireAll();
+
+    /// \brief Size of all responses stored on disk in bytes.
+    qint64 diskSize();
+
+private:
+    static QString keyHash(const QString& key);
+    QString cacheFilePath(const QString& hash) const;
+
+    void loadIndex();
+    bool readEntry(const QString& hash, Entry& entry) const;
+    /// \brief Applies expireAll() to the given entry.
+    void applyExpiry(Entry& entry) const;
+    bool writeEntry(const QString& hash, const Entry& entry);
+    void removeEntry(const QString& hash);
+    /// \brief Removes the oldest responses until the cache is smaller than its maximum size.
+    void prune();
+
+private:
+    /// \brief Metadata of a response on disk; keyed by keyHash().
+    struct IndexEntry
+    {
+        qint64 size = 0;
+        /// \brief Time of the last write in milliseconds since epoch.
+        qint64 lastWritten = 0;
+    };
+
+    QMutex m_mutex;
+    QString m_directory;
+    qint64 m_maxSizeBytes;
+    bool m_indexLoaded = false;
+    QHash<QString, IndexEntry> m_index;
+    qint64 m_diskSize = 0;
+    /// \brief Entries received or revalidated before this time are stale, see expireAll().
+    QDateTime m_expiredBefore;
+    /// \brief Recently used responses; keyed by keyHash(), cost is their size in bytes.
+    QCache<QString, Entry> m_memoryCache;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -13,8 +13,10 @@ enum class HttpStatusCode : int
     // Redirection
     MovedPermanently = 301,
     Found = 302,
+    NotModified = 304,
 
-    TooManyRequests = 429
+    TooManyRequests = 429,
+    ServiceUnavailable = 503
 };
 
 /// \brief Translates the given NetworkError to a human readable error string.
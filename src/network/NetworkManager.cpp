@@ -1,6 +1,7 @@
 #include "network/NetworkManager.h"
 
-#include "network/NetworkReplyWatcher.h"
+#include "network/RequestScheduler.h"
+#include "network/ScheduledReply.h"
 
 #include <QNetworkProxy>
 
@@ -12,7 +13,6 @@ NetworkManager::NetworkManager(QObject* parent) : QObject(parent)
     // Mapping of important signals
     // clang-format off
     connect(&m_qnam, &QNetworkAccessManager::authenticationRequired, this, &NetworkManager::authenticationRequired, Qt::UniqueConnection);
-    connect(&m_qnam, &QNetworkAccessManager::finished,               this, &NetworkManager::finished,               Qt::UniqueConnection);
     // clang-format on
 }
 
@@ -28,25 +28,32 @@ void NetworkManager::enableDefaultProxy()
 
 QNetworkReply* NetworkManager::get(const QNetworkRequest& request)
 {
-    return m_qnam.get(request);
+    return schedule(QNetworkAccessManager::GetOperation, request, {}, false);
 }
 
 QNetworkReply* NetworkManager::getWithWatcher(const QNetworkRequest& request)
 {
-    QNetworkReply* reply = m_qnam.get(request);
-    new NetworkReplyWatcher(this, reply);
-    return reply;
+    return schedule(QNetworkAccessManager::GetOperation, request, {}, true);
 }
 
 QNetworkReply* NetworkManager::post(const QNetworkRequest& request, const QByteArray& data)
 {
-    return m_qnam.post(request, data);
+    return schedule(QNetworkAccessManager::PostOperation, request, data, false);
 }
 
 QNetworkReply* NetworkManager::postWithWatcher(const QNetworkRequest& request, const QByteArray& data)
 {
-    QNetworkReply* reply = m_qnam.post(request, data);
-    new NetworkReplyWatcher(this, reply);
+    return schedule(QNetworkAccessManager::PostOperation, request, data, true);
+}
+
+QNetworkReply* NetworkManager::schedule(QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    const QByteArray& data,
+    bool withWatcher)
+{
+    auto* reply = new ScheduledReply(&m_qnam, operation, request, data, withWatcher, this);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() { emit finished(reply); });
+    RequestScheduler::instance().enqueue(reply);
     return reply;
 }
 
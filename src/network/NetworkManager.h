@@ -11,6 +11,9 @@ namespace mediaelch {
 namespace network {
 
 /// \brief Wrapper around QNetworkAccessManager that adds timeout mechanisms and logging.
+///
+/// Requests are not sent immediately but are queued in the RequestScheduler which
+/// enforces per-host limits.  The returned replies can be used as usual.
 class NetworkManager : public QObject
 {
     Q_OBJECT
@@ -37,6 +40,12 @@ signals:
     void authenticationRequired(QNetworkReply* reply, QAuthenticator* authenticator);
     void finished(QNetworkReply* reply);
 
+private:
+    QNetworkReply* schedule(QNetworkAccessManager::Operation operation,
+        const QNetworkRequest& request,
+        const QByteArray& data,
+        bool withWatcher);
+
 private:
     QNetworkAccessManager m_qnam;
 };
@@ -0,0 +1,211 @@
+#include "network/RequestScheduler.h"
+
+#include "log/Log.h"
+#include "network/ScheduledReply.h"
+
+#include <algorithm>
+
+namespace mediaelch {
+namespace network {
+
+RequestScheduler::RequestScheduler(QObject* parent) : QObject(parent)
+{
+    m_clock.start();
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, [this]() { startRequests(); });
+
+    // Documented limits of APIs used by MediaElch:
+    //  - https://developer.themoviedb.org/docs/rate-limiting
+    //  - https://musicbrainz.org/doc/MusicBrainz_API/Rate_Limiting
+    //  - https://www.tvmaze.com/api#rate-limiting
+    setHostLimits("api.themoviedb.org", HostLimits{40.0, 40, 20});
+    setHostLimits("musicbrainz.org", HostLimits{1.0, 1, 1});
+    setHostLimits("api.tvmaze.com", HostLimits{2.0, 20, 6});
+}
+
+RequestScheduler& RequestScheduler::instance()
+{
+    // Never deleted: Replies may still be destroyed during shutdown.
+    static auto* s_instance = new RequestScheduler();
+    return *s_instance;
+}
+
+void RequestScheduler::setHostLimits(const QString& host, HostLimits limits)
+{
+    HostState& state = hostState(host);
+    state.limits = limits;
+    state.tokens = std::min(state.tokens, static_cast<double>(limits.burst));
+}
+
+HostLimits RequestScheduler::hostLimits(const QString& host) const
+{
+    return m_hosts.value(host.toLower()).limits;
+}
+
+HostStatistics RequestScheduler::statistics(const QString& host) const
+{
+    return m_hosts.value(host.toLower()).statistics;
+}
+
+QStringList RequestScheduler::hosts() const
+{
+    QStringList hosts = m_hosts.keys();
+    hosts.sort();
+    return hosts;
+}
+
+void RequestScheduler::logStatistics() const
+{
+    for (const QString& host : hosts()) {
+        const HostStatistics statistics = m_hosts.value(host).statistics;
+        if (statistics.started == 0) {
+            continue;
+        }
+        qCInfo(generic).nospace() << "[RequestScheduler] " << host << ": " << statistics.started << " started, "
+                                  << statistics.finished << " finished, " << statistics.failed << " failed, "
+                                  << statistics.rateLimited << " rate limited, average wait time "
+                                  << statistics.totalWaitTime / statistics.started << " ms";
+    }
+}
+
+void RequestScheduler::enqueue(ScheduledReply* reply)
+{
+    HostState& state = hostState(hostKey(reply));
+    QueuedReply queued;
+    queued.reply = reply;
+    queued.enqueuedAt = m_clock.elapsed();
+    state.queues[priorityIndex(reply->request().priority())].enqueue(queued);
+    startRequests();
+}
+
+void RequestScheduler::remove(ScheduledReply* reply)
+{
+    auto state = m_hosts.find(hostKey(reply));
+    if (state == m_hosts.end()) {
+        return;
+    }
+    for (auto& queue : state->queues) {
+        queue.erase(std::remove_if(queue.begin(),
+                        queue.end(),
+                        [reply](const QueuedReply& queued) { return queued.reply == reply; }),
+            queue.end());
+    }
+}
+
+void RequestScheduler::requestFinished(ScheduledReply* reply, bool hasError)
+{
+    HostState& state = hostState(hostKey(reply));
+    state.running = std::max(0, state.running - 1);
+    ++state.statistics.finished;
+    if (hasError) {
+        ++state.statistics.failed;
+    }
+    startRequests();
+}
+
+void RequestScheduler::retryLater(ScheduledReply* reply, std::chrono::milliseconds delay)
+{
+    const QString host = hostKey(reply);
+    HostState& state = hostState(host);
+    state.running = std::max(0, state.running - 1);
+    state.pausedUntil = std::max(state.pausedUntil, m_clock.elapsed() + static_cast<qint64>(delay.count()));
+    ++state.statistics.rateLimited;
+    ++state.statistics.retried;
+
+    qCDebug(generic) << "[RequestScheduler] Pausing requests to" << host << "for" << delay.count() << "ms";
+
+    // Retried requests are the oldest ones and go first.
+    QueuedReply queued;
+    queued.reply = reply;
+    queued.enqueuedAt = m_clock.elapsed();
+    state.queues[priorityIndex(reply->request().priority())].prepend(queued);
+    startRequests();
+}
+
+QString RequestScheduler::hostKey(const ScheduledReply* reply)
+{
+    return reply->request().url().host().toLower();
+}
+
+int RequestScheduler::priorityIndex(QNetworkRequest::Priority priority)
+{
+    switch (priority) {
+    case QNetworkRequest::HighPriority: return 0;
+    case QNetworkRequest::NormalPriority: return 1;
+    case QNetworkRequest::LowPriority: return 2;
+    }
+    return 1;
+}
+
+RequestScheduler::HostState& RequestScheduler::hostState(const QString& host)
+{
+    auto state = m_hosts.find(host.toLower());
+    if (state == m_hosts.end()) {
+        HostState newState;
+        newState.tokens = newState.limits.burst;
+        newState.lastRefill = m_clock.elapsed();
+        state = m_hosts.insert(host.toLower(), newState);
+    }
+    return *state;
+}
+
+void RequestScheduler::startRequests()
+{
+    const qint64 now = m_clock.elapsed();
+    qint64 nextRun = -1;
+    // Iterate over keys: starting a request may call back into the scheduler.
+    const QStringList hosts = m_hosts.keys();
+    for (const QString& host : hosts) {
+        const qint64 wait = startRequests(m_hosts[host], now);
+        if (wait >= 0 && (nextRun < 0 || wait < nextRun)) {
+            nextRun = wait;
+        }
+    }
+
+    if (nextRun > 0 && (!m_timer.isActive() || m_timer.remainingTime() > nextRun)) {
+        m_timer.start(static_cast<int>(nextRun));
+    }
+}
+
+qint64 RequestScheduler::startRequests(HostState& state, qint64 now)
+{
+    const HostLimits& limits = state.limits;
+    const bool hasRateLimit = limits.requestsPerSecond > 0.0;
+    if (hasRateLimit) {
+        const double elapsedSeconds = static_cast<double>(now - state.lastRefill) / 1000.0;
+        state.tokens = std::min(
+            static_cast<double>(limits.burst), state.tokens + elapsedSeconds * limits.requestsPerSecond);
+    }
+    state.lastRefill = now;
+
+    for (auto& queue : state.queues) {
+        while (!queue.isEmpty()) {
+            if (now < state.pausedUntil) {
+                return state.pausedUntil - now;
+            }
+            if (state.running >= limits.maxParallelRequests) {
+                // Started again by requestFinished().
+                return -1;
+            }
+            if (hasRateLimit && state.tokens < 1.0) {
+                return static_cast<qint64>((1.0 - state.tokens) / limits.requestsPerSecond * 1000.0) + 1;
+            }
+
+            const QueuedReply queued = queue.dequeue();
+            if (queued.reply.isNull()) {
+                continue;
+            }
+            if (hasRateLimit) {
+                state.tokens -= 1.0;
+            }
+            ++state.running;
+            ++state.statistics.started;
+            state.statistics.totalWaitTime += now - queued.enqueuedAt;
+            queued.reply->start();
+        }
+    }
+    return -1;
+}
+
+} // namespace network
+} // namespace mediaelch
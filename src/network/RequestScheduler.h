@@ -0,0 +1,118 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <array>
+#include <chrono>
+
+namespace mediaelch {
+namespace network {
+
+class ScheduledReply;
+
+/// \brief Limits for requests to a single host.
+struct HostLimits
+{
+    /// \brief Average number of requests that may be started per second. 0 means unlimited.
+    double requestsPerSecond = 0.0;
+    /// \brief Number of requests that may be started at once, i.e. the size of the token bucket.
+    int burst = 1;
+    /// \brief Number of requests that may run in parallel.
+    int maxParallelRequests = 6;
+};
+
+struct HostStatistics
+{
+    int started = 0;
+    int finished = 0;
+    int failed = 0;
+    /// \brief Number of "429 Too Many Requests" and "503 Service Unavailable" responses.
+    int rateLimited = 0;
+    int retried = 0;
+    /// \brief Time that requests had to wait in the queue in milliseconds.
+    qint64 totalWaitTime = 0;
+};
+
+/// \brief Decides when network requests are started, independently for each host.
+///
+/// Each host has a token bucket that limits the request rate as well as a limit for
+/// parallel requests.  Requests with a higher QNetworkRequest::Priority are started
+/// first, e.g. requests of scrapers before image downloads.  If a host responds with
+/// "429 Too Many Requests" or "503 Service Unavailable", all requests to it are paused
+/// for some time and the request is retried.
+///
+/// Limits of known hosts are based on their documented rate limits.  All other hosts
+/// only have a limit for parallel requests.
+///
+/// The scheduler is not thread safe and must only be used from the GUI thread.
+class RequestScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static RequestScheduler& instance();
+
+    void setHostLimits(const QString& host, HostLimits limits);
+    HostLimits hostLimits(const QString& host) const;
+    HostStatistics statistics(const QString& host) const;
+    /// \brief All hosts that have limits or to which requests were sent.
+    QStringList hosts() const;
+    /// \brief Logs the statistics of all hosts to which requests were sent.
+    void logStatistics() const;
+
+    /// \brief Queues the reply.  It is started as soon as the host's limits allow it.
+    void enqueue(ScheduledReply* reply);
+    /// \brief Removes a queued reply, e.g. because it was aborted.
+    void remove(ScheduledReply* reply);
+    /// \brief Must be called once a started reply has finished so that other requests can start.
+    void requestFinished(ScheduledReply* reply, bool hasError);
+    /// \brief Pauses all requests to the reply's host and queues the reply again.
+    void retryLater(ScheduledReply* reply, std::chrono::milliseconds delay);
+
+private:
+    explicit RequestScheduler(QObject* parent = nullptr);
+
+    struct QueuedReply
+    {
+        QPointer<ScheduledReply> reply;
+        qint64 enqueuedAt = 0;
+    };
+
+    struct HostState
+    {
+        HostLimits limits;
+        HostStatistics statistics;
+        double tokens = 0.0;
+        qint64 lastRefill = 0;
+        qint64 pausedUntil = 0;
+        int running = 0;
+        /// \brief One queue for each priority, see priorityIndex().
+        std::array<QQueue<QueuedReply>, 3> queues;
+    };
+
+    static QString hostKey(const ScheduledReply* reply);
+    static int priorityIndex(QNetworkRequest::Priority priority);
+    HostState& hostState(const QString& host);
+
+    /// \brief Starts all requests that the hosts' limits allow and schedules the next run.
+    void startRequests();
+    /// \brief Starts requests of the given host.  Returns the time in milliseconds until
+    ///        the next request could be started or -1 if there is no queued request.
+    qint64 startRequests(HostState& state, qint64 now);
+
+private:
+    QHash<QString, HostState> m_hosts;
+    QElapsedTimer m_clock;
+    QTimer m_timer;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,181 @@
+#include "network/ScheduledReply.h"
+
+#include "log/Log.h"
+#include "network/HttpStatusCodes.h"
+#include "network/NetworkReplyWatcher.h"
+#include "network/RequestScheduler.h"
+
+#include <QtGlobal>
+#include <array>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief How often a request is retried if the server is overloaded.
+static constexpr int MAX_RETRIES = 3;
+
+ScheduledReply::ScheduledReply(QNetworkAccessManager* manager,
+    QNetworkAccessManager::Operation operation,
+    const QNetworkRequest& request,
+    QByteArray body,
+    bool withWatcher,
+    QObject* parent) :
+    QNetworkReply(parent), m_manager{manager}, m_body{std::move(body)}, m_withWatcher{withWatcher}
+{
+    setRequest(request);
+    setUrl(request.url());
+    setOperation(operation);
+    open(QIODevice::ReadOnly);
+}
+
+ScheduledReply::~ScheduledReply()
+{
+    if (m_state == State::Queued) {
+        RequestScheduler::instance().remove(this);
+
+    } else if (m_state == State::Running) {
+        RequestScheduler::instance().requestFinished(this, true);
+    }
+
+    if (!m_reply.isNull()) {
+        m_reply->disconnect(this);
+        if (m_reply->isRunning()) {
+            m_reply->abort();
+        }
+        m_reply->deleteLater();
+    }
+}
+
+void ScheduledReply::start()
+{
+    m_state = State::Running;
+    if (m_manager.isNull()) {
+        RequestScheduler::instance().requestFinished(this, true);
+        finish(QNetworkReply::OperationCanceledError, tr("Network manager was deleted"));
+        return;
+    }
+
+    if (operation() == QNetworkAccessManager::PostOperation) {
+        m_reply = m_manager->post(request(), m_body);
+    } else {
+        m_reply = m_manager->get(request());
+    }
+    if (m_withWatcher) {
+        // Watch the actual reply, so that the time in the queue does not count as timeout.
+        new NetworkReplyWatcher(this, m_reply);
+    }
+
+    connect(m_reply, &QNetworkReply::metaDataChanged, this, [this]() {
+        copyMetaData();
+        emit metaDataChanged();
+    });
+    connect(m_reply, &QNetworkReply::readyRead, this, &QNetworkReply::readyRead);
+    connect(m_reply, &QNetworkReply::downloadProgress, this, &QNetworkReply::downloadProgress);
+    connect(m_reply, &QNetworkReply::uploadProgress, this, &QNetworkReply::uploadProgress);
+    connect(m_reply, &QNetworkReply::finished, this, &ScheduledReply::onReplyFinished);
+}
+
+void ScheduledReply::abort()
+{
+    if (m_state == State::Finished) {
+        return;
+    }
+    m_aborted = true;
+    if (m_state == State::Queued) {
+        RequestScheduler::instance().remove(this);
+        finish(QNetworkReply::OperationCanceledError, tr("Operation canceled"));
+        return;
+    }
+    if (m_reply.isNull()) {
+        // The network manager was deleted together with the actual reply.
+        RequestScheduler::instance().requestFinished(this, true);
+        finish(QNetworkReply::OperationCanceledError, tr("Operation canceled"));
+        return;
+    }
+    // Results in onReplyFinished()
+    m_reply->abort();
+}
+
+qint64 ScheduledReply::bytesAvailable() const
+{
+    const qint64 available = !m_reply.isNull() ? m_reply->bytesAvailable() : 0;
+    return QNetworkReply::bytesAvailable() + available;
+}
+
+qint64 ScheduledReply::readData(char* data, qint64 maxSize)
+{
+    if (m_reply.isNull()) {
+        return m_state == State::Finished ? -1 : 0;
+    }
+    const qint64 read = m_reply->read(data, maxSize);
+    if (read == 0 && m_state == State::Finished) {
+        return -1;
+    }
+    return read;
+}
+
+void ScheduledReply::onReplyFinished()
+{
+    const int status = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const bool isOverloaded = status == static_cast<int>(HttpStatusCode::TooManyRequests)
+                              || status == static_cast<int>(HttpStatusCode::ServiceUnavailable);
+
+    if (isOverloaded && !m_aborted && m_retries < MAX_RETRIES) {
+        ++m_retries;
+        // Retry-After may also be a date, which is not supported; use an exponential backoff then.
+        bool ok = false;
+        const int retryAfter = m_reply->rawHeader("Retry-After").trimmed().toInt(&ok);
+        const qint64 delay = ok ? qBound(1, retryAfter, 60) * 1000 : (1000LL << m_retries);
+
+        qCInfo(generic) << "[ScheduledReply] Server is overloaded, retrying in" << delay << "ms:" << url();
+
+        m_reply->disconnect(this);
+        m_reply->deleteLater();
+        m_reply = nullptr;
+        m_state = State::Queued;
+        RequestScheduler::instance().retryLater(this, std::chrono::milliseconds(delay));
+        return;
+    }
+
+    copyMetaData();
+    setUrl(m_reply->url());
+    // NetworkReplyWatcher marks the actual reply; callers only know this one.
+    setProperty(NetworkReplyWatcher::TIMEOUT_PROP, m_reply->property(NetworkReplyWatcher::TIMEOUT_PROP));
+
+    RequestScheduler::instance().requestFinished(this, m_reply->error() != QNetworkReply::NoError);
+    finish(m_reply->error(), m_reply->errorString());
+}
+
+void ScheduledReply::copyMetaData()
+{
+    static const std::array<QNetworkRequest::Attribute, 5> attributes{QNetworkRequest::HttpStatusCodeAttribute,
+        QNetworkRequest::HttpReasonPhraseAttribute,
+        QNetworkRequest::RedirectionTargetAttribute,
+        QNetworkRequest::ConnectionEncryptedAttribute,
+        QNetworkRequest::SourceIsFromCacheAttribute};
+    for (const auto attribute : attributes) {
+        setAttribute(attribute, m_reply->attribute(attribute));
+    }
+    const auto headers = m_reply->rawHeaderPairs();
+    for (const auto& header : headers) {
+        setRawHeader(header.first, header.second);
+    }
+}
+
+void ScheduledReply::finish(QNetworkReply::NetworkError code, const QString& errorString)
+{
+    m_state = State::Finished;
+    if (code != QNetworkReply::NoError) {
+        setError(code, errorString);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        emit errorOccurred(code);
+#else
+        emit error(code);
+#endif
+    }
+    setFinished(true);
+    emit finished();
+}
+
+} // namespace network
+} // namespace mediaelch
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QByteArray>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPointer>
+
+namespace mediaelch {
+namespace network {
+
+/// \brief Network reply whose request is started by the RequestScheduler.
+///
+/// The reply can be used like any other QNetworkReply right after it was created,
+/// even though the actual request may only be sent later.  All data, headers and
+/// signals of the actual reply are forwarded.  If the server is overloaded, the
+/// request is retried transparently.
+class ScheduledReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    ScheduledReply(QNetworkAccessManager* manager,
+        QNetworkAccessManager::Operation operation,
+        const QNetworkRequest& request,
+        QByteArray body,
+        bool withWatcher,
+        QObject* parent);
+    ~ScheduledReply() override;
+
+    void abort() override;
+    qint64 bytesAvailable() const override;
+    bool isSequential() const override { return true; }
+
+    /// \brief Sends the request. Called by the RequestScheduler.
+    void start();
+    int retries() const { return m_retries; }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+
+private:
+    enum class State
+    {
+        Queued,
+        Running,
+        Finished
+    };
+
+    void onReplyFinished();
+    void copyMetaData();
+    void finish(QNetworkReply::NetworkError code, const QString& errorString);
+
+private:
+    QPointer<QNetworkAccessManager> m_manager;
+    QByteArray m_body;
+    bool m_withWatcher;
+    /// \brief The actual reply.  It is a child of the network manager, which may delete it
+    ///        before this reply is deleted, e.g. if both belong to the same NetworkManager.
+    QPointer<QNetworkReply> m_reply;
+    State m_state = State::Queued;
+    int m_retries = 0;
+    bool m_aborted = false;
+};
+
+} // namespace network
+} // namespace mediaelch
@@ -1,5 +1,7 @@
 #include "network/WebsiteCache.h"
 
+#include "network/HttpStatusCodes.h"
+
 #include <QDateTime>
 #include <QString>
 #include <QUrl>
@@ -7,58 +9,121 @@
 namespace mediaelch {
 namespace scraper {
 
-WebsiteCache::WebsiteCache()
+constexpr std::chrono::seconds WebsiteCache::defaultTimeToLive;
+
+WebsiteCache::WebsiteCache(std::chrono::seconds timeToLive, network::HttpCache* cache) :
+    m_timeToLive{timeToLive}, m_cache{cache != nullptr ? *cache : network::HttpCache::instance()}
 {
-    QObject::connect(&m_timer, &QTimer::timeout, &m_timer, [this]() { clearOldCacheEntries(); });
 }
 
 bool WebsiteCache::hasValidElement(const QUrl& url, const Locale& locale)
 {
-    const QString h = hash(url, locale);
-    return m_cache.contains(h) && m_cache[h].date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds);
+    network::HttpCache::Entry entry;
+    return m_cache.find(key(url, locale), entry) && entry.isFresh();
 }
 
-QString WebsiteCache::hash(const QUrl& url, const Locale& locale)
+QString WebsiteCache::getElement(const QUrl& url, const Locale& locale)
 {
-    return QStringLiteral("%1_##_%2").arg(locale.toString(), url.toString());
+    network::HttpCache::Entry entry;
+    m_cache.find(key(url, locale), entry);
+    return QString::fromUtf8(entry.data);
 }
 
-void WebsiteCache::addElement(const QUrl& url, const Locale& locale, QString data)
+void WebsiteCache::addValidationHeaders(QNetworkRequest& request, const Locale& locale)
 {
-    if (data.isEmpty() || !url.isValid()) {
+    const QString cacheKey = key(request.url(), locale);
+    network::HttpCache::Entry entry;
+    if (!m_cache.find(cacheKey, entry) || (entry.eTag.isEmpty() && entry.lastModified.isEmpty())) {
         return;
     }
-    CacheElement c;
-    c.data = std::move(data);
-    c.date = QDateTime::currentDateTime();
-    m_cache.insert(hash(url, locale), c);
-
-    if (!m_timer.isActive()) {
-        // set timer for clearing the cache
-        m_timer.start(timeoutSeconds * 1000);
+    if (!entry.eTag.isEmpty()) {
+        request.setRawHeader("If-None-Match", entry.eTag);
+    }
+    if (!entry.lastModified.isEmpty()) {
+        request.setRawHeader("If-Modified-Since", entry.lastModified);
     }
+    QMutexLocker locker(&m_mutex);
+    m_validating.insert(cacheKey, std::move(entry));
 }
 
-QString WebsiteCache::getElement(const QUrl& url, const Locale& locale)
+QString WebsiteCache::readReply(QNetworkReply& reply, const Locale& locale)
 {
-    const QString h = hash(url, locale);
-    return m_cache[h].data;
+    const QString cacheKey = key(reply.request().url(), locale);
+    network::HttpCache::Entry validated;
+    {
+        QMutexLocker locker(&m_mutex);
+        validated = m_validating.take(cacheKey);
+    }
+
+    const int status = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status != static_cast<int>(HttpStatusCode::NotModified)) {
+        return QString::fromUtf8(reply.readAll());
+    }
+
+    network::HttpCache::Entry entry;
+    if (m_cache.find(cacheKey, entry)) {
+        m_cache.revalidate(cacheKey, maxAge(reply));
+    } else {
+        // The element was removed from the HttpCache while the request was running.
+        entry = std::move(validated);
+        entry.date = QDateTime::currentDateTimeUtc();
+        entry.maxAge = maxAge(reply);
+        if (!entry.data.isEmpty()) {
+            m_cache.insert(cacheKey, entry);
+        }
+    }
+    return QString::fromUtf8(entry.data);
 }
 
-void WebsiteCache::clearOldCacheEntries()
+void WebsiteCache::addElement(const QNetworkReply& reply, const Locale& locale, const QString& data)
 {
-    auto it = m_cache.begin();
-    while (it != m_cache.end()) {
-        if (it.value().date >= QDateTime::currentDateTime().addSecs(-timeoutSeconds)) {
-            it = m_cache.erase(it);
-        } else {
-            ++it;
-        }
+    // The request's URL and not the reply's, which differs after redirects.
+    const QUrl url = reply.request().url();
+    if (data.isEmpty() || !url.isValid()) {
+        return;
+    }
+    const int status = reply.attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == static_cast<int>(HttpStatusCode::NotModified)) {
+        // Already revalidated in readReply().
+        return;
     }
+    const QByteArray cacheControl = reply.rawHeader("Cache-Control").toLower();
+    if (cacheControl.contains("no-store")) {
+        return;
+    }
+
+    network::HttpCache::Entry entry;
+    entry.data = data.toUtf8();
+    entry.date = QDateTime::currentDateTimeUtc();
+    entry.maxAge = maxAge(reply);
+    entry.eTag = reply.rawHeader("ETag");
+    entry.lastModified = reply.rawHeader("Last-Modified");
+    m_cache.insert(key(url, locale), std::move(entry));
+}
 
-    if (!m_cache.isEmpty()) {
-        m_timer.start(timeoutSeconds * 1000);
+QString WebsiteCache::key(const QUrl& url, const Locale& locale)
+{
+    return QStringLiteral("%1_##_%2").arg(locale.toString(), url.toString());
+}
+
+std::chrono::seconds WebsiteCache::maxAge(const QNetworkReply& reply) const
+{
+    // e.g. "Cache-Control: public, max-age=3600"
+    const QList<QByteArray> directives = reply.rawHeader("Cache-Control").toLower().split(',');
+    for (const QByteArray& directive : directives) {
+        const QByteArray trimmed = directive.trimmed();
+        if (trimmed == "no-cache") {
+            return std::chrono::seconds(0);
+        }
+        if (trimmed.startsWith("max-age=")) {
+            bool ok = false;
+            const qint64 seconds = trimmed.mid(8).toLongLong(&ok);
+            if (ok) {
+                return std::chrono::seconds(seconds);
+            }
+        }
     }
+    return m_timeToLive;
 }
 
 } // namespace scraper
@@ -1,48 +1,63 @@
 #pragma once
 
 #include "data/Locale.h"
+#include "network/HttpCache.h"
 
-#include <QDateTime>
-#include <QMap>
+#include <QHash>
+#include <QMutex>
+#include <QNetworkReply>
+#include <QNetworkRequest>
 #include <QString>
-#include <QTimer>
 #include <QUrl>
 
+#include <chrono>
+
 namespace mediaelch {
 namespace scraper {
 
-/// \brief TheTvDb API cache stores the result for a API request as a string.
+/// \brief Cache for the responses of a scraper API.
+///
+/// Responses are stored in the persistent HttpCache, so that they survive
+/// restarts of MediaElch.  A response is used without asking the server
+/// for the time given in its Cache-Control "max-age" or, if there is none,
+/// for the API's time to live.  Afterwards it is revalidated using its ETag
+/// or Last-Modified header, if the server sent one of them.
 ///
-/// Clears cache elements every timeoutSeconds. The cache is *not*
-/// thread safe.
+/// The cache is thread safe.
 class WebsiteCache
 {
 public:
-    constexpr static int timeoutSeconds = 240;
+    /// \brief Default time to live of the scraper APIs, see AdvancedSettings::scraperCacheTimeToLive().
+    static constexpr std::chrono::seconds defaultTimeToLive{12 * 60 * 60};
 
-    WebsiteCache();
+    explicit WebsiteCache(std::chrono::seconds timeToLive = defaultTimeToLive, network::HttpCache* cache = nullptr);
 
-    void addElement(const QUrl& url, const Locale& locale, QString data);
-    QString getElement(const QUrl& url, const Locale& locale);
+    /// \brief Returns true if there is a fresh element, i.e. no request is necessary.
     bool hasValidElement(const QUrl& url, const Locale& locale);
+    QString getElement(const QUrl& url, const Locale& locale);
+
+    /// \brief Adds "If-None-Match" and "If-Modified-Since" headers if there is a stale element.
+    /// \details The element is kept until the reply is read, so that it is still available
+    ///          if it is removed from the HttpCache in the meantime, e.g. because it was pruned.
+    void addValidationHeaders(QNetworkRequest& request, const Locale& locale);
+    /// \brief Reads the reply's data.  If the server responded with "304 Not Modified",
+    ///        the cached element is returned instead and is valid again.
+    QString readReply(QNetworkReply& reply, const Locale& locale);
+    /// \brief Stores the reply's data, unless the server does not allow it.
+    void addElement(const QNetworkReply& reply, const Locale& locale, const QString& data);
 
 private:
-    struct CacheElement
-    {
-        QDateTime date;
-        QString data;
-    };
-
-    QString hash(const QUrl& url, const Locale& locale);
-
-    /// \brief Clears old cache entries that are older than timeoutSeconds.
-    ///
-    /// Restarts the timer if the cache is not empty to ensure that all elements
-    /// are eventually deleted.
-    void clearOldCacheEntries();
-
-    QMap<QUrl, CacheElement> m_cache;
-    QTimer m_timer;
+    static QString key(const QUrl& url, const Locale& locale);
+    std::chrono::seconds maxAge(const QNetworkReply& reply) const;
+
+    std::chrono::seconds m_timeToLive;
+    network::HttpCache& m_cache;
+
+    QMutex m_mutex;
+    /// \brief Elements for which a request with validation headers was sent; keyed by key().
+    /// \details An element is replaced by the next request for the same URL, if the
+    ///          previous one failed.
+    QHash<QString, network::HttpCache::Entry> m_validating;
 };
 
 } // namespace scraper
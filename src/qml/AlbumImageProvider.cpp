@@ -4,6 +4,9 @@
 
 #include "globals/Manager.h"
 
+#include <QBuffer>
+#include <QImageReader>
+
 AlbumImageProvider::AlbumImageProvider() : QQuickImageProvider(QQuickImageProvider::Image)
 {
 }
@@ -30,17 +33,27 @@ QImage AlbumImageProvider::requestImage(const QString& id, QSize* size, const QS
         Album* album = artist->albums().at(albumNum);
 
         int row = album->bookletModel()->rowById(imageId);
-        QImage img = QImage::fromData(
-            album->bookletModel()->data(album->bookletModel()->index(row, 0), Qt::UserRole + 4).toByteArray());
-
+        QByteArray data =
+            album->bookletModel()->data(album->bookletModel()->index(row, 0), Qt::UserRole + 4).toByteArray();
+
+        // Decode the image directly at the requested size.  For JPEGs this is a lot
+        // faster than decoding the full image and scaling it afterwards.
+        QBuffer buffer(&data);
+        QImageReader reader(&buffer);
+        const QSize originalSize = reader.size();
         if (size != nullptr) {
-            *size = QSize(img.width(), img.height());
+            *size = originalSize;
         }
-        if (requestedSize.width() > 0 || requestedSize.height() > 0) {
-            return img.scaled(
-                requestedSize.width(), requestedSize.height(), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        if (!originalSize.isEmpty() && (requestedSize.width() > 0 || requestedSize.height() > 0)) {
+            QSize scaledSize = requestedSize;
+            if (scaledSize.width() <= 0) {
+                scaledSize.setWidth(originalSize.width() * scaledSize.height() / originalSize.height());
+            } else if (scaledSize.height() <= 0) {
+                scaledSize.setHeight(originalSize.height() * scaledSize.width() / originalSize.width());
+            }
+            reader.setScaledSize(originalSize.scaled(scaledSize, Qt::KeepAspectRatio));
         }
-        return img;
+        return reader.read();
     }
 
     return QImage();
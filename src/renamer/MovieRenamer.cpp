@@ -20,6 +20,8 @@ MovieRenamer::RenameError MovieRenamer::renameMovie(Movie& movie)
     QString newFolderName = m_config.directoryPattern;
 
     MediaCenterInterface* mediaCenter = Manager::instance()->mediaCenterInterface();
+    // Placeholders such as stream details are not part of the list data.
+    movie.controller()->loadDetails(mediaCenter);
     QString nfo = mediaCenter->nfoFilePath(&movie);
 
     QString newFileName;
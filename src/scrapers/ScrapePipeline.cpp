@@ -0,0 +1,237 @@
+#include "scrapers/ScrapePipeline.h"
+
+#include "log/Log.h"
+#include "scrapers/movie/custom/CustomMovieScraper.h"
+#include "scrapers/movie/imdb/ImdbMovie.h"
+#include "scrapers/movie/tmdb/TmdbMovie.h"
+#include "scrapers/tv_show/custom/CustomTvScraper.h"
+#include "scrapers/tv_show/imdb/ImdbTv.h"
+#include "scrapers/tv_show/thetvdb/TheTvDb.h"
+#include "scrapers/tv_show/tmdb/TmdbTv.h"
+#include "scrapers/tv_show/tvmaze/TvMaze.h"
+
+#include <algorithm>
+
+namespace mediaelch {
+namespace scraper {
+
+ScrapePipeline::ScrapePipeline(QObject* parent) : QObject(parent)
+{
+}
+
+ScrapePipeline::Limits ScrapePipeline::limitsForScraper(const QString& identifier)
+{
+    Limits limits;
+    if (identifier == TmdbMovie::ID || identifier == TmdbTv::ID) {
+        // TMDb's API is fast and has generous rate limits.
+        limits.search = 6;
+        limits.load = 4;
+
+    } else if (identifier == ImdbMovie::ID || identifier == ImdbTv::ID) {
+        // IMDb is scraped from its website which blocks too many requests.
+        limits.search = 2;
+        limits.load = 2;
+
+    } else if (identifier == TvMaze::ID) {
+        // TVmaze allows 20 requests every 10 seconds.
+        limits.search = 2;
+        limits.load = 1;
+
+    } else if (identifier == TheTvDb::ID) {
+        limits.search = 2;
+        limits.load = 2;
+
+    } else if (identifier == CustomMovieScraper::ID || identifier == CustomTvScraper::ID) {
+        // Custom scrapers query several scrapers per item.
+        limits.search = 1;
+        limits.load = 1;
+    }
+    return limits;
+}
+
+void ScrapePipeline::setLimits(Limits limits)
+{
+    m_limits = limits;
+    pump();
+}
+
+ScrapePipeline::Limits ScrapePipeline::limits() const
+{
+    return m_limits;
+}
+
+void ScrapePipeline::setHandler(Stage stage, Handler handler)
+{
+    m_handlers[static_cast<int>(stage)] = std::move(handler);
+}
+
+int ScrapePipeline::start(int itemCount)
+{
+    abort();
+    const int run = ++m_run;
+    m_items = QVector<ItemState>(std::max(0, itemCount));
+    m_running = true;
+    pump();
+    return run;
+}
+
+void ScrapePipeline::advance(int item, int run)
+{
+    if (!m_running || run != m_run || item < 0 || item >= m_items.size()) {
+        return;
+    }
+    if (!leaveStage(item)) {
+        qCWarning(generic) << "[ScrapePipeline] Item" << item << "advanced but it isn't processed by any stage";
+        return;
+    }
+    enterStage(item, m_items[item].stage + 1);
+    pump();
+}
+
+void ScrapePipeline::finish(int item, int run)
+{
+    if (!m_running || run != m_run || item < 0 || item >= m_items.size()) {
+        return;
+    }
+    ItemState& state = m_items[item];
+    if (state.stage == notStarted || state.stage == done) {
+        return;
+    }
+    if (!leaveStage(item)) {
+        m_waiting[state.stage].removeOne(item);
+    }
+    enterStage(item, done);
+    pump();
+}
+
+void ScrapePipeline::abort()
+{
+    m_running = false;
+    for (auto& waiting : m_waiting) {
+        waiting.clear();
+    }
+    m_runningCount.fill(0);
+    m_items.clear();
+    m_nextItem = 0;
+    m_finishedCount = 0;
+}
+
+int ScrapePipeline::runningCount(Stage stage) const
+{
+    return m_runningCount[static_cast<int>(stage)];
+}
+
+bool ScrapePipeline::isProcessing(int item, Stage stage) const
+{
+    if (item < 0 || item >= m_items.size()) {
+        return false;
+    }
+    const ItemState& state = m_items.at(item);
+    return state.isRunning && state.stage == static_cast<int>(stage);
+}
+
+void ScrapePipeline::pump()
+{
+    // Handlers may advance items synchronously, which calls pump() again.
+    // Instead of recursing, the outer call loops until nothing changes.
+    if (m_pumping) {
+        m_pumpAgain = true;
+        return;
+    }
+    m_pumping = true;
+    do {
+        m_pumpAgain = false;
+        // Later stages first so that items already in flight finish before new ones are started.
+        for (int stage = stageCount - 1; stage >= 0 && m_running; --stage) {
+            pumpStage(stage);
+        }
+        const int firstStage = nextStage(0);
+        while (m_running && m_nextItem < m_items.size()
+               && (firstStage == done || (m_waiting[firstStage].isEmpty() && hasCapacity(firstStage)))) {
+            const int item = m_nextItem++;
+            const int run = m_run;
+            emit itemStarted(item);
+            if (!m_running || run != m_run) {
+                // Aborted or restarted by a slot connected to itemStarted().
+                break;
+            }
+            enterStage(item, firstStage);
+            if (firstStage != done) {
+                pumpStage(firstStage);
+            }
+        }
+    } while (m_pumpAgain && m_running);
+    m_pumping = false;
+
+    if (m_running && m_finishedCount == m_items.size()) {
+        m_running = false;
+        emit finished();
+    }
+}
+
+void ScrapePipeline::pumpStage(int stage)
+{
+    while (m_running && !m_waiting[stage].isEmpty() && hasCapacity(stage)) {
+        const int item = m_waiting[stage].dequeue();
+        m_items[item].isRunning = true;
+        ++m_runningCount[stage];
+        m_handlers[stage](item, m_run);
+    }
+}
+
+bool ScrapePipeline::hasCapacity(int stage) const
+{
+    if (m_runningCount[stage] >= limit(stage)) {
+        return false;
+    }
+    // Don't start more items than the next stage can take.  Otherwise all items
+    // would be searched before the first one is loaded.
+    const int next = nextStage(stage + 1);
+    return next == done || m_waiting[next].size() < limit(next);
+}
+
+int ScrapePipeline::limit(int stage) const
+{
+    switch (static_cast<Stage>(stage)) {
+    case Stage::Search: return std::max(1, m_limits.search);
+    case Stage::Load: return std::max(1, m_limits.load);
+    case Stage::Download: return std::max(1, m_limits.download);
+    case Stage::Save: return std::max(1, m_limits.save);
+    }
+    return 1;
+}
+
+int ScrapePipeline::nextStage(int stage) const
+{
+    while (stage < stageCount && !m_handlers[stage]) {
+        ++stage;
+    }
+    return stage;
+}
+
+bool ScrapePipeline::leaveStage(int item)
+{
+    ItemState& state = m_items[item];
+    if (!state.isRunning) {
+        return false;
+    }
+    state.isRunning = false;
+    --m_runningCount[state.stage];
+    return true;
+}
+
+void ScrapePipeline::enterStage(int item, int stage)
+{
+    ItemState& state = m_items[item];
+    state.stage = nextStage(stage);
+    state.isRunning = false;
+    if (state.stage == done) {
+        ++m_finishedCount;
+        emit itemFinished(item);
+    } else {
+        m_waiting[state.stage].enqueue(item);
+    }
+}
+
+} // namespace scraper
+} // namespace mediaelch
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "utils/Meta.h"
+
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <QVector>
+
+#include <array>
+#include <functional>
+
+namespace mediaelch {
+namespace scraper {
+
+/// \brief Scrapes multiple items concurrently, e.g. in the multi-scrape dialogs.
+///
+/// Each item passes the stages search → load → download → save.  Every stage
+/// has its own limit of items in flight, so that the next item can already be
+/// searched while the details of the previous one are still loaded.
+///
+/// A stage's handler is called for each item that enters the stage.  Once the
+/// handler's work is done, it must call advance() to pass the item on to the next
+/// stage or finish() to skip the remaining stages, e.g. if nothing was found.
+/// Handlers may call advance() and finish() synchronously.  Stages without
+/// a handler are skipped.
+///
+/// Each call of start() begins a new run.  Handlers get the run's identifier and
+/// pass it on to advance() and finish(), so that late calls of an aborted run,
+/// e.g. of a search that finished after the dialog was restarted, are ignored.
+///
+/// Items are identified by their index in [0, itemCount).  They are started
+/// in order but may finish in any order.
+class ScrapePipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Stage : int
+    {
+        Search = 0,
+        Load = 1,
+        Download = 2,
+        Save = 3
+    };
+
+    /// \brief Maximum number of items per stage that are processed at the same time.
+    struct Limits
+    {
+        int search = 2;
+        int load = 2;
+        int download = 4;
+        int save = 1;
+    };
+
+    using Handler = std::function<void(int item, int run)>;
+
+public:
+    explicit ScrapePipeline(QObject* parent = nullptr);
+    ~ScrapePipeline() override = default;
+
+    /// \brief Limits that don't overwhelm the given scraper's website or API.
+    /// \param identifier Identifier of a movie or TV show scraper, e.g. "TMDb".
+    static Limits limitsForScraper(const QString& identifier);
+
+    void setLimits(Limits limits);
+    Limits limits() const;
+    void setHandler(Stage stage, Handler handler);
+
+    /// \brief Start scraping items [0, itemCount).  Aborts a running scrape.
+    /// \returns Identifier of the new run.
+    int start(int itemCount);
+    /// \brief The handler of the item's current stage is done with the item.
+    /// \param run Run in which the handler was called.  Calls of other runs are ignored.
+    void advance(int item, int run);
+    /// \brief Skip all remaining stages of the item.
+    /// \param run Run in which the handler was called.  Calls of other runs are ignored.
+    void finish(int item, int run);
+    /// \brief Stop scraping.  Handlers are not called anymore and late calls
+    ///        to advance() or finish() are ignored.
+    void abort();
+
+    bool isRunning() const { return m_running; }
+    /// \brief Identifier of the current or last run, see start().
+    int run() const { return m_run; }
+    int itemCount() const { return qsizetype_to_int(m_items.size()); }
+    int finishedCount() const { return m_finishedCount; }
+    /// \brief Number of items whose handler is currently running in the given stage.
+    int runningCount(Stage stage) const;
+    /// \brief Whether the handler of the given stage is currently running for the item.
+    ///        Useful for signals that are not only emitted for the pipeline's requests.
+    bool isProcessing(int item, Stage stage) const;
+
+signals:
+    /// \brief The item entered its first stage.
+    void itemStarted(int item);
+    /// \brief The item passed its last stage or was finished early.
+    void itemFinished(int item);
+    /// \brief All items are finished.  Not emitted if the pipeline was aborted.
+    void finished();
+
+private:
+    static constexpr int stageCount = 4;
+    /// \brief Stage index of items that have not been started, yet.
+    static constexpr int notStarted = -1;
+    /// \brief Stage index of finished items.
+    static constexpr int done = stageCount;
+
+    struct ItemState
+    {
+        int stage = notStarted;
+        bool isRunning = false;
+    };
+
+    void pump();
+    void pumpStage(int stage);
+    bool hasCapacity(int stage) const;
+    int limit(int stage) const;
+    /// \brief First stage starting at the given one that has a handler, or done.
+    int nextStage(int stage) const;
+    /// \brief Removes the item from its stage if it is currently running.
+    bool leaveStage(int item);
+    void enterStage(int item, int stage);
+
+private:
+    Limits m_limits;
+    std::array<Handler, stageCount> m_handlers;
+    std::array<QQueue<int>, stageCount> m_waiting;
+    std::array<int, stageCount> m_runningCount{};
+    QVector<ItemState> m_items;
+    int m_nextItem = 0;
+    int m_finishedCount = 0;
+    int m_run = 0;
+    bool m_running = false;
+    bool m_pumping = false;
+    bool m_pumpAgain = false;
+};
+
+} // namespace scraper
+} // namespace mediaelch
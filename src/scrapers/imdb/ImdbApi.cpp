@@ -3,6 +3,7 @@
 #include "Version.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 #include <QJsonDocument>
@@ -15,7 +16,9 @@
 namespace mediaelch {
 namespace scraper {
 
-ImdbApi::ImdbApi(QObject* parent) : QObject(parent)
+ImdbApi::ImdbApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("imdb", WebsiteCache::defaultTimeToLive)}
 {
 }
 
@@ -43,16 +46,17 @@ void ImdbApi::sendGetRequest(const Locale& locale, const QUrl& url, ImdbApi::Api
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
     addHeadersToRequest(locale, request);
 
+    m_cache.addValidationHeaders(request, locale);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
         auto dls = makeDeleteLaterScope(reply);
         QString html;
         if (reply->error() == QNetworkReply::NoError) {
-            html = QString::fromUtf8(reply->readAll());
+            html = m_cache.readReply(*reply, locale);
 
             if (!html.isEmpty()) {
-                m_cache.addElement(reply->url(), locale, html);
+                m_cache.addElement(*reply, locale, html);
             }
         } else {
             qCWarning(generic) << "[ImdbTv][Api] Network Error:" << reply->errorString() << "for URL" << reply->url();
@@ -2,12 +2,15 @@
 
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 namespace mediaelch {
 namespace scraper {
 
-AdultDvdEmpireApi::AdultDvdEmpireApi(QObject* parent) : QObject(parent)
+AdultDvdEmpireApi::AdultDvdEmpireApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("adultdvdempire", std::chrono::hours(1))}
 {
 }
 
@@ -28,6 +31,7 @@ void AdultDvdEmpireApi::sendGetRequest(const QUrl& url, AdultDvdEmpireApi::ApiCa
     // If we use the MediaElch user agent, then no actor images are sent in the response (i.e. HTML).
     // See GitHub issue #1164
     mediaelch::network::useFirefoxUserAgent(request);
+    m_cache.addValidationHeaders(request, Locale::English);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
@@ -35,7 +39,7 @@ void AdultDvdEmpireApi::sendGetRequest(const QUrl& url, AdultDvdEmpireApi::ApiCa
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, Locale::English);
 
         } else {
             qCWarning(generic) << "[AdultDvdEmpireApi] Network Error:" << reply->errorString() << "for URL"
@@ -43,7 +47,7 @@ void AdultDvdEmpireApi::sendGetRequest(const QUrl& url, AdultDvdEmpireApi::ApiCa
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), Locale::English, data);
+            m_cache.addElement(*reply, Locale::English, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
@@ -2,12 +2,15 @@
 
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 namespace mediaelch {
 namespace scraper {
 
-AebnApi::AebnApi(QObject* parent) : QObject(parent)
+AebnApi::AebnApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("aebn", std::chrono::hours(1))}
 {
 }
 
@@ -23,6 +26,7 @@ void AebnApi::sendGetRequest(const QUrl& url, const Locale& locale, AebnApi::Api
     }
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
+    m_cache.addValidationHeaders(request, locale);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
@@ -30,14 +34,14 @@ void AebnApi::sendGetRequest(const QUrl& url, const Locale& locale, AebnApi::Api
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, locale);
 
         } else {
             qCWarning(generic) << "[AebnApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), locale, data);
+            m_cache.addElement(*reply, locale, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
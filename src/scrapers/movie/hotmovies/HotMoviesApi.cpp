@@ -2,12 +2,15 @@
 
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 namespace mediaelch {
 namespace scraper {
 
-HotMoviesApi::HotMoviesApi(QObject* parent) : QObject(parent)
+HotMoviesApi::HotMoviesApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("hotmovies", std::chrono::hours(1))}
 {
 }
 
@@ -24,6 +27,7 @@ void HotMoviesApi::sendGetRequest(const QUrl& url, HotMoviesApi::ApiCallback cal
     }
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
+    m_cache.addValidationHeaders(request, Locale::English);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
@@ -31,14 +35,14 @@ void HotMoviesApi::sendGetRequest(const QUrl& url, HotMoviesApi::ApiCallback cal
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, Locale::English);
 
         } else {
             qCWarning(generic) << "[HotMoviesApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), Locale::English, data);
+            m_cache.addElement(*reply, Locale::English, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
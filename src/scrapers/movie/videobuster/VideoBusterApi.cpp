@@ -3,12 +3,15 @@
 #include "globals/Helper.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 namespace mediaelch {
 namespace scraper {
 
-VideoBusterApi::VideoBusterApi(QObject* parent) : QObject(parent)
+VideoBusterApi::VideoBusterApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("videobuster", std::chrono::hours(1))}
 {
 }
 
@@ -25,6 +28,7 @@ void VideoBusterApi::sendGetRequest(const QUrl& url, VideoBusterApi::ApiCallback
     }
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
+    m_cache.addValidationHeaders(request, Locale::English);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
@@ -32,7 +36,7 @@ void VideoBusterApi::sendGetRequest(const QUrl& url, VideoBusterApi::ApiCallback
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, Locale::English);
 
         } else {
             qCWarning(generic) << "[VideoBusterApi] Network Error:" << reply->errorString() << "for URL"
@@ -40,7 +44,7 @@ void VideoBusterApi::sendGetRequest(const QUrl& url, VideoBusterApi::ApiCallback
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), Locale::English, data);
+            m_cache.addElement(*reply, Locale::English, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
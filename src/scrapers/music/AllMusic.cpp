@@ -4,6 +4,7 @@
 #include "data/music/Artist.h"
 #include "scrapers/ScraperUtils.h"
 #include "scrapers/music/UniversalMusicScraper.h"
+#include "settings/Settings.h"
 
 #include <QJsonArray>
 #include <QJsonDocument>
@@ -12,7 +13,9 @@
 namespace mediaelch {
 namespace scraper {
 
-AllMusicApi::AllMusicApi(QObject* parent) : QObject(parent)
+AllMusicApi::AllMusicApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("allmusic", WebsiteCache::defaultTimeToLive)}
 {
 }
 
@@ -5,6 +5,7 @@
 #include "network/NetworkRequest.h"
 #include "scrapers/ScraperUtils.h"
 #include "scrapers/music/UniversalMusicScraper.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 #include <QDomDocument>
@@ -13,7 +14,9 @@
 namespace mediaelch {
 namespace scraper {
 
-MusicBrainzApi::MusicBrainzApi(QObject* parent) : QObject(parent)
+MusicBrainzApi::MusicBrainzApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("musicbrainz", WebsiteCache::defaultTimeToLive)}
 {
 }
 
@@ -30,6 +33,7 @@ void MusicBrainzApi::sendGetRequest(const Locale& locale, const QUrl& url, Music
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
 
+    m_cache.addValidationHeaders(request, locale);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
@@ -37,14 +41,14 @@ void MusicBrainzApi::sendGetRequest(const Locale& locale, const QUrl& url, Music
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, locale);
 
         } else {
             qCWarning(generic) << "[MusicBrainz] Network Error:" << reply->errorString() << "for URL" << reply->url();
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), locale, data);
+            m_cache.addElement(*reply, locale, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
@@ -5,6 +5,7 @@
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
 #include "scrapers/music/UniversalMusicScraper.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 #include <QJsonArray>
@@ -12,7 +13,10 @@
 namespace mediaelch {
 namespace scraper {
 
-TheAudioDbApi::TheAudioDbApi(QObject* parent) : QObject(parent), m_tadbApiKey{"7490823590829082posuda"}
+TheAudioDbApi::TheAudioDbApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("theaudiodb", WebsiteCache::defaultTimeToLive)},
+    m_tadbApiKey{"7490823590829082posuda"}
 {
 }
 
@@ -29,6 +33,7 @@ void TheAudioDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheAud
 
     QNetworkRequest request = mediaelch::network::requestWithDefaults(url);
 
+    m_cache.addValidationHeaders(request, locale);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
@@ -36,14 +41,14 @@ void TheAudioDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheAud
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, locale);
 
         } else {
             qCWarning(generic) << "[MusicBrainz] Network Error:" << reply->errorString() << "for URL" << reply->url();
         }
 
         if (!data.isEmpty()) {
-            m_cache.addElement(reply->url(), locale, data);
+            m_cache.addElement(*reply, locale, data);
         }
 
         ScraperError error = makeScraperError(data, *reply, {});
@@ -5,6 +5,7 @@
 #include "data/TvDbId.h"
 #include "log/Log.h"
 #include "network/HttpStatusCodes.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 #include <QJsonArray>
@@ -17,7 +18,9 @@
 namespace mediaelch {
 namespace scraper {
 
-TmdbApi::TmdbApi(QObject* parent) : QObject(parent)
+TmdbApi::TmdbApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("tmdb", WebsiteCache::defaultTimeToLive)}
 {
 }
 
@@ -69,6 +72,7 @@ void TmdbApi::sendGetRequest(const Locale& locale, const QUrl& url, TmdbApi::Api
     }
 
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
+    m_cache.addValidationHeaders(request, locale);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
@@ -76,7 +80,7 @@ void TmdbApi::sendGetRequest(const Locale& locale, const QUrl& url, TmdbApi::Api
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, locale);
 
         } else {
             qCWarning(generic) << "[TmdbApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
@@ -87,7 +91,7 @@ void TmdbApi::sendGetRequest(const Locale& locale, const QUrl& url, TmdbApi::Api
         if (!data.isEmpty()) {
             json = QJsonDocument::fromJson(data.toUtf8(), &parseError);
             if (parseError.error == QJsonParseError::NoError) {
-                m_cache.addElement(reply->url(), locale, data);
+                m_cache.addElement(*reply, locale, data);
             }
         }
 
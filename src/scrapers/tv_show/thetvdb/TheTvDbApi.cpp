@@ -3,6 +3,7 @@
 #include "Version.h"
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 #include <QJsonDocument>
@@ -15,7 +16,9 @@
 namespace mediaelch {
 namespace scraper {
 
-TheTvDbApi::TheTvDbApi(QObject* parent) : QObject(parent)
+TheTvDbApi::TheTvDbApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("thetvdb", WebsiteCache::defaultTimeToLive)}
 {
 }
 
@@ -79,6 +82,7 @@ void TheTvDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheTvDbAp
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
     addHeadersToRequest(locale, request);
 
+    m_cache.addValidationHeaders(request, locale);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), locale, this]() {
@@ -86,7 +90,7 @@ void TheTvDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheTvDbAp
 
         QString data;
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, locale);
 
         } else {
             qCWarning(generic) << "[TheTvDbApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
@@ -97,7 +101,7 @@ void TheTvDbApi::sendGetRequest(const Locale& locale, const QUrl& url, TheTvDbAp
         if (!data.isEmpty()) {
             json = QJsonDocument::fromJson(data.toUtf8(), &parseError);
             if (parseError.error == QJsonParseError::NoError) {
-                m_cache.addElement(reply->url(), locale, data);
+                m_cache.addElement(*reply, locale, data);
             }
         }
 
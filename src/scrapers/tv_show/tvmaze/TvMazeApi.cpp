@@ -2,6 +2,7 @@
 
 #include "log/Log.h"
 #include "network/NetworkRequest.h"
+#include "settings/Settings.h"
 #include "utils/Meta.h"
 
 #include <QTimer>
@@ -11,7 +12,9 @@
 namespace mediaelch {
 namespace scraper {
 
-TvMazeApi::TvMazeApi(QObject* parent) : QObject(parent)
+TvMazeApi::TvMazeApi(QObject* parent) :
+    QObject(parent),
+    m_cache{Settings::instance()->advanced()->scraperCacheTimeToLive("tvmaze", WebsiteCache::defaultTimeToLive)}
 {
 }
 
@@ -40,6 +43,7 @@ void TvMazeApi::sendGetRequest(const QUrl& url, TvMazeApi::ApiCallback callback)
     }
 
     QNetworkRequest request = mediaelch::network::jsonRequestWithDefaults(url);
+    m_cache.addValidationHeaders(request, Locale::English);
     QNetworkReply* reply = m_network.getWithWatcher(request);
 
     connect(reply, &QNetworkReply::finished, this, [reply, cb = std::move(callback), this]() {
@@ -47,7 +51,7 @@ void TvMazeApi::sendGetRequest(const QUrl& url, TvMazeApi::ApiCallback callback)
         QString data;
 
         if (reply->error() == QNetworkReply::NoError) {
-            data = QString::fromUtf8(reply->readAll());
+            data = m_cache.readReply(*reply, Locale::English);
 
         } else {
             qCWarning(generic) << "[TvMazeApi] Network Error:" << reply->errorString() << "for URL" << reply->url();
@@ -58,7 +62,7 @@ void TvMazeApi::sendGetRequest(const QUrl& url, TvMazeApi::ApiCallback callback)
         if (!data.isEmpty()) {
             json = QJsonDocument::fromJson(data.toUtf8(), &parseError);
             if (parseError.error == QJsonParseError::NoError) {
-                m_cache.addElement(reply->url(), Locale::English, data);
+                m_cache.addElement(*reply, Locale::English, data);
             }
         }
 
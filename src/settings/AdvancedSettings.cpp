@@ -241,6 +241,16 @@ mediaelch::ThumbnailDimensions AdvancedSettings::episodeThumbnailDimensions() co
     return m_episodeThumbnailDimensions;
 }
 
+std::chrono::seconds AdvancedSettings::scraperCacheTimeToLive(const QString& api,
+    std::chrono::seconds defaultTimeToLive) const
+{
+    const auto timeToLive = m_scraperCacheTimeToLive.constFind(api);
+    if (timeToLive == m_scraperCacheTimeToLive.cend()) {
+        return defaultTimeToLive;
+    }
+    return std::chrono::seconds(*timeToLive);
+}
+
 bool AdvancedSettings::isFileExcluded(QString file) const
 {
     for (const auto& pattern : m_excludePatterns) {
@@ -329,6 +339,10 @@ QDebug operator<<(QDebug dbg, const AdvancedSettings& settings)
     out << "    useFirstStudioOnly:      " << (settings.m_useFirstStudioOnly ? "true" : "false") << nl;
     out << "    exclude patterns:        " << nl;
     printExcludePatterns(settings.m_excludePatterns);
+    out << "    scraperCache timeToLive: " << nl;
+    for (auto it = settings.m_scraperCacheTimeToLive.cbegin(); it != settings.m_scraperCacheTimeToLive.cend(); ++it) {
+        out << "        " << it.key() << ": " << it.value() << "s" << nl;
+    }
 
     dbg.nospace().noquote() << *out.string();
     return dbg.maybeSpace().maybeQuote();
@@ -14,6 +14,8 @@
 #include <QStringList>
 #include <QVector>
 
+#include <chrono>
+
 class FileSearchExclude
 {
 public:
@@ -99,6 +101,9 @@ public:
     int bookletCut() const;
     bool writeThumbUrlsToNfo() const;
     mediaelch::ThumbnailDimensions episodeThumbnailDimensions() const;
+    /// \brief Time in which cached responses of the given scraper API are used without asking
+    ///        the server, unless the server specifies it, see WebsiteCache.
+    std::chrono::seconds scraperCacheTimeToLive(const QString& api, std::chrono::seconds defaultTimeToLive) const;
 
     bool isFileExcluded(QString file) const;
     bool isFolderExcluded(QString dir) const;
@@ -131,6 +136,8 @@ private:
     QHash<QString, QString> m_countryMappings;
     mediaelch::ThumbnailDimensions m_episodeThumbnailDimensions;
     QVector<FileSearchExclude> m_excludePatterns;
+    /// \brief Time to live in seconds; keyed by scraper API.
+    QHash<QString, int> m_scraperCacheTimeToLive;
     bool m_forceCache = false;
     bool m_portableMode = false;
     int m_bookletCut = 2;
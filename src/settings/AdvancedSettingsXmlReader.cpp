@@ -154,6 +154,9 @@ void AdvancedSettingsXmlReader::parseSettings(const QString& xmlSource)
         } else if (m_xml.name() == QLatin1String("exclude")) {
             loadExcludePatterns();
 
+        } else if (m_xml.name() == QLatin1String("scraperCache")) {
+            loadScraperCache();
+
         } else {
             skipUnsupportedTag();
         }
@@ -280,6 +283,31 @@ void AdvancedSettingsXmlReader::loadExcludePatterns()
     }
 }
 
+void AdvancedSettingsXmlReader::loadScraperCache()
+{
+    m_settings.m_scraperCacheTimeToLive.clear();
+    while (m_xml.readNextStartElement()) {
+        if (m_xml.name() == QLatin1String("timeToLive")) {
+            const QString api = m_xml.attributes().value("api").trimmed().toString().toLower();
+            if (api.isEmpty()) {
+                qCWarning(generic) << "[AdvancedSettings] Missing 'api' attribute of <timeToLive> element at"
+                                   << currentLocation();
+                addError("timeToLive", ParseErrorType::InvalidAttributeValue);
+                m_xml.skipCurrentElement();
+                continue;
+            }
+            int seconds = -1;
+            expectIntChecked(seconds, [](int value) { return value >= 0; });
+            if (seconds >= 0) {
+                m_settings.m_scraperCacheTimeToLive.insert(api, seconds);
+            }
+
+        } else {
+            skipUnsupportedTag();
+        }
+    }
+}
+
 void AdvancedSettingsXmlReader::addError(QString tag, ParseErrorType type)
 {
     m_messages.push_back({type, tag});
@@ -45,6 +45,7 @@ private:
     void loadFilters();
     void loadMappings(QHash<QString, QString>& map);
     void loadExcludePatterns();
+    void loadScraperCache();
 
     void addError(QString tag, ParseErrorType type);
     void addWarning(QString tag, ParseErrorType type);
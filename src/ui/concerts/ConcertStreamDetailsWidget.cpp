@@ -65,7 +65,7 @@ ConcertStreamDetailsWidget::~ConcertStreamDetailsWidget() = default;
 
 void ConcertStreamDetailsWidget::onReloadStreamDetails()
 {
-    const bool success = m_concertController->loadStreamDetailsFromFile();
+    const bool success = m_concertController->loadStreamDetailsFromFile(true);
     ui->lblReloadStreamDetailsError->setVisible(!success);
     if (success) {
         ui->lblReloadStreamDetailsError->clear();
@@ -229,19 +229,16 @@ void ConcertWidget::setConcert(Concert* concert)
     qCDebug(generic) << "Entered, concert=" << concert->title();
     concert->controller()->loadData(Manager::instance()->mediaCenterInterfaceConcert());
     m_concert = concert;
+    updateConcertInfo();
+
     if (!concert->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
-        const bool success = concert->controller()->loadStreamDetailsFromFile();
-        if (success) {
-            const auto videoDetails = concert->streamDetails()->videoDetails();
-            if (concert->streamDetailsLoaded()
-                && videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds).toInt() != 0) {
-                using namespace std::chrono;
-                seconds runtime{videoDetails.value(StreamDetails::VideoDetails::DurationInSeconds).toInt()};
-                concert->setRuntime(duration_cast<minutes>(runtime));
-            }
-        }
+        connect(concert->controller(),
+            &ConcertController::sigStreamDetailsLoaded,
+            this,
+            &ConcertWidget::onStreamDetailsLoaded,
+            Qt::UniqueConnection);
+        concert->controller()->loadStreamDetailsInBackground();
     }
-    updateConcertInfo();
 
     // clang-format off
     connect(m_concert->controller(), &ConcertController::sigInfoLoadDone,      this, &ConcertWidget::onInfoLoadDone,      Qt::UniqueConnection);
@@ -301,6 +298,18 @@ void ConcertWidget::onInfoLoadDone(Concert* concert)
     }
 }
 
+void ConcertWidget::onStreamDetailsLoaded(Concert* concert, bool success)
+{
+    if (m_concert != concert) {
+        return;
+    }
+    ui->concertStreamdetails->updateConcert(m_concert->controller());
+    if (success) {
+        ui->concertInfo->setRuntime(m_concert->runtime());
+        ui->mediaFlags->setStreamDetails(m_concert->streamDetails());
+    }
+}
+
 void ConcertWidget::onLoadDone(Concert* concert)
 {
     if (m_concert == nullptr || m_concert != concert) {
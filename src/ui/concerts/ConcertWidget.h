@@ -51,6 +51,7 @@ private slots:
 
     void onInfoLoadDone(Concert* concert);
     void onLoadDone(Concert* concert);
+    void onStreamDetailsLoaded(Concert* concert, bool success);
     void onLoadImagesStarted(Concert* concert);
     void onLoadingImages(Concert* concert, QSet<ImageType> imageTypes);
     void onDownloadProgress(Concert* concert, int current, int maximum);
@@ -122,6 +122,7 @@ void CsvExportDialog::onExport()
 
     // Movies ------------------------------------------
     if (!m_shouldAbort && ui->checkMovies->isChecked()) {
+        Manager::instance()->movieModel()->loadMovieDetails();
         const QVector<Movie*>& movies = Manager::instance()->movieModel()->movies();
 
         int processedCount = 0;
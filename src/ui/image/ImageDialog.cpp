@@ -18,11 +18,14 @@
 
 #include <QBuffer>
 #include <QFileDialog>
+#include <QFutureWatcher>
 #include <QLabel>
 #include <QMovie>
 #include <QPainter>
 #include <QSize>
+#include <QThread>
 #include <QTimer>
+#include <QtConcurrent>
 #include <QtCore/qmath.h>
 
 ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDialog)
@@ -68,8 +71,8 @@ ImageDialog::ImageDialog(QWidget* parent) : QDialog(parent), ui(new Ui::ImageDia
     ui->labelSpinner->setMovie(movie);
 
     setImageType(ImageType::MoviePoster);
-    m_currentDownloadReply = nullptr;
     m_multiSelection = false;
+    m_decodePool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
 
     // create zoom out/in buttons and make them darker
     QPixmap zoomOut(":/img/zoom_out.png");
@@ -234,7 +237,7 @@ void ImageDialog::setAndStartDownloads(QVector<Poster> downloads)
     if (downloads.count() == 0) {
         ui->stackedWidget->setCurrentIndex(2);
     }
-    startNextDownload();
+    startDownloads();
 }
 
 mediaelch::network::NetworkManager* ImageDialog::network()
@@ -297,67 +300,100 @@ void ImageDialog::resizeAndReposition()
     }
 }
 
-void ImageDialog::startNextDownload()
+void ImageDialog::startDownloads()
 {
-    qCDebug(generic) << "[ImageDialog] Start next download";
-
-    elch_ssize_t nextIndex = -1;
-    for (elch_ssize_t i = 0, n = m_elements.size(); i < n; i++) {
-        if (!m_elements[i].downloaded) {
-            nextIndex = i;
-            break;
+    while (m_downloads.size() < maxParallelDownloads && m_nextDownloadIndex < m_elements.size()) {
+        const int index = m_nextDownloadIndex++;
+        const DownloadElement& element = m_elements.at(index);
+        if (element.downloaded) {
+            continue;
         }
-    }
+        const QUrl url = element.thumbUrl.isValid() ? element.thumbUrl : element.originalUrl;
 
-    if (nextIndex == -1) {
-        ui->labelLoading->setVisible(false);
-        ui->labelSpinner->setVisible(false);
-        return;
+        qCDebug(generic) << "[ImageDialog] Start download" << index;
+        QNetworkReply* reply = network()->get(mediaelch::network::requestWithDefaults(url));
+        m_downloads.insert(reply, index);
+        connect(reply, &QNetworkReply::finished, this, &ImageDialog::downloadFinished);
     }
-
-    const QUrl url = m_elements[nextIndex].thumbUrl.isValid() //
-                         ? m_elements[nextIndex].thumbUrl
-                         : m_elements[nextIndex].originalUrl;
-
-    m_currentDownloadIndex = qsizetype_to_int(nextIndex);
-    m_currentDownloadReply = network()->get(mediaelch::network::requestWithDefaults(url));
-    connect(m_currentDownloadReply, &QNetworkReply::finished, this, &ImageDialog::downloadFinished);
+    updateLoadingIndicator();
 }
 
 void ImageDialog::downloadFinished()
 {
-    if (m_currentDownloadReply->error() == QNetworkReply::OperationCanceledError) {
-        // It is possible that m_elements has been cleared by aborting all downloads
-        // via abort() or close().
-        m_currentDownloadReply->deleteLater();
+    auto* reply = dynamic_cast<QNetworkReply*>(QObject::sender());
+    if (reply == nullptr) {
+        qCCritical(generic) << "[ImageDialog] dynamic_cast<QNetworkReply*> failed for downloadFinished!";
         return;
     }
+    reply->deleteLater();
 
-    // Mark item as downloaded even if there was a network error to avoid an infinite loop.
-    m_elements[m_currentDownloadIndex].downloaded = true;
+    // Replies of canceled downloads are not tracked anymore, because
+    // m_elements has been cleared by cancelDownloads().
+    auto download = m_downloads.find(reply);
+    if (download == m_downloads.end() || reply->error() == QNetworkReply::OperationCanceledError) {
+        return;
+    }
+    const int index = download.value();
+    m_downloads.erase(download);
 
-    if (m_currentDownloadReply->error() == QNetworkReply::NoError) {
-        DownloadElement& element = m_elements[m_currentDownloadIndex];
-        element.pixmap.loadFromData(m_currentDownloadReply->readAll());
-        element.pixmap.setDevicePixelRatio(devicePixelRatioF());
+    if (reply->error() == QNetworkReply::NoError) {
+        decodePreview(index, reply->readAll());
 
-        if (!element.pixmap.isNull()) {
-            const int width = static_cast<int>((getColumnWidth() - 10) * devicePixelRatioF());
-            element.scaledPixmap = element.pixmap.scaledToWidth(width, Qt::SmoothTransformation);
+    } else {
+        // Mark item as downloaded even if there was a network error to avoid an infinite loop.
+        m_elements[index].downloaded = true;
+        showError(tr("Error while downloading one or more images: %1").arg(reply->errorString()));
+        qCWarning(generic) << "Network Error: " << reply->errorString() << " | " << reply->url();
+    }
+
+    startDownloads();
+}
+
+void ImageDialog::decodePreview(int index, QByteArray data)
+{
+    const int generation = m_downloadGeneration;
+    ++m_decodingCount;
+
+    auto* watcher = new QFutureWatcher<Preview>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, index, generation]() {
+        watcher->deleteLater();
+        if (generation != m_downloadGeneration) {
+            return;
+        }
+        --m_decodingCount;
+
+        DownloadElement& element = m_elements[index];
+        element.downloaded = true;
+
+        const Preview preview = watcher->result();
+        if (!preview.image.isNull()) {
+            element.pixmap = QPixmap::fromImage(preview.image);
+            element.pixmap.setDevicePixelRatio(devicePixelRatioF());
+            element.scaledPixmap = QPixmap::fromImage(preview.scaledImage);
             element.scaledPixmap.setDevicePixelRatio(devicePixelRatioF());
-            element.cellWidget->setImage(element.scaledPixmap);
-            element.cellWidget->setHint(element.resolution, element.hint);
+            showPreview(element);
+            ui->table->resizeRowsToContents();
         }
-        ui->table->resizeRowsToContents();
+        updateLoadingIndicator();
+    });
+    watcher->setFuture(QtConcurrent::run(&m_decodePool, &ImageDialog::decodeImage, data, previewWidth()));
+}
 
-    } else {
-        showError(tr("Error while downloading one or more images: %1").arg(m_currentDownloadReply->errorString()));
-        qCWarning(generic) << "Network Error: " << m_currentDownloadReply->errorString() << " | "
-                           << m_currentDownloadReply->url();
+ImageDialog::Preview ImageDialog::decodeImage(const QByteArray& data, int width)
+{
+    Preview preview;
+    preview.image.loadFromData(data);
+    if (!preview.image.isNull()) {
+        preview.scaledImage = preview.image.scaledToWidth(width, Qt::SmoothTransformation);
     }
+    return preview;
+}
 
-    m_currentDownloadReply->deleteLater();
-    startNextDownload();
+void ImageDialog::updateLoadingIndicator()
+{
+    const bool isLoading = !m_downloads.isEmpty() || m_decodingCount > 0;
+    ui->labelLoading->setVisible(isLoading);
+    ui->labelSpinner->setVisible(isLoading);
 }
 
 void ImageDialog::renderTable()
@@ -379,20 +415,34 @@ void ImageDialog::renderTable()
         auto* item = new QTableWidgetItem;
         item->setData(Qt::UserRole, m_elements[i].originalUrl);
         auto* label = new ImageLabel(ui->table);
-        if (!m_elements[i].pixmap.isNull()) {
-            const int width = static_cast<int>((getColumnWidth() - 10) * devicePixelRatioF());
-            QPixmap pixmap = m_elements[i].pixmap.scaledToWidth(width, Qt::SmoothTransformation);
-            pixmap.setDevicePixelRatio(devicePixelRatioF());
-            label->setImage(pixmap);
-            label->setHint(m_elements[i].resolution, m_elements[i].hint);
-        }
         m_elements[i].cellWidget = label;
+        showPreview(m_elements[i]);
         ui->table->setItem(row, i % cols, item);
         ui->table->setCellWidget(row, i % cols, label);
         ui->table->resizeRowToContents(row);
     }
 }
 
+int ImageDialog::previewWidth()
+{
+    return static_cast<int>((getColumnWidth() - 10) * devicePixelRatioF());
+}
+
+void ImageDialog::showPreview(DownloadElement& element)
+{
+    if (element.pixmap.isNull() || element.cellWidget == nullptr) {
+        return;
+    }
+    // Previews are only scaled again if the preview size has changed.
+    const int width = previewWidth();
+    if (element.scaledPixmap.isNull() || element.scaledPixmap.width() != width) {
+        element.scaledPixmap = element.pixmap.scaledToWidth(width, Qt::SmoothTransformation);
+        element.scaledPixmap.setDevicePixelRatio(devicePixelRatioF());
+    }
+    element.cellWidget->setImage(element.scaledPixmap);
+    element.cellWidget->setHint(element.resolution, element.hint);
+}
+
 /**
  * \brief Calculates the number of columns that can be displayed
  * \return Number of columns that fit in the layout
@@ -495,12 +545,21 @@ void ImageDialog::cancelDownloads()
     ui->labelLoading->setVisible(false);
     ui->labelSpinner->setVisible(false);
 
-    if (m_currentDownloadReply != nullptr && m_currentDownloadReply->isRunning()) {
+    // Previews that are still decoded are discarded once they are finished.
+    ++m_downloadGeneration;
+    m_decodingCount = 0;
+
+    const auto replies = m_downloads.keys();
+    m_downloads.clear();
+    if (!replies.isEmpty()) {
         qCDebug(generic) << "[ImageDialog] Canceling current downloads";
-        m_currentDownloadReply->abort();
+    }
+    for (QNetworkReply* reply : replies) {
+        reply->abort();
     }
 
     m_elements.clear();
+    m_nextDownloadIndex = 0;
 }
 
 /**
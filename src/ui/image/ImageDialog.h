@@ -9,10 +9,13 @@
 #include "scrapers/image/ImageProvider.h"
 
 #include <QDialog>
+#include <QHash>
+#include <QImage>
 #include <QLabel>
 #include <QNetworkReply>
 #include <QResizeEvent>
 #include <QTableWidgetItem>
+#include <QThreadPool>
 #include <QUrl>
 #include <QWidget>
 
@@ -66,9 +69,10 @@ protected:
 
 private slots:
     /// \brief Called when a download has finished
-    /// \details Renders the table and displays the downloaded image and starts the next download
+    /// \details Decodes the downloaded image in a background thread and starts the next download
     void downloadFinished();
-    void startNextDownload();
+    /// \brief Starts downloads until maxParallelDownloads are running
+    void startDownloads();
     void imageClicked(int row, int col);
     void chooseLocalImage();
     void onImageDropped(QUrl url);
@@ -103,15 +107,30 @@ private:
         QString hint;
     };
 
+    /// \brief Decoded preview, see decodePreview()
+    struct Preview
+    {
+        QImage image;
+        QImage scaledImage;
+    };
+
     struct DataRole
     {
         constexpr static int providerPointer = Qt::UserRole;
         constexpr static int isDefaultProvider = Qt::UserRole + 1;
     };
 
+    /// \brief Number of previews that are downloaded at the same time.
+    static constexpr int maxParallelDownloads = 6;
+
     mediaelch::network::NetworkManager m_network;
-    int m_currentDownloadIndex = 0;
-    QNetworkReply* m_currentDownloadReply = nullptr;
+    /// \brief Running downloads and the index of their element in m_elements.
+    QHash<QNetworkReply*, int> m_downloads;
+    int m_nextDownloadIndex = 0;
+    int m_decodingCount = 0;
+    /// \brief Incremented by cancelDownloads() so that previews of old elements are discarded.
+    int m_downloadGeneration = 0;
+    QThreadPool m_decodePool;
     ImageType m_imageType = ImageType::None;
     QVector<DownloadElement> m_elements;
     QUrl m_imageUrl;
@@ -138,6 +157,13 @@ private:
     void setupProviderCombo();
     void resizeAndReposition();
     void renderTable();
+    /// \brief Width of the previews in device pixels
+    int previewWidth();
+    /// \brief Shows the element's image in its cell, scaled to the current preview width
+    void showPreview(DownloadElement& element);
+    void decodePreview(int index, QByteArray data);
+    static Preview decodeImage(const QByteArray& data, int width);
+    void updateLoadingIndicator();
     int calcColumnCount();
     int getColumnWidth();
     /// \brief Triggers loading of images from the current provider
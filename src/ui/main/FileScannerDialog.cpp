@@ -4,7 +4,9 @@
 
 #include <QTimer>
 
+#include "data/movie/Movie.h"
 #include "media/ImageCache.h"
+#include "media/StreamDetailsService.h"
 
 FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new Ui::FileScannerDialog)
 {
@@ -51,6 +53,7 @@ FileScannerDialog::FileScannerDialog(QWidget* parent) : QDialog(parent), ui(new
     // clang-format on
 
     connect(manager->movieFileSearcher(), &MovieFileSearcher::finished, this, [this]() {
+        prefetchMovieStreamDetails();
         if (m_reloadType != ReloadType::All) {
             accept();
         } else {
@@ -168,6 +171,21 @@ void FileScannerDialog::reject()
     QDialog::reject();
 }
 
+void FileScannerDialog::prefetchMovieStreamDetails()
+{
+    if (!Settings::instance()->autoLoadStreamDetails()) {
+        return;
+    }
+    QVector<mediaelch::FileList> files;
+    const auto movies = Manager::instance()->movieModel()->movies();
+    for (const Movie* movie : movies) {
+        if (!movie->streamDetailsLoaded() && !movie->files().isEmpty()) {
+            files << movie->files();
+        }
+    }
+    mediaelch::StreamDetailsService::instance()->prefetch(files);
+}
+
 void FileScannerDialog::onStartMovieScanner()
 {
     ui->progressBar->setValue(0);
@@ -52,6 +52,11 @@ private slots:
     void onStartMusicScannerForce();
     void onStartMusicScannerCache();
 
+private:
+    /// \brief Probe all movies without stream details in the background so that
+    ///        opening them does not have to wait for MediaInfo.
+    void prefetchMovieStreamDetails();
+
 private:
     Ui::FileScannerDialog* ui;
 
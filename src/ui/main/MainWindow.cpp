@@ -4,6 +4,8 @@
 #include "globals/Globals.h"
 #include "globals/Manager.h"
 #include "log/Log.h"
+#include "network/HttpCache.h"
+#include "network/RequestScheduler.h"
 #include "scrapers/TvShowUpdater.h"
 #include "settings/Settings.h"
 #include "ui/export/CsvExportDialog.h"
@@ -297,6 +299,8 @@ void MainWindow::closeEvent(QCloseEvent* /*event*/)
     m_settings->setMainWindowPosition(pos());
     m_settings->setMainSplitterState(ui->movieSplitter->saveState());
     m_settings->setMainWindowMaximized(isMaximized());
+
+    mediaelch::network::RequestScheduler::instance().logStatistics();
 }
 
 void MainWindow::setupToolbar()
@@ -377,6 +381,9 @@ void MainWindow::onActionSearch()
 {
     MainWidgets current = currentTab();
 
+    // Scraping is requested explicitly, so responses cached by earlier scrapes must be revalidated.
+    mediaelch::network::HttpCache::instance().expireAll();
+
     if (current == MainWidgets::Movies) {
         if (ui->movieFilesWidget->selectedMovies().count() > 1) {
             ui->movieFilesWidget->multiScrape();
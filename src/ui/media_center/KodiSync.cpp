@@ -107,6 +107,10 @@ void KodiSync::startSync()
     m_xbmcConcerts.clear();
     m_xbmcShows.clear();
     m_xbmcEpisodes.clear();
+    m_xbmcMovieFiles.clear();
+    m_xbmcConcertFiles.clear();
+    m_xbmcShowFiles.clear();
+    m_xbmcEpisodeFiles.clear();
 
     m_moviesToRemove.clear();
     m_concertsToRemove.clear();
@@ -261,10 +265,13 @@ void KodiSync::onMovieListFinished()
             it.next();
             if (it.key() == "movies" && !it.value().toList().isEmpty()) {
                 for (const QVariant& var : it.value().toList()) {
-                    if (var.toMap().value("movieid").toInt() == 0) {
+                    const int id = var.toMap().value("movieid").toInt();
+                    if (id == 0) {
                         continue;
                     }
-                    m_xbmcMovies.insert(var.toMap().value("movieid").toInt(), parseXbmcDataFromMap(var.toMap()));
+                    const XbmcData data = parseXbmcDataFromMap(var.toMap());
+                    m_xbmcMovies.insert(id, data);
+                    m_xbmcMovieFiles.insert(id, data.file);
                 }
             }
         }
@@ -293,10 +300,13 @@ void KodiSync::onConcertListFinished()
             it.next();
             if (it.key() == "musicvideos" && !it.value().toList().isEmpty()) {
                 for (const QVariant& var : it.value().toList()) {
-                    if (var.toMap().value("musicvideoid").toInt() == 0) {
+                    const int id = var.toMap().value("musicvideoid").toInt();
+                    if (id == 0) {
                         continue;
                     }
-                    m_xbmcConcerts.insert(var.toMap().value("musicvideoid").toInt(), parseXbmcDataFromMap(var.toMap()));
+                    const XbmcData data = parseXbmcDataFromMap(var.toMap());
+                    m_xbmcConcerts.insert(id, data);
+                    m_xbmcConcertFiles.insert(id, data.file);
                 }
             }
         }
@@ -325,10 +335,13 @@ void KodiSync::onTvShowListFinished()
             it.next();
             if (it.key() == "tvshows" && !it.value().toList().isEmpty()) {
                 for (const QVariant& var : it.value().toList()) {
-                    if (var.toMap().value("tvshowid").toInt() == 0) {
+                    const int id = var.toMap().value("tvshowid").toInt();
+                    if (id == 0) {
                         continue;
                     }
-                    m_xbmcShows.insert(var.toMap().value("tvshowid").toInt(), parseXbmcDataFromMap(var.toMap()));
+                    const XbmcData data = parseXbmcDataFromMap(var.toMap());
+                    m_xbmcShows.insert(id, data);
+                    m_xbmcShowFiles.insert(id, data.file);
                 }
             }
         }
@@ -357,10 +370,13 @@ void KodiSync::onEpisodeListFinished()
             it.next();
             if (it.key() == "episodes" && !it.value().toList().isEmpty()) {
                 for (const QVariant& var : it.value().toList()) {
-                    if (var.toMap().value("episodeid").toInt() == 0) {
+                    const int id = var.toMap().value("episodeid").toInt();
+                    if (id == 0) {
                         continue;
                     }
-                    m_xbmcEpisodes.insert(var.toMap().value("episodeid").toInt(), parseXbmcDataFromMap(var.toMap()));
+                    const XbmcData data = parseXbmcDataFromMap(var.toMap());
+                    m_xbmcEpisodes.insert(id, data);
+                    m_xbmcEpisodeFiles.insert(id, data.file);
                 }
             }
         }
@@ -398,7 +414,7 @@ void KodiSync::setupItemsToRemove()
 {
     for (Movie* movie : m_moviesToSync) {
         movie->setSyncNeeded(false);
-        int id = findId(movie->files().toStringList(), m_xbmcMovies);
+        int id = m_xbmcMovieFiles.findId(movie->files().toStringList());
         if (id > 0) {
             m_moviesToRemove.append(id);
         }
@@ -406,7 +422,7 @@ void KodiSync::setupItemsToRemove()
 
     for (Concert* concert : m_concertsToSync) {
         concert->setSyncNeeded(false);
-        int id = findId(concert->files().toStringList(), m_xbmcConcerts);
+        int id = m_xbmcConcertFiles.findId(concert->files().toStringList());
         if (id > 0) {
             m_concertsToRemove.append(id);
         }
@@ -423,7 +439,7 @@ void KodiSync::setupItemsToRemove()
         } else if (!showDir.contains("/") && !showDir.endsWith("\\")) {
             showDir.append("\\");
         }
-        int id = findId(QStringList() << showDir, m_xbmcShows);
+        int id = m_xbmcShowFiles.findId(QStringList() << showDir);
         if (id > 0) {
             m_tvShowsToRemove.append(id);
         }
@@ -431,7 +447,7 @@ void KodiSync::setupItemsToRemove()
 
     for (TvShowEpisode* episode : m_episodesToSync) {
         episode->setSyncNeeded(false);
-        int id = findId(episode->files().toStringList(), m_xbmcEpisodes);
+        int id = m_xbmcEpisodeFiles.findId(episode->files().toStringList());
         if (id > 0) {
             m_episodesToRemove.append(id);
         }
@@ -440,72 +456,54 @@ void KodiSync::setupItemsToRemove()
 
 void KodiSync::removeItems()
 {
-    QJsonObject o;
-    o.insert("jsonrpc", QString("2.0"));
-    o.insert("id", ++m_requestId);
+    // Kodi supports JSON-RPC batch requests.  Removing items one request at a
+    // time takes ages for large libraries, so remove them in batches.
+    constexpr int maxBatchSize = 100;
 
+    QJsonArray batch;
     if (!m_moviesToRemove.isEmpty()) {
         ui->status->setText(tr("Removing movies from database"));
-        int id = m_moviesToRemove.takeFirst();
-        QJsonObject params;
-        params.insert("movieid", id);
-        o.insert("params", params);
-        o.insert("method", QString("VideoLibrary.RemoveMovie"));
-        QNetworkRequest request(xbmcUrl());
-        request.setRawHeader("Content-Type", "application/json");
-        request.setRawHeader("Accept", "application/json");
-        QNetworkReply* reply = m_network.post(request, QJsonDocument(o).toJson(QJsonDocument::Compact));
-        connect(reply, &QNetworkReply::finished, this, &KodiSync::onRemoveFinished);
-        return;
-    }
+        batch = takeRemoveRequests(m_moviesToRemove, "VideoLibrary.RemoveMovie", "movieid", maxBatchSize);
 
-    if (!m_concertsToRemove.isEmpty()) {
+    } else if (!m_concertsToRemove.isEmpty()) {
         ui->status->setText(tr("Removing concerts from database"));
-        int id = m_concertsToRemove.takeFirst();
-        QJsonObject params;
-        params.insert("musicvideoid", id);
-        o.insert("params", params);
-        o.insert("method", QString("VideoLibrary.RemoveMusicVideo"));
-        QNetworkRequest request(xbmcUrl());
-        request.setRawHeader("Content-Type", "application/json");
-        request.setRawHeader("Accept", "application/json");
-        QNetworkReply* reply = m_network.post(request, QJsonDocument(o).toJson(QJsonDocument::Compact));
-        connect(reply, &QNetworkReply::finished, this, &KodiSync::onRemoveFinished);
-        return;
-    }
+        batch = takeRemoveRequests(m_concertsToRemove, "VideoLibrary.RemoveMusicVideo", "musicvideoid", maxBatchSize);
 
-    if (!m_tvShowsToRemove.isEmpty()) {
+    } else if (!m_tvShowsToRemove.isEmpty()) {
         ui->status->setText(tr("Removing TV shows from database"));
-        int id = m_tvShowsToRemove.takeFirst();
-        QJsonObject params;
-        params.insert("tvshowid", id);
-        o.insert("params", params);
-        o.insert("method", QString("VideoLibrary.RemoveTVShow"));
-        QNetworkRequest request(xbmcUrl());
-        request.setRawHeader("Content-Type", "application/json");
-        request.setRawHeader("Accept", "application/json");
-        QNetworkReply* reply = m_network.post(request, QJsonDocument(o).toJson(QJsonDocument::Compact));
-        connect(reply, &QNetworkReply::finished, this, &KodiSync::onRemoveFinished);
+        batch = takeRemoveRequests(m_tvShowsToRemove, "VideoLibrary.RemoveTVShow", "tvshowid", maxBatchSize);
+
+    } else if (!m_episodesToRemove.isEmpty()) {
+        ui->status->setText(tr("Removing episodes from database"));
+        batch = takeRemoveRequests(m_episodesToRemove, "VideoLibrary.RemoveEpisode", "episodeid", maxBatchSize);
+
+    } else {
+        QTimer::singleShot(m_reloadTimeOut, this, &KodiSync::triggerReload);
         return;
     }
 
-    if (!m_episodesToRemove.isEmpty()) {
-        ui->status->setText(tr("Removing episodes from database"));
-        int id = m_episodesToRemove.takeFirst();
+    QNetworkRequest request(xbmcUrl());
+    request.setRawHeader("Content-Type", "application/json");
+    request.setRawHeader("Accept", "application/json");
+    QNetworkReply* reply = m_network.post(request, QJsonDocument(batch).toJson(QJsonDocument::Compact));
+    connect(reply, &QNetworkReply::finished, this, &KodiSync::onRemoveFinished);
+}
 
+QJsonArray KodiSync::takeRemoveRequests(QVector<int>& ids, const char* method, const char* idName, int maxCount)
+{
+    QJsonArray requests;
+    while (!ids.isEmpty() && requests.size() < maxCount) {
         QJsonObject params;
-        params.insert("episodeid", id);
+        params.insert(idName, ids.takeFirst());
+
+        QJsonObject o;
+        o.insert("jsonrpc", QString("2.0"));
+        o.insert("id", ++m_requestId);
+        o.insert("method", QString(method));
         o.insert("params", params);
-        o.insert("method", QString("VideoLibrary.RemoveEpisode"));
-        QNetworkRequest request(xbmcUrl());
-        request.setRawHeader("Content-Type", "application/json");
-        request.setRawHeader("Accept", "application/json");
-        QNetworkReply* reply = m_network.post(request, QJsonDocument(o).toJson(QJsonDocument::Compact));
-        connect(reply, &QNetworkReply::finished, this, &KodiSync::onRemoveFinished);
-        return;
+        requests.append(o);
     }
-
-    QTimer::singleShot(m_reloadTimeOut, this, &KodiSync::triggerReload);
+    return requests;
 }
 
 void KodiSync::onRemoveFinished()
@@ -585,8 +583,9 @@ void KodiSync::onCleanFinished()
 void KodiSync::updateWatched()
 {
     for (Movie* movie : asConst(m_moviesToSync)) {
-        const int id = findId(movie->files().toStringList(), m_xbmcMovies);
+        const int id = m_xbmcMovieFiles.findId(movie->files().toStringList());
         if (id > 0) {
+            movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
             movie->blockSignals(true);
             movie->setPlayCount(m_xbmcMovies.value(id).playCount);
             movie->setLastPlayed(m_xbmcMovies.value(id).lastPlayed);
@@ -598,7 +597,7 @@ void KodiSync::updateWatched()
     }
 
     for (Concert* concert : asConst(m_concertsToSync)) {
-        const int id = findId(concert->files().toStringList(), m_xbmcConcerts);
+        const int id = m_xbmcConcertFiles.findId(concert->files().toStringList());
         if (id > 0) {
             concert->blockSignals(true);
             concert->setPlayCount(m_xbmcConcerts.value(id).playCount);
@@ -611,7 +610,7 @@ void KodiSync::updateWatched()
     }
 
     for (TvShowEpisode* episode : asConst(m_episodesToSync)) {
-        const int id = findId(episode->files().toStringList(), m_xbmcEpisodes);
+        const int id = m_xbmcEpisodeFiles.findId(episode->files().toStringList());
         if (id > 0) {
             episode->blockSignals(true);
             episode->setPlayCount(m_xbmcEpisodes.value(id).playCount);
@@ -627,103 +626,6 @@ void KodiSync::updateWatched()
     ui->buttonSync->setEnabled(true);
 }
 
-int KodiSync::findId(const QStringList& files, const QMap<int, XbmcData>& items)
-{
-    if (files.isEmpty()) {
-        return -1;
-    }
-
-    QVector<int> matches;
-    int level = 0;
-
-    do {
-        matches.clear();
-        QMapIterator<int, XbmcData> it(items);
-        while (it.hasNext()) {
-            it.next();
-            QString file = it.value().file;
-            QStringList xbmcFiles;
-            if (file.startsWith("stack://")) {
-                xbmcFiles << file.mid(8).split(" , ");
-            } else {
-                xbmcFiles << file;
-            }
-
-            if (compareFiles(files, xbmcFiles, level)) {
-                matches.append(it.key());
-            }
-        }
-    } while (matches.count() > 1 && level++ < 4);
-
-    if (matches.count() == 1) {
-        return matches.at(0);
-    }
-    if (matches.count() == 0) {
-        return 0;
-    }
-    return -1;
-}
-
-bool KodiSync::compareFiles(const QStringList& files, const QStringList& xbmcFiles, const int& level)
-{
-    if (files.count() == 1 && xbmcFiles.count() == 1) {
-        QStringList file = splitFile(files.at(0));
-        QStringList xbmcFile = splitFile(xbmcFiles.at(0));
-        for (int i = 0; i <= level; ++i) {
-            if (file.isEmpty() || xbmcFile.isEmpty()) {
-                return false;
-            }
-            if (QString::compare(file.takeLast(), xbmcFile.takeLast(), Qt::CaseInsensitive) != 0) {
-                return false;
-            }
-        }
-        return true;
-    }
-    if (files.count() == xbmcFiles.count()) {
-        // construct a new stack
-        QStringList stack;
-        QStringList xbmcStack;
-        for (const QString& file : xbmcFiles) {
-            QStringList parts = splitFile(file);
-            if (parts.count() < level) {
-                return false;
-            }
-            QStringList partsNew;
-            for (int i = 0; i <= level; ++i) {
-                partsNew << parts.takeLast();
-            }
-            xbmcStack << partsNew.join("/");
-        }
-
-        for (const QString& file : files) {
-            QStringList parts = splitFile(file);
-            if (parts.count() < level) {
-                return false;
-            }
-            QStringList partsNew;
-            for (int i = 0; i <= level; ++i) {
-                partsNew << parts.takeLast();
-            }
-            stack << partsNew.join("/");
-        }
-
-        std::sort(stack.begin(), stack.end());
-        std::sort(xbmcStack.begin(), xbmcStack.end());
-
-        return (stack == xbmcStack);
-    }
-    return false;
-}
-
-QStringList KodiSync::splitFile(const QString& file)
-{
-    // Windows file names must not contain /
-    if (file.contains("/")) {
-        return file.split("/");
-    }
-    return file.split("\\");
-}
-
 void KodiSync::onRadioContents()
 {
     ui->lblContents->setVisible(true);
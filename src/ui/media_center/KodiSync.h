@@ -1,11 +1,13 @@
 #pragma once
 
 #include "data/movie/Movie.h"
+#include "media_center/kodi/KodiFileIndex.h"
 #include "network/NetworkManager.h"
 #include "settings/Settings.h"
 
 #include <QAuthenticator>
 #include <QDialog>
+#include <QJsonArray>
 #include <QMutex>
 #include <QNetworkReply>
 #include <QTcpSocket>
@@ -84,6 +86,10 @@ private:
     QMap<int, XbmcData> m_xbmcConcerts;
     QMap<int, XbmcData> m_xbmcShows;
     QMap<int, XbmcData> m_xbmcEpisodes;
+    mediaelch::kodi::KodiFileIndex m_xbmcMovieFiles;
+    mediaelch::kodi::KodiFileIndex m_xbmcConcertFiles;
+    mediaelch::kodi::KodiFileIndex m_xbmcShowFiles;
+    mediaelch::kodi::KodiFileIndex m_xbmcEpisodeFiles;
     QVector<int> m_moviesToRemove;
     QVector<int> m_concertsToRemove;
     QVector<int> m_tvShowsToRemove;
@@ -98,11 +104,9 @@ private:
     int m_reloadTimeOut;
     int m_requestId;
 
-    int findId(const QStringList& files, const QMap<int, XbmcData>& items);
-    bool compareFiles(const QStringList& files, const QStringList& xbmcFiles, const int& level);
-    QStringList splitFile(const QString& file);
     void setupItemsToRemove();
     void removeItems();
+    QJsonArray takeRemoveRequests(QVector<int>& ids, const char* method, const char* idName, int maxCount);
     void updateWatched();
     void checkIfListsReady(Element element);
     KodiSync::XbmcData parseXbmcDataFromMap(QMap<QString, QVariant> map);
@@ -285,6 +285,7 @@ void SetsWidget::onSortTitleChanged(QTableWidgetItem* item)
         return;
     }
     auto* movie = ui->movies->item(item->row(), 0)->data(Qt::UserRole).value<Movie*>();
+    movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
     movie->setSortTitle(item->text());
     ui->movies->sortByColumn(1, Qt::AscendingOrder);
     if (!m_moviesToSave[movie->set().name].contains(movie)) {
@@ -322,6 +323,7 @@ void SetsWidget::onAddMovie()
         if (movie->set().name == setName) {
             continue;
         }
+        movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
         MovieSet set = movie->set();
         set.name = setName;
         movie->setSet(set);
@@ -352,6 +354,7 @@ void SetsWidget::onRemoveMovie()
     if (!m_moviesToSave[movie->set().name].contains(movie)) {
         m_moviesToSave[movie->set().name].append(movie);
     }
+    movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
     movie->setSortTitle("");
     movie->setSet(MovieSet{});
     ui->movies->removeRow(ui->movies->currentRow());
@@ -534,6 +537,7 @@ void SetsWidget::onRemoveMovieSet()
     ui->sets->removeRow(ui->sets->currentRow());
 
     for (Movie* movie : m_sets[origSetName]) {
+        movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
         movie->setSet(MovieSet{});
         movie->setSortTitle("");
     }
@@ -564,6 +568,7 @@ void SetsWidget::onSetNameChanged(QTableWidgetItem* item)
 
     for (Movie* movie : m_sets[origSetName]) {
         m_moviesToSave[newName].append(movie);
+        movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
         MovieSet set;
         set.name = newName;
         movie->setSet(set);
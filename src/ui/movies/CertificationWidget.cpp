@@ -156,6 +156,7 @@ void CertificationWidget::onCertificationNameChanged(QTableWidgetItem* item)
 
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->certification() == origName) {
+            movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
             movie->setCertification(newName);
         }
     }
@@ -223,6 +224,7 @@ void CertificationWidget::deleteCertification()
 
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->certification() == certification) {
+            movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
             movie->setCertification(Certification::NoCertification);
         }
     }
@@ -244,6 +246,7 @@ void CertificationWidget::removeMovie()
     }
 
     auto* movie = ui->movies->item(ui->movies->currentRow(), 0)->data(Qt::UserRole).value<Movie*>();
+    movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
     movie->setCertification(Certification::NoCertification);
     ui->movies->removeRow(ui->movies->currentRow());
 }
@@ -267,6 +270,7 @@ void CertificationWidget::addMovie()
     }
 
     for (Movie* movie : movies) {
+        movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
         movie->setCertification(cert);
     }
     onCertificationSelected();
@@ -159,6 +159,7 @@ void GenreWidget::onGenreNameChanged(QTableWidgetItem* item)
 
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->genres().contains(origName)) {
+            movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
             movie->removeGenre(origName);
             if (!movie->genres().contains(newName)) {
                 movie->addGenre(newName);
@@ -226,6 +227,7 @@ void GenreWidget::deleteGenre()
 
     for (Movie* movie : Manager::instance()->movieModel()->movies()) {
         if (movie->genres().contains(genreName)) {
+            movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
             movie->removeGenre(genreName);
         }
     }
@@ -249,6 +251,7 @@ void GenreWidget::removeMovie()
 
     QString genreName = ui->genres->item(ui->genres->currentRow(), 0)->data(Qt::UserRole).toString();
     auto* movie = ui->movies->item(ui->movies->currentRow(), 0)->data(Qt::UserRole).value<Movie*>();
+    movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
     movie->removeGenre(genreName);
     ui->movies->removeRow(ui->movies->currentRow());
 }
@@ -274,6 +277,7 @@ void GenreWidget::addMovie()
         if (movie->genres().contains(genreName)) {
             continue;
         }
+        movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
         movie->addGenre(genreName);
     }
     onGenreSelected();
@@ -4,12 +4,10 @@
 #include "data/movie/Movie.h"
 #include "globals/Helper.h"
 #include "globals/Manager.h"
-#include "globals/MessageIds.h"
 #include "log/Log.h"
 #include "model/MovieProxyModel.h"
 #include "ui/UiUtils.h"
 #include "ui/movies/MovieDuplicateItem.h"
-#include "ui/notifications/NotificationBox.h"
 
 #include <QDesktopServices>
 #include <QMenu>
@@ -65,39 +63,12 @@ MovieDuplicates::~MovieDuplicates()
 
 void MovieDuplicates::detectDuplicates()
 {
+    // The index is kept up-to-date while movies change.  Rebuilding it is
+    // cheap and is only done in case the user wants to be sure.
     qCDebug(generic) << "Detecting duplicates";
-
     ui->duplicates->clear();
     ui->duplicates->setRowCount(0);
-    m_duplicateMovies.clear();
-
-    int counter = 0;
-    int movieCount = qsizetype_to_int(Manager::instance()->movieModel()->movies().count());
-    NotificationBox::instance()->showProgressBar(
-        tr("Detecting duplicate movies..."), Constants::MovieDuplicatesProgressMessageId);
-    NotificationBox::instance()->progressBarProgress(0, movieCount, Constants::MovieDuplicatesProgressMessageId);
-
-    for (Movie* movie : Manager::instance()->movieModel()->movies()) {
-        ++counter;
-        QApplication::processEvents();
-
-        NotificationBox::instance()->progressBarProgress(
-            counter, movieCount, Constants::MovieDuplicatesProgressMessageId);
-        movie->setHasDuplicates(false);
-
-        QVector<Movie*> dups{movie};
-        for (Movie* subMovie : Manager::instance()->movieModel()->movies()) {
-            if (movie != subMovie && subMovie->isDuplicate(movie)) {
-                dups.append(subMovie);
-            }
-        }
-        if (dups.count() > 1) {
-            m_duplicateMovies.insert(movie, dups);
-            movie->setHasDuplicates(true);
-        }
-    }
-
-    NotificationBox::instance()->hideProgressBar(Constants::MovieDuplicatesProgressMessageId);
+    Manager::instance()->movieDuplicates()->rebuild();
 }
 
 void MovieDuplicates::onItemActivated(QModelIndex /*index*/, QModelIndex /*previous*/)
@@ -107,14 +78,15 @@ void MovieDuplicates::onItemActivated(QModelIndex /*index*/, QModelIndex /*previ
         return;
     }
 
-    if (!m_duplicateMovies.contains(movie)) {
+    const QVector<Movie*> duplicates = Manager::instance()->movieDuplicates()->duplicatesOf(movie);
+    if (duplicates.isEmpty()) {
         return;
     }
 
     ui->duplicates->clear();
     ui->duplicates->setRowCount(0);
 
-    for (Movie* dup : asConst(m_duplicateMovies[movie])) {
+    for (Movie* dup : duplicates) {
         auto* item = new MovieDuplicateItem(ui->duplicates);
         item->setMovie(dup, dup == movie);
         item->setDuplicateProperties(movie->duplicateProperties(dup));
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <QMap>
 #include <QModelIndex>
 #include <QVector>
 #include <QWidget>
@@ -41,6 +40,4 @@ private:
     Ui::MovieDuplicates* ui;
     MovieProxyModel* m_movieProxyModel;
     QMenu* m_contextMenu = nullptr;
-
-    QMap<Movie*, QVector<Movie*>> m_duplicateMovies;
 };
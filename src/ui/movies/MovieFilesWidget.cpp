@@ -18,6 +18,7 @@
 #include <QScrollBar>
 #include <QTableWidget>
 #include <QTimer>
+#include <algorithm>
 
 MovieFilesWidget* MovieFilesWidget::m_instance;
 
@@ -198,6 +199,7 @@ void MovieFilesWidget::markAsWatched()
     for (const QModelIndex& index : ui->files->selectionModel()->selectedRows(0)) {
         const int row = index.model()->data(index, Qt::UserRole).toInt();
         Movie* movie = Manager::instance()->movieModel()->movie(row);
+        movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
         if (movie->playcount() < 1) {
             movie->setPlayCount(1);
         }
@@ -217,6 +219,7 @@ void MovieFilesWidget::markAsUnwatched()
     for (const QModelIndex& index : ui->files->selectionModel()->selectedRows(0)) {
         const int row = index.model()->data(index, Qt::UserRole).toInt();
         Movie* movie = Manager::instance()->movieModel()->movie(row);
+        movie->controller()->loadDetails(Manager::instance()->mediaCenterInterface());
         movie->setPlayCount(0);
     }
     if (ui->files->selectionModel()->selectedRows(0).count() > 0) {
@@ -341,6 +344,11 @@ void MovieFilesWidget::movieSelectedEmitter()
  */
 void MovieFilesWidget::setFilter(QVector<Filter*> filters, QString text)
 {
+    const bool needsDetails =
+        std::any_of(filters.cbegin(), filters.cend(), [](const Filter* filter) { return filter->needsMovieDetails(); });
+    if (needsDetails) {
+        Manager::instance()->movieModel()->loadMovieDetails();
+    }
     m_movieProxyModel->setFilter(filters, text);
     m_movieProxyModel->setFilterWildcard("*" + text + "*");
     setAlphaListData();
@@ -2,6 +2,7 @@
 #include "ui_MovieMultiScrapeDialog.h"
 
 #include "globals/Manager.h"
+#include "scrapers/ScrapePipeline.h"
 #include "scrapers/movie/custom/CustomMovieScraper.h"
 #include "scrapers/movie/imdb/ImdbMovie.h"
 #include "scrapers/movie/tmdb/TmdbMovie.h"
@@ -29,6 +30,18 @@ MovieMultiScrapeDialog::MovieMultiScrapeDialog(QWidget* parent) : QDialog(parent
     m_executed = false;
     m_currentMovie = nullptr;
 
+    using namespace mediaelch::scraper;
+    m_pipeline = new ScrapePipeline(this);
+    // Images are downloaded by the movie's controller as part of loading its details.
+    // The download stage waits for them so that they are part of the saved movie.
+    m_pipeline->setHandler(ScrapePipeline::Stage::Search, [this](int item, int run) { searchMovie(item, run); });
+    m_pipeline->setHandler(ScrapePipeline::Stage::Load, [this](int item, int) { loadMovie(item); });
+    m_pipeline->setHandler(ScrapePipeline::Stage::Download, [this](int item, int run) { waitForImages(item, run); });
+    m_pipeline->setHandler(ScrapePipeline::Stage::Save, [this](int item, int run) { saveMovie(item, run); });
+    connect(m_pipeline, &ScrapePipeline::itemStarted, this, &MovieMultiScrapeDialog::onItemStarted);
+    connect(m_pipeline, &ScrapePipeline::itemFinished, this, &MovieMultiScrapeDialog::onItemFinished);
+    connect(m_pipeline, &ScrapePipeline::finished, this, &MovieMultiScrapeDialog::onScrapingFinished);
+
     ui->chkActors->setMyData(static_cast<int>(MovieScraperInfo::Actors));
     ui->chkBackdrop->setMyData(static_cast<int>(MovieScraperInfo::Backdrop));
     ui->chkCertification->setMyData(static_cast<int>(MovieScraperInfo::Certification));
@@ -78,7 +91,11 @@ MovieMultiScrapeDialog::~MovieMultiScrapeDialog()
 
 int MovieMultiScrapeDialog::exec()
 {
-    m_queue.clear();
+    m_pipeline->abort();
+    m_itemOfMovie.clear();
+    m_waitingForImages.clear();
+    m_imagesLoaded.clear();
+    m_ids.clear();
 
     ui->movieCounter->setVisible(false);
     ui->comboScraper->setEnabled(true);
@@ -108,8 +125,8 @@ void MovieMultiScrapeDialog::accept()
 {
     m_currentMovie = nullptr;
     m_executed = false;
-    MediaElch_Assert(m_queue.isEmpty());
-    m_queue.clear(); // TODO: What if there are still items?
+    MediaElch_Assert(!m_pipeline->isRunning());
+    m_pipeline->abort();
 
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyImdb->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
@@ -121,11 +138,15 @@ void MovieMultiScrapeDialog::accept()
 void MovieMultiScrapeDialog::reject()
 {
     m_executed = false;
-    if (m_currentMovie != nullptr) {
-        m_queue.clear();
-        m_currentMovie->controller()->abortDownloads();
-        m_currentMovie = nullptr;
+    m_pipeline->abort();
+
+    const auto movies = m_itemOfMovie.keys();
+    m_itemOfMovie.clear();
+    for (Movie* movie : movies) {
+        disconnect(movie->controller(), nullptr, this, nullptr);
+        movie->controller()->abortDownloads();
     }
+    m_currentMovie = nullptr;
 
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyImdb->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
@@ -136,7 +157,7 @@ void MovieMultiScrapeDialog::reject()
 
 void MovieMultiScrapeDialog::setMovies(QVector<Movie*> movies)
 {
-    // m_queue is filled in onStartScraping()
+    // The pipeline is started in onStartScraping()
     m_movies = movies;
 }
 
@@ -160,14 +181,12 @@ void MovieMultiScrapeDialog::onStartScraping()
     m_isTmdb = (m_scraperInterface->meta().identifier == TmdbMovie::ID);
     m_isImdb = (m_scraperInterface->meta().identifier == ImdbMovie::ID);
 
-    m_queue.append(m_movies.toList());
-
-    ui->movieCounter->setText(QStringLiteral("0/%1").arg(m_queue.count()));
+    ui->movieCounter->setText(QStringLiteral("0/%1").arg(m_movies.count()));
     ui->movieCounter->setVisible(true);
     ui->progressAll->setMaximum(qsizetype_to_int(m_movies.count()));
 
-    // Queue is filled, start scraping them.
-    scrapeNext();
+    m_pipeline->setLimits(ScrapePipeline::limitsForScraper(m_scraperInterface->meta().identifier));
+    m_pipeline->start(qsizetype_to_int(m_movies.count()));
 }
 
 void MovieMultiScrapeDialog::onScrapingFinished()
@@ -193,72 +212,74 @@ void MovieMultiScrapeDialog::onScrapingFinished()
     ui->btnStartScraping->setVisible(false);
 }
 
-void MovieMultiScrapeDialog::scrapeNext()
+void MovieMultiScrapeDialog::onItemStarted(int item)
 {
-    using namespace mediaelch::scraper;
+    Movie* movie = m_movies.at(item);
+    m_itemOfMovie.insert(movie, item);
 
-    // In case that scraping was aborted, return.
-    if (!isExecuted()) {
-        return;
-    }
-
-    if (m_currentMovie != nullptr) {
-        // clang-format off
-        disconnect(m_currentMovie->controller(), &MovieController::sigLoadDone,         this, &MovieMultiScrapeDialog::scrapeNext);
-        disconnect(m_currentMovie->controller(), &MovieController::sigDownloadProgress, this, &MovieMultiScrapeDialog::onProgress);
-        // clang-format on
-
-        if (ui->chkAutoSave->isChecked()) {
-            m_currentMovie->controller()->saveData(Manager::instance()->mediaCenterInterface());
-        }
-    }
+    // clang-format off
+    connect(movie->controller(), &MovieController::sigInfoLoadDone,     this, &MovieMultiScrapeDialog::onInfoLoadDone, Qt::UniqueConnection);
+    connect(movie->controller(), &MovieController::sigLoadDone,         this, &MovieMultiScrapeDialog::onLoadDone,     Qt::UniqueConnection);
+    connect(movie->controller(), &MovieController::sigDownloadProgress, this, &MovieMultiScrapeDialog::onProgress,     Qt::UniqueConnection);
+    // clang-format on
 
-    if (m_queue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
+    m_currentMovie = movie;
+    ui->movie->setText(movie->name().trimmed());
+    ui->progressMovie->setValue(0);
+}
 
-    m_currentMovie = m_queue.dequeue();
+void MovieMultiScrapeDialog::onItemFinished(int item)
+{
+    Movie* movie = m_movies.at(item);
+    m_itemOfMovie.remove(movie);
+    m_waitingForImages.remove(movie);
+    m_imagesLoaded.remove(movie);
+    m_ids.remove(movie);
+    disconnect(movie->controller(), nullptr, this, nullptr);
+
+    const int finished = m_pipeline->finishedCount();
+    ui->movieCounter->setText(QStringLiteral("%1/%2").arg(finished).arg(m_movies.count()));
+    ui->progressAll->setValue(finished);
+}
 
-    ui->movie->setText(m_currentMovie->name().trimmed());
-    ui->movieCounter->setText(QStringLiteral("%1/%2").arg(m_movies.count() - m_queue.count()).arg(m_movies.count()));
+void MovieMultiScrapeDialog::searchMovie(int item, int run)
+{
+    using namespace mediaelch::scraper;
 
-    ui->progressAll->setValue(ui->progressAll->maximum() - qsizetype_to_int(m_queue.size()) - 1);
-    ui->progressMovie->setValue(0);
+    Movie* movie = m_movies.at(item);
 
     if (ui->chkOnlyImdb->isChecked()
-        && ((!m_currentMovie->imdbId().isValid() && m_isImdb)
-            || (!m_currentMovie->tmdbId().isValid() && !m_currentMovie->imdbId().isValid() && m_isTmdb)
-            || (!m_currentMovie->imdbId().isValid() && !m_currentMovie->tmdbId().isValid()
+        && ((!movie->imdbId().isValid() && m_isImdb)
+            || (!movie->tmdbId().isValid() && !movie->imdbId().isValid() && m_isTmdb)
+            || (!movie->imdbId().isValid() && !movie->tmdbId().isValid()
                 && m_scraperInterface->meta().identifier == CustomMovieScraper::ID))) {
-        scrapeNext();
+        m_pipeline->finish(item, run);
         return;
     }
 
-    // clang-format off
-    connect(m_currentMovie->controller(), &MovieController::sigLoadDone,         this, &MovieMultiScrapeDialog::scrapeNext, Qt::UniqueConnection);
-    connect(m_currentMovie->controller(), &MovieController::sigDownloadProgress, this, &MovieMultiScrapeDialog::onProgress, Qt::UniqueConnection);
-    // clang-format on
-
-    m_currentIds.clear();
+    QHash<MovieScraper*, MovieIdentifier>& ids = m_ids[movie];
+    ids.clear();
 
-    if (m_isImdb && m_currentMovie->imdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->imdbId());
+    if (m_isImdb && movie->imdbId().isValid()) {
+        ids.insert(nullptr, MovieIdentifier(movie->imdbId()));
+        m_pipeline->advance(item, run);
         return;
     }
-    if (m_isTmdb && m_currentMovie->tmdbId().isValid()) {
-        loadMovieData(m_currentMovie, m_currentMovie->tmdbId());
+    if (m_isTmdb && movie->tmdbId().isValid()) {
+        ids.insert(nullptr, MovieIdentifier(movie->tmdbId()));
+        m_pipeline->advance(item, run);
         return;
     }
-    if (m_isTmdb && m_currentMovie->imdbId().isValid()) {
+    if (m_isTmdb && movie->imdbId().isValid()) {
         // TMDb can also load with IMDb IDs.
-        loadMovieData(m_currentMovie, m_currentMovie->imdbId());
+        ids.insert(nullptr, MovieIdentifier(movie->imdbId()));
+        m_pipeline->advance(item, run);
         return;
     }
 
     MovieSearchJob::Config config;
     // FIXME config.locale =
-    config.query = m_currentMovie->name().replace(".", " ");
+    config.query = movie->name().replace(".", " ");
     config.includeAdult = Settings::instance()->showAdultScrapers();
 
     MovieScraper* scraperForSearchJob = m_scraperInterface;
@@ -267,38 +288,71 @@ void MovieMultiScrapeDialog::scrapeNext()
         scraperForSearchJob = CustomMovieScraper::instance()->titleScraper();
         const QString& titleScraper = scraperForSearchJob->meta().identifier;
 
-        if (titleScraper == ImdbMovie::ID && m_currentMovie->imdbId().isValid()) {
-            config.query = m_currentMovie->imdbId().toString();
+        if (titleScraper == ImdbMovie::ID && movie->imdbId().isValid()) {
+            config.query = movie->imdbId().toString();
 
-        } else if (titleScraper == TmdbMovie::ID && m_currentMovie->tmdbId().isValid()) {
-            config.query = m_currentMovie->tmdbId().withPrefix();
+        } else if (titleScraper == TmdbMovie::ID && movie->tmdbId().isValid()) {
+            config.query = movie->tmdbId().withPrefix();
 
-        } else if (titleScraper == TmdbMovie::ID && m_currentMovie->imdbId().isValid()) {
+        } else if (titleScraper == TmdbMovie::ID && movie->imdbId().isValid()) {
             // TMDb can also load with IMDb IDs.
-            config.query = m_currentMovie->imdbId().toString();
+            config.query = movie->imdbId().toString();
         }
     }
 
     auto* searchJob = m_scraperInterface->search(config);
     searchJob->setProperty("scraper", QVariant::fromValue(scraperForSearchJob));
+    searchJob->setProperty("item", item);
+    searchJob->setProperty("run", run);
     connect(searchJob, &MovieSearchJob::searchFinished, this, &MovieMultiScrapeDialog::onSearchFinished);
     searchJob->start();
 }
 
-void MovieMultiScrapeDialog::loadMovieData(Movie* movie, ImdbId id)
+void MovieMultiScrapeDialog::loadMovie(int item)
 {
-    using namespace mediaelch::scraper;
-    QHash<MovieScraper*, MovieIdentifier> ids;
-    ids.insert(nullptr, MovieIdentifier(id));
-    movie->controller()->loadData(ids, m_scraperInterface, m_infosToLoad);
+    Movie* movie = m_movies.at(item);
+    movie->controller()->loadData(m_ids.value(movie), m_scraperInterface, m_infosToLoad);
 }
 
-void MovieMultiScrapeDialog::loadMovieData(Movie* movie, TmdbId id)
+void MovieMultiScrapeDialog::waitForImages(int item, int run)
 {
-    using namespace mediaelch::scraper;
-    QHash<MovieScraper*, MovieIdentifier> ids;
-    ids.insert(nullptr, MovieIdentifier(id));
-    movie->controller()->loadData(ids, m_scraperInterface, m_infosToLoad);
+    // Images are downloaded by the movie's controller once its details are loaded.
+    // They may already be finished, e.g. if no images were selected.
+    Movie* movie = m_movies.at(item);
+    if (m_imagesLoaded.remove(movie)) {
+        m_pipeline->advance(item, run);
+    } else {
+        m_waitingForImages.insert(movie);
+    }
+}
+
+void MovieMultiScrapeDialog::saveMovie(int item, int run)
+{
+    if (ui->chkAutoSave->isChecked()) {
+        m_movies.at(item)->controller()->saveData(Manager::instance()->mediaCenterInterface());
+    }
+    m_pipeline->advance(item, run);
+}
+
+void MovieMultiScrapeDialog::onInfoLoadDone(Movie* movie)
+{
+    // Movies' signals are only connected while they are scraped in the current run, see onItemStarted().
+    const int item = m_itemOfMovie.value(movie, -1);
+    if (isExecuted() && m_pipeline->isProcessing(item, mediaelch::scraper::ScrapePipeline::Stage::Load)) {
+        m_pipeline->advance(item, m_pipeline->run());
+    }
+}
+
+void MovieMultiScrapeDialog::onLoadDone(Movie* movie)
+{
+    if (!isExecuted() || !m_itemOfMovie.contains(movie)) {
+        return;
+    }
+    if (m_waitingForImages.remove(movie)) {
+        m_pipeline->advance(m_itemOfMovie.value(movie), m_pipeline->run());
+    } else {
+        m_imagesLoaded.insert(movie);
+    }
 }
 
 void MovieMultiScrapeDialog::onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob)
@@ -311,70 +365,78 @@ void MovieMultiScrapeDialog::onSearchFinished(mediaelch::scraper::MovieSearchJob
         return;
     }
 
+    const int item = searchJob->property("item").toInt();
+    const int run = searchJob->property("run").toInt();
+    Movie* movie = m_movies.value(item);
+    if (movie == nullptr || !m_itemOfMovie.contains(movie)) {
+        return;
+    }
+
     if (searchJob->hasError()) {
         // TODO: Show the error
-        scrapeNext();
+        m_pipeline->finish(item, run);
         return;
     }
 
     if (searchJob->results().isEmpty()) {
-        scrapeNext();
+        m_pipeline->finish(item, run);
         return;
     }
 
+    QHash<MovieScraper*, MovieIdentifier>& ids = m_ids[movie];
+
     if (m_scraperInterface->meta().identifier == CustomMovieScraper::ID) {
         if (!searchJob->property("scraper").isValid()) {
             qCCritical(generic) << "[MovieMultiScraperDialog] Could not get scraper from search job! Invalid QVariant";
-            scrapeNext();
+            m_pipeline->finish(item, run);
             return;
         }
         auto* scraper = searchJob->property("scraper").value<MovieScraper*>();
         if (scraper == nullptr) {
             qCCritical(generic)
                 << "[MovieMultiScraperDialog] Could not get scraper from search job! Scraper is nullptr";
-            scrapeNext();
+            m_pipeline->finish(item, run);
             return;
         }
-        m_currentIds.insert(scraper, searchJob->results().first().identifier);
+        ids.insert(scraper, searchJob->results().first().identifier);
         const QVector<MovieScraper*>& searchScrapers =
-            CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, m_currentIds);
+            CustomMovieScraper::instance()->scrapersNeedSearch(m_infosToLoad, ids);
 
         if (!searchScrapers.isEmpty()) {
             MovieSearchJob::Config config;
             // FIXME config.locale = TODO
             config.includeAdult = Settings::instance()->showAdultScrapers();
-            config.query = m_currentMovie->name();
+            config.query = movie->name();
             config.query = config.query.replace(".", " ");
 
             if ((searchScrapers.first()->meta().identifier == TmdbMovie::ID
                     || searchScrapers.first()->meta().identifier == ImdbMovie::ID)
-                && m_currentMovie->imdbId().isValid()) {
-                config.query = m_currentMovie->imdbId().toString();
+                && movie->imdbId().isValid()) {
+                config.query = movie->imdbId().toString();
 
-            } else if (searchScrapers.first()->meta().identifier == TmdbMovie::ID
-                       && m_currentMovie->tmdbId().isValid()) {
-                config.query = m_currentMovie->tmdbId().toString();
+            } else if (searchScrapers.first()->meta().identifier == TmdbMovie::ID && movie->tmdbId().isValid()) {
+                config.query = movie->tmdbId().toString();
             }
 
             auto* nextSearchJob = searchScrapers.first()->search(config);
             nextSearchJob->setProperty("scraper", QVariant::fromValue(searchScrapers.first()));
+            nextSearchJob->setProperty("item", item);
+            nextSearchJob->setProperty("run", run);
             connect(nextSearchJob, &MovieSearchJob::searchFinished, this, &MovieMultiScrapeDialog::onSearchFinished);
             nextSearchJob->start();
 
             return;
         }
     } else {
-        m_currentIds.insert(m_scraperInterface, searchJob->results().first().identifier);
+        ids.insert(m_scraperInterface, searchJob->results().first().identifier);
     }
 
-    m_currentMovie->controller()->loadData(m_currentIds, m_scraperInterface, m_infosToLoad);
+    m_pipeline->advance(item, run);
 }
 
 void MovieMultiScrapeDialog::onProgress(Movie* movie, int current, int maximum)
 {
-    Q_UNUSED(movie);
-
-    if (!isExecuted()) {
+    if (!isExecuted() || movie != m_currentMovie) {
         return;
     }
 
@@ -5,8 +5,8 @@
 #include "scrapers/movie/MovieIdentifier.h"
 
 #include <QDialog>
+#include <QHash>
 #include <QPointer>
-#include <QQueue>
 
 namespace Ui {
 class MovieMultiScrapeDialog;
@@ -15,6 +15,7 @@ class MovieMultiScrapeDialog;
 namespace mediaelch {
 namespace scraper {
 class MovieSearchJob;
+class ScrapePipeline;
 }
 } // namespace mediaelch
 
@@ -39,7 +40,10 @@ private slots:
     void onStartScraping();
     void onScrapingFinished();
     void onSearchFinished(mediaelch::scraper::MovieSearchJob* searchJob);
-    void scrapeNext();
+    void onItemStarted(int item);
+    void onItemFinished(int item);
+    void onInfoLoadDone(Movie* movie);
+    void onLoadDone(Movie* movie);
     void onProgress(Movie* movie, int current, int maximum);
     void onChkToggled();
     void onChkAllToggled();
@@ -48,16 +52,25 @@ private slots:
 private:
     Ui::MovieMultiScrapeDialog* ui = nullptr;
     QVector<Movie*> m_movies;
-    QQueue<Movie*> m_queue;
+    mediaelch::scraper::ScrapePipeline* m_pipeline = nullptr;
+    /// \brief Index of each movie that is currently scraped.
+    QHash<Movie*, int> m_itemOfMovie;
+    /// \brief Movies whose images are downloaded and that wait for sigLoadDone().
+    QSet<Movie*> m_waitingForImages;
+    /// \brief Movies whose images were downloaded before they entered the download stage.
+    QSet<Movie*> m_imagesLoaded;
+    /// \brief The most recently started movie, whose name and progress are shown.
     QPointer<Movie> m_currentMovie;
     mediaelch::scraper::MovieScraper* m_scraperInterface = nullptr;
-    QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier> m_currentIds;
+    QHash<Movie*, QHash<mediaelch::scraper::MovieScraper*, mediaelch::scraper::MovieIdentifier>> m_ids;
     bool m_isImdb = false;
     bool m_isTmdb = false;
     bool m_executed = false;
     QSet<MovieScraperInfo> m_infosToLoad;
 
-    void loadMovieData(Movie* movie, ImdbId id);
-    void loadMovieData(Movie* movie, TmdbId id);
+    void searchMovie(int item, int run);
+    void loadMovie(int item);
+    void waitForImages(int item, int run);
+    void saveMovie(int item, int run);
     bool isExecuted() const;
 };
@@ -362,22 +362,21 @@ void MovieWidget::setDisabledTrue()
  */
 void MovieWidget::setMovie(Movie* movie)
 {
-    using namespace std::chrono;
     qCDebug(generic) << "Entered, movie=" << movie->name();
     movie->controller()->loadData(Manager::instance()->mediaCenterInterface());
-    if (!movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
-        const bool success = movie->controller()->loadStreamDetailsFromFile();
-        if (success) {
-            const seconds durationInSeconds = seconds(
-                movie->streamDetails()->videoDetails().value(StreamDetails::VideoDetails::DurationInSeconds).toInt());
-            if (movie->streamDetailsLoaded() && durationInSeconds > 0s) {
-                movie->setRuntime(duration_cast<minutes>(durationInSeconds));
-            }
-        }
-    }
     m_movie = movie;
     updateMovieInfo();
 
+    if (!movie->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails()) {
+        // MediaInfo may take seconds, e.g. for files on network shares; don't block the GUI.
+        connect(movie->controller(),
+            &MovieController::sigStreamDetailsLoaded,
+            this,
+            &MovieWidget::onStreamDetailsLoaded,
+            Qt::UniqueConnection);
+        movie->controller()->loadStreamDetailsInBackground();
+    }
+
     connect(m_movie->controller(),
         &MovieController::sigInfoLoadDone,
         this,
@@ -469,6 +468,23 @@ void MovieWidget::onInfoLoadDone(Movie* movie)
     }
 }
 
+void MovieWidget::onStreamDetailsLoaded(Movie* movie, bool success)
+{
+    if (m_movie != movie) {
+        return;
+    }
+    if (success) {
+        updateStreamDetails(true);
+    }
+    ui->videoAspectRatio->setEnabled(m_movie->streamDetailsLoaded());
+    ui->videoCodec->setEnabled(m_movie->streamDetailsLoaded());
+    ui->videoDuration->setEnabled(m_movie->streamDetailsLoaded());
+    ui->videoHeight->setEnabled(m_movie->streamDetailsLoaded());
+    ui->videoWidth->setEnabled(m_movie->streamDetailsLoaded());
+    ui->videoScantype->setEnabled(m_movie->streamDetailsLoaded());
+    ui->stereoMode->setEnabled(m_movie->streamDetailsLoaded());
+}
+
 void MovieWidget::onLoadDone(Movie* movie)
 {
     if (m_movie == nullptr) {
@@ -847,7 +863,7 @@ void MovieWidget::updateStreamDetails(bool reloadedFromFile)
 
 void MovieWidget::onClickReloadStreamDetails()
 {
-    const bool success = m_movie->controller()->loadStreamDetailsFromFile();
+    const bool success = m_movie->controller()->loadStreamDetailsFromFile(true);
     ui->lblReloadStreamDetailsError->setVisible(!success);
     if (success) {
         ui->lblReloadStreamDetailsError->clear();
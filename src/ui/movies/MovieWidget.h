@@ -51,6 +51,7 @@ private slots:
     void onInfoLoadDone(Movie* movie);
     void onLoadStarted(Movie* movie);
     void onLoadDone(Movie* movie);
+    void onStreamDetailsLoaded(Movie* movie, bool success);
     void onLoadImagesStarted(Movie* movie);
     void onLoadingImages(Movie* movie, QSet<ImageType> imageTypes);
     void onDownloadProgress(Movie* movie, int current, int maximum);
@@ -1,15 +1,19 @@
 #include "ui/settings/NetworkSettingsWidget.h"
 #include "ui_NetworkSettingsWidget.h"
 
+#include "globals/Helper.h"
+#include "network/HttpCache.h"
 #include "settings/Settings.h"
 
 #include <QFileDialog>
+#include <QLocale>
 
 NetworkSettingsWidget::NetworkSettingsWidget(QWidget* parent) : QWidget(parent), ui(new Ui::NetworkSettingsWidget)
 {
     ui->setupUi(this);
 
     connect(ui->chkUseProxy, &QAbstractButton::clicked, this, &NetworkSettingsWidget::onUseProxy);
+    connect(ui->btnClearScraperCache, &QAbstractButton::clicked, this, &NetworkSettingsWidget::onClearScraperCache);
 }
 
 NetworkSettingsWidget::~NetworkSettingsWidget()
@@ -33,6 +37,7 @@ void NetworkSettingsWidget::loadSettings()
     ui->proxyUsername->setText(netSettings.proxyUsername());
     ui->proxyPassword->setText(netSettings.proxyPassword());
     onUseProxy();
+    updateScraperCacheSize();
 }
 
 void NetworkSettingsWidget::saveSettings()
@@ -59,3 +64,15 @@ void NetworkSettingsWidget::onUseProxy()
     ui->proxyUsername->setEnabled(enabled);
     ui->proxyPassword->setEnabled(enabled);
 }
+
+void NetworkSettingsWidget::onClearScraperCache()
+{
+    mediaelch::network::HttpCache::instance().clear();
+    updateScraperCacheSize();
+}
+
+void NetworkSettingsWidget::updateScraperCacheSize()
+{
+    const qint64 size = mediaelch::network::HttpCache::instance().diskSize();
+    ui->scraperCacheSize->setText(helper::formatFileSizeBinary(static_cast<double>(size), QLocale()));
+}
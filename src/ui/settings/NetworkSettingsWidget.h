@@ -24,6 +24,10 @@ public:
 
 private slots:
     void onUseProxy();
+    void onClearScraperCache();
+
+private:
+    void updateScraperCacheSize();
 
 private:
     Ui::NetworkSettingsWidget* ui = nullptr;
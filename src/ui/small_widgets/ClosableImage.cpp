@@ -56,6 +56,20 @@ ClosableImage::ClosableImage(QWidget* parent) : QLabel(parent)
     m_capture = m_capture.scaledToWidth(width, Qt::SmoothTransformation);
 
     setAcceptDrops(true);
+
+    connect(ImageCache::instance(),
+        &ImageCache::imageLoaded,
+        this,
+        [this](const mediaelch::FilePath& path, int width, int height) {
+            if (height == 0 && width == scaledImageWidth() && path.toString() == m_imagePath) {
+                update();
+            }
+        });
+}
+
+ClosableImage::~ClosableImage()
+{
+    ImageCache::instance()->cancelRequests(this);
 }
 
 void ClosableImage::mousePressEvent(QMouseEvent* ev)
@@ -155,14 +169,27 @@ void ClosableImage::paintEvent(QPaintEvent* event)
     QImage img;
     int origWidth = 0;
     int origHeight = 0;
-    const int w = static_cast<int>((width() - 9) * devicePixelRatioF());
+    const int w = scaledImageWidth();
     if (!m_image.isNull()) {
-        img = QImage::fromData(m_image);
-        origWidth = img.width();
-        origHeight = img.height();
-        img = img.scaledToWidth(w, Qt::SmoothTransformation);
+        if (m_scaledImage.isNull() || m_scaledImage.width() != w) {
+            const QImage original = QImage::fromData(m_image);
+            m_originalSize = original.size();
+            m_scaledImage = original.scaledToWidth(w, Qt::SmoothTransformation);
+        }
+        img = m_scaledImage;
+        origWidth = m_originalSize.width();
+        origHeight = m_originalSize.height();
     } else if (!m_imagePath.isEmpty()) {
-        img = ImageCache::instance()->image(mediaelch::FilePath(m_imagePath), w, 0, origWidth, origHeight);
+        const mediaelch::FilePath path(m_imagePath);
+        img = ImageCache::instance()->cachedImage(path, w, 0, origWidth, origHeight);
+        if (img.isNull()) {
+            if (!ImageCache::instance()->hasFailed(path, w, 0)) {
+                // Repainted once the image is loaded, see constructor.
+                ImageCache::instance()->requestImage(path, w, 0, this);
+            }
+            QLabel::paintEvent(event);
+            return;
+        }
     } else {
         const int x = static_cast<int>((width() - (m_defaultPixmap.width() / m_defaultPixmap.devicePixelRatioF())) / 2);
         const int y =
@@ -234,6 +261,31 @@ void ClosableImage::setMyData(const QVariant& myData)
     m_myData = myData;
 }
 
+void ClosableImage::hideEvent(QHideEvent* event)
+{
+    ImageCache::instance()->cancelRequests(this);
+    QLabel::hideEvent(event);
+}
+
+void ClosableImage::prefetchImage()
+{
+    if (m_imagePath.isEmpty()) {
+        return;
+    }
+    const mediaelch::FilePath path(m_imagePath);
+    const int w = scaledImageWidth();
+    int origWidth = 0;
+    int origHeight = 0;
+    if (ImageCache::instance()->cachedImage(path, w, 0, origWidth, origHeight).isNull()) {
+        ImageCache::instance()->requestImage(path, w, 0, this, ImageCache::Priority::Prefetch);
+    }
+}
+
+int ClosableImage::scaledImageWidth() const
+{
+    return static_cast<int>((width() - 9) * devicePixelRatioF());
+}
+
 void ClosableImage::setImage(const QByteArray& image)
 {
     clear();
@@ -348,6 +400,7 @@ void ClosableImage::setLoading(const bool& loading)
     if (loading) {
         setMovie(m_loadingMovie);
         m_image = QByteArray();
+        m_scaledImage = QImage();
         m_imagePath.clear();
         update();
     } else {
@@ -360,8 +413,10 @@ void ClosableImage::clear()
     if (m_anim != nullptr) {
         m_anim->stop();
     }
+    ImageCache::instance()->cancelRequests(this);
     m_imagePath.clear();
     m_image = QByteArray();
+    m_scaledImage = QImage();
     m_pixmap = m_emptyPixmap;
     m_loading = false;
     setMovie(nullptr);
@@ -392,6 +447,7 @@ void ClosableImage::closed()
 {
     m_pixmap = QPixmap();
     m_image = QByteArray();
+    m_scaledImage = QImage();
     m_imagePath.clear();
     update();
 }
@@ -2,6 +2,7 @@
 
 #include "globals/Globals.h"
 
+#include <QImage>
 #include <QLabel>
 #include <QMouseEvent>
 #include <QMovie>
@@ -19,6 +20,7 @@ class ClosableImage : public QLabel
 
 public:
     explicit ClosableImage(QWidget* parent = nullptr);
+    ~ClosableImage() override;
     void setMyData(const QVariant& myData);
     QVariant myData() const;
     void setImage(const QByteArray& image);
@@ -44,6 +46,10 @@ public:
     bool showCapture() const;
     void setShowCapture(bool showCapture);
 
+    /// \brief Load the image in the background if it is not visible, yet, e.g. because it is
+    ///        scrolled out of view.
+    void prefetchImage();
+
 signals:
     void sigClose();
     void sigCapture(ImageType type);
@@ -52,6 +58,7 @@ signals:
 
 protected:
     void paintEvent(QPaintEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
     void mousePressEvent(QMouseEvent* ev) override;
     void mouseMoveEvent(QMouseEvent* ev) override;
     void dragEnterEvent(QDragEnterEvent* event) override;
@@ -64,6 +71,9 @@ private slots:
 private:
     QVariant m_myData;
     QByteArray m_image;
+    /// \brief m_image scaled to the widget's size; avoids decoding m_image in each paint event.
+    QImage m_scaledImage;
+    QSize m_originalSize;
     QString m_imagePath;
     QPixmap m_pixmap;
     QPixmap m_defaultPixmap;
@@ -85,6 +95,8 @@ private:
     QPixmap m_emptyPixmap;
 
     void updateSize(int imageWidth, int imageHeight);
+    /// \brief Width of the drawn image in device pixels.
+    int scaledImageWidth() const;
     QRect imgRect();
     QRect closeRect();
     QRect zoomRect();
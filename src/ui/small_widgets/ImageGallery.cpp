@@ -7,6 +7,7 @@
 #include <QScrollBar>
 
 #include "log/Log.h"
+#include "media/ImageCache.h"
 
 ImageGallery::ImageGallery(QWidget* parent) :
     QWidget(parent),
@@ -197,6 +198,24 @@ void ImageGallery::positionImages()
         onHorizontalScrollBarRangeChanged(
             m_scrollArea->horizontalScrollBar()->minimum(), m_scrollArea->horizontalScrollBar()->maximum());
     }
+    updateImageRequests();
+}
+
+void ImageGallery::updateImageRequests()
+{
+    // Visible images are requested when they are painted.
+    const QRect visible(-m_imagesWidget->pos(), m_scrollArea->viewport()->size());
+    const QRect nearby = visible.adjusted(-visible.width(), -visible.height(), visible.width(), visible.height());
+    for (ClosableImage* label : asConst(m_imageLabels)) {
+        if (label->geometry().intersects(visible)) {
+            continue;
+        }
+        if (label->geometry().intersects(nearby)) {
+            label->prefetchImage();
+        } else {
+            ImageCache::instance()->cancelRequests(label);
+        }
+    }
 }
 
 void ImageGallery::onCloseImage()
@@ -251,6 +270,7 @@ void ImageGallery::onVerticalScrollBarMoved(const int& value)
 
     m_buttonTop->setEnabled(value != 0);
     m_buttonBottom->setEnabled(value != m_scrollArea->verticalScrollBar()->maximum());
+    updateImageRequests();
 }
 
 void ImageGallery::onHorizontalScrollBarMoved(const int& value)
@@ -261,6 +281,7 @@ void ImageGallery::onHorizontalScrollBarMoved(const int& value)
 
     m_buttonLeft->setEnabled(value != 0);
     m_buttonRight->setEnabled(value != m_scrollArea->horizontalScrollBar()->maximum());
+    updateImageRequests();
 }
 
 void ImageGallery::onButtonLeft()
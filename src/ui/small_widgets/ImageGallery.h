@@ -60,4 +60,7 @@ private:
     bool m_showZoomAndResolution;
 
     void positionImages();
+    /// \brief Prefetch images close to the visible area and cancel the requests of images
+    ///        that were scrolled out of view before they were loaded.
+    void updateImageRequests();
 };
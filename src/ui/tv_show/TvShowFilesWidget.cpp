@@ -497,8 +497,9 @@ void TvShowFilesWidget::hideSpecialsInMissingEpisodes()
 void TvShowFilesWidget::setFilter(const QVector<Filter*>& filters, QString text)
 {
     QString filterText = filters.isEmpty() ? text : filters.first()->shortText();
-    m_tvShowProxyModel->setFilterWildcard("*" + filterText + "*");
+    // Set the filters first: setting the wildcard re-filters the model.
     m_tvShowProxyModel->setFilter(filters, text);
+    m_tvShowProxyModel->setFilterWildcard("*" + filterText + "*");
 }
 
 /// \brief Renews the model (necessary after searching for TV shows)
@@ -5,6 +5,7 @@
 #include "log/Log.h"
 #include "media/ImageCache.h"
 #include "media/ImageUtils.h"
+#include "scrapers/ScrapePipeline.h"
 #include "scrapers/tv_show/TvScraper.h"
 #include "scrapers/tv_show/custom/CustomTvScraper.h"
 #include "scrapers/tv_show/imdb/ImdbTv.h"
@@ -85,8 +86,15 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
 #endif
     ui->itemCounter->setFont(font);
 
-    m_showQueue.append(m_shows.toList());
-    m_episodeQueue.append(m_episodes.toList());
+    using namespace mediaelch::scraper;
+    m_pipeline = new ScrapePipeline(this);
+    m_pipeline->setHandler(ScrapePipeline::Stage::Search, [this](int item, int run) { searchItem(item, run); });
+    m_pipeline->setHandler(ScrapePipeline::Stage::Load, [this](int item, int) { loadItem(item); });
+    m_pipeline->setHandler(ScrapePipeline::Stage::Download, [this](int item, int run) { downloadImages(item, run); });
+    m_pipeline->setHandler(ScrapePipeline::Stage::Save, [this](int item, int run) { saveItem(item, run); });
+    connect(m_pipeline, &ScrapePipeline::itemStarted, this, &TvShowMultiScrapeDialog::onItemStarted);
+    connect(m_pipeline, &ScrapePipeline::itemFinished, this, &TvShowMultiScrapeDialog::onItemFinished);
+    connect(m_pipeline, &ScrapePipeline::finished, this, &TvShowMultiScrapeDialog::onScrapingFinished);
 
     ui->chkActors->setMyData(static_cast<int>(ShowScraperInfo::Actors));
     ui->chkBanner->setMyData(static_cast<int>(ShowScraperInfo::Banner));
@@ -144,8 +152,9 @@ TvShowMultiScrapeDialog::TvShowMultiScrapeDialog(QVector<TvShow*> shows,
     connect(ui->comboLanguage,    &LanguageCombo::languageChanged, this, &TvShowMultiScrapeDialog::onLanguageChanged);
 
     auto queuedUnique = static_cast<Qt::ConnectionType>(Qt::QueuedConnection | Qt::UniqueConnection);
-    connect(m_downloadManager, &DownloadManager::sigElemDownloaded,    this, &TvShowMultiScrapeDialog::onDownloadFinished, queuedUnique);
-    connect(m_downloadManager, &DownloadManager::allDownloadsFinished, this, &TvShowMultiScrapeDialog::scrapeNext,         queuedUnique);
+    connect(m_downloadManager, &DownloadManager::sigElemDownloaded,          this, &TvShowMultiScrapeDialog::onDownloadFinished,      queuedUnique);
+    connect(m_downloadManager, &DownloadManager::allTvShowDownloadsFinished, this, &TvShowMultiScrapeDialog::onShowDownloadsFinished, queuedUnique);
+    connect(m_downloadManager, &DownloadManager::allDownloadsFinished,       this, &TvShowMultiScrapeDialog::onAllDownloadsFinished,  queuedUnique);
     // clang-format on
 }
 
@@ -209,8 +218,24 @@ void TvShowMultiScrapeDialog::accept()
 
 void TvShowMultiScrapeDialog::reject()
 {
+    m_pipeline->abort();
     m_downloadManager->abortDownloads();
 
+    // Shows and episodes that are still scraped must not report back to this dialog.
+    const auto shows = m_itemOfShow.keys();
+    for (TvShow* show : shows) {
+        disconnect(show, nullptr, this, nullptr);
+    }
+    const auto episodes = m_itemOfEpisode.keys();
+    for (TvShowEpisode* episode : episodes) {
+        disconnect(episode, nullptr, this, nullptr);
+    }
+    m_itemOfShow.clear();
+    m_itemOfEpisode.clear();
+    m_runningSearches.clear();
+    m_currentShow = nullptr;
+    m_currentEpisode = nullptr;
+
     Settings::instance()->setMultiScrapeOnlyWithId(ui->chkOnlyId->isChecked());
     Settings::instance()->setMultiScrapeSaveEach(ui->chkAutoSave->isChecked());
     Settings::instance()->saveSettings();
@@ -289,6 +314,8 @@ void TvShowMultiScrapeDialog::onChkAllEpisodeInfosToggled()
 
 void TvShowMultiScrapeDialog::onStartScraping()
 {
+    using namespace mediaelch::scraper;
+
     ui->showInfosGroupBox->setEnabled(false);
     ui->episodeInfosGroupBox->setEnabled(false);
     ui->btnStartScraping->setEnabled(false);
@@ -299,151 +326,190 @@ void TvShowMultiScrapeDialog::onStartScraping()
     ui->comboScraper->setEnabled(false);
     ui->txtScraperLog->clear();
 
-    ui->itemCounter->setText(QStringLiteral("0/%1").arg(m_showQueue.count() + m_episodeQueue.count()));
+    const int sum = qsizetype_to_int(m_shows.count() + m_episodes.count());
+    ui->itemCounter->setText(QStringLiteral("0/%1").arg(sum));
     ui->itemCounter->setVisible(true);
-    ui->progressAll->setMaximum(qsizetype_to_int(m_showQueue.count() + m_episodeQueue.count()));
+    ui->progressAll->setMaximum(sum);
 
     logToUser(tr("Start scraping using \"%1\"").arg(m_currentScraper->meta().name));
 
-    scrapeNext();
+    m_pipeline->setLimits(ScrapePipeline::limitsForScraper(m_currentScraper->meta().identifier));
+    m_pipeline->start(sum);
 }
 
-void TvShowMultiScrapeDialog::scrapeNext()
+TvShow* TvShowMultiScrapeDialog::showOfItem(int item) const
 {
-    qCDebug(generic) << "[TvShowMultiScrapeDialog] Scrape next item";
-    using namespace mediaelch::scraper;
-
-    saveCurrentItem();
+    return item < m_shows.size() ? m_shows.at(item) : nullptr;
+}
 
-    if (m_showQueue.isEmpty() && m_episodeQueue.isEmpty()) {
-        onScrapingFinished();
-        return;
-    }
+TvShowEpisode* TvShowMultiScrapeDialog::episodeOfItem(int item) const
+{
+    return item >= m_shows.size() ? m_episodes.value(item - m_shows.size()) : nullptr;
+}
 
-    m_currentShow = nullptr;
-    m_currentEpisode = nullptr;
+void TvShowMultiScrapeDialog::onItemStarted(int item)
+{
+    m_currentShow = showOfItem(item);
+    m_currentEpisode = episodeOfItem(item);
 
-    if (!m_showQueue.isEmpty()) {
-        m_currentShow = m_showQueue.dequeue();
+    if (m_currentShow != nullptr) {
+        m_itemOfShow.insert(m_currentShow, item);
         ui->title->setText(m_currentShow->title().trimmed());
 
-    } else if (!m_episodeQueue.isEmpty()) {
-        m_currentEpisode = m_episodeQueue.dequeue();
+    } else if (m_currentEpisode != nullptr) {
+        m_itemOfEpisode.insert(m_currentEpisode, item);
         ui->title->setText(m_currentEpisode->title().trimmed());
     }
+    ui->progressItem->setValue(0);
+}
 
-    const int sum = qsizetype_to_int(m_shows.count() + m_episodes.count());
-    ui->itemCounter->setText(QStringLiteral("%1/%2").arg(sum - m_showQueue.count() - m_episodeQueue.count()).arg(sum));
+void TvShowMultiScrapeDialog::onItemFinished(int item)
+{
+    TvShow* show = showOfItem(item);
+    TvShowEpisode* episode = episodeOfItem(item);
+    if (show != nullptr) {
+        m_itemOfShow.remove(show);
+        m_extraArts.remove(show);
+        disconnect(show, nullptr, this, nullptr);
+    }
+    if (episode != nullptr) {
+        m_itemOfEpisode.remove(episode);
+        disconnect(episode, nullptr, this, nullptr);
+    }
+    m_itemIds.remove(item);
+    m_downloading.remove(item);
 
-    ui->progressAll->setValue(
-        ui->progressAll->maximum() - qsizetype_to_int(m_showQueue.size() + m_episodeQueue.count()) - 1);
-    ui->progressItem->setValue(0);
+    const int finished = m_pipeline->finishedCount();
+    ui->itemCounter->setText(QStringLiteral("%1/%2").arg(finished).arg(m_pipeline->itemCount()));
+    ui->progressAll->setValue(finished);
+}
+
+void TvShowMultiScrapeDialog::searchItem(int item, int run)
+{
+    using namespace mediaelch::scraper;
+
+    const TvShowEpisode* episode = episodeOfItem(item);
+    const TvShow* show = (episode != nullptr) ? episode->tvShow() : showOfItem(item);
+    if (show == nullptr) {
+        qCCritical(generic) << "[TvShowMultiScrapeDialog] Cannot scrape item without TV show:" << item;
+        m_pipeline->finish(item, run);
+        return;
+    }
+
+    auto id = getShowIdentifierForScraper(*m_currentScraper, *show);
 
     // Check if the show/episode has an ID that suits the current scraper.
     // If not and the "only with ID" checkbox is enabled, skip this show/episode.
-    if (ui->chkOnlyId->isChecked()) {
-        const TvShow* show = m_currentShow;
-        if (show == nullptr && m_currentEpisode != nullptr) {
-            show = m_currentEpisode->tvShow();
-        }
-        if (show != nullptr) {
-            const auto id = getShowIdentifierForScraper(*m_currentScraper, *show);
-            if (id.str().isEmpty()) {
-                logToUser(tr("Skipping show \"%1\" because it does not have a valid ID."));
-                scrapeNext();
-                return;
-            }
-        }
+    if (ui->chkOnlyId->isChecked() && id.str().isEmpty()) {
+        logToUser(tr("Skipping show \"%1\" because it does not have a valid ID.").arg(show->title()));
+        m_pipeline->finish(item, run);
+        return;
     }
 
-    if (m_currentShow != nullptr) {
-        const auto id = getShowIdentifierForScraper(*m_currentScraper, *m_currentShow);
-
-        // no useful id: search first
-        if (id.str().isEmpty()) {
-            // Most scrapers do not support a year, so we remove it.
-            // Because the title may still be the filename / folder name, we also replace
-            // the dot with space.
-            // TODO: Use some common utility function for sanitization.
-            QString searchQuery = m_currentShow->title().replace(".", " ").trimmed();
-            searchQuery = ShowSearchJob::extractTitleAndYear(searchQuery).first;
-
-            logToUser(tr("Search for TV show \"%1\" because no valid ID was found.").arg(searchQuery));
-            ShowSearchJob::Config config{searchQuery, m_locale, Settings::instance()->showAdultScrapers()};
-            auto* searchJob = m_currentScraper->search(config);
-            connect(searchJob, &ShowSearchJob::searchFinished, this, &TvShowMultiScrapeDialog::onSearchFinished);
-            searchJob->start();
-
-        } else {
-            logToUser(tr("Scraping next TV show with ID \"%1\".").arg(id.str()));
-            connect(m_currentShow.data(),
-                &TvShow::sigLoaded,
-                this,
-                &TvShowMultiScrapeDialog::onInfoLoadDone,
-                Qt::UniqueConnection);
-            m_currentShow->scrapeData(m_currentScraper,
-                id,
-                m_locale,
-                m_seasonOrder,
-                TvShowUpdateType::Show,
-                m_showDetailsToLoad,
-                m_episodeDetailsToLoad);
-        }
+    const QString title = show->title();
+    if (id.str().isEmpty() && m_showIds.contains(title)) {
+        id = m_showIds.value(title);
+    }
+    if (!id.str().isEmpty()) {
+        m_itemIds.insert(item, id);
+        m_pipeline->advance(item, run);
+        return;
+    }
 
-    } else if (m_currentEpisode != nullptr) {
-        connect(m_currentEpisode.data(),
-            &TvShowEpisode::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onEpisodeLoadDone,
-            Qt::UniqueConnection);
+    // The show may already be searched for, e.g. for another episode of the same show.
+    auto runningSearch = m_runningSearches.find(title);
+    if (runningSearch != m_runningSearches.end()) {
+        runningSearch->append(item);
+        return;
+    }
+    m_runningSearches.insert(title, {item});
 
-        const QString title = m_currentEpisode->tvShow()->title();
-        auto id = getShowIdentifierForScraper(*m_currentScraper, *m_currentEpisode->tvShow());
+    // Most scrapers do not support a year, so we remove it.
+    // Because the title may still be the filename / folder name, we also replace
+    // the dot with space.
+    // TODO: Use some common utility function for sanitization.
+    QString searchQuery = QString(title).replace(".", " ").trimmed();
+    searchQuery = ShowSearchJob::extractTitleAndYear(searchQuery).first;
 
-        if (id.str().isEmpty() && m_showIds.contains(title)) {
-            id = m_showIds.value(title);
-        }
+    if (episode != nullptr) {
+        logToUser(tr("Search for TV show \"%1\" because no valid show ID was found for the episode.").arg(searchQuery));
+    } else {
+        logToUser(tr("Search for TV show \"%1\" because no valid ID was found.").arg(searchQuery));
+    }
+    ShowSearchJob::Config config{searchQuery, m_locale, Settings::instance()->showAdultScrapers()};
+    auto* searchJob = m_currentScraper->search(config);
+    searchJob->setProperty("title", title);
+    searchJob->setProperty("run", run);
+    connect(searchJob, &ShowSearchJob::searchFinished, this, &TvShowMultiScrapeDialog::onSearchFinished);
+    searchJob->start();
+}
 
-        if (id.str().isEmpty()) {
-            logToUser(tr("Search for TV show \"%1\" because no valid show ID was found for the episode.")
-                          .arg(m_currentEpisode->tvShow()->title()));
-            ShowSearchJob::Config config{
-                m_currentEpisode->tvShow()->title(), m_locale, Settings::instance()->showAdultScrapers()};
-            auto* searchJob = m_currentScraper->search(config);
-            connect(searchJob, &ShowSearchJob::searchFinished, this, &TvShowMultiScrapeDialog::onSearchFinished);
-            searchJob->start();
-
-        } else {
-            logToUser(tr("S%1E%2: Scraping next episode with show ID \"%3\".")
-                          .arg(m_currentEpisode->seasonNumber().toPaddedString(),
-                              m_currentEpisode->episodeNumber().toPaddedString(),
-                              id.str()));
-            m_currentEpisode->scrapeData(m_currentScraper, m_locale, id, m_seasonOrder, m_episodeDetailsToLoad);
-        }
+void TvShowMultiScrapeDialog::loadItem(int item)
+{
+    const auto id = m_itemIds.value(item);
 
-    } else {
-        qCCritical(generic)
-            << "[TvShowMultiScrapeDialog] Cannot scrape next! No further items to process but initial check "
-               "did not notice it!";
-        onScrapingFinished();
+    if (TvShow* show = showOfItem(item)) {
+        logToUser(tr("Scraping next TV show with ID \"%1\".").arg(id.str()));
+        connect(show, &TvShow::sigLoaded, this, &TvShowMultiScrapeDialog::onInfoLoadDone, Qt::UniqueConnection);
+        show->scrapeData(m_currentScraper,
+            id,
+            m_locale,
+            m_seasonOrder,
+            TvShowUpdateType::Show,
+            m_showDetailsToLoad,
+            m_episodeDetailsToLoad);
+
+    } else if (TvShowEpisode* episode = episodeOfItem(item)) {
+        logToUser(tr("S%1E%2: Scraping next episode with show ID \"%3\".")
+                      .arg(episode->seasonNumber().toPaddedString(),
+                          episode->episodeNumber().toPaddedString(),
+                          id.str()));
+        connect(episode,
+            &TvShowEpisode::sigLoaded,
+            this,
+            &TvShowMultiScrapeDialog::onEpisodeLoadDone,
+            Qt::UniqueConnection);
+        episode->scrapeData(m_currentScraper, m_locale, id, m_seasonOrder, m_episodeDetailsToLoad);
     }
 }
 
-void TvShowMultiScrapeDialog::saveCurrentItem()
+void TvShowMultiScrapeDialog::downloadImages(int item, int run)
 {
-    if (!ui->chkAutoSave->isChecked()) {
+    if (TvShow* show = showOfItem(item)) {
+        downloadShowImages(item, run, show);
         return;
     }
 
-    if (m_currentShow != nullptr) {
-        m_currentShow->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
+    TvShowEpisode* episode = episodeOfItem(item);
+    if (episode != nullptr && m_episodeDetailsToLoad.contains(EpisodeScraperInfo::Thumbnail)
+        && !episode->thumbnail().isEmpty()) {
+        m_downloading.insert(item);
+        addDownload(ImageType::TvShowEpisodeThumb, episode->thumbnail(), episode);
+    } else {
+        m_pipeline->advance(item, run);
     }
+}
 
-    if (m_currentEpisode != nullptr) {
-        m_currentEpisode->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
+void TvShowMultiScrapeDialog::finishDownloads(int item)
+{
+    // Downloads of aborted runs are aborted as well, see reject().
+    if (m_downloading.remove(item)) {
+        m_pipeline->advance(item, m_pipeline->run());
     }
 }
 
+void TvShowMultiScrapeDialog::saveItem(int item, int run)
+{
+    if (ui->chkAutoSave->isChecked()) {
+        if (TvShow* show = showOfItem(item)) {
+            show->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
+        } else if (TvShowEpisode* episode = episodeOfItem(item)) {
+            episode->saveData(Manager::instance()->mediaCenterInterfaceTvShow());
+        }
+    }
+    m_pipeline->advance(item, run);
+}
+
 TvShowUpdateType TvShowMultiScrapeDialog::updateType() const
 {
     // Create "fake" update type because the type is based on whether a show was selected or not.
@@ -459,50 +525,34 @@ void TvShowMultiScrapeDialog::onSearchFinished(scraper::ShowSearchJob* searchJob
 {
     searchJob->deleteLater();
 
+    const int run = searchJob->property("run").toInt();
+    if (run != m_pipeline->run()) {
+        // The search's items were aborted.  Items of the current run wait for their own search.
+        return;
+    }
+    const QString title = searchJob->property("title").toString();
+    const QVector<int> items = m_runningSearches.take(title);
+
     if (searchJob->hasError()) {
         logToUser(tr("Error while searching for TV show: \"%1\"").arg(searchJob->scraperError().message));
-        scrapeNext();
+        for (int item : items) {
+            m_pipeline->finish(item, run);
+        }
         return;
     }
     if (searchJob->results().isEmpty()) {
         logToUser(tr("Did not find any results for search term \"%1\".").arg(searchJob->config().query));
-        scrapeNext();
+        for (int item : items) {
+            m_pipeline->finish(item, run);
+        }
         return;
     }
 
     const auto id = searchJob->results().first().identifier;
-    if (m_currentShow != nullptr) {
-        logToUser(tr("Scraping next TV show with ID \"%1\".").arg(id.str()));
-        m_showIds.insert(m_currentShow->title(), id);
-
-        // TODO: deduplicate code with scrapeNext()
-        connect(m_currentShow.data(),
-            &TvShow::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onInfoLoadDone,
-            Qt::UniqueConnection);
-        m_currentShow->scrapeData(m_currentScraper,
-            id,
-            m_locale,
-            m_seasonOrder,
-            TvShowUpdateType::Show,
-            m_showDetailsToLoad,
-            m_episodeDetailsToLoad);
-
-    } else if (m_currentEpisode != nullptr) {
-        logToUser(tr("S%1E%2: Scraping next episode with show ID \"%3\".")
-                      .arg(m_currentEpisode->seasonNumber().toPaddedString(),
-                          m_currentEpisode->episodeNumber().toPaddedString(),
-                          id.str()));
-        m_showIds.insert(m_currentEpisode->tvShow()->title(), id);
-
-        // TODO: deduplicate code with scrapeNext()
-        connect(m_currentEpisode.data(),
-            &TvShowEpisode::sigLoaded,
-            this,
-            &TvShowMultiScrapeDialog::onEpisodeLoadDone,
-            Qt::UniqueConnection);
-        m_currentEpisode->scrapeData(m_currentScraper, m_locale, id, m_seasonOrder, m_episodeDetailsToLoad);
+    m_showIds.insert(title, id);
+    for (int item : items) {
+        m_itemIds.insert(item, id);
+        m_pipeline->advance(item, run);
     }
 }
 
@@ -546,10 +596,8 @@ void TvShowMultiScrapeDialog::onScrapingFinished()
 
 void TvShowMultiScrapeDialog::onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo> details)
 {
-    Q_UNUSED(details);
-
-    if (show != m_currentShow) {
-        qCCritical(generic) << "[TvShowMultiScrapeDialog] TV show has changed mid-scrape-process!";
+    if (!m_itemOfShow.contains(show)) {
+        qCCritical(generic) << "[TvShowMultiScrapeDialog] Loaded TV show that is not scraped!";
         return;
     }
 
@@ -583,10 +631,18 @@ void TvShowMultiScrapeDialog::onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo>
 
 void TvShowMultiScrapeDialog::onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster>> posters)
 {
-    if (show != m_currentShow) {
-        qCCritical(generic) << "[TvShowMultiScrapeDialog] TV show has changed mid-scrape-process!";
+    // fanart.tv's images may also be requested by other widgets.
+    const int item = m_itemOfShow.value(show, -1);
+    if (!m_pipeline->isProcessing(item, mediaelch::scraper::ScrapePipeline::Stage::Load)) {
         return;
     }
+    m_extraArts.insert(show, posters);
+    m_pipeline->advance(item, m_pipeline->run());
+}
+
+void TvShowMultiScrapeDialog::downloadShowImages(int item, int run, TvShow* show)
+{
+    const QMap<ImageType, QVector<Poster>> posters = m_extraArts.take(show);
 
     int downloadsSize = 0;
     if (!show->posters().isEmpty() && m_showDetailsToLoad.contains(ShowScraperInfo::Poster)) {
@@ -667,9 +723,12 @@ void TvShowMultiScrapeDialog::onLoadDone(TvShow* show, QMap<ImageType, QVector<P
     }
 
     if (downloadsSize > 0) {
-        ui->progressItem->setMaximum(downloadsSize);
+        m_downloading.insert(item);
+        if (show == m_currentShow) {
+            ui->progressItem->setMaximum(downloadsSize);
+        }
     } else {
-        scrapeNext();
+        m_pipeline->advance(item, run);
     }
 }
 
@@ -706,9 +765,11 @@ void TvShowMultiScrapeDialog::addDownload(ImageType imageType, QUrl url, TvShowE
 void TvShowMultiScrapeDialog::onDownloadFinished(DownloadManagerElement elem)
 {
     if (elem.show != nullptr) {
-        int left = m_downloadManager->downloadsLeftForShow(m_currentShow);
-        ui->progressItem->setValue(ui->progressItem->maximum() - left);
-        qCDebug(generic) << "Download finished" << left << ui->progressItem->maximum();
+        if (elem.show == m_currentShow) {
+            int left = m_downloadManager->downloadsLeftForShow(m_currentShow);
+            ui->progressItem->setValue(ui->progressItem->maximum() - left);
+            qCDebug(generic) << "Download finished" << left << ui->progressItem->maximum();
+        }
 
         if (TvShow::seasonImageTypes().contains(elem.imageType)) {
             if (elem.imageType == ImageType::TvShowSeasonBackdrop) {
@@ -727,7 +788,29 @@ void TvShowMultiScrapeDialog::onDownloadFinished(DownloadManagerElement elem)
         }
     } else if ((elem.episode != nullptr) && elem.imageType == ImageType::TvShowEpisodeThumb) {
         elem.episode->setThumbnailImage(elem.data);
-        // scrapeNext();
+        if (m_itemOfEpisode.contains(elem.episode)) {
+            finishDownloads(m_itemOfEpisode.value(elem.episode));
+        }
+    }
+}
+
+void TvShowMultiScrapeDialog::onShowDownloadsFinished(TvShow* show)
+{
+    if (m_itemOfShow.contains(show)) {
+        finishDownloads(m_itemOfShow.value(show));
+    }
+}
+
+void TvShowMultiScrapeDialog::onAllDownloadsFinished()
+{
+    // Downloads that were given up on don't report that they have finished.
+    // Don't let their items wait forever.
+    if (m_downloadManager->isDownloading()) {
+        return;
+    }
+    const auto items = m_downloading.values();
+    for (int item : items) {
+        finishDownloads(item);
     }
 }
 
@@ -845,14 +928,16 @@ void TvShowMultiScrapeDialog::onEpisodeLoadDone()
         return;
     }
 
+    const int item = m_itemOfEpisode.value(episode, -1);
+    if (!m_pipeline->isProcessing(item, mediaelch::scraper::ScrapePipeline::Stage::Load)) {
+        return;
+    }
+
     logToUser(tr("S%2E%3: Finished scraping episode details. Title is: \"%1\".")
                   .arg(episode->title(),
-                      m_currentEpisode->seasonNumber().toPaddedString(),
-                      m_currentEpisode->episodeNumber().toPaddedString()));
+                      episode->seasonNumber().toPaddedString(),
+                      episode->episodeNumber().toPaddedString()));
 
-    if (m_episodeDetailsToLoad.contains(EpisodeScraperInfo::Thumbnail) && !episode->thumbnail().isEmpty()) {
-        addDownload(ImageType::TvShowEpisodeThumb, episode->thumbnail(), episode);
-    } else {
-        scrapeNext();
-    }
+    // Episodes' signals are only connected while they are scraped in the current run, see reject().
+    m_pipeline->advance(item, m_pipeline->run());
 }
@@ -6,13 +6,19 @@
 #include "scrapers/tv_show/TvScraper.h"
 
 #include <QDialog>
+#include <QHash>
 #include <QPointer>
-#include <QQueue>
 
 namespace Ui {
 class TvShowMultiScrapeDialog;
 }
 
+namespace mediaelch {
+namespace scraper {
+class ScrapePipeline;
+}
+} // namespace mediaelch
+
 /// \brief Dialog for scraping multiple episodes or TV shows.
 /// \details Create a dialog which scrapes either the given shows (and episodes) or just the episodes.
 ///          exec() must only be called once. Create a fresh dialog after scraping shows.
@@ -40,11 +46,14 @@ private slots:
     void onStartScraping();
     void onScrapingFinished();
     void onSearchFinished(mediaelch::scraper::ShowSearchJob* searchJob);
-    void scrapeNext();
+    void onItemStarted(int item);
+    void onItemFinished(int item);
     void onInfoLoadDone(TvShow* show, QSet<ShowScraperInfo> details);
     void onEpisodeLoadDone();
     void onLoadDone(TvShow* show, QMap<ImageType, QVector<Poster>> posters);
     void onDownloadFinished(DownloadManagerElement elem);
+    void onShowDownloadsFinished(TvShow* show);
+    void onAllDownloadsFinished();
 
     void onScraperChanged(int index);
     void onLanguageChanged();
@@ -57,8 +66,19 @@ private:
     SeasonOrder m_seasonOrder = SeasonOrder::Aired;
     QSet<ShowScraperInfo> m_showDetailsToLoad;
     QSet<EpisodeScraperInfo> m_episodeDetailsToLoad;
-    QQueue<TvShow*> m_showQueue;
-    QQueue<TvShowEpisode*> m_episodeQueue;
+    /// \brief Shows are items [0, m_shows.size()), episodes follow.
+    mediaelch::scraper::ScrapePipeline* m_pipeline = nullptr;
+    QHash<TvShow*, int> m_itemOfShow;
+    QHash<TvShowEpisode*, int> m_itemOfEpisode;
+    QHash<int, mediaelch::scraper::ShowIdentifier> m_itemIds;
+    /// \brief Items waiting for the search of their show's title.  Shows and their
+    ///        episodes are scraped at the same time but the show is searched only once.
+    QHash<QString, QVector<int>> m_runningSearches;
+    /// \brief Images from fanart.tv, downloaded along with the show's images.
+    QHash<TvShow*, QMap<ImageType, QVector<Poster>>> m_extraArts;
+    /// \brief Items whose images are currently downloaded.
+    QSet<int> m_downloading;
+    /// \brief The most recently started show or episode, whose title and progress are shown.
     QPointer<TvShow> m_currentShow = nullptr;
     QPointer<TvShowEpisode> m_currentEpisode = nullptr;
     mediaelch::scraper::TvScraper* m_currentScraper = nullptr;
@@ -71,7 +91,15 @@ private:
     void setupScraperDropdown();
     void setupSeasonOrderComboBox();
     void updateCheckBoxes();
-    void saveCurrentItem();
+
+    TvShow* showOfItem(int item) const;
+    TvShowEpisode* episodeOfItem(int item) const;
+    void searchItem(int item, int run);
+    void loadItem(int item);
+    void downloadImages(int item, int run);
+    void downloadShowImages(int item, int run, TvShow* show);
+    void finishDownloads(int item);
+    void saveItem(int item, int run);
 
     TvShowUpdateType updateType() const;
 
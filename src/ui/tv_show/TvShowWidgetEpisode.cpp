@@ -332,16 +332,18 @@ void TvShowWidgetEpisode::setEpisode(TvShowEpisode* episode)
 {
     qCDebug(generic) << "Entered, episode=" << episode->title();
     m_episode = episode;
-    if (!episode->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails() && !episode->isDummy()) {
-        // Loading stream details als marks the episode as changed...
-        // TODO: Refactor the "hasChanged" stuff...
-        const bool prevState = episode->hasChanged();
-        Q_UNUSED(episode->loadStreamDetailsFromFile());
-        episode->setChanged(prevState);
-    }
     ui->missingLabel->setVisible(episode->isDummy());
     updateEpisodeInfo();
 
+    if (!episode->streamDetailsLoaded() && Settings::instance()->autoLoadStreamDetails() && !episode->isDummy()) {
+        connect(episode,
+            &TvShowEpisode::sigStreamDetailsLoaded,
+            this,
+            &TvShowWidgetEpisode::onStreamDetailsLoaded,
+            Qt::UniqueConnection);
+        episode->loadStreamDetailsInBackground();
+    }
+
     emit sigSetActionSearchEnabled(!episode->isDummy(), MainWidgets::TvShows);
     emit sigSetActionSaveEnabled(!episode->isDummy(), MainWidgets::TvShows);
 }
@@ -583,7 +585,7 @@ void TvShowWidgetEpisode::updateStreamDetails(bool reloadedFromFile)
 
 void TvShowWidgetEpisode::onReloadStreamDetails()
 {
-    const bool success = m_episode->loadStreamDetailsFromFile();
+    const bool success = m_episode->loadStreamDetailsFromFile(true);
     ui->lblReloadStreamDetailsError->setVisible(!success);
     if (success) {
         ui->lblReloadStreamDetailsError->clear();
@@ -704,6 +706,24 @@ void TvShowWidgetEpisode::onLoadDone()
     ui->buttonRevert->setVisible(true);
 }
 
+/// \brief Updates the stream details once they were loaded in the background.
+void TvShowWidgetEpisode::onStreamDetailsLoaded(TvShowEpisode* episode, bool success)
+{
+    if (m_episode != episode) {
+        return;
+    }
+    if (success) {
+        updateStreamDetails(true);
+    }
+    ui->videoAspectRatio->setEnabled(m_episode->streamDetailsLoaded());
+    ui->videoCodec->setEnabled(m_episode->streamDetailsLoaded());
+    ui->videoDuration->setEnabled(m_episode->streamDetailsLoaded());
+    ui->videoHeight->setEnabled(m_episode->streamDetailsLoaded());
+    ui->videoWidth->setEnabled(m_episode->streamDetailsLoaded());
+    ui->videoScantype->setEnabled(m_episode->streamDetailsLoaded());
+    ui->stereoMode->setEnabled(m_episode->streamDetailsLoaded());
+}
+
 /**
  * \brief Shows the MovieImageDialog and after successful execution starts downloads
  */
@@ -45,6 +45,7 @@ private slots:
     void onImageDropped(ImageType imageType, QUrl imageUrl);
     void onPosterDownloadFinished(DownloadManagerElement elem);
     void onLoadDone();
+    void onStreamDetailsLoaded(TvShowEpisode* episode, bool success);
     void onRevertChanges();
     void onCaptureImage(ImageType type);
 
@@ -0,0 +1,77 @@
+#include "test/test_helpers.h"
+
+#include "file_search/TvShowFileSearcher.h"
+#include "media/NameFormatter.h"
+
+#include <QRegularExpression>
+#include <QStringList>
+
+static const QStringList s_episodeFiles = {
+    "Breaking.Bad.S01E01.720p.BluRay.x264.mkv",
+    "Doctor Who (2005) - 5x01 - The Eleventh Hour.avi",
+    "The.Simpsons.S12E03E04.German.DL.1080p.WEB.h264.mkv",
+    "Firefly - Season 1 - Episode 02 - The Train Job.mp4",
+    "Chernobyl.E03.Open.Wide.O.Earth.2019.2160p.mkv",
+    "Stargate Universe - Season 2/stargate.universe.201.hdtv.mkv",
+    "Sherlock - S02E01-E03 - A Scandal in Belgravia.mkv",
+    "Game of Thrones/Season 08/Game.of.Thrones.S08E06.Part.1.mkv",
+};
+
+static const QStringList s_movieNames = {
+    "The.Matrix.1999.1080p.BluRay.x264-GROUP",
+    "Alien [1979] Directors Cut (DVD)",
+    "Der_Herr_der_Ringe_-_Die_Gefaehrten_-_Extended",
+    "Inception.2010.German.DL.AC3.720p.BluRay.x264",
+    "Blade Runner 2049 (2017) [2160p] [HDR] - ",
+};
+
+TEST_CASE("Filename parsing", "[benchmark][filename]")
+{
+    BENCHMARK("TvShowFileSearcher::getSeasonNumber")
+    {
+        int sum = 0;
+        for (const QString& file : s_episodeFiles) {
+            sum += TvShowFileSearcher::getSeasonNumber({file}).toInt();
+        }
+        return sum;
+    };
+
+    BENCHMARK("TvShowFileSearcher::getEpisodeNumbers")
+    {
+        int count = 0;
+        for (const QString& file : s_episodeFiles) {
+            count += TvShowFileSearcher::getEpisodeNumbers({file}).size();
+        }
+        return count;
+    };
+
+    BENCHMARK("NameFormatter::formatName")
+    {
+        int length = 0;
+        for (const QString& name : s_movieNames) {
+            length += NameFormatter::formatName(name).length();
+        }
+        return length;
+    };
+
+    // Baseline: Costs of compiling a pattern for each call, which the parsers above avoid.
+    BENCHMARK("QRegularExpression compiled per call")
+    {
+        int count = 0;
+        for (const QString& file : s_episodeFiles) {
+            QRegularExpression rx("S(\\d+)[\\._\\-]?E(\\d+)", QRegularExpression::CaseInsensitiveOption);
+            count += rx.match(file).hasMatch() ? 1 : 0;
+        }
+        return count;
+    };
+
+    BENCHMARK("QRegularExpression compiled once")
+    {
+        static const QRegularExpression rx("S(\\d+)[\\._\\-]?E(\\d+)", QRegularExpression::CaseInsensitiveOption);
+        int count = 0;
+        for (const QString& file : s_episodeFiles) {
+            count += rx.match(file).hasMatch() ? 1 : 0;
+        }
+        return count;
+    };
+}
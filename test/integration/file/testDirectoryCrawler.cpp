@@ -0,0 +1,93 @@
+#include "test/test_helpers.h"
+
+#include "file_search/DirectoryCrawler.h"
+
+#include "test/helpers/resource_dir.h"
+
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+
+using namespace mediaelch;
+
+static void createFile(const QDir& dir, const QString& filePath)
+{
+    const QFileInfo info(dir.filePath(filePath));
+    QDir().mkpath(info.path());
+    QFile file(info.filePath());
+    REQUIRE(file.open(QIODevice::WriteOnly));
+    file.close();
+}
+
+TEST_CASE("DirectoryCrawler", "[file_search]")
+{
+    QDir root = test::makeTempDir("file_search/crawler");
+    createFile(root, "root.mkv");
+    createFile(root, "Movie A/movie-a.mkv");
+    createFile(root, "Movie A/movie-a.nfo");
+    createFile(root, "Movie B/movie-b.avi");
+    createFile(root, "Movie B/extras/extra.mkv");
+    createFile(root, "Movie C/Sub 1/Sub 2/movie-c.mkv");
+
+    QMutex mutex;
+    QMap<QString, QStringList> files;
+    QMap<QString, QStringList> otherFiles;
+    QMap<QString, int> depths;
+    const auto collect = [&](const DirectoryListing& listing) {
+        const QString relative = listing.depth == 0 ? "." : root.relativeFilePath(listing.path);
+        QMutexLocker locker(&mutex);
+        depths.insert(relative, listing.depth);
+        for (const QFileInfo& file : listing.files) {
+            files[relative].append(file.fileName());
+        }
+        for (const QFileInfo& file : listing.otherFiles) {
+            otherFiles[relative].append(file.fileName());
+        }
+    };
+
+    SECTION("all directories are listed")
+    {
+        DirectoryCrawler crawler(QStringList{"*.mkv", "*.avi"});
+        crawler.crawl(root.path(), collect);
+
+        CHECK(depths.value(".") == 0);
+        CHECK(depths.value("Movie A") == 1);
+        CHECK(depths.value("Movie B/extras") == 2);
+        CHECK(depths.value("Movie C/Sub 1/Sub 2") == 3);
+
+        CHECK(files.value(".") == QStringList{"root.mkv"});
+        CHECK(files.value("Movie A") == QStringList{"movie-a.mkv"});
+        CHECK(files.value("Movie B") == QStringList{"movie-b.avi"});
+        CHECK(files.value("Movie B/extras") == QStringList{"extra.mkv"});
+        CHECK(files.value("Movie C/Sub 1/Sub 2") == QStringList{"movie-c.mkv"});
+
+        CHECK(otherFiles.value("Movie A") == QStringList{"movie-a.nfo"});
+        CHECK_FALSE(otherFiles.contains("Movie B"));
+    }
+
+    SECTION("descend filter skips directories")
+    {
+        DirectoryCrawler crawler(QStringList{"*.mkv"}, QDir::NoFilter, 1);
+        crawler.setDescendFilter([](const QFileInfo& dir, int depth) {
+            return dir.fileName() != "extras" && depth < 1;
+        });
+        crawler.crawl(root.path(), collect);
+
+        CHECK(depths.contains("Movie B"));
+        CHECK_FALSE(depths.contains("Movie B/extras"));
+        CHECK_FALSE(depths.contains("Movie C/Sub 1"));
+    }
+
+    SECTION("abort stops crawling")
+    {
+        DirectoryCrawler crawler;
+        int count = 0;
+        crawler.crawl(root.path(), [&](const DirectoryListing&) {
+            QMutexLocker locker(&mutex);
+            ++count;
+            crawler.abort();
+        });
+        CHECK(crawler.isAborted());
+        CHECK(count < 7);
+    }
+}
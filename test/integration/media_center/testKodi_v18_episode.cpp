@@ -7,7 +7,7 @@
 #include "test/helpers/resource_dir.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -25,9 +25,11 @@ static void createAndCompareSingleEpisode(const QString& filename, Callback call
     TvShowEpisode episode;
 
     mediaelch::kodi::EpisodeXmlReader reader(episode);
-    QDomDocument doc;
-    doc.setContent(test::readResourceFile(filename));
-    reader.parseNfoDom(doc.elementsByTagName("episodedetails").at(0).toElement());
+    QXmlStreamReader xml(test::readResourceFile(filename));
+    REQUIRE(xml.readNextStartElement()); // <episodes>
+    REQUIRE(xml.readNextStartElement()); // <episodedetails>
+    reader.parse(xml);
+    CHECK_FALSE(xml.hasError());
 
     mediaelch::kodi::EpisodeXmlWriterGeneric writer(mediaelch::KodiVersion(18), {&episode});
     const QString actual = writer.getEpisodeXmlWithSingleRoot(true).trimmed();
@@ -44,17 +46,21 @@ static void createAndCompareMultiEpisode(const QString& filename, Callback callb
     std::vector<std::unique_ptr<TvShowEpisode>> episodes;
     QVector<TvShowEpisode*> episodesPointer;
 
-    QDomDocument doc;
-    doc.setContent(test::readResourceFile(filename));
-    QDomNodeList detailTags = doc.elementsByTagName("episodedetails");
+    QXmlStreamReader xml(test::readResourceFile(filename));
+    REQUIRE(xml.readNextStartElement()); // <episodes>
 
-    for (int i = 0; i < detailTags.size(); ++i) {
+    while (xml.readNextStartElement()) {
+        if (xml.name() != QLatin1String("episodedetails")) {
+            xml.skipCurrentElement();
+            continue;
+        }
         episodes.push_back(std::make_unique<TvShowEpisode>());
         episodesPointer.push_back(episodes.back().get());
 
         mediaelch::kodi::EpisodeXmlReader reader(*episodesPointer.last());
-        reader.parseNfoDom(detailTags.at(i).toElement());
+        reader.parse(xml);
     }
+    CHECK_FALSE(xml.hasError());
 
     callback(episodesPointer);
 
@@ -102,9 +108,10 @@ TEST_CASE("Episode XML writer for Kodi v18", "[data][tvshow][kodi][nfo]")
 
         EpisodeXmlReader reader(episode);
 
-        QDomDocument doc;
-        doc.setContent(test::readResourceFile(filename));
-        reader.parseNfoDom(doc.elementsByTagName("episodedetails").at(0).toElement());
+        QXmlStreamReader xml(test::readResourceFile(filename));
+        REQUIRE(xml.readNextStartElement()); // <episodes>
+        REQUIRE(xml.readNextStartElement()); // <episodedetails>
+        reader.parse(xml);
 
         mediaelch::kodi::EpisodeXmlWriterGeneric writer(mediaelch::KodiVersion(18), {&episode});
         QString actual = writer.getEpisodeXmlWithSingleRoot(true).trimmed();
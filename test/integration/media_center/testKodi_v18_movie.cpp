@@ -6,7 +6,7 @@
 #include "test/helpers/resource_dir.h"
 
 #include <QDateTime>
-#include <QDomDocument>
+#include <QXmlStreamReader>
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -22,9 +22,9 @@ static void createAndCompareMovie(const QString& filename, Callback callback)
     Movie movie;
 
     mediaelch::kodi::MovieXmlReader reader(movie);
-    QDomDocument doc;
-    doc.setContent(test::readResourceFile(filename));
-    reader.parseNfoDom(doc);
+    QXmlStreamReader xml(test::readResourceFile(filename));
+    reader.parse(xml);
+    CHECK_FALSE(xml.hasError());
 
     mediaelch::kodi::MovieXmlWriterGeneric writer(mediaelch::KodiVersion(18), movie);
     QString actual = writer.getMovieXml(true).trimmed();
@@ -0,0 +1,63 @@
+#include "test/test_helpers.h"
+
+#include "export/ImageExporter.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+TEST_CASE("ImageExporter", "[export]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    std::atomic_bool canceled{false};
+
+    const QString source = dir.filePath("poster.png");
+    QImage sourceImage(400, 600, QImage::Format_RGB32);
+    sourceImage.fill(Qt::red);
+    REQUIRE(sourceImage.save(source));
+    const qint64 sourceLastModified = QFileInfo(source).lastModified().toMSecsSinceEpoch() / 1000;
+
+    {
+        ImageExporter exporter(dir.path(), canceled);
+        exporter.add({{source, "1-poster_200x300.png", QSize(200, 300)},
+            {source, "1-poster_100x100.png", QSize(100, 100)},
+            {source, "1-poster_200x300.png", QSize(200, 300)}});
+        exporter.waitForDone();
+        CHECK(exporter.isDone());
+    }
+
+    CHECK(QImage(dir.filePath("1-poster_200x300.png")).size() == QSize(200, 300));
+    CHECK(QImage(dir.filePath("1-poster_100x100.png")).size() == QSize(66, 100));
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    SECTION("destinations have the modification time of their source")
+    {
+        const QFileInfo destination(dir.filePath("1-poster_200x300.png"));
+        CHECK(destination.lastModified().toMSecsSinceEpoch() / 1000 == sourceLastModified);
+    }
+
+    SECTION("skips images that are up to date")
+    {
+        // Replace the exported image, but keep its modification time.
+        const QString destination = dir.filePath("1-poster_200x300.png");
+        REQUIRE(QImage(1, 1, QImage::Format_RGB32).save(destination));
+        {
+            QFile file(destination);
+            REQUIRE(file.open(QFile::Append));
+            REQUIRE(file.setFileTime(QFileInfo(source).lastModified(), QFileDevice::FileModificationTime));
+        }
+
+        ImageExporter exporter(dir.path(), canceled);
+        exporter.add({{source, "1-poster_200x300.png", QSize(200, 300)}});
+        exporter.waitForDone();
+        CHECK(QImage(destination).size() == QSize(1, 1));
+    }
+#else
+    Q_UNUSED(sourceLastModified)
+#endif
+}
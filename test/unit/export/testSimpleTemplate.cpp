@@ -0,0 +1,106 @@
+#include "test/test_helpers.h"
+
+#include "export/SimpleTemplate.h"
+
+using namespace mediaelch;
+
+namespace {
+
+TemplateData movieWithGenres(const QString& title, const QStringList& genres)
+{
+    TemplateData data;
+    data.variables.insert("MOVIE.TITLE", title);
+    data.addList("GENRES", "GENRE.NAME", genres);
+    return data;
+}
+
+} // namespace
+
+TEST_CASE("SimpleTemplate renders variables", "[export]")
+{
+    SECTION("replaces all occurrences")
+    {
+        SimpleTemplate tpl("<h1>{{ MOVIE.TITLE }}</h1><title>{{ MOVIE.TITLE }}</title>");
+        CHECK(tpl.render(movieWithGenres("Alien", {}), false) == "<h1>Alien</h1><title>Alien</title>");
+    }
+
+    SECTION("keeps unknown tokens")
+    {
+        SimpleTemplate tpl("{{ MOVIE.TITLE }} {{ MOVIE.UNKNOWN }} {{ broken");
+        CHECK(tpl.render(movieWithGenres("Alien", {}), false) == "Alien {{ MOVIE.UNKNOWN }} {{ broken");
+    }
+
+    SECTION("values are not parsed again")
+    {
+        SimpleTemplate tpl("{{ MOVIE.TITLE }}");
+        CHECK(tpl.render(movieWithGenres("{{ MOVIE.TITLE }}", {}), false) == "{{ MOVIE.TITLE }}");
+    }
+}
+
+TEST_CASE("SimpleTemplate renders blocks", "[export]")
+{
+    SECTION("trims the block and joins items with its separator")
+    {
+        SimpleTemplate tpl("Genres: {{ BEGIN_BLOCK_GENRES }}\n  <b>{{ GENRE.NAME }}</b>\n{{ END_BLOCK_GENRES }}!");
+        CHECK(tpl.render(movieWithGenres("Alien", {"Horror", "Sci-Fi & Fantasy"}), false)
+              == "Genres: <b>Horror</b> <b>Sci-Fi &amp; Fantasy</b>!");
+        CHECK(tpl.render(movieWithGenres("Alien", {}), false) == "Genres: !");
+    }
+
+    SECTION("looks up values of the enclosing item")
+    {
+        SimpleTemplate tpl("{{ BEGIN_BLOCK_GENRES }}{{ MOVIE.TITLE }}: {{ GENRE.NAME }}{{ END_BLOCK_GENRES }}");
+        CHECK(tpl.render(movieWithGenres("Alien", {"Horror", "Sci-Fi"}), false) == "Alien: Horror Alien: Sci-Fi");
+    }
+
+    SECTION("uses pre-rendered items")
+    {
+        SimpleTemplate tpl("<ul>{{ BEGIN_BLOCK_MOVIE }}<li>{{ MOVIE.TITLE }}</li>{{ END_BLOCK_MOVIE }}</ul>");
+        TemplateBlock block;
+        block.rendered = QStringList{"<li>Alien</li>", "<li>Heat</li>"};
+        block.separator = "\n";
+        TemplateData data;
+        data.blocks.insert("MOVIE", block);
+        CHECK(tpl.render(data, false) == "<ul><li>Alien</li>\n<li>Heat</li></ul>");
+        CHECK(tpl.block("MOVIE").render(movieWithGenres("Alien", {}), false) == "<li>Alien</li>");
+    }
+
+    SECTION("keeps unknown and unclosed blocks")
+    {
+        SimpleTemplate tpl(
+            "{{ BEGIN_BLOCK_ACTORS }} {{ MOVIE.TITLE }} {{ END_BLOCK_ACTORS }} {{ BEGIN_BLOCK_GENRES }}");
+        CHECK(tpl.render(movieWithGenres("Alien", {"Horror"}), false)
+              == "{{ BEGIN_BLOCK_ACTORS }} Alien {{ END_BLOCK_ACTORS }} {{ BEGIN_BLOCK_GENRES }}");
+        CHECK(tpl.hasBlock("ACTORS"));
+        CHECK_FALSE(tpl.hasBlock("GENRES"));
+    }
+}
+
+TEST_CASE("SimpleTemplate renders images", "[export]")
+{
+    SimpleTemplate tpl("<img src=\"{{ IMAGE.Poster[200, 300] }}\"> <img src=\"{{ IMAGE.fanart[400,200] }}\">");
+    CHECK(tpl.imageTypes() == QSet<QString>{"poster", "fanart"});
+
+    TemplateData data;
+    data.images.insert("poster", TemplateImage{"/media/poster.jpg", "movie_images/1-", "jpg", "movie"});
+    data.images.insert("fanart", TemplateImage{"", "movie_images/1-", "jpg", "movie"});
+
+    SECTION("uses the theme's default image if there is no image")
+    {
+        QVector<ExportImage> images;
+        CHECK(tpl.render(data, true, &images)
+              == "<img src=\"../movie_images/1-poster_200x300.jpg\"> "
+                 "<img src=\"../defaults/movie_fanart_400x200.png\">");
+        REQUIRE(images.size() == 1);
+        CHECK(images[0].source == "/media/poster.jpg");
+        CHECK(images[0].destination == "movie_images/1-poster_200x300.jpg");
+        CHECK(images[0].size == QSize(200, 300));
+    }
+
+    SECTION("keeps unsupported image types")
+    {
+        data.images.remove("fanart");
+        CHECK(tpl.render(data, false)
+              == "<img src=\"movie_images/1-poster_200x300.jpg\"> <img src=\"{{ IMAGE.fanart[400,200] }}\">");
+    }
+}
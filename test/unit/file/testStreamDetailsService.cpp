@@ -0,0 +1,137 @@
+#include "test/test_helpers.h"
+
+#include "database/Database.h"
+#include "media/StreamDetailsService.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+
+#include <memory>
+
+using namespace mediaelch;
+
+namespace {
+
+StreamDetails::Details exampleDetails()
+{
+    StreamDetails::Details details;
+    details.video.insert(StreamDetails::VideoDetails::Codec, "h264");
+    details.video.insert(StreamDetails::VideoDetails::Width, "1920");
+    details.video.insert(StreamDetails::VideoDetails::DurationInSeconds, "5400");
+    details.audio.push_back({{StreamDetails::AudioDetails::Language, "eng"},
+        {StreamDetails::AudioDetails::Codec, "dtshd_ma"},
+        {StreamDetails::AudioDetails::Channels, "6"}});
+    details.audio.push_back({{StreamDetails::AudioDetails::Language, "deu"},
+        {StreamDetails::AudioDetails::Codec, "ac3"},
+        {StreamDetails::AudioDetails::Channels, "2"}});
+    details.subtitles.push_back({{StreamDetails::SubtitleDetails::Language, "fra"}});
+    return details;
+}
+
+} // namespace
+
+TEST_CASE("StreamDetailsService serializes stream details", "[media][streamdetails]")
+{
+    const StreamDetails::Details details = exampleDetails();
+
+    SECTION("round trip")
+    {
+        StreamDetails::Details read;
+        REQUIRE(StreamDetailsService::deserialize(StreamDetailsService::serialize(details), read));
+        CHECK(read.video == details.video);
+        CHECK(read.audio == details.audio);
+        CHECK(read.subtitles == details.subtitles);
+    }
+
+    SECTION("invalid data is rejected")
+    {
+        StreamDetails::Details read;
+        CHECK_FALSE(StreamDetailsService::deserialize(QByteArray{}, read));
+        CHECK_FALSE(StreamDetailsService::deserialize(QByteArray("\x7f", 1), read));
+        CHECK_FALSE(StreamDetailsService::deserialize(StreamDetailsService::serialize(details).left(8), read));
+    }
+}
+
+TEST_CASE("StreamDetailsService caches stream details by path, size and modification time", "[media][streamdetails]")
+{
+    // Don't touch the user's database.
+    QStandardPaths::setTestModeEnabled(true);
+
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("movie.mkv");
+    {
+        QFile file(path);
+        REQUIRE(file.open(QIODevice::WriteOnly));
+        file.write("not a video");
+    }
+    const FileList files{FilePath(path)};
+    const QFileInfo fileInfo(path);
+    const qint64 size = fileInfo.size();
+    const qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    std::unique_ptr<Database> database(Database::newConnection(nullptr));
+    database->setCachedStreamDetails(path, size, lastModified, StreamDetailsService::serialize(exampleDetails()));
+    REQUIRE_FALSE(database->cachedStreamDetails(path, size, lastModified).isEmpty());
+
+    StreamDetailsService service;
+    StreamDetails::Details details;
+    // The file is no video, so probing it must not result in the cached stream details.
+    const auto isCached = [&details]() { return details.video == exampleDetails().video; };
+
+    SECTION("cached stream details are used if the file did not change")
+    {
+        REQUIRE(service.loadNow(files, details));
+        CHECK(isCached());
+        CHECK(details.audio == exampleDetails().audio);
+    }
+
+    SECTION("cached stream details are ignored if the size changed")
+    {
+        {
+            QFile file(path);
+            REQUIRE(file.open(QIODevice::Append));
+            file.write(" anymore");
+        }
+        const bool success = service.loadNow(files, details);
+        CHECK((!success || !isCached()));
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    SECTION("cached stream details are ignored if the modification time changed")
+    {
+        {
+            QFile file(path);
+            REQUIRE(file.open(QIODevice::Append));
+            REQUIRE(file.setFileTime(fileInfo.lastModified().addSecs(60), QFileDevice::FileModificationTime));
+        }
+        const bool success = service.loadNow(files, details);
+        CHECK((!success || !isCached()));
+    }
+#endif
+
+    SECTION("cached stream details are ignored if the files are reprobed")
+    {
+        const bool success = service.loadNow(files, details, true);
+        CHECK((!success || !isCached()));
+    }
+
+    QStandardPaths::setTestModeEnabled(false);
+}
+
+TEST_CASE("StreamDetails can be set from plain details", "[media][streamdetails]")
+{
+    StreamDetails streamDetails(nullptr, FileList{});
+    streamDetails.setDetails(exampleDetails());
+
+    CHECK(streamDetails.videoCodec() == "h264");
+    CHECK(streamDetails.audioCodec() == "dtshd_ma");
+    CHECK(streamDetails.audioChannels() == 6);
+    CHECK(streamDetails.hasAudioChannels(2));
+    CHECK(streamDetails.hasAudioQuality("hd"));
+    CHECK(streamDetails.allSubtitleLanguages() == QStringList{"fra"});
+    CHECK_FALSE(streamDetails.hasLoaded());
+}
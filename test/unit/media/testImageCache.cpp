@@ -0,0 +1,96 @@
+#include "test/test_helpers.h"
+
+#include "media/ImageCache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+using namespace mediaelch;
+
+static int cachedFileCount(const QTemporaryDir& dir)
+{
+    return QDir(dir.filePath("cache/images")).entryList(QDir::Files | QDir::NoDotAndDotDot).size();
+}
+
+TEST_CASE("ImageCache", "[media]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const DirectoryPath cacheDir(dir.filePath("cache"));
+    const int memoryCacheBytes = 1024 * 1024;
+
+    const FilePath source(dir.filePath("poster.png"));
+    QImage sourceImage(400, 600, QImage::Format_RGB32);
+    sourceImage.fill(Qt::red);
+    REQUIRE(sourceImage.save(source.toString()));
+
+    int origWidth = 0;
+    int origHeight = 0;
+
+    SECTION("stores scaled images in memory and on disk")
+    {
+        {
+            ImageCache cache(cacheDir, memoryCacheBytes);
+            CHECK(cache.cachedImage(source, 100, 100, origWidth, origHeight).isNull());
+            CHECK(cache.image(source, 100, 100, origWidth, origHeight).size() == QSize(66, 100));
+            CHECK(origWidth == 400);
+            CHECK(origHeight == 600);
+            CHECK(cache.cachedImage(source, 100, 100, origWidth, origHeight).size() == QSize(66, 100));
+        }
+        // The destructor waits until all images are written.
+        CHECK(cachedFileCount(dir) == 1);
+
+        ImageCache reloaded(cacheDir, memoryCacheBytes);
+        CHECK(reloaded.imageSize(source) == QSize(400, 600));
+        CHECK(reloaded.image(source, 100, 100, origWidth, origHeight).size() == QSize(66, 100));
+        CHECK(cachedFileCount(dir) == 1);
+    }
+
+    SECTION("invalidated images are removed from memory and disk")
+    {
+        {
+            ImageCache cache(cacheDir, memoryCacheBytes);
+            cache.image(source, 100, 100, origWidth, origHeight);
+            cache.image(source, 50, 50, origWidth, origHeight);
+            // The scaled images may still be written to disk.
+            cache.invalidateImages(source);
+            CHECK(cache.cachedImage(source, 100, 100, origWidth, origHeight).isNull());
+            CHECK(cache.cachedImage(source, 50, 50, origWidth, origHeight).isNull());
+            CHECK(cachedFileCount(dir) == 0);
+        }
+        CHECK(cachedFileCount(dir) == 0);
+    }
+
+    SECTION("evicts the least recently used images from memory")
+    {
+        // Only one of the scaled images fits into memory: 66x100 and 53x80 pixels, 4 bytes each.
+        ImageCache cache(cacheDir, 30000);
+        cache.image(source, 100, 100, origWidth, origHeight);
+        cache.image(source, 80, 80, origWidth, origHeight);
+        CHECK(cache.cachedImage(source, 100, 100, origWidth, origHeight).isNull());
+        CHECK(cache.cachedImage(source, 80, 80, origWidth, origHeight).size() == QSize(53, 80));
+
+        // Evicted images are still on disk.
+        CHECK(cache.image(source, 100, 100, origWidth, origHeight).size() == QSize(66, 100));
+        CHECK(origWidth == 400);
+    }
+
+    SECTION("removes all cached images if the index has an unknown format")
+    {
+        {
+            ImageCache cache(cacheDir, memoryCacheBytes);
+            cache.image(source, 100, 100, origWidth, origHeight);
+        }
+        REQUIRE(cachedFileCount(dir) == 1);
+
+        QFile index(dir.filePath("cache/images.index"));
+        REQUIRE(index.open(QIODevice::WriteOnly));
+        index.write("not an index");
+        index.close();
+
+        ImageCache reloaded(cacheDir, memoryCacheBytes);
+        CHECK(cachedFileCount(dir) == 0);
+    }
+}
@@ -0,0 +1,41 @@
+#include "test/test_helpers.h"
+
+#include "media_center/kodi/KodiFileIndex.h"
+
+using mediaelch::kodi::KodiFileIndex;
+
+TEST_CASE("KodiFileIndex", "[kodi]")
+{
+    KodiFileIndex index;
+    index.insert(1, "smb://nas/movies/Alien (1979)/movie.mkv");
+    index.insert(2, "smb://nas/movies/Aliens (1986)/movie.mkv");
+    index.insert(3, "smb://nas/movies/Heat (1995)/Heat.mkv");
+    index.insert(4, "stack://smb://nas/movies/Ran/Ran-cd1.mkv , smb://nas/movies/Ran/Ran-cd2.mkv");
+
+    SECTION("finds unique file names")
+    {
+        CHECK(index.findId({"/mnt/media/Heat (1995)/Heat.mkv"}) == 3);
+        CHECK(index.findId({"C:\\Media\\Heat (1995)\\heat.MKV"}) == 3);
+    }
+
+    SECTION("uses parent directories if file names are ambiguous")
+    {
+        CHECK(index.findId({"/mnt/media/Alien (1979)/movie.mkv"}) == 1);
+        CHECK(index.findId({"/mnt/media/Aliens (1986)/movie.mkv"}) == 2);
+        CHECK(index.findId({"/mnt/media/Alien 3 (1992)/movie.mkv"}) == 0);
+    }
+
+    SECTION("matches stacked files regardless of their order")
+    {
+        CHECK(index.findId({"/mnt/media/Ran/Ran-cd2.mkv", "/mnt/media/Ran/Ran-cd1.mkv"}) == 4);
+        CHECK(index.findId({"/mnt/media/Ran/Ran-cd1.mkv"}) == 0);
+    }
+
+    SECTION("returns -1 for ambiguous or empty input")
+    {
+        // Same file, but added through another source.
+        index.insert(5, "nfs://nas/movies/Alien (1979)/movie.mkv");
+        CHECK(index.findId({"//nas/movies/Alien (1979)/movie.mkv"}) == -1);
+        CHECK(index.findId({}) == -1);
+    }
+}
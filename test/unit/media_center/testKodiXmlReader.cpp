@@ -0,0 +1,69 @@
+#include "test/test_helpers.h"
+
+#include "media/StreamDetails.h"
+#include "media_center/kodi/KodiXmlReader.h"
+
+#include <QXmlStreamReader>
+
+using mediaelch::kodi::htmlToPlainText;
+
+TEST_CASE("htmlToPlainText", "[kodi]")
+{
+    SECTION("returns plain text as is")
+    {
+        CHECK(htmlToPlainText("") == "");
+        CHECK(htmlToPlainText("A movie collection") == "A movie collection");
+    }
+
+    SECTION("decodes entities")
+    {
+        CHECK(htmlToPlainText("Tom &amp; Jerry") == "Tom & Jerry");
+        CHECK(htmlToPlainText("&quot;quoted&quot; &lt;text&gt;") == "\"quoted\" <text>");
+        CHECK(htmlToPlainText("Caf&#233; &#x27;Noir&#x27;") == QString::fromUtf8("Café 'Noir'"));
+        CHECK(htmlToPlainText("a&nbsp;b") == "a b");
+        // only decoded once, same as QTextDocument
+        CHECK(htmlToPlainText("&amp;amp;") == "&amp;");
+    }
+
+    SECTION("keeps ampersands that are no entities")
+    {
+        CHECK(htmlToPlainText("Fast & Furious") == "Fast & Furious");
+        CHECK(htmlToPlainText("A & B; C") == "A & B; C");
+        CHECK(htmlToPlainText("&unknown;") == "&unknown;");
+    }
+
+    SECTION("strips tags and collapses whitespace")
+    {
+        CHECK(htmlToPlainText("<b>bold</b> and <i>italic</i>") == "bold and italic");
+        CHECK(htmlToPlainText("  many \n\t spaces  ") == "many spaces");
+        CHECK(htmlToPlainText("line<br>break<br/>again") == "line\nbreak\nagain");
+        CHECK(htmlToPlainText("<p>first</p><p>second</p>") == "first\nsecond");
+    }
+}
+
+TEST_CASE("readStreamDetails", "[kodi]")
+{
+    QXmlStreamReader xml(R"(<streamdetails>
+          <video><codec>h264</codec><width>1920</width></video>
+          <video><codec>mpeg2</codec></video>
+          <audio><language>eng</language><codec>ac3</codec></audio>
+          <audio><language>ger</language></audio>
+          <subtitle><file>external.srt</file><language>fre</language></subtitle>
+          <subtitle><language>eng</language></subtitle>
+        </streamdetails>)");
+    REQUIRE(xml.readNextStartElement());
+
+    StreamDetails details(nullptr, {});
+    CHECK(mediaelch::kodi::readStreamDetails(xml, details));
+    CHECK_FALSE(xml.hasError());
+    CHECK(details.hasLoaded());
+
+    CHECK(details.videoDetails().value(StreamDetails::VideoDetails::Codec) == "h264");
+    CHECK(details.videoDetails().value(StreamDetails::VideoDetails::Width) == "1920");
+    REQUIRE(details.audioDetails().size() == 2);
+    CHECK(details.audioDetails().at(1).value(StreamDetails::AudioDetails::Language) == "ger");
+    // external subtitles are skipped but keep their index
+    REQUIRE(details.subtitleDetails().size() == 2);
+    CHECK(details.subtitleDetails().at(0).isEmpty());
+    CHECK(details.subtitleDetails().at(1).value(StreamDetails::SubtitleDetails::Language) == "eng");
+}
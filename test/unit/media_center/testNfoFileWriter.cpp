@@ -0,0 +1,58 @@
+#include "test/test_helpers.h"
+
+#include "media_center/kodi/NfoFileWriter.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+using namespace mediaelch::kodi;
+
+static QByteArray nfoWithGenerator(const QByteArray& title, const QByteArray& dateTime)
+{
+    return "<movie>\n    <title>" + title + "</title>\n    <generator>\n        <datetime>" + dateTime
+           + "</datetime>\n    </generator>\n</movie>\n";
+}
+
+TEST_CASE("isSameNfoContent", "[kodi][nfo]")
+{
+    CHECK(isSameNfoContent("<movie/>", "<movie/>"));
+    CHECK_FALSE(isSameNfoContent("<movie/>", "<movie />"));
+    CHECK(isSameNfoContent(
+        nfoWithGenerator("Alien", "2020-01-01T10:00:00Z"), nfoWithGenerator("Alien", "2021-02-02T11:11:11Z")));
+    CHECK_FALSE(isSameNfoContent(
+        nfoWithGenerator("Alien", "2020-01-01T10:00:00Z"), nfoWithGenerator("Aliens", "2020-01-01T10:00:00Z")));
+    CHECK_FALSE(isSameNfoContent(nfoWithGenerator("Alien", "2020-01-01T10:00:00Z"), "<movie/>"));
+}
+
+TEST_CASE("saveNfoFile", "[kodi][nfo]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString filePath = dir.filePath("subdir/movie.nfo");
+    const QByteArray content = nfoWithGenerator("Alien", "2020-01-01T10:00:00Z");
+
+    REQUIRE(saveNfoFile(filePath, content) == NfoSaveResult::Written);
+    {
+        QFile file(filePath);
+        REQUIRE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        CHECK(file.readAll() == content);
+    }
+
+    SECTION("skips files with the same content")
+    {
+        CHECK(saveNfoFile(filePath, nfoWithGenerator("Alien", "2021-02-02T11:11:11Z")) == NfoSaveResult::Unchanged);
+        QFile file(filePath);
+        REQUIRE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        CHECK(file.readAll() == content);
+    }
+
+    SECTION("replaces files with other content")
+    {
+        const QByteArray otherContent = nfoWithGenerator("Aliens", "2020-01-01T10:00:00Z");
+        CHECK(saveNfoFile(filePath, otherContent) == NfoSaveResult::Written);
+        QFile file(filePath);
+        REQUIRE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+        CHECK(file.readAll() == otherContent);
+    }
+}
@@ -0,0 +1,139 @@
+#include "test/test_helpers.h"
+
+#include "model/SearchIndex.h"
+
+using namespace mediaelch;
+
+namespace {
+
+struct Item
+{
+    QString title;
+};
+
+SearchTerms termsOf(const QString& title, const QStringList& genres = {})
+{
+    SearchTerms terms;
+    terms.addText("title", title);
+    terms.addValues("genre", genres);
+    return terms;
+}
+
+} // namespace
+
+TEST_CASE("searchTokens splits text", "[model][search]")
+{
+    CHECK(searchTokens("").isEmpty());
+    CHECK(searchTokens(" - ").isEmpty());
+    CHECK(searchTokens("The Matrix") == QStringList{"the", "matrix"});
+    CHECK(searchTokens("X-Men: Days of Future Past (2014)")
+          == QStringList{"x", "men", "days", "of", "future", "past", "2014"});
+    CHECK(searchTokens("S01E02 Pilot") == QStringList{"s01e02", "pilot"});
+}
+
+TEST_CASE("SearchIndex finds items", "[model][search]")
+{
+    Item matrix{"The Matrix"};
+    Item reloaded{"The Matrix Reloaded"};
+    Item alien{"Alien"};
+
+    SearchIndex<Item> index;
+    index.insert(&matrix, termsOf(matrix.title, {"Action", "Science Fiction"}));
+    index.insert(&reloaded, termsOf(reloaded.title, {"Action"}));
+    index.insert(&alien, termsOf(alien.title, {"Horror"}));
+
+    QSet<Item*> result;
+
+    SECTION("queries without tokens can't be looked up")
+    {
+        CHECK_FALSE(index.findText("title", "", result));
+        CHECK_FALSE(index.findText("title", " :", result));
+    }
+
+    SECTION("each query token must be part of a token")
+    {
+        REQUIRE(index.findText("title", "matr", result));
+        CHECK(result == QSet<Item*>{&matrix, &reloaded});
+
+        REQUIRE(index.findText("title", "MATRIX re", result));
+        CHECK(result == QSet<Item*>{&reloaded});
+
+        REQUIRE(index.findText("title", "lie", result));
+        CHECK(result == QSet<Item*>{&alien});
+
+        REQUIRE(index.findText("title", "matrix alien", result));
+        CHECK(result.isEmpty());
+
+        REQUIRE(index.findText("originalTitle", "matrix", result));
+        CHECK(result.isEmpty());
+    }
+
+    SECTION("values only match exactly")
+    {
+        CHECK(index.findValue("genre", "Action") == QSet<Item*>{&matrix, &reloaded});
+        CHECK(index.findValue("genre", "action").isEmpty());
+        CHECK(index.findValue("genre", "Science").isEmpty());
+    }
+
+    SECTION("removed items are not found")
+    {
+        index.remove(&matrix);
+        CHECK_FALSE(index.contains(&matrix));
+
+        REQUIRE(index.findText("title", "matrix", result));
+        CHECK(result == QSet<Item*>{&reloaded});
+        CHECK(index.findValue("genre", "Science Fiction").isEmpty());
+    }
+
+    SECTION("updated items are found by their new terms")
+    {
+        const quint64 generation = index.generation();
+        index.update(&alien, termsOf(alien.title, {"Horror"}));
+        CHECK(index.generation() == generation);
+
+        alien.title = "Aliens";
+        index.update(&alien, termsOf(alien.title, {"Action"}));
+        CHECK(index.generation() != generation);
+
+        REQUIRE(index.findText("title", "aliens", result));
+        CHECK(result == QSet<Item*>{&alien});
+        CHECK(index.findValue("genre", "Horror").isEmpty());
+        CHECK(index.findValue("genre", "Action") == QSet<Item*>{&matrix, &reloaded, &alien});
+    }
+}
+
+TEST_CASE("SearchCandidates intersects filters", "[model][search]")
+{
+    Item matrix{"The Matrix"};
+    Item alien{"Alien"};
+
+    SearchIndex<Item> index;
+    index.insert(&matrix, termsOf(matrix.title, {"Action"}));
+    index.insert(&alien, termsOf(alien.title, {"Horror"}));
+
+    const auto find = [](const SearchIndex<Item>& searchIndex, const QString& query, QSet<Item*>& result) {
+        return searchIndex.findText("title", query, result);
+    };
+
+    SearchCandidates<Item> candidates;
+
+    candidates.update(index, QStringList{}, find);
+    CHECK_FALSE(candidates.isNarrowed());
+    CHECK(candidates.contains(&matrix));
+
+    candidates.invalidate();
+    candidates.update(index, QStringList{"the", "matrix"}, find);
+    CHECK(candidates.isNarrowed());
+    CHECK(candidates.contains(&matrix));
+    CHECK_FALSE(candidates.contains(&alien));
+
+    candidates.invalidate();
+    candidates.update(index, QStringList{"matrix", "alien"}, find);
+    CHECK(candidates.items().isEmpty());
+
+    // Changes to the index are picked up without invalidating the candidates.
+    Item aliens{"Aliens vs. Matrix"};
+    index.insert(&aliens, termsOf(aliens.title));
+    candidates.update(index, QStringList{"matrix", "alien"}, find);
+    CHECK(candidates.items() == QSet<Item*>{&aliens});
+}
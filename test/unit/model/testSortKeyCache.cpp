@@ -0,0 +1,66 @@
+#include "test/test_helpers.h"
+
+#include "model/SortKeyCache.h"
+
+#include <QSortFilterProxyModel>
+#include <QStringListModel>
+
+using namespace mediaelch;
+
+TEST_CASE("SortKeyCache compares titles", "[model]")
+{
+    SortKeyCache cache;
+    int a = 0;
+    int b = 0;
+
+    SECTION("titles are compared locale aware")
+    {
+        CHECK(cache.compare(&a, "Alien", &b, "Zorro") < 0);
+        CHECK(cache.compare(&a, "Zorro", &b, "Alien") > 0);
+        CHECK(cache.compare(&a, "Alien", &b, "Alien") == 0);
+        CHECK(cache.compare(&a, QStringLiteral("\u00C4rger"), &b, "Zorro") < 0);
+    }
+
+    SECTION("changed titles are not taken from the cache")
+    {
+        CHECK(cache.compare(&a, "A", &b, "B") < 0);
+        CHECK(cache.compare(&a, "C", &b, "B") > 0);
+        CHECK(cache.compare(&a, "C", &b, "C") == 0);
+    }
+
+    SECTION("cache is cleared if rows are removed or the model is reset")
+    {
+        QStringListModel model(QStringList{"Alien", "Zorro"});
+        QSortFilterProxyModel proxy;
+        proxy.setSourceModel(&model);
+        cache.attach(&proxy);
+
+        cache.compare(&a, "Alien", &b, "Zorro");
+        CHECK(cache.size() == 2);
+        model.removeRows(0, 1);
+        CHECK(cache.size() == 0);
+
+        cache.compare(&a, "Alien", &b, "Zorro");
+        model.setStringList({});
+        CHECK(cache.size() == 0);
+    }
+
+    SECTION("only the current source model clears the cache")
+    {
+        QStringListModel oldModel(QStringList{"Alien", "Zorro"});
+        QStringListModel newModel(QStringList{"Alien", "Zorro"});
+        QSortFilterProxyModel proxy;
+        cache.attach(&proxy);
+        proxy.setSourceModel(&oldModel);
+
+        cache.compare(&a, "Alien", &b, "Zorro");
+        proxy.setSourceModel(&newModel);
+        CHECK(cache.size() == 0);
+
+        cache.compare(&a, "Alien", &b, "Zorro");
+        oldModel.removeRows(0, 1);
+        CHECK(cache.size() == 2);
+        newModel.removeRows(0, 1);
+        CHECK(cache.size() == 0);
+    }
+}
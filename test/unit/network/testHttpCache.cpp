@@ -0,0 +1,106 @@
+#include "test/test_helpers.h"
+
+#include "network/HttpCache.h"
+
+#include <QTemporaryDir>
+#include <QThread>
+
+using mediaelch::network::HttpCache;
+
+static HttpCache::Entry makeEntry(const QByteArray& data, std::chrono::seconds maxAge = std::chrono::hours(1))
+{
+    HttpCache::Entry entry;
+    entry.data = data;
+    entry.date = QDateTime::currentDateTimeUtc();
+    entry.maxAge = maxAge;
+    return entry;
+}
+
+TEST_CASE("HttpCache", "[network]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+
+    SECTION("stores entries")
+    {
+        HttpCache cache(dir.path());
+        HttpCache::Entry entry = makeEntry("{\"id\": 42}");
+        entry.eTag = "\"abc\"";
+        cache.insert("https://example.com/42", entry);
+
+        HttpCache::Entry found;
+        REQUIRE(cache.find("https://example.com/42", found));
+        CHECK(found.data == "{\"id\": 42}");
+        CHECK(found.eTag == "\"abc\"");
+        CHECK(found.isFresh());
+        CHECK_FALSE(cache.find("https://example.com/43", found));
+    }
+
+    SECTION("entries survive a restart")
+    {
+        {
+            HttpCache cache(dir.path());
+            cache.insert("https://example.com/42", makeEntry("data"));
+        }
+        HttpCache cache(dir.path());
+        HttpCache::Entry found;
+        REQUIRE(cache.find("https://example.com/42", found));
+        CHECK(found.data == "data");
+        CHECK(cache.diskSize() > 0);
+    }
+
+    SECTION("stale entries can be revalidated")
+    {
+        HttpCache cache(dir.path());
+        cache.insert("https://example.com/42", makeEntry("data", std::chrono::seconds(0)));
+        HttpCache::Entry found;
+        REQUIRE(cache.find("https://example.com/42", found));
+        found.date = found.date.addSecs(-10);
+        CHECK_FALSE(found.isFresh());
+
+        cache.revalidate("https://example.com/42", std::chrono::hours(1));
+        REQUIRE(cache.find("https://example.com/42", found));
+        CHECK(found.isFresh());
+        CHECK(found.data == "data");
+    }
+
+    SECTION("expired entries must be revalidated")
+    {
+        HttpCache cache(dir.path());
+        HttpCache::Entry entry = makeEntry("data");
+        entry.date = entry.date.addSecs(-10);
+        cache.insert("https://example.com/42", entry);
+        cache.expireAll();
+
+        HttpCache::Entry found;
+        REQUIRE(cache.find("https://example.com/42", found));
+        CHECK_FALSE(found.isFresh());
+        CHECK(found.data == "data");
+
+        cache.revalidate("https://example.com/42", std::chrono::hours(1));
+        REQUIRE(cache.find("https://example.com/42", found));
+        CHECK(found.isFresh());
+    }
+
+    SECTION("removes the oldest entries if the cache is full")
+    {
+        const QByteArray data(1000, 'x');
+        HttpCache cache(dir.path(), 3500);
+        for (const char* key : {"first", "second", "third", "fourth"}) {
+            cache.insert(key, makeEntry(data));
+            // Entries are ordered by their write time in milliseconds.
+            QThread::msleep(5);
+        }
+        CHECK(cache.diskSize() > 0);
+        CHECK(cache.diskSize() <= 3500);
+
+        HttpCache::Entry found;
+        CHECK_FALSE(cache.find("first", found));
+        CHECK(cache.find("third", found));
+        CHECK(cache.find("fourth", found));
+        CHECK(found.data == data);
+
+        HttpCache reloaded(dir.path(), 3500);
+        CHECK(reloaded.diskSize() == cache.diskSize());
+    }
+}
@@ -0,0 +1,105 @@
+#include "test/test_helpers.h"
+
+#include "network/NetworkManager.h"
+#include "network/RequestScheduler.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTimer>
+
+using namespace mediaelch::network;
+
+namespace {
+
+/// \brief Local files have no host, so their limits can be changed without affecting other tests.
+const QString s_fileHost = "";
+
+bool waitForFinished(QNetworkReply* reply)
+{
+    if (reply->isFinished()) {
+        return true;
+    }
+    QEventLoop loop;
+    QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+    return reply->isFinished();
+}
+
+QNetworkRequest fileRequest(const QString& path)
+{
+    return QNetworkRequest(QUrl::fromLocalFile(path));
+}
+
+} // namespace
+
+TEST_CASE("RequestScheduler", "[network]")
+{
+    QTemporaryDir dir;
+    REQUIRE(dir.isValid());
+    const QString path = dir.filePath("data.json");
+    {
+        QFile file(path);
+        REQUIRE(file.open(QFile::WriteOnly));
+        file.write("{\"id\": 42}");
+    }
+
+    RequestScheduler& scheduler = RequestScheduler::instance();
+    const HostLimits previousLimits = scheduler.hostLimits(s_fileHost);
+    scheduler.setHostLimits(s_fileHost, HostLimits{0.0, 1, 1});
+    const HostStatistics before = scheduler.statistics(s_fileHost);
+
+    SECTION("forwards the actual reply's data")
+    {
+        NetworkManager manager;
+        QNetworkReply* reply = manager.get(fileRequest(path));
+        REQUIRE(waitForFinished(reply));
+        CHECK(reply->error() == QNetworkReply::NoError);
+        CHECK(reply->readAll() == "{\"id\": 42}");
+        reply->deleteLater();
+    }
+
+    SECTION("limits parallel requests")
+    {
+        NetworkManager manager;
+        QNetworkReply* first = manager.get(fileRequest(path));
+        QNetworkReply* second = manager.get(fileRequest(path));
+        CHECK(scheduler.statistics(s_fileHost).started == before.started + 1);
+
+        REQUIRE(waitForFinished(first));
+        REQUIRE(waitForFinished(second));
+        CHECK(second->readAll() == "{\"id\": 42}");
+        const HostStatistics after = scheduler.statistics(s_fileHost);
+        CHECK(after.started == before.started + 2);
+        CHECK(after.finished == before.finished + 2);
+        CHECK(after.failed == before.failed);
+    }
+
+    SECTION("aborts queued requests")
+    {
+        NetworkManager manager;
+        QNetworkReply* first = manager.get(fileRequest(path));
+        QNetworkReply* second = manager.get(fileRequest(path));
+        second->abort();
+        CHECK(second->isFinished());
+        CHECK(second->error() == QNetworkReply::OperationCanceledError);
+        REQUIRE(waitForFinished(first));
+        CHECK(scheduler.statistics(s_fileHost).started == before.started + 1);
+    }
+
+    SECTION("network manager can be deleted while requests are running")
+    {
+        auto* manager = new NetworkManager();
+        manager->get(fileRequest(path));
+        manager->get(fileRequest(path));
+        delete manager;
+
+        // The deleted requests must not block the host.
+        NetworkManager other;
+        QNetworkReply* reply = other.get(fileRequest(path));
+        REQUIRE(waitForFinished(reply));
+        CHECK(reply->readAll() == "{\"id\": 42}");
+    }
+
+    scheduler.setHostLimits(s_fileHost, previousLimits);
+}
@@ -0,0 +1,133 @@
+#include "test/test_helpers.h"
+
+#include "scrapers/ScrapePipeline.h"
+
+using namespace mediaelch::scraper;
+
+TEST_CASE("ScrapePipeline passes items through all stages", "[scraper][pipeline]")
+{
+    ScrapePipeline pipeline;
+    QVector<int> started;
+    QVector<int> finished;
+    bool allFinished = false;
+    QObject::connect(&pipeline, &ScrapePipeline::itemStarted, [&](int item) { started << item; });
+    QObject::connect(&pipeline, &ScrapePipeline::itemFinished, [&](int item) { finished << item; });
+    QObject::connect(&pipeline, &ScrapePipeline::finished, [&]() { allFinished = true; });
+
+    SECTION("without items, the pipeline finishes immediately")
+    {
+        pipeline.start(0);
+        CHECK(allFinished);
+        CHECK_FALSE(pipeline.isRunning());
+    }
+
+    SECTION("synchronous handlers")
+    {
+        QVector<QPair<int, int>> calls;
+        pipeline.setHandler(ScrapePipeline::Stage::Search, [&](int item, int run) {
+            calls.push_back({0, item});
+            pipeline.advance(item, run);
+        });
+        pipeline.setHandler(ScrapePipeline::Stage::Save, [&](int item, int run) {
+            calls.push_back({3, item});
+            pipeline.advance(item, run);
+        });
+        pipeline.start(3);
+
+        CHECK(allFinished);
+        CHECK(started == QVector<int>{0, 1, 2});
+        CHECK(finished == QVector<int>{0, 1, 2});
+        CHECK(calls == QVector<QPair<int, int>>{{0, 0}, {3, 0}, {0, 1}, {3, 1}, {0, 2}, {3, 2}});
+    }
+
+    SECTION("stages respect their limits")
+    {
+        QVector<int> searching;
+        QVector<int> loading;
+        pipeline.setHandler(ScrapePipeline::Stage::Search, [&](int item, int) { searching << item; });
+        pipeline.setHandler(ScrapePipeline::Stage::Load, [&](int item, int) { loading << item; });
+
+        ScrapePipeline::Limits limits;
+        limits.search = 2;
+        limits.load = 1;
+        pipeline.setLimits(limits);
+        const int run = pipeline.start(5);
+
+        CHECK(searching == QVector<int>{0, 1});
+        CHECK(pipeline.runningCount(ScrapePipeline::Stage::Search) == 2);
+
+        pipeline.advance(1, run);
+        CHECK(loading == QVector<int>{1});
+        CHECK(searching == QVector<int>{0, 1, 2});
+
+        // The load stage is busy and item 0 has to wait for it.  No new item is
+        // searched as long as it's waiting.
+        pipeline.advance(0, run);
+        CHECK(loading == QVector<int>{1});
+        CHECK(searching == QVector<int>{0, 1, 2});
+
+        pipeline.advance(1, run);
+        CHECK(finished == QVector<int>{1});
+        CHECK(loading == QVector<int>{1, 0});
+        CHECK(searching == QVector<int>{0, 1, 2, 3});
+
+        pipeline.finish(3, run);
+        CHECK(searching == QVector<int>{0, 1, 2, 3, 4});
+
+        pipeline.finish(2, run);
+        pipeline.advance(0, run);
+        CHECK(finished == QVector<int>{1, 3, 2, 0});
+        CHECK_FALSE(allFinished);
+
+        pipeline.advance(4, run);
+        pipeline.advance(4, run);
+        CHECK(allFinished);
+        CHECK(pipeline.finishedCount() == 5);
+    }
+
+    SECTION("aborted pipelines ignore late calls")
+    {
+        QVector<int> loading;
+        pipeline.setHandler(ScrapePipeline::Stage::Search, [&](int, int) {});
+        pipeline.setHandler(ScrapePipeline::Stage::Load, [&](int item, int) { loading << item; });
+        const int run = pipeline.start(2);
+
+        pipeline.abort();
+        pipeline.advance(0, run);
+        CHECK(loading.isEmpty());
+        CHECK(finished.isEmpty());
+        CHECK_FALSE(allFinished);
+        CHECK_FALSE(pipeline.isRunning());
+    }
+
+    SECTION("restarted pipelines ignore late calls of the previous run")
+    {
+        QVector<int> loading;
+        pipeline.setHandler(ScrapePipeline::Stage::Search, [&](int, int) {});
+        pipeline.setHandler(ScrapePipeline::Stage::Load, [&](int item, int) { loading << item; });
+        const int firstRun = pipeline.start(2);
+        const int secondRun = pipeline.start(2);
+        CHECK(firstRun != secondRun);
+        CHECK(pipeline.run() == secondRun);
+
+        pipeline.advance(0, firstRun);
+        pipeline.finish(1, firstRun);
+        CHECK(loading.isEmpty());
+        CHECK(finished.isEmpty());
+
+        pipeline.advance(0, secondRun);
+        CHECK(loading == QVector<int>{0});
+    }
+
+    SECTION("pipelines can be aborted when an item is started")
+    {
+        QVector<int> searching;
+        pipeline.setHandler(ScrapePipeline::Stage::Search, [&](int item, int) { searching << item; });
+        QObject::connect(&pipeline, &ScrapePipeline::itemStarted, [&]() { pipeline.abort(); });
+        pipeline.start(2);
+
+        CHECK(started == QVector<int>{0});
+        CHECK(searching.isEmpty());
+        CHECK_FALSE(pipeline.isRunning());
+    }
+}
@@ -140,6 +140,34 @@ TEST_CASE("Advanced Settings XML", "[settings]")
         }
     }
 
+    SECTION("scraper cache time to live")
+    {
+        QString xml = addBaseXml(R"xml(
+            <scraperCache>
+                <timeToLive api="tmdb">86400</timeToLive>
+                <timeToLive api="AEBN">0</timeToLive>
+                <timeToLive api="tvmaze">-1</timeToLive>
+                <timeToLive>60</timeToLive>
+            </scraperCache>
+        )xml");
+
+        const auto pair = AdvancedSettingsXmlReader::loadFromXml(xml);
+        const auto settings = pair.first;
+        const auto messages = pair.second;
+
+        const std::chrono::seconds defaultTimeToLive = std::chrono::hours(1);
+        CHECK(settings.scraperCacheTimeToLive("tmdb", defaultTimeToLive) == std::chrono::hours(24));
+        CHECK(settings.scraperCacheTimeToLive("aebn", defaultTimeToLive) == std::chrono::seconds(0));
+        CHECK(settings.scraperCacheTimeToLive("tvmaze", defaultTimeToLive) == defaultTimeToLive);
+        CHECK(settings.scraperCacheTimeToLive("imdb", defaultTimeToLive) == defaultTimeToLive);
+
+        REQUIRE(messages.size() == 2);
+        CHECK(messages[0].tag == "timeToLive");
+        CHECK(messages[0].type == AdvancedSettingsXmlReader::ParseErrorType::InvalidValue);
+        CHECK(messages[1].tag == "timeToLive");
+        CHECK(messages[1].type == AdvancedSettingsXmlReader::ParseErrorType::InvalidAttributeValue);
+    }
+
     SECTION("read attributes correctly")
     {
         QString xml = addBaseXml(R"xml(
@@ -0,0 +1,81 @@
+#include "test/test_helpers.h"
+
+#include "data/tv_show/TvShow.h"
+#include "data/tv_show/TvShowEpisode.h"
+
+static TvShowEpisode* addEpisode(TvShow& show, int season, int episode, bool isDummy = false)
+{
+    auto* tvShowEpisode = new TvShowEpisode({}, &show);
+    tvShowEpisode->setSeason(SeasonNumber(season));
+    tvShowEpisode->setEpisode(EpisodeNumber(episode));
+    tvShowEpisode->setIsDummy(isDummy);
+    show.addEpisode(tvShowEpisode);
+    return tvShowEpisode;
+}
+
+TEST_CASE("TvShow episode lookup", "[tvshow][data]")
+{
+    TvShow show;
+
+    SECTION("unknown episodes are not found")
+    {
+        CHECK(show.episode(SeasonNumber(1), EpisodeNumber(1)) == nullptr);
+        addEpisode(show, 1, 1);
+        CHECK(show.episode(SeasonNumber(1), EpisodeNumber(2)) == nullptr);
+        CHECK(show.episode(SeasonNumber(2), EpisodeNumber(1)) == nullptr);
+        CHECK(show.episodeCount() == 1);
+    }
+
+    SECTION("episodes are found by season and episode number")
+    {
+        auto* s1e1 = addEpisode(show, 1, 1);
+        auto* s1e2 = addEpisode(show, 1, 2);
+        auto* s2e1 = addEpisode(show, 2, 1);
+
+        CHECK(show.episode(SeasonNumber(1), EpisodeNumber(1)) == s1e1);
+        CHECK(show.episode(SeasonNumber(1), EpisodeNumber(2)) == s1e2);
+        CHECK(show.episode(SeasonNumber(2), EpisodeNumber(1)) == s2e1);
+
+        CHECK(show.episodes(SeasonNumber(1)) == QVector<TvShowEpisode*>{s1e1, s1e2});
+        CHECK(show.episodes(SeasonNumber(2)) == QVector<TvShowEpisode*>{s2e1});
+        CHECK(show.episodes(SeasonNumber(3)).isEmpty());
+    }
+
+    SECTION("seasons are returned in order of their first episode")
+    {
+        addEpisode(show, 2, 1);
+        addEpisode(show, 1, 1);
+        addEpisode(show, 2, 2);
+        addEpisode(show, 0, 1);
+
+        CHECK(show.seasons() == QVector<SeasonNumber>{SeasonNumber(2), SeasonNumber(1), SeasonNumber(0)});
+    }
+
+    SECTION("renumbered episodes are found by their new number")
+    {
+        auto* episode = addEpisode(show, 1, 1);
+        episode->setSeason(SeasonNumber(3));
+        episode->setEpisode(EpisodeNumber(7));
+
+        CHECK(show.episode(SeasonNumber(1), EpisodeNumber(1)) == nullptr);
+        CHECK(show.episode(SeasonNumber(3), EpisodeNumber(7)) == episode);
+        CHECK(show.seasons() == QVector<SeasonNumber>{SeasonNumber(3)});
+    }
+
+    SECTION("dummy episodes")
+    {
+        addEpisode(show, 1, 1);
+        addEpisode(show, 1, 2, true);
+        auto* s2e1 = addEpisode(show, 2, 1, true);
+
+        CHECK(show.hasDummyEpisodes(SeasonNumber(1)));
+        CHECK_FALSE(show.isDummySeason(SeasonNumber(1)));
+        CHECK(show.isDummySeason(SeasonNumber(2)));
+        CHECK(show.seasons(false) == QVector<SeasonNumber>{SeasonNumber(1)});
+        CHECK(show.seasons(true) == QVector<SeasonNumber>{SeasonNumber(1), SeasonNumber(2)});
+
+        s2e1->setIsDummy(false);
+        CHECK_FALSE(show.isDummySeason(SeasonNumber(2)));
+        CHECK(show.seasons(false) == QVector<SeasonNumber>{SeasonNumber(1), SeasonNumber(2)});
+    }
+}